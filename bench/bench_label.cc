@@ -0,0 +1,40 @@
+/**
+ * \file bench/bench_label.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <stdint.h>
+#include <string.h>
+
+/* Project's .h */
+#include "library/watershed.h"
+
+/**
+ * \class BenchLabel
+ * \brief Label function of the benchmark shuffle. Sends every record with the same key, written by BenchSource in its
+ * first bytes, to the same instance.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class BenchLabel : public LabelFunction {
+
+	public:
+
+		/**
+		 * \brief Retrieves the instance receiving a record.
+		 * \param message Record to be sent.
+		 * \param total_instances Number of consumer instances.
+		 * \return The key modulo the number of instances.
+		 */
+		int GetLabel ( Message& message, int total_instances ) {
+			uint64_t key = 0;
+			memcpy ( &key, message.GetData ( ), ( message.GetDataSize ( ) < ( int ) sizeof(key) ) ? message.GetDataSize ( ) : sizeof(key) );
+			return ( int ) ( key % total_instances );
+		}
+};
+
+RegisterFunction ( BenchLabel )
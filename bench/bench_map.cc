@@ -0,0 +1,79 @@
+/**
+ * \file bench/bench_map.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Project's .h */
+#include "bench/bench_report.h"
+#include "library/watershed.h"
+
+/**
+ * \class BenchMap
+ * \brief Benchmark map. Forwards every record it receives, after reading its bytes a configurable number of times to
+ * simulate some processing cost.
+ *
+ * Arguments: -work number of passes over each record (default 0), -report directory of the report files, -interval
+ * time between report lines in seconds (default 1).
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class BenchMap : public ProcessingModule {
+
+	public:
+
+		/**
+		 * \brief Creates a new BenchMap instance.
+		 * \return Not applicable.
+		 */
+		BenchMap ( void ) {
+			work_ = 0;
+			checksum_ = 0;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~BenchMap ( void ) {
+		}
+
+		/**
+		 * \brief Forwards a record.
+		 * \param message Record received.
+		 * \return Not applicable.
+		 */
+		void Process ( Message& message ) {
+			if ( !report_.IsOpen ( ) ) {
+				work_ = atoi ( GetArgument ( "work" ).c_str ( ) );
+				report_.Open ( GetArgument ( "report" ).empty ( ) ? "." : GetArgument ( "report" ), GetModuleName ( ), GetRank ( ), atof ( GetArgument ( "interval" ).c_str ( ) ) );
+			}
+			const unsigned char* data = ( const unsigned char* ) message.GetData ( );
+			for ( int w = 0; w < work_; ++w ) {
+				for ( int i = 0; i < message.GetDataSize ( ); ++i ) {
+					checksum_ = checksum_ * 31 + data[i];
+				}
+			}
+			Send ( message );
+			report_.Count ( message, false );
+		}
+
+	private:
+
+		/** \brief Number of passes over each record. */
+		int work_;
+
+		/** \brief Result of the passes, kept so they are not optimized away. */
+		volatile uint32_t checksum_;
+
+		/** \brief Throughput of the instance. */
+		BenchReport report_;
+};
+
+RegisterModule ( BenchMap )
@@ -0,0 +1,95 @@
+/**
+ * \file bench/bench_report.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "bench/bench_report.h"
+
+BenchReport::BenchReport ( void ) {
+	file_ = NULL;
+	open_ = false;
+	interval_ = 0;
+	start_time_ = 0;
+	last_time_ = 0;
+	last_cpu_time_ = 0;
+	records_ = 0;
+	bytes_ = 0;
+}
+
+BenchReport::~BenchReport ( void ) {
+	if ( file_ != NULL ) {
+		Write ( );
+		fclose ( file_ );
+	}
+}
+
+void BenchReport::Count ( Message& message, bool latency ) {
+	++records_;
+	bytes_ += message.GetDataSize ( );
+	if ( latency && message.GetOriginTime ( ) != 0 ) {
+		latencies_.push_back ( message.GetReceiveTime ( ) - message.GetOriginTime ( ) );
+	}
+
+	/* The clock is read once every few records, so the report does not weigh on the module being measured */
+	if ( file_ != NULL && ( records_ & 0x3f ) == 0 && GetClockTime ( ) - last_time_ >= interval_ ) {
+		Write ( );
+	}
+}
+
+double BenchReport::GetClockTime ( void ) {
+	struct timeval now;
+	gettimeofday ( &now, NULL );
+	return now.tv_sec + now.tv_usec * 0.000001;
+}
+
+double BenchReport::GetCPUTime ( void ) {
+	struct rusage usage;
+	getrusage ( RUSAGE_SELF, &usage );
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 0.000001 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 0.000001;
+}
+
+double BenchReport::GetLatencyPercentile ( int permille ) {
+	if ( latencies_.empty ( ) ) {
+		return 0;
+	}
+	size_t position = ( latencies_.size ( ) - 1 ) * permille / 1000;
+	nth_element ( latencies_.begin ( ), latencies_.begin ( ) + position, latencies_.end ( ) );
+	return latencies_[position] / 1000.0;
+}
+
+bool BenchReport::IsOpen ( void ) {
+	return open_;
+}
+
+void BenchReport::Open ( string directory, string module_name, int rank, double interval ) {
+	char file_name[FILENAME_MAX];
+	snprintf ( file_name, sizeof ( file_name ), "%s/%s.%d.log", directory.c_str ( ), module_name.c_str ( ), rank );
+	file_ = fopen ( file_name, "w" );
+	open_ = true;
+	interval_ = ( interval > 0 ) ? interval : 1;
+	start_time_ = GetClockTime ( );
+	last_time_ = start_time_;
+	last_cpu_time_ = GetCPUTime ( );
+	if ( file_ != NULL ) {
+		fprintf ( file_, "# elapsed\tseconds\trecords\tbytes\tcpu\tp50_us\tp99_us\tp999_us\n" );
+		fflush ( file_ );
+	}
+}
+
+void BenchReport::Write ( void ) {
+	double now = GetClockTime ( );
+	double cpu_time = GetCPUTime ( );
+	double p50 = GetLatencyPercentile ( 500 );
+	double p99 = GetLatencyPercentile ( 990 );
+	double p999 = GetLatencyPercentile ( 999 );
+	fprintf ( file_, "%.3f\t%.3f\t%ld\t%ld\t%.6f\t%.1f\t%.1f\t%.1f\n", now - start_time_, now - last_time_, records_, bytes_, cpu_time - last_cpu_time_, p50, p99, p999 );
+	fflush ( file_ );
+
+	last_time_ = now;
+	last_cpu_time_ = cpu_time;
+	records_ = 0;
+	bytes_ = 0;
+	latencies_.clear ( );
+}
@@ -0,0 +1,139 @@
+/**
+ * \file bench/bench_report.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_BENCH_BENCH_REPORT_H_
+#define WATERSHED_BENCH_BENCH_REPORT_H_
+
+/* C libraries */
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+/* C++ libraries */
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/* Project's .h */
+#include "comm/message.h"
+
+using namespace std;
+
+/**
+ * \class BenchReport
+ * \brief Throughput, latency and CPU usage of a benchmark module instance. Every interval, one line is appended to
+ * the instance report file with the elapsed time, the records and bytes counted, the CPU time of the process and, for
+ * sinks, the latency percentiles since the previous line. bench/ws-bench sums the lines of all the instances.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class BenchReport {
+
+	public:
+
+		/**
+		 * \brief Creates a new BenchReport instance, which writes nothing until it is opened.
+		 * \return Not applicable.
+		 */
+		BenchReport ( void );
+
+		/**
+		 * \brief Destructor. Writes the last interval and closes the report file.
+		 * \return Not applicable.
+		 */
+		virtual ~BenchReport ( void );
+
+		/**
+		 * \brief Checks if the report file is open.
+		 * \return True once Open was called, even if the file could not be created.
+		 */
+		bool IsOpen ( void );
+
+		/**
+		 * \brief Counts a record, writing a line if the interval is over.
+		 * \param message The record sent or received.
+		 * \param latency True to count the latency from the record origin, in a sink.
+		 * \return Not applicable.
+		 */
+		void Count ( Message& message, bool latency );
+
+		/**
+		 * \brief Creates the report file of an instance.
+		 * \param directory Directory of the report files.
+		 * \param module_name The module name.
+		 * \param rank The instance rank.
+		 * \param interval Time between two lines, in seconds.
+		 * \return Not applicable.
+		 */
+		void Open ( string directory, string module_name, int rank, double interval );
+
+	protected:
+
+	private:
+
+		/**
+		 * \brief Retrieves the CPU time of the process, including its communication threads.
+		 * \return The time in seconds.
+		 */
+		double GetCPUTime ( void );
+
+		/**
+		 * \brief Retrieves the wall clock time.
+		 * \return The time in seconds.
+		 */
+		double GetClockTime ( void );
+
+		/**
+		 * \brief Retrieves a percentile of the latencies counted in the interval. Sorts them.
+		 * \param permille The percentile, from 0 to 1000.
+		 * \return The latency in microseconds, 0 if none was counted.
+		 */
+		double GetLatencyPercentile ( int permille );
+
+		/**
+		 * \brief Appends the line of the interval and starts a new one.
+		 * \return Not applicable.
+		 */
+		void Write ( void );
+
+		/** \brief The report file, NULL until opened. */
+		FILE* file_;
+
+		/** \brief Open was called. */
+		bool open_;
+
+		/** \brief Time between two lines, in seconds. */
+		double interval_;
+
+		/** \brief Clock time when the report was opened. */
+		double start_time_;
+
+		/** \brief Clock time of the last line. */
+		double last_time_;
+
+		/** \brief CPU time of the last line. */
+		double last_cpu_time_;
+
+		/** \brief Records counted in the interval. */
+		long records_;
+
+		/** \brief Bytes counted in the interval. */
+		long bytes_;
+
+		/** \brief Latencies counted in the interval, in nanoseconds. */
+		vector < int64_t > latencies_;
+
+		/** \brief Copy is not allowed. */
+		BenchReport ( const BenchReport& );
+
+		/** \brief Assignment is not allowed. */
+		BenchReport& operator= ( const BenchReport& );
+};
+
+#endif /* WATERSHED_BENCH_BENCH_REPORT_H_ */
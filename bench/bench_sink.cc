@@ -0,0 +1,60 @@
+/**
+ * \file bench/bench_sink.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <stdlib.h>
+
+/* Project's .h */
+#include "bench/bench_report.h"
+#include "library/watershed.h"
+
+/**
+ * \class BenchSink
+ * \brief Benchmark sink. Discards the records it receives, reporting their throughput and end-to-end latency.
+ *
+ * Arguments: -report directory of the report files, -interval time between report lines in seconds (default 1).
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class BenchSink : public ProcessingModule {
+
+	public:
+
+		/**
+		 * \brief Creates a new BenchSink instance.
+		 * \return Not applicable.
+		 */
+		BenchSink ( void ) {
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~BenchSink ( void ) {
+		}
+
+		/**
+		 * \brief Counts a record.
+		 * \param message Record received.
+		 * \return Not applicable.
+		 */
+		void Process ( Message& message ) {
+			if ( !report_.IsOpen ( ) ) {
+				report_.Open ( GetArgument ( "report" ).empty ( ) ? "." : GetArgument ( "report" ), GetModuleName ( ), GetRank ( ), atof ( GetArgument ( "interval" ).c_str ( ) ) );
+			}
+			report_.Count ( message, true );
+		}
+
+	private:
+
+		/** \brief Throughput and latency of the instance. */
+		BenchReport report_;
+};
+
+RegisterModule ( BenchSink )
@@ -0,0 +1,116 @@
+/**
+ * \file bench/bench_source.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project's .h */
+#include "bench/bench_report.h"
+#include "library/watershed.h"
+
+/**
+ * \class BenchSource
+ * \brief Benchmark source. Produces records of a fixed size as fast as the consumers' credits allow, each one starting
+ * with a key cycling through a fixed number of values.
+ *
+ * Arguments: -size record size in bytes (default 100), -keys number of distinct keys (default 1024), -report directory
+ * of the report files, -interval time between report lines in seconds (default 1).
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class BenchSource : public ProcessingModule {
+
+	public:
+
+		/**
+		 * \brief Creates a new BenchSource instance.
+		 * \return Not applicable.
+		 */
+		BenchSource ( void ) {
+			record_size_ = 0;
+			number_keys_ = 0;
+			sequence_number_ = 0;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~BenchSource ( void ) {
+		}
+
+		/**
+		 * \brief Sends records until the batch is full.
+		 * \param batch Batch receiving the records.
+		 * \return Not applicable.
+		 */
+		void Generate ( OutputBatch& batch ) {
+			if ( !report_.IsOpen ( ) ) {
+				Configure ( );
+			}
+			while ( !batch.IsFull ( ) ) {
+				uint64_t key = sequence_number_++ % number_keys_;
+				memcpy ( record_.GetData ( ), &key, sizeof(key) );
+				record_.SetDataSize ( record_size_ );
+				batch.Add ( record_ );
+				report_.Count ( record_, false );
+			}
+		}
+
+		/**
+		 * \brief Not used, the source has no inputs.
+		 * \param message Message received.
+		 * \return Not applicable.
+		 */
+		void Process ( Message& message ) {
+		}
+
+	private:
+
+		/**
+		 * \brief Reads the arguments and fills the record.
+		 * \return Not applicable.
+		 */
+		void Configure ( void ) {
+			record_size_ = atoi ( GetArgument ( "size" ).c_str ( ) );
+			if ( record_size_ <= 0 ) {
+				record_size_ = 100;
+			}
+			if ( record_size_ < ( int ) sizeof(uint64_t) ) {
+				record_size_ = sizeof(uint64_t);
+			}
+			if ( record_size_ > Constants::MAX_DATA_SIZE ) {
+				record_size_ = Constants::MAX_DATA_SIZE;
+			}
+			number_keys_ = atol ( GetArgument ( "keys" ).c_str ( ) );
+			if ( number_keys_ <= 0 ) {
+				number_keys_ = 1024;
+			}
+			memset ( record_.GetData ( ), 'w', record_size_ );
+			report_.Open ( GetArgument ( "report" ).empty ( ) ? "." : GetArgument ( "report" ), GetModuleName ( ), GetRank ( ), atof ( GetArgument ( "interval" ).c_str ( ) ) );
+		}
+
+		/** \brief Record size in bytes. */
+		int record_size_;
+
+		/** \brief Number of distinct keys. */
+		long number_keys_;
+
+		/** \brief Number of records produced. */
+		uint64_t sequence_number_;
+
+		/** \brief The record, reused for every send. */
+		Message record_;
+
+		/** \brief Throughput of the instance. */
+		BenchReport report_;
+};
+
+RegisterModule ( BenchSource )
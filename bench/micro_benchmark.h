@@ -0,0 +1,67 @@
+/**
+ * \file bench/micro_benchmark.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_BENCH_MICRO_BENCHMARK_H_
+#define WATERSHED_BENCH_MICRO_BENCHMARK_H_
+
+/* C++ libraries */
+#include <string>
+
+using namespace std;
+
+/**
+ * \class MicroBenchmark
+ * \brief An operation measured in isolation. Subclasses prepare the operation inputs when they are created, so Run
+ * repeats only the operation being measured.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class MicroBenchmark {
+
+	public:
+
+		/**
+		 * \brief Creates a new MicroBenchmark instance.
+		 * \param name The benchmark name, as component/operation/parameter.
+		 * \return Not applicable.
+		 */
+		MicroBenchmark ( string name ) {
+			name_ = name;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~MicroBenchmark ( void ) {
+		}
+
+		/**
+		 * \brief Retrieves the benchmark name.
+		 * \return The benchmark name.
+		 */
+		string GetName ( void ) {
+			return name_;
+		}
+
+		/**
+		 * \brief Repeats the operation.
+		 * \param iterations Number of repetitions.
+		 * \return Not applicable.
+		 */
+		virtual void Run ( long iterations ) = 0;
+
+	protected:
+
+	private:
+
+		/** \brief The benchmark name. */
+		string name_;
+};
+
+#endif /* WATERSHED_BENCH_MICRO_BENCHMARK_H_ */
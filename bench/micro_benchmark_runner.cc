@@ -0,0 +1,80 @@
+/**
+ * \file bench/micro_benchmark_runner.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "bench/micro_benchmark_runner.h"
+
+MicroBenchmarkRunner::MicroBenchmarkRunner ( double minimum_time, int repetitions, string filter ) {
+	minimum_time_ = ( minimum_time > 0 ) ? minimum_time : 0.1;
+	repetitions_ = ( repetitions > 0 ) ? repetitions : 1;
+	filter_ = filter;
+}
+
+MicroBenchmarkRunner::~MicroBenchmarkRunner ( void ) {
+	for ( uint i = 0; i < benchmarks_.size ( ); ++i ) {
+		delete ( benchmarks_[i] );
+	}
+	benchmarks_.clear ( );
+}
+
+void MicroBenchmarkRunner::Add ( MicroBenchmark* benchmark ) {
+	benchmarks_.push_back ( benchmark );
+}
+
+double MicroBenchmarkRunner::Measure ( MicroBenchmark* benchmark, long iterations ) {
+	struct timespec start, end;
+	clock_gettime ( CLOCK_MONOTONIC, &start );
+	benchmark->Run ( iterations );
+	clock_gettime ( CLOCK_MONOTONIC, &end );
+	return ( end.tv_sec - start.tv_sec ) * 1e9 + ( end.tv_nsec - start.tv_nsec );
+}
+
+void MicroBenchmarkRunner::Run ( void ) {
+	for ( uint b = 0; b < benchmarks_.size ( ); ++b ) {
+		if ( !filter_.empty ( ) && benchmarks_[b]->GetName ( ).find ( filter_ ) == string::npos ) {
+			continue;
+		}
+
+		/* Calibration, which also warms up the caches touched by the operation */
+		long iterations = 1;
+		double elapsed_time = Measure ( benchmarks_[b], iterations );
+		while ( elapsed_time < minimum_time_ * 1e9 && iterations < ( 1L << 40 ) ) {
+			iterations *= 2;
+			elapsed_time = Measure ( benchmarks_[b], iterations );
+		}
+
+		vector < double > samples;
+		for ( int r = 0; r < repetitions_; ++r ) {
+			samples.push_back ( Measure ( benchmarks_[b], iterations ) / iterations );
+		}
+		sort ( samples.begin ( ), samples.end ( ) );
+
+		Result result;
+		result.name_ = benchmarks_[b]->GetName ( );
+		result.iterations_ = iterations;
+		result.median_ = samples[samples.size ( ) / 2];
+		result.minimum_ = samples.front ( );
+		result.maximum_ = samples.back ( );
+		results_.push_back ( result );
+		fprintf ( stderr, "%-40s %12.1f ns/op\n", result.name_.c_str ( ), result.median_ );
+	}
+}
+
+void MicroBenchmarkRunner::Write ( FILE* output ) {
+	char host_name[256] = "";
+	char date[64] = "";
+	time_t now = time ( NULL );
+	gethostname ( host_name, sizeof ( host_name ) - 1 );
+	strftime ( date, sizeof ( date ), "%Y-%m-%dT%H:%M:%S", localtime ( &now ) );
+
+	/* Benchmark names are generated by the harness and never need escaping */
+	fprintf ( output, "{\n\t\"context\": {\"host\": \"%s\", \"date\": \"%s\", \"minimum_time\": %g, \"repetitions\": %d},\n\t\"benchmarks\": [", host_name, date, minimum_time_, repetitions_ );
+	for ( uint i = 0; i < results_.size ( ); ++i ) {
+		fprintf ( output, "%s\n\t\t{\"name\": \"%s\", \"iterations\": %ld, \"ns_per_op\": %.2f, \"min_ns_per_op\": %.2f, \"max_ns_per_op\": %.2f}", ( i == 0 ) ? "" : ",", results_[i].name_.c_str ( ), results_[i].iterations_, results_[i].median_, results_[i].minimum_, results_[i].maximum_ );
+	}
+	fprintf ( output, "\n\t]\n}\n" );
+	fflush ( output );
+}
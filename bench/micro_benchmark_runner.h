@@ -0,0 +1,124 @@
+/**
+ * \file bench/micro_benchmark_runner.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_BENCH_MICRO_BENCHMARK_RUNNER_H_
+#define WATERSHED_BENCH_MICRO_BENCHMARK_RUNNER_H_
+
+/* C libraries */
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+/* C++ libraries */
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/* Project's .h */
+#include "bench/micro_benchmark.h"
+
+using namespace std;
+
+/**
+ * \class MicroBenchmarkRunner
+ * \brief Measures micro benchmarks and writes their results as JSON. The number of iterations of a benchmark is
+ * doubled until a run lasts the minimum time, then the benchmark is run a number of times with that many iterations
+ * and the median, fastest and slowest nanoseconds per operation are reported.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class MicroBenchmarkRunner {
+
+	public:
+
+		/**
+		 * \brief Creates a new MicroBenchmarkRunner instance.
+		 * \param minimum_time Minimum duration of a run, in seconds.
+		 * \param repetitions Number of measured runs by benchmark.
+		 * \param filter Only the benchmarks whose names contain it are run, all of them if it is empty.
+		 * \return Not applicable.
+		 */
+		MicroBenchmarkRunner ( double minimum_time, int repetitions, string filter );
+
+		/**
+		 * \brief Destructor. Deletes the benchmarks.
+		 * \return Not applicable.
+		 */
+		virtual ~MicroBenchmarkRunner ( void );
+
+		/**
+		 * \brief Adds a benchmark, which is deleted by the runner.
+		 * \param benchmark The benchmark.
+		 * \return Not applicable.
+		 */
+		void Add ( MicroBenchmark* benchmark );
+
+		/**
+		 * \brief Runs the benchmarks in the order they were added.
+		 * \return Not applicable.
+		 */
+		void Run ( void );
+
+		/**
+		 * \brief Writes the results as a JSON document with the run context and one object by benchmark.
+		 * \param output The output file.
+		 * \return Not applicable.
+		 */
+		void Write ( FILE* output );
+
+	protected:
+
+	private:
+
+		/**
+		 * \brief Result of a benchmark.
+		 */
+		struct Result {
+				/** \brief The benchmark name. */
+				string name_;
+				/** \brief Number of iterations of each run. */
+				long iterations_;
+				/** \brief Median time by operation, in nanoseconds. */
+				double median_;
+				/** \brief Fastest time by operation, in nanoseconds. */
+				double minimum_;
+				/** \brief Slowest time by operation, in nanoseconds. */
+				double maximum_;
+		};
+
+		/**
+		 * \brief Runs a benchmark once.
+		 * \param benchmark The benchmark.
+		 * \param iterations Number of iterations.
+		 * \return The run duration in nanoseconds.
+		 */
+		static double Measure ( MicroBenchmark* benchmark, long iterations );
+
+		/** \brief Minimum duration of a run, in seconds. */
+		double minimum_time_;
+
+		/** \brief Number of measured runs by benchmark. */
+		int repetitions_;
+
+		/** \brief Filter of the benchmark names. */
+		string filter_;
+
+		/** \brief The benchmarks. */
+		vector < MicroBenchmark* > benchmarks_;
+
+		/** \brief The results of the benchmarks already run. */
+		vector < Result > results_;
+
+		/** \brief Copy is not allowed. */
+		MicroBenchmarkRunner ( const MicroBenchmarkRunner& );
+
+		/** \brief Assignment is not allowed. */
+		MicroBenchmarkRunner& operator= ( const MicroBenchmarkRunner& );
+};
+
+#endif /* WATERSHED_BENCH_MICRO_BENCHMARK_RUNNER_H_ */
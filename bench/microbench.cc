@@ -0,0 +1,477 @@
+/**
+ * \file bench/microbench.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ *
+ * Micro benchmarks of the hot paths shared by every module: messages, the communicator, the consumer policies,
+ * tokenization, input queries and the join and window operators. Runs alone, or with a second MPI process answering the communicator round trips:
+ *
+ *   mpirun -np 2 ws-microbench [-f filter] [-t seconds] [-r repetitions] [-o output.json]
+ */
+
+/* C libraries */
+#include <getopt.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project's .h */
+#include "bench/micro_benchmark_runner.h"
+#include "comm/mpi/mpi_communicator.h"
+#include "common/util.h"
+#include "common/xml_query.h"
+#include "library/data_consumer.h"
+#include "library/join_flow.h"
+#include "library/label_function.h"
+#include "library/operators/hash_join.h"
+#include "library/operators/window.h"
+
+/** \brief Message sizes of the message and communicator benchmarks. */
+static const int MESSAGE_SIZES[] = { 0, 64, 1024, Constants::MAX_DATA_SIZE };
+
+/** \brief Keeps the benchmark results alive, so the compiler cannot drop the measured operations. */
+static volatile long sink_;
+
+/**
+ * \class MessageSetDataBenchmark
+ * \brief Copies data into a message.
+ */
+class MessageSetDataBenchmark : public MicroBenchmark {
+
+	public:
+
+		MessageSetDataBenchmark ( int size ) :
+				MicroBenchmark ( "message/set_data/" + Util::IntegerToString ( size ) ) {
+			size_ = size;
+			memset ( data_, 'w', sizeof ( data_ ) );
+		}
+
+		void Run ( long iterations ) {
+			for ( long i = 0; i < iterations; ++i ) {
+				message_.SetData ( data_, size_ );
+			}
+			sink_ = message_.GetDataSize ( );
+		}
+
+	private:
+
+		int size_;
+		char data_[Constants::MAX_DATA_SIZE];
+		Message message_;
+};
+
+/**
+ * \class MessageGetSizeBenchmark
+ * \brief Computes the number of bytes of a message sent on the wire.
+ */
+class MessageGetSizeBenchmark : public MicroBenchmark {
+
+	public:
+
+		MessageGetSizeBenchmark ( void ) :
+				MicroBenchmark ( "message/get_size" ) {
+			message_.SetData ( ( void* ) "record", 7 );
+		}
+
+		void Run ( long iterations ) {
+			long size = 0;
+			for ( long i = 0; i < iterations; ++i ) {
+				size += message_.GetSize ( );
+			}
+			sink_ = size;
+		}
+
+	private:
+
+		Message message_;
+};
+
+/**
+ * \class RoundTripBenchmark
+ * \brief Sends a message to the second process and waits for it back, through Send, Probe and Receive.
+ */
+class RoundTripBenchmark : public MicroBenchmark {
+
+	public:
+
+		RoundTripBenchmark ( MpiCommunicator* communicator, int size ) :
+				MicroBenchmark ( "communicator/round_trip/" + Util::IntegerToString ( size ) ) {
+			communicator_ = communicator;
+			char data[Constants::MAX_DATA_SIZE];
+			memset ( data, 'w', size );
+			message_.SetData ( data, size );
+		}
+
+		void Run ( long iterations ) {
+			for ( long i = 0; i < iterations; ++i ) {
+				message_.SetOperationCode ( Constants::MESSAGE_OP_PROCESSING_MODULE_DATA );
+				communicator_->Send ( &message_, 1 );
+				while ( communicator_->Probe ( 1, Constants::MESSAGE_OP_PROCESSING_MODULE_DATA ) == -1 ) {
+				}
+				communicator_->Receive ( 1, &message_ );
+			}
+		}
+
+	private:
+
+		MpiCommunicator* communicator_;
+		Message message_;
+};
+
+/**
+ * \class KeyLabel
+ * \brief Label function spreading the records by their first bytes, as a typical labeled stream does.
+ */
+class KeyLabel : public LabelFunction {
+
+	public:
+
+		int GetLabel ( Message& message, int total_instances ) {
+			uint32_t key;
+			memcpy ( &key, message.GetData ( ), sizeof(key) );
+			return key % total_instances;
+		}
+};
+
+/**
+ * \class ConsumerPolicyBenchmark
+ * \brief Chooses the consumer instance of a record. Broadcast sends to every instance and chooses none.
+ */
+class ConsumerPolicyBenchmark : public MicroBenchmark {
+
+	public:
+
+		ConsumerPolicyBenchmark ( string policy ) :
+				MicroBenchmark ( "consumer/get_next_to_receive/" + policy ) {
+			consumer_ = new DataConsumer ( Constants::EMPTY_ATTRIBUTE, "consumer", Constants::POLICY_ROUND_ROBIN, Constants::EMPTY_ATTRIBUTE, Constants::PUSHDOWN_FILTER );
+			consumer_->SetCommunicator ( new MpiCommunicator ( 0, NULL, Constants::COMM_SCOPE_WORLD ) );
+			label_ = NULL;
+			if ( policy.compare ( Constants::POLICY_LABELED ) == 0 ) {
+				label_ = new KeyLabel ( );
+				consumer_->SetPolicy ( Constants::POLICY_LABELED );
+				consumer_->SetPolicyFunction ( label_ );
+			}
+			uint32_t key = 12345;
+			message_.SetData ( &key, sizeof(key) );
+		}
+
+		virtual ~ConsumerPolicyBenchmark ( void ) {
+			/* The label function was not loaded from a library, so the consumer must not close one */
+			consumer_->SetPolicy ( Constants::POLICY_ROUND_ROBIN );
+			delete ( consumer_ );
+			delete ( label_ );
+		}
+
+		void Run ( long iterations ) {
+			long destinations = 0;
+			for ( long i = 0; i < iterations; ++i ) {
+				destinations += consumer_->GetNextToReceive ( message_ );
+			}
+			sink_ = destinations;
+		}
+
+	private:
+
+		DataConsumer* consumer_;
+		KeyLabel* label_;
+		Message message_;
+};
+
+/**
+ * \class TokenizeStringBenchmark
+ * \brief Splits a line of tab separated fields, as the runtime messages are parsed.
+ */
+class TokenizeStringBenchmark : public MicroBenchmark {
+
+	public:
+
+		TokenizeStringBenchmark ( void ) :
+				MicroBenchmark ( "util/tokenize_string" ) {
+			line_ = "/var/tmp/watershed/module.xml\tport#1.2.3.4$tag#0$\t0\tport#5.6.7.8$tag#1$";
+		}
+
+		void Run ( long iterations ) {
+			long tokens = 0;
+			for ( long i = 0; i < iterations; ++i ) {
+				tokens += Util::TokenizeString ( "\t", line_ ).size ( );
+			}
+			sink_ = tokens;
+		}
+
+	private:
+
+		string line_;
+};
+
+/**
+ * \class ExecuteQueryBenchmark
+ * \brief Evaluates an input query over an XML record, through the streaming evaluator or the XQuery engine.
+ */
+class ExecuteQueryBenchmark : public MicroBenchmark {
+
+	public:
+
+		ExecuteQueryBenchmark ( string name, string query ) :
+				MicroBenchmark ( "xml_query/execute_query/" + name ) {
+			query_ = query;
+			record_ = "<order id=\"42\" status=\"open\"><customer>ana</customer><item sku=\"a1\" quantity=\"2\"/><item sku=\"b7\" quantity=\"1\"/></order>";
+		}
+
+		void Run ( long iterations ) {
+			long length = 0;
+			for ( long i = 0; i < iterations; ++i ) {
+				length += xml_query_.ExecuteQuery ( record_, query_ ).length ( );
+			}
+			sink_ = length;
+		}
+
+	private:
+
+		string query_;
+		string record_;
+		XMLQuery xml_query_;
+};
+
+/**
+ * \class KeyJoin
+ * \brief Join key function reading the key from the first bytes of the record, as KeyLabel does.
+ */
+class KeyJoin : public JoinKeyFunction {
+
+	public:
+
+		unsigned long GetKey ( Message& message ) {
+			uint32_t key;
+			memcpy ( &key, message.GetData ( ), sizeof(key) );
+			return key;
+		}
+};
+
+/**
+ * \class CountJoinOutput
+ * \brief Counts the join matches instead of building messages.
+ */
+class CountJoinOutput : public JoinOutput {
+
+	public:
+
+		CountJoinOutput ( void ) {
+			number_matches_ = 0;
+		}
+
+		void Emit ( JoinTuple& left, JoinTuple& right ) {
+			++number_matches_;
+		}
+
+		long number_matches_;
+};
+
+/**
+ * \class HashJoinBenchmark
+ * \brief Inserts records of both inputs in a symmetric hash join, alternating the sides, with one record per
+ * millisecond of event time so that the window keeps about a second of each input.
+ */
+class HashJoinBenchmark : public MicroBenchmark {
+
+	public:
+
+		HashJoinBenchmark ( void ) :
+				MicroBenchmark ( "operators/hash_join/insert" ) {
+			join_flow_.SetLeft ( "left" );
+			join_flow_.SetRight ( "right" );
+			join_flow_.SetWindow ( 1000 );
+			join_flow_.SetCapacity ( 2048 );
+			join_ = new SymmetricHashJoin ( &join_flow_, &key_function_, &output_ );
+			sides_[0] = join_->GetSide ( "left" );
+			sides_[1] = join_->GetSide ( "right" );
+			uint32_t key = 0;
+			message_.SetData ( &key, sizeof(key) );
+			event_time_ = 0;
+		}
+
+		virtual ~HashJoinBenchmark ( void ) {
+			delete ( join_ );
+		}
+
+		void Run ( long iterations ) {
+			for ( long i = 0; i < iterations; ++i ) {
+				uint32_t key = ( uint32_t ) ( i % 4096 );
+				memcpy ( message_.GetData ( ), &key, sizeof(key) );
+				message_.SetOriginTime ( ++event_time_ * 1000000 );
+				join_->Insert ( sides_[i & 1], message_ );
+			}
+			sink_ = output_.number_matches_;
+		}
+
+	private:
+
+		JoinFlow join_flow_;
+		KeyJoin key_function_;
+		CountJoinOutput output_;
+		SymmetricHashJoin* join_;
+		int sides_[2];
+		int64_t event_time_;
+		Message message_;
+};
+
+/**
+ * \class CountWindowOutput
+ * \brief Counts the window results instead of sending them.
+ */
+class CountWindowOutput : public WindowOutput < long > {
+
+	public:
+
+		CountWindowOutput ( void ) {
+			number_results_ = 0;
+		}
+
+		void Emit ( long start, long end, const long& value ) {
+			++number_results_;
+		}
+
+		long number_results_;
+};
+
+/**
+ * \class WindowBenchmark
+ * \brief Counts records in a window, with one record per millisecond of origin time and one session every 100
+ * records.
+ */
+template < typename Window >
+class WindowBenchmark : public MicroBenchmark {
+
+	public:
+
+		WindowBenchmark ( string name, Window* window ) :
+				MicroBenchmark ( "operators/window/" + name ) {
+			window_ = window;
+			origin_time_ = 0;
+		}
+
+		virtual ~WindowBenchmark ( void ) {
+			delete ( window_ );
+		}
+
+		void Run ( long iterations ) {
+			for ( long i = 0; i < iterations; ++i ) {
+				origin_time_ += ( i % 100 == 0 ) ? 10 : 1;
+				message_.SetOriginTime ( origin_time_ * 1000000 );
+				window_->Insert ( message_, 1 );
+			}
+			sink_ = window_->GetNumberDropped ( );
+		}
+
+	private:
+
+		Window* window_;
+		int64_t origin_time_;
+		Message message_;
+};
+
+/**
+ * \brief Answers the round trips of the first process until it terminates.
+ * \param communicator Communicator including both processes.
+ * \return Not applicable.
+ */
+static void Echo ( MpiCommunicator* communicator ) {
+	Message message;
+	while ( true ) {
+		message.SetOperationCode ( Constants::MESSAGE_OP_ANY );
+		communicator->Receive ( 0, &message );
+		if ( message.GetOperationCode ( ) == Constants::MESSAGE_OP_TERMINATION ) {
+			break;
+		}
+		communicator->Send ( &message, 0 );
+	}
+}
+
+int main ( int argc, char** argv ) {
+	double minimum_time = 0.2;
+	int repetitions = 5;
+	string filter = "";
+	string output_file_name = "";
+	int option;
+	while ( ( option = getopt ( argc, argv, "f:t:r:o:" ) ) > 0 ) {
+		switch ( option ) {
+			case 'f' : {
+				filter = optarg;
+				break;
+			}
+			case 't' : {
+				minimum_time = atof ( optarg );
+				break;
+			}
+			case 'r' : {
+				repetitions = atoi ( optarg );
+				break;
+			}
+			case 'o' : {
+				output_file_name = optarg;
+				break;
+			}
+			default : {
+				fprintf ( stderr, "Usage: %s [-f filter] [-t seconds] [-r repetitions] [-o output.json]\n", argv[0] );
+				return 1;
+			}
+		}
+	}
+
+	MpiCommunicator* communicator = new MpiCommunicator ( argc, argv, Constants::COMM_SCOPE_WORLD );
+	if ( communicator->GetProcessRank ( ) > 0 ) {
+		if ( communicator->GetProcessRank ( ) == 1 ) {
+			Echo ( communicator );
+		}
+		delete ( communicator );
+		return 0;
+	}
+
+	MicroBenchmarkRunner* runner = new MicroBenchmarkRunner ( minimum_time, repetitions, filter );
+	int number_sizes = sizeof ( MESSAGE_SIZES ) / sizeof(int);
+	for ( int i = 0; i < number_sizes; ++i ) {
+		runner->Add ( new MessageSetDataBenchmark ( MESSAGE_SIZES[i] ) );
+	}
+	runner->Add ( new MessageGetSizeBenchmark ( ) );
+	if ( communicator->GetNumberProcesses ( ) > 1 ) {
+		for ( int i = 0; i < number_sizes; ++i ) {
+			runner->Add ( new RoundTripBenchmark ( communicator, MESSAGE_SIZES[i] ) );
+		}
+	}
+	else {
+		fprintf ( stderr, "communicator benchmarks skipped, they need a second process (mpirun -np 2)\n" );
+	}
+	runner->Add ( new ConsumerPolicyBenchmark ( Constants::POLICY_ROUND_ROBIN ) );
+	runner->Add ( new ConsumerPolicyBenchmark ( Constants::POLICY_LABELED ) );
+	runner->Add ( new TokenizeStringBenchmark ( ) );
+	runner->Add ( new ExecuteQueryBenchmark ( "streaming", "/order[@status='open']/item/@sku" ) );
+	runner->Add ( new ExecuteQueryBenchmark ( "xquery", "sum(/order/item/@quantity)" ) );
+	runner->Add ( new HashJoinBenchmark ( ) );
+	CountWindowOutput* window_output = new CountWindowOutput ( );
+	runner->Add ( new WindowBenchmark < TumblingWindow < CountAggregate < int > > > ( "tumbling", new TumblingWindow < CountAggregate < int > > ( 1000, 0, window_output ) ) );
+	runner->Add ( new WindowBenchmark < SlidingWindow < CountAggregate < int > > > ( "sliding", new SlidingWindow < CountAggregate < int > > ( 1000, 100, 0, window_output ) ) );
+	runner->Add ( new WindowBenchmark < SessionWindow < CountAggregate < int > > > ( "session", new SessionWindow < CountAggregate < int > > ( 5, 0, window_output ) ) );
+	runner->Run ( );
+
+	if ( output_file_name.empty ( ) ) {
+		runner->Write ( stdout );
+	}
+	else {
+		FILE* output = fopen ( output_file_name.c_str ( ), "w" );
+		if ( output == NULL ) {
+			fprintf ( stderr, "cannot write %s\n", output_file_name.c_str ( ) );
+		}
+		else {
+			runner->Write ( output );
+			fclose ( output );
+		}
+	}
+	delete ( runner );
+	delete ( window_output );
+
+	if ( communicator->GetNumberProcesses ( ) > 1 ) {
+		Message termination ( NULL, Constants::MESSAGE_OP_TERMINATION, 0 );
+		communicator->Send ( &termination, 1 );
+	}
+	delete ( communicator );
+	return 0;
+}
@@ -56,6 +56,13 @@ class Communicator {
 		 */
 		virtual Communicator* Connect ( string port ) = 0;
 
+		/**
+		 * \brief Merges the two groups linked by this communicator into a single group.
+		 * \param high Whether the processes of this side are ranked after the ones of the other side.
+		 * \return A new communicator including the processes of both groups.
+		 */
+		virtual Communicator* Merge ( bool high ) = 0;
+
 		/**
 		 * \brief Spawn processes at a group of hosts.
 		 * \param argv Command line arguments.
@@ -9,23 +9,38 @@
 
 Message::Message ( void ) {
 	data_size_ = 0;
+	origin_time_ = 0;
+	send_time_ = 0;
+	receive_time_ = 0;
 }
 
 Message::Message ( void* data, int size ) {
 	SetData ( data, size );
 	SetSequenceNumber ( 0 );
+	origin_time_ = 0;
+	send_time_ = 0;
+	receive_time_ = 0;
 }
 
 Message::Message ( void* data, int operation_code, int size ) {
 	SetOperationCode ( operation_code );
 	SetData ( data, size );
 	SetSequenceNumber ( 0 );
+	origin_time_ = 0;
+	send_time_ = 0;
+	receive_time_ = 0;
 }
 
 Message::~Message ( void ) {
 
 }
 
+int64_t Message::GetCurrentTime ( void ) {
+	struct timespec now;
+	clock_gettime ( CLOCK_REALTIME, &now );
+	return ( int64_t ) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
 void* Message::GetData ( void ) {
 	return &data_;
 }
@@ -38,6 +53,14 @@ int Message::GetOperationCode ( void ) {
 	return ntohl ( operation_code_ );
 }
 
+int64_t Message::GetOriginTime ( void ) {
+	return be64toh ( origin_time_ );
+}
+
+int64_t Message::GetReceiveTime ( void ) {
+	return be64toh ( receive_time_ );
+}
+
 int Message::GetSequenceNumber ( void ) {
 	return ntohl ( sequence_number_ );
 }
@@ -47,6 +70,10 @@ int Message::GetSize ( void ) {
 	return effective_size;
 }
 
+int64_t Message::GetSendTime ( void ) {
+	return be64toh ( send_time_ );
+}
+
 int Message::GetSource ( void ) {
 	return ntohl ( source_ );
 }
@@ -70,14 +97,30 @@ void Message::SetData ( void* data, int size ) {
 	}
 }
 
+void Message::SetDataSize ( int size ) {
+	data_size_ = htonl ( ( size >= 0 ) ? size : 0 );
+}
+
 void Message::SetOperationCode ( int operation_code ) {
 	operation_code_ = htonl ( operation_code );
 }
 
+void Message::SetOriginTime ( int64_t origin_time ) {
+	origin_time_ = htobe64 ( origin_time );
+}
+
+void Message::SetReceiveTime ( int64_t receive_time ) {
+	receive_time_ = htobe64 ( receive_time );
+}
+
 void Message::SetSequenceNumber ( int sequence_number ) {
 	sequence_number_ = htonl ( sequence_number );
 }
 
+void Message::SetSendTime ( int64_t send_time ) {
+	send_time_ = htobe64 ( send_time );
+}
+
 void Message::SetSource ( int source ) {
 	source_ = htonl ( source );
 }
@@ -7,7 +7,10 @@
 #ifndef WATERSHED_COMM_MESSAGE_H_
 #define WATERSHED_COMM_MESSAGE_H_
 
-/* Other libraries */
+/* C libraries */
+#include <endian.h>
+#include <stdint.h>
+#include <time.h>
 
 /* Project's .h */
 #include "comm/message_data.h"
@@ -55,6 +58,13 @@ class Message {
 		 */
 		~Message ( void );
 
+		/**
+		 * \brief Retrieves the wall clock time used by the message latency stamps, comparable across hosts as far as
+		 * their clocks are synchronized.
+		 * \return The time in nanoseconds.
+		 */
+		static int64_t GetCurrentTime ( void );
+
 		/**
 		 * \brief Retrieves the size of internal data.
 		 * \return Size of the data.
@@ -91,6 +101,25 @@ class Message {
 		 */
 		int GetTimestamp ( void );
 
+		/**
+		 * \brief Retrieves when the record was first sent by a source module. Unlike the timestamp, it is kept across
+		 * hops.
+		 * \return The origin time in nanoseconds, 0 if it is not set.
+		 */
+		int64_t GetOriginTime ( void );
+
+		/**
+		 * \brief Retrieves when the message was received on the last hop.
+		 * \return The receive time in nanoseconds.
+		 */
+		int64_t GetReceiveTime ( void );
+
+		/**
+		 * \brief Retrieves when the message was sent on the last hop.
+		 * \return The send time in nanoseconds.
+		 */
+		int64_t GetSendTime ( void );
+
 		string GetSourceStream(void);
 
 		/**
@@ -107,6 +136,13 @@ class Message {
 		 */
 		void SetData ( void* data, int size );
 
+		/**
+		 * \brief Sets the message data size when the data was written directly through GetData.
+		 * \param size Data size.
+		 * \return Not applicable.
+		 */
+		void SetDataSize ( int size );
+
 		/**
 		 * \brief Assign an operation code to a message.
 		 * \param operation_code Message operation code.
@@ -114,6 +150,20 @@ class Message {
 		 */
 		void SetOperationCode ( int operation_code );
 
+		/**
+		 * \brief Sets when the record was first sent. The communicator sets it on the first send if it is not set.
+		 * \param origin_time The origin time in nanoseconds, 0 to unset it.
+		 * \return Not applicable.
+		 */
+		void SetOriginTime ( int64_t origin_time );
+
+		/**
+		 * \brief Sets when the message was received on the last hop.
+		 * \param receive_time The receive time in nanoseconds.
+		 * \return Not applicable.
+		 */
+		void SetReceiveTime ( int64_t receive_time );
+
 		/**
 		 * \brief Sets the message sequence number.
 		 * \param sequence_number The message sequence number.
@@ -121,6 +171,13 @@ class Message {
 		 */
 		void SetSequenceNumber ( int sequence_number );
 
+		/**
+		 * \brief Sets when the message was sent on the last hop.
+		 * \param send_time The send time in nanoseconds.
+		 * \return Not applicable.
+		 */
+		void SetSendTime ( int64_t send_time );
+
 		/**
 		 * \brief Assign a source to a message.
 		 * \param source Message source.
@@ -159,6 +216,15 @@ class Message {
 		/** \brief The message creation timestamp. */
 		int timestamp_;
 
+		/** \brief When the record was first sent, in nanoseconds. */
+		int64_t origin_time_;
+
+		/** \brief When the message was sent on the last hop, in nanoseconds. */
+		int64_t send_time_;
+
+		/** \brief When the message was received on the last hop, in nanoseconds. */
+		int64_t receive_time_;
+
 		/** The name of the source stream. */
 		char source_stream_[Constants::MAX_LINE_SIZE];
 
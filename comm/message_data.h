@@ -92,6 +92,242 @@ class IdentificationMessage {
 		int process_identification_;
 };
 
+/**
+ * \class AddInstanceMessage
+ * \brief Message to add instances to a running processing module.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class AddInstanceMessage {
+
+	public:
+
+		/**
+		 * \brief Message constructor. Creates a new instance.
+		 * \param number_instances The number of instances to be added.
+		 * \param module_name The processing module name.
+		 * \return Not applicable.
+		 */
+		AddInstanceMessage ( int number_instances, string module_name ) {
+			SetNumberInstances ( number_instances );
+			SetModuleName ( module_name );
+			SetHostName ( "" );
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~AddInstanceMessage ( void ) {
+
+		}
+
+		/**
+		 * \brief Retrieves the number of instances to be added.
+		 * \return The number of instances.
+		 */
+		int GetNumberInstances ( void ) {
+			return ntohl ( number_instances_ );
+		}
+
+		/**
+		 * \brief Retrieves the processing module name.
+		 * \return The processing module name.
+		 */
+		string GetModuleName ( void ) {
+			return module_name_;
+		}
+
+		/**
+		 * \brief Retrieves the host which receives the new instances.
+		 * \return The host name, empty when the scheduler chooses the hosts.
+		 */
+		string GetHostName ( void ) {
+			return host_name_;
+		}
+
+		/**
+		 * \brief Sets the host which receives the new instances.
+		 * \param host_name The host name, empty when the scheduler chooses the hosts.
+		 * \return Not applicable.
+		 */
+		void SetHostName ( string host_name ) {
+			strcpy ( host_name_, host_name.c_str ( ) );
+		}
+
+		/**
+		 * \brief Sets the number of instances to be added.
+		 * \param number_instances The number of instances.
+		 * \return Not applicable.
+		 */
+		void SetNumberInstances ( int number_instances ) {
+			number_instances_ = htonl ( number_instances );
+		}
+
+		/**
+		 * \brief Set the processing module name.
+		 * \param module_name The module name.
+		 * \return Not applicable.
+		 */
+		void SetModuleName ( string module_name ) {
+			strcpy ( module_name_, module_name.c_str ( ) );
+		}
+
+	protected:
+
+	private:
+
+		/** \brief The processing module name. */
+		char module_name_[Constants::MAX_LINE_SIZE];
+
+		/** \brief The host which receives the new instances. */
+		char host_name_[Constants::MAX_LINE_SIZE];
+
+		/** \brief The number of instances to be added. */
+		int number_instances_;
+};
+
+/**
+ * \class InstanceStatisticsMessage
+ * \brief Message with the statistics of a processing module instance over the last report interval, used by the
+ * autoscaler.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class InstanceStatisticsMessage {
+
+	public:
+
+		/**
+		 * \brief Message constructor. Creates a new instance.
+		 * \param host_name The host running the instance.
+		 * \param interval Length of the report interval, in milliseconds.
+		 * \param number_records Number of records processed, or generated by a source, during the interval.
+		 * \param cpu_time CPU time used during the interval, in milliseconds.
+		 * \param starvation_time Time spent waiting for consumer credits during the interval, in milliseconds.
+		 * \param resident_size Resident set size of the instance process at the end of the interval, in kilobytes.
+		 * \param voluntary_switches Context switches caused by blocking during the interval.
+		 * \param involuntary_switches Context switches caused by preemption during the interval.
+		 * \return Not applicable.
+		 */
+		InstanceStatisticsMessage ( string host_name, int interval, int number_records, int cpu_time, int starvation_time, int resident_size, int voluntary_switches, int involuntary_switches ) {
+			strcpy ( host_name_, host_name.c_str ( ) );
+			interval_ = htonl ( interval );
+			number_records_ = htonl ( number_records );
+			cpu_time_ = htonl ( cpu_time );
+			starvation_time_ = htonl ( starvation_time );
+			resident_size_ = htonl ( resident_size );
+			voluntary_switches_ = htonl ( voluntary_switches );
+			involuntary_switches_ = htonl ( involuntary_switches );
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~InstanceStatisticsMessage ( void ) {
+
+		}
+
+		/**
+		 * \brief Retrieves the CPU time used during the interval.
+		 * \return The CPU time in milliseconds.
+		 */
+		int GetCPUTime ( void ) {
+			return ntohl ( cpu_time_ );
+		}
+
+		/**
+		 * \brief Retrieves the length of the report interval.
+		 * \return The interval in milliseconds.
+		 */
+		int GetInterval ( void ) {
+			return ntohl ( interval_ );
+		}
+
+		/**
+		 * \brief Retrieves the number of context switches caused by preemption during the interval. Many of them mean
+		 * the instance competes for the CPU of its host.
+		 * \return The number of context switches.
+		 */
+		int GetInvoluntarySwitches ( void ) {
+			return ntohl ( involuntary_switches_ );
+		}
+
+		/**
+		 * \brief Retrieves the number of records processed, or generated by a source, during the interval.
+		 * \return The number of records.
+		 */
+		int GetNumberRecords ( void ) {
+			return ntohl ( number_records_ );
+		}
+
+		/**
+		 * \brief Retrieves the resident set size of the instance process at the end of the interval.
+		 * \return The size in kilobytes.
+		 */
+		int GetResidentSize ( void ) {
+			return ntohl ( resident_size_ );
+		}
+
+		/**
+		 * \brief Retrieves the time spent waiting for consumer credits during the interval.
+		 * \return The starvation time in milliseconds.
+		 */
+		int GetStarvationTime ( void ) {
+			return ntohl ( starvation_time_ );
+		}
+
+		/**
+		 * \brief Retrieves the number of context switches caused by blocking during the interval. Many of them mean
+		 * the instance mostly waits on communication.
+		 * \return The number of context switches.
+		 */
+		int GetVoluntarySwitches ( void ) {
+			return ntohl ( voluntary_switches_ );
+		}
+
+		/**
+		 * \brief Retrieves the host running the instance.
+		 * \return The host name.
+		 */
+		string GetHostName ( void ) {
+			return host_name_;
+		}
+
+	protected:
+
+	private:
+
+		/** \brief The host running the instance. */
+		char host_name_[Constants::MAX_LINE_SIZE];
+
+		/** \brief Length of the report interval, in milliseconds. */
+		int interval_;
+
+		/** \brief Number of records processed during the interval. */
+		int number_records_;
+
+		/** \brief CPU time used during the interval, in milliseconds. */
+		int cpu_time_;
+
+		/** \brief Time spent waiting for consumer credits during the interval, in milliseconds. */
+		int starvation_time_;
+
+		/** \brief Resident set size of the instance process, in kilobytes. */
+		int resident_size_;
+
+		/** \brief Context switches caused by blocking during the interval. */
+		int voluntary_switches_;
+
+		/** \brief Context switches caused by preemption during the interval. */
+		int involuntary_switches_;
+};
+
 /**
  * \class RemoveInstanceMessage
  * \brief Message to remove a processing module instance.
@@ -111,6 +347,7 @@ class RemoveInstanceMessage {
 		RemoveInstanceMessage ( int instance_identification, string module_name ) {
 			SetInstanceIdentification ( instance_identification );
 			SetModuleName ( module_name );
+			SetSuccessorIdentification ( -1 );
 		}
 
 		/**
@@ -134,6 +371,14 @@ class RemoveInstanceMessage {
 			return module_name_;
 		}
 
+		/**
+		 * \brief Retrieves the instance receiving the state of a migrated instance.
+		 * \return The successor identification, -1 when the instance is just removed.
+		 */
+		int GetSuccessorIdentification ( void ) {
+			return ntohl ( successor_identification_ );
+		}
+
 		/** todo */
 		void SetInstanceIdentification ( int instance_identification ) {
 			instance_identification_ = htonl ( instance_identification );
@@ -148,6 +393,15 @@ class RemoveInstanceMessage {
 			strcpy ( module_name_, module_name.c_str ( ) );
 		}
 
+		/**
+		 * \brief Sets the instance receiving the state of a migrated instance.
+		 * \param successor_identification The successor identification, -1 when the instance is just removed.
+		 * \return Not applicable.
+		 */
+		void SetSuccessorIdentification ( int successor_identification ) {
+			successor_identification_ = htonl ( successor_identification );
+		}
+
 	protected:
 
 	private:
@@ -157,6 +411,9 @@ class RemoveInstanceMessage {
 
 		/** \brief The instance identification. */
 		int instance_identification_;
+
+		/** \brief The instance receiving the state of a migrated instance, -1 when there is none. */
+		int successor_identification_;
 };
 
 #endif
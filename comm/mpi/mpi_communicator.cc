@@ -24,7 +24,7 @@ MpiCommunicator::MpiCommunicator ( int argc, char** argv ) {
 	inter_communicator_ = parent;
 	inter_communicator_.Set_errhandler ( MPI::ERRORS_THROW_EXCEPTIONS );
 
-	++number_instances_;
+	__sync_add_and_fetch ( &number_instances_, 1 );
 }
 
 MpiCommunicator::MpiCommunicator ( int argc, char** argv, int scope ) {
@@ -55,7 +55,7 @@ MpiCommunicator::MpiCommunicator ( int argc, char** argv, int scope ) {
 		}
 	}
 	intra_communicator_.Set_errhandler ( MPI::ERRORS_THROW_EXCEPTIONS );
-	++number_instances_;
+	__sync_add_and_fetch ( &number_instances_, 1 );
 }
 
 MpiCommunicator::MpiCommunicator ( MPI::Intracomm intracomm, MPI::Intercomm intercomm ) {
@@ -79,16 +79,14 @@ MpiCommunicator::MpiCommunicator ( MPI::Intracomm intracomm, MPI::Intercomm inte
 	if ( inter_communicator_ != MPI::COMM_NULL ) {
 		inter_communicator_.Set_errhandler ( MPI::ERRORS_THROW_EXCEPTIONS );
 	}
-	++number_instances_;
+	__sync_add_and_fetch ( &number_instances_, 1 );
 }
 
 MpiCommunicator::~MpiCommunicator ( void ) {
 	pthread_mutex_destroy ( &class_mutex_ );
 
-	--number_instances_;
-
-	/* The last instance must finalize MPI */
-	if ( number_instances_ == 0 ) {
+	/* The last instance must finalize MPI. Instances are created and deleted by concurrent deployment jobs. */
+	if ( __sync_sub_and_fetch ( &number_instances_, 1 ) == 0 ) {
 		MPI::Finalize ( );
 	}
 }
@@ -163,6 +161,23 @@ void MpiCommunicator::Disconnect ( void ) {
 	inter_communicator_.Disconnect ( );
 }
 
+MpiCommunicator* MpiCommunicator::Duplicate ( void ) throw ( ProcessSpawnningException ) {
+	MPI::Intracomm duplicated_communicator;
+	try {
+		duplicated_communicator = intra_communicator_.Dup ( );
+	}
+	catch ( MPI::Exception e ) {
+		throw ProcessSpawnningException ( "it was not possible to duplicate the communicator." );
+	}
+	return new MpiCommunicator ( duplicated_communicator, MPI::COMM_NULL );
+}
+
+void MpiCommunicator::Free ( void ) {
+	if ( intra_communicator_ != MPI::COMM_NULL ) {
+		intra_communicator_.Free ( );
+	}
+}
+
 string MpiCommunicator::GetHostName ( void ) {
 	char name[100];
 	int result_lenght;
@@ -214,6 +229,17 @@ void MpiCommunicator::Lock ( void ) {
 	pthread_mutex_lock ( &class_mutex_ );
 }
 
+MpiCommunicator* MpiCommunicator::Merge ( bool high ) {
+	MPI::Intracomm merged_communicator;
+	try {
+		merged_communicator = inter_communicator_.Merge ( high );
+	}
+	catch ( MPI::Exception e ) {
+
+	}
+	return new MpiCommunicator ( merged_communicator, MPI::COMM_NULL );
+}
+
 string MpiCommunicator::OpenPort ( void ) {
 	char port[MPI_MAX_PORT_NAME];
 	try {
@@ -373,6 +399,7 @@ int MpiCommunicator::Receive ( int source, Message* data ) throw ( BadParameterE
 	catch ( MPI::Exception e ) {
 
 	}
+	data->SetReceiveTime ( Message::GetCurrentTime ( ) );
 	data->SetSource ( operation_status.Get_source ( ) );
 	return operation_status.Get_source ( );
 }
@@ -433,6 +460,10 @@ void MpiCommunicator::Send ( Message* data, int destination ) throw ( BadParamet
 
 	try {
 		data->SetTimestamp ( timestamp );
+		data->SetSendTime ( Message::GetCurrentTime ( ) );
+		if ( data->GetOriginTime ( ) == 0 ) {
+			data->SetOriginTime ( data->GetSendTime ( ) );
+		}
 		if ( intra_communicator_ != MPI::COMM_NULL ) {
 			intra_communicator_.Send ( data, data->GetSize ( ), MPI::BYTE, destination, data->GetOperationCode ( ) );
 		}
@@ -463,6 +494,10 @@ void MpiCommunicator::SSend ( Message* data, int destination ) throw ( BadParame
 
 	try {
 		data->SetTimestamp ( timestamp );
+		data->SetSendTime ( Message::GetCurrentTime ( ) );
+		if ( data->GetOriginTime ( ) == 0 ) {
+			data->SetOriginTime ( data->GetSendTime ( ) );
+		}
 		if ( intra_communicator_ != MPI::COMM_NULL ) {
 			intra_communicator_.Ssend ( data, data->GetSize ( ), MPI::BYTE, destination, data->GetOperationCode ( ) );
 		}
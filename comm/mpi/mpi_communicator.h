@@ -79,7 +79,7 @@ class MpiCommunicator : public Communicator {
 		int Probe ( int source, int tag ) throw ( BadParameterException );
 
 		/**
-		 * \brief Receive data from a source.
+		 * \brief Receive data from a source, stamping the receive time.
 		 * \param source Could be the id of specific process or COMM_ANY_SOURCE to receive from any process.
 		 * \param data Buffer where received data will be stored.
 		 * \return The source of the message.
@@ -100,6 +100,21 @@ class MpiCommunicator : public Communicator {
 		 */
 		MpiCommunicator* Connect ( string port );
 
+		/**
+		 * \brief Duplicates the intracommunicator, so collective operations, as spawns, can run on the copy while
+		 * other threads use the original. The copy must be released by Free.
+		 * \return A new instance of MpiCommunicator with the copy of the intracommunicator. Throws a
+		 * ProcessSpawnningException if the intracommunicator cannot be duplicated.
+		 */
+		MpiCommunicator* Duplicate ( void ) throw ( ProcessSpawnningException );
+
+		/**
+		 * \brief Merges the two groups linked by the intercommunicator into a single group.
+		 * \param high Whether the processes of this side are ranked after the ones of the other side.
+		 * \return A new instance of MpiCommunicator with an intracommunicator including the processes of both groups.
+		 */
+		MpiCommunicator* Merge ( bool high );
+
 		/**
 		 * \brief Spawn processes at a group of hosts.
 		 * \param argv Command line arguments.
@@ -151,6 +166,12 @@ class MpiCommunicator : public Communicator {
 		 */
 		void Disconnect ( void );
 
+		/**
+		 * \brief Releases the intracommunicator of a copy made by Duplicate.
+		 * \return Not applicable.
+		 */
+		void Free ( void );
+
 		/**
 		 * \brief Locks the class mutex, allowing parallel access.
 		 * \return Not applicable.
@@ -170,7 +191,8 @@ class MpiCommunicator : public Communicator {
 		void SBroadCast ( Message* data ) throw ( BadParameterException );
 
 		/**
-		 * \brief Send a message to a specified destination.
+		 * \brief Send a message to a specified destination, stamping the send time, and the origin time if it is not
+		 * set yet.
 		 * \param data Pointer to the data that will be sent.
 		 * \param destination Id of process that data will be sent.
 		 * \return Not applicable.
@@ -178,7 +200,7 @@ class MpiCommunicator : public Communicator {
 		void Send ( Message* data, int destination ) throw ( BadParameterException );
 
 		/**
-		 * \brief Send a message to a specified destination and waits to its receipt.
+		 * \brief Send a message to a specified destination and waits to its receipt, stamping it as Send does.
 		 * \param data Pointer to the data that will be sent.
 		 * \param destination Id of process that data will be sent.
 		 * \return Not applicable.
@@ -0,0 +1,155 @@
+/**
+ * \file common/async_logger.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Project's .h */
+#include "common/async_logger.h"
+
+AsyncLogger::AsyncLogger ( MpiCommunicator* communicator, string source_name ) {
+	communicator_ = communicator;
+	source_name_ = source_name;
+	for ( int i = 0; i < Constants::LOG_RING_CAPACITY; ++i ) {
+		slots_[i].sequence_ = i;
+	}
+	head_ = 0;
+	tail_ = 0;
+	full_drops_ = 0;
+	rate_drops_ = 0;
+	reported_drops_ = 0;
+	rate_window_ = 0;
+	rate_window_records_ = 0;
+	stop_ = false;
+	pthread_create ( &sender_thread_, NULL, &AsyncLogger::StartSenderThread, this );
+}
+
+AsyncLogger::~AsyncLogger ( void ) {
+	stop_ = true;
+	pthread_join ( sender_thread_, NULL );
+}
+
+MpiCommunicator* AsyncLogger::GetCommunicator ( void ) {
+	return communicator_;
+}
+
+long AsyncLogger::GetDroppedRecords ( void ) {
+	return full_drops_ + rate_drops_;
+}
+
+bool AsyncLogger::Log ( int level, string text ) {
+	long position = head_;
+	Slot* slot;
+
+	/* Claims the slot at the head, unless another thread claims it first */
+	while ( true ) {
+		slot = &slots_[position % Constants::LOG_RING_CAPACITY];
+		long difference = slot->sequence_ - position;
+		if ( difference == 0 ) {
+			if ( __sync_bool_compare_and_swap ( &head_, position, position + 1 ) ) {
+				break;
+			}
+			position = head_;
+		}
+		else if ( difference < 0 ) {
+			__sync_fetch_and_add ( &full_drops_, 1 );
+			return false;
+		}
+		else {
+			position = head_;
+		}
+	}
+
+	slot->level_ = level;
+	strncpy ( slot->text_, text.c_str ( ), Constants::LOG_RECORD_SIZE - 1 );
+	slot->text_[Constants::LOG_RECORD_SIZE - 1] = '\0';
+	__sync_synchronize ( );
+	slot->sequence_ = position + 1;
+	return true;
+}
+
+vector < pair < int, string > > AsyncLogger::ReadBatch ( Message& batch ) {
+	vector < pair < int, string > > records;
+	char* data = ( char* ) batch.GetData ( );
+	int size = batch.GetDataSize ( );
+	int offset = 0;
+	while ( offset < size ) {
+		int level = ( unsigned char ) data[offset++];
+		int length = strnlen ( data + offset, size - offset );
+		records.push_back ( make_pair ( level, string ( data + offset, length ) ) );
+		offset += length + 1;
+	}
+	return records;
+}
+
+void AsyncLogger::SendBatch ( string& batch ) {
+	if ( !batch.empty ( ) ) {
+		Message message ( ( void* ) batch.data ( ), Constants::MESSAGE_OP_LOG_BATCH, batch.length ( ) );
+		communicator_->Send ( &message, Constants::COMM_ROOT_PROCESS );
+		batch.clear ( );
+	}
+}
+
+void AsyncLogger::SendRecords ( void ) {
+	string batch;
+	time_t now = time ( NULL );
+	if ( now != rate_window_ ) {
+		rate_window_ = now;
+		rate_window_records_ = 0;
+	}
+
+	while ( true ) {
+		Slot* slot = &slots_[tail_ % Constants::LOG_RING_CAPACITY];
+		if ( slot->sequence_ != tail_ + 1 ) {
+			break;
+		}
+		__sync_synchronize ( );
+
+		if ( rate_window_records_ < Constants::LOG_RATE_LIMIT ) {
+			++rate_window_records_;
+			int length = strlen ( slot->text_ );
+			if ( batch.length ( ) + length + 2 > ( uint ) Constants::MAX_DATA_SIZE ) {
+				SendBatch ( batch );
+			}
+			batch += ( char ) slot->level_;
+			batch.append ( slot->text_, length + 1 );
+		}
+		else {
+			__sync_fetch_and_add ( &rate_drops_, 1 );
+		}
+
+		/* Frees the slot for the position one lap ahead */
+		__sync_synchronize ( );
+		slot->sequence_ = tail_ + Constants::LOG_RING_CAPACITY;
+		++tail_;
+	}
+
+	/* The drops are reported after the records that made it, as one record beyond the rate limit */
+	long dropped_records = GetDroppedRecords ( );
+	if ( dropped_records > reported_drops_ ) {
+		char text[Constants::MAX_LINE_SIZE];
+		snprintf ( text, sizeof ( text ), "%s dropped %ld log records (%ld in total over the rate limit, %ld with the log buffer full)", source_name_.c_str ( ), dropped_records - reported_drops_, ( long ) rate_drops_, ( long ) full_drops_ );
+		if ( batch.length ( ) + strlen ( text ) + 2 > ( uint ) Constants::MAX_DATA_SIZE ) {
+			SendBatch ( batch );
+		}
+		batch += ( char ) Constants::MESSAGE_OP_WARNING_LOG;
+		batch.append ( text, strlen ( text ) + 1 );
+		reported_drops_ = dropped_records;
+	}
+	SendBatch ( batch );
+}
+
+void* AsyncLogger::StartSenderThread ( void* obj ) {
+	AsyncLogger* logger = reinterpret_cast < AsyncLogger * > ( obj );
+	while ( !logger->stop_ ) {
+		usleep ( Constants::LOG_FLUSH_INTERVAL * 1000 );
+		logger->SendRecords ( );
+	}
+	logger->SendRecords ( );
+	pthread_exit ( NULL);
+}
@@ -0,0 +1,163 @@
+/**
+ * \file common/async_logger.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_COMMON_ASYNC_LOGGER_H_
+#define WATERSHED_COMMON_ASYNC_LOGGER_H_
+
+/* C libraries */
+#include <pthread.h>
+#include <time.h>
+
+/* C++ libraries */
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Project's .h */
+#include "comm/message.h"
+#include "comm/mpi/mpi_communicator.h"
+#include "common/constants.h"
+
+using namespace std;
+
+/**
+ * \class AsyncLogger
+ * \brief Sends the log records of a process to the root of a communicator in batches. Log only copies the record into
+ * a lock-free ring buffer, which any thread may write, and a background thread empties the buffer once every flush
+ * interval, packing the records into as few messages as possible. Records beyond the rate limit, or arriving while the
+ * buffer is full, are dropped and counted, and the number of records dropped is reported in the next batch.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class AsyncLogger {
+
+	public:
+
+		/**
+		 * \brief Creates a new AsyncLogger instance and starts its sender thread.
+		 * \param communicator Communicator whose root process receives the records.
+		 * \param source_name Name of the process in the messages about dropped records.
+		 * \return Not applicable.
+		 */
+		AsyncLogger ( MpiCommunicator* communicator, string source_name );
+
+		/**
+		 * \brief Destructor. Stops the sender thread after it sends the records still in the buffer.
+		 * \return Not applicable.
+		 */
+		virtual ~AsyncLogger ( void );
+
+		/**
+		 * \brief Retrieves the communicator whose root process receives the records.
+		 * \return The communicator.
+		 */
+		MpiCommunicator* GetCommunicator ( void );
+
+		/**
+		 * \brief Retrieves the number of records dropped so far, over the rate limit or with the buffer full.
+		 * \return The number of records.
+		 */
+		long GetDroppedRecords ( void );
+
+		/**
+		 * \brief Queues a record to be sent. Never blocks.
+		 * \param level Code of the record level, Constants::MESSAGE_OP_INFO_LOG, MESSAGE_OP_WARNING_LOG or
+		 * MESSAGE_OP_ERROR_LOG.
+		 * \param text The record text, truncated to Constants::LOG_RECORD_SIZE.
+		 * \return False if the buffer is full and the record was dropped, true otherwise.
+		 */
+		bool Log ( int level, string text );
+
+		/**
+		 * \brief Unpacks the records of a batch.
+		 * \param batch A message with the operation code Constants::MESSAGE_OP_LOG_BATCH.
+		 * \return The level code and the text of each record, in the order they were logged.
+		 */
+		static vector < pair < int, string > > ReadBatch ( Message& batch );
+
+	protected:
+
+	private:
+
+		/**
+		 * \brief A slot of the ring buffer. The sequence number tells whether the slot is free for the record at a
+		 * position, equal to the position, or holds it, equal to the position plus one.
+		 */
+		struct Slot {
+				/** \brief Sequence number of the slot. */
+				volatile long sequence_;
+				/** \brief Code of the record level. */
+				int level_;
+				/** \brief The null terminated record text. */
+				char text_[Constants::LOG_RECORD_SIZE];
+		};
+
+		/**
+		 * \brief Empties the buffer, sending its records to the root process.
+		 * \return Not applicable.
+		 */
+		void SendRecords ( void );
+
+		/**
+		 * \brief Sends a batch and empties it.
+		 * \param batch The packed records.
+		 * \return Not applicable.
+		 */
+		void SendBatch ( string& batch );
+
+		/**
+		 * \brief Executes the sender thread.
+		 * \param obj The logger.
+		 * \return A NULL pointer.
+		 */
+		static void* StartSenderThread ( void* obj );
+
+		/** \brief Communicator whose root process receives the records. */
+		MpiCommunicator* communicator_;
+
+		/** \brief Name of the process in the messages about dropped records. */
+		string source_name_;
+
+		/** \brief The ring buffer. */
+		Slot slots_[Constants::LOG_RING_CAPACITY];
+
+		/** \brief Position of the next record to be written, shared by the logging threads. */
+		volatile long head_;
+
+		/** \brief Position of the next record to be read, owned by the sender thread. */
+		long tail_;
+
+		/** \brief Records dropped with the buffer full. */
+		volatile long full_drops_;
+
+		/** \brief Records dropped over the rate limit. */
+		volatile long rate_drops_;
+
+		/** \brief Records dropped when the drops were last reported. */
+		long reported_drops_;
+
+		/** \brief Second of the current rate limit window. */
+		time_t rate_window_;
+
+		/** \brief Records sent in the current rate limit window. */
+		int rate_window_records_;
+
+		/** \brief Whether the sender thread must stop after emptying the buffer. */
+		volatile bool stop_;
+
+		/** \brief Sender thread. */
+		pthread_t sender_thread_;
+
+		/** \brief Copy is not allowed. */
+		AsyncLogger ( const AsyncLogger& );
+
+		/** \brief Assignment is not allowed. */
+		AsyncLogger& operator= ( const AsyncLogger& );
+};
+
+#endif /* WATERSHED_COMMON_ASYNC_LOGGER_H_ */
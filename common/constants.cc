@@ -7,19 +7,30 @@
 /* Project's .h */
 #include "common/constants.h"
 
+const string Constants::COMMAND_ADD_INSTANCE = "add-instance";
 const string Constants::COMMAND_ADD_PROCESSING_MODULE = "add-module";
 const string Constants::COMMAND_REMOVE_PROCESSING_MODULE = "remove-module";
 const string Constants::COMMAND_REMOVE_INSTANCE = "remove-instance";
 const string Constants::COMMAND_SHUTDOWN = "shutdown";
+const string Constants::COMMAND_STATS = "stats";
+const string Constants::COMMAND_JOBS = "jobs";
 const string Constants::DIR_BIN = "bin";
+const string Constants::DIR_SHARED_MEMORY = "/dev/shm";
 const string Constants::EMPTY_ATTRIBUTE = "none";
+const string Constants::FILE_CHECKPOINT_EXTENSION = ".ckpt";
 const string Constants::FILE_INFO = "watershed.info";
+const string Constants::FILE_METRICS_PREFIX = "watershed-metrics.";
 const string Constants::FILE_LOCK = "watershed.lock";
 const string Constants::FILE_LOG = "watershed.log";
 const string Constants::SYSTEM_NAME = "watershed";
 const string Constants::POLICY_BROADCAST = "broadcast";
 const string Constants::POLICY_ROUND_ROBIN = "round_robin";
 const string Constants::POLICY_LABELED = "labeled";
+const string Constants::ENCODING_XML = "xml";
+const string Constants::ENCODING_BINARY = "binary";
+const string Constants::PUSHDOWN_NONE = "none";
+const string Constants::PUSHDOWN_FILTER = "filter";
+const string Constants::PUSHDOWN_PROJECT = "project";
 const string Constants::PROCESSING_MODULE_CONSUMER = "consumer";
 const string Constants::PROCESSING_MODULE_PRODUCER = "producer";
 const string Constants::CONTAINER_NAME = "watershed.dbxml";
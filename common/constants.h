@@ -42,12 +42,24 @@ class Constants {
 		/** \brief Constant of sleeping to consume less CPU time. */
 		static const int SLEEP_TIME = 20;
 
+		/** \brief Maximum time a rate-controlled source sleeps waiting for a token, in microseconds. */
+		static const int SOURCE_MAX_SLEEP_TIME = 1000;
+
 		/** \brief Maximum size of an integer transformed in a string. */
 		static const int MAX_INT_TO_STRING_LENGTH = 5;
 
 		/** \brief Maximum deadlock retries.  */
 		static const int MAX_DEADLOCK_RETRIES = 5;
 
+		/** \brief Number of executions a cached query dynamic context is reused before being recreated. */
+		static const int XML_QUERY_CONTEXT_REUSE_LIMIT = 1024;
+
+		/** \brief Maximum number of compiled queries cached by an XMLQuery. The least recently used one is evicted. */
+		static const int XML_QUERY_CACHE_CAPACITY = 64;
+
+		/** \brief Size a checkpoint log must reach before being compacted into a single full checkpoint (1 MB). */
+		static const long CHECKPOINT_COMPACTION_MIN_SIZE = 1024 * 1024;
+
 		/** \brief Berkeley DB cache size (25 MB).  */
 		static const u_int32_t ENV_CACHE_SIZE = 25 * 1024 * 1024;
 
@@ -155,6 +167,40 @@ class Constants {
 		/** todo */
 		static const int MESSAGE_OP_ACCEPT_CONNECT = 32;
 
+		/** \brief Code of a checkpoint barrier, injected by the runtime in the sources and forwarded through the flows. */
+		static const int MESSAGE_OP_CHECKPOINT_BARRIER = 33;
+
+		/** \brief Code of a message asking for new instances of a running processing module. */
+		static const int MESSAGE_OP_ADD_INSTANCE = 34;
+
+		/** \brief Code of the acknowledgment of new instances, also sent by a module when its instances have joined. */
+		static const int MESSAGE_OP_ADD_INSTANCE_ACK = 35;
+
+		/** \brief Code of the statistics periodically sent by the instances of an autoscaled processing module. */
+		static const int MESSAGE_OP_INSTANCE_STATISTICS = 36;
+
+		/** \brief Code of a chunk of the state sent by a migrated instance to the instance replacing it, the last
+		 * chunk being empty. */
+		static const int MESSAGE_OP_MIGRATION_STATE = 37;
+
+		/** \brief Code of a query for the metrics of the processing module instances. */
+		static const int MESSAGE_OP_QUERY_METRICS = 38;
+
+		/** \brief Code of the metrics of the processing module instances running on a host. */
+		static const int MESSAGE_OP_QUERY_METRICS_ACK = 39;
+
+		/** \brief Code of a batch of log records, each one its level code followed by its null terminated text. */
+		static const int MESSAGE_OP_LOG_BATCH = 40;
+
+		/** \brief Code of a query for the state of the processing module deployments. */
+		static const int MESSAGE_OP_QUERY_DEPLOYMENTS = 41;
+
+		/** \brief Code of the state of the processing module deployments, one line by deployment job. */
+		static const int MESSAGE_OP_QUERY_DEPLOYMENTS_ACK = 42;
+
+		/** \brief Code of a versioned change of an entry of the module directory replicated by the runtime daemons. */
+		static const int MESSAGE_OP_MODULE_DIRECTORY_UPDATE = 43;
+
 		/* ---- XML  ------------------------------------------------------------------------------------------------- */
 		static const int START = 0;
 		static const int CREATE_TAG = 1;
@@ -162,6 +208,9 @@ class Constants {
 		static const int CREATE_ATTR = 3;
 		static const int CREATE_CHAR_DATA = 4;
 
+		/** \brief Initial buffer size of an XML writer that does not write into a message. */
+		static const int XML_WRITER_DEFAULT_CAPACITY = 4096;
+
 		/* ----- Console/runtime commands ---------------------------------------------------------------------------- */
 
 		/** \brief Command add-module. */
@@ -170,12 +219,21 @@ class Constants {
 		/** \brief Command remove-module. */
 		static const string COMMAND_REMOVE_PROCESSING_MODULE;
 
+		/** \brief Command to add instances to a running processing module. */
+		static const string COMMAND_ADD_INSTANCE;
+
 		/** \brief Command to remove a processing module instance. */
 		static const string COMMAND_REMOVE_INSTANCE;
 
 		/** \brief Command system shutdown. */
 		static const string COMMAND_SHUTDOWN;
 
+		/** \brief Command to show the metrics of the processing module instances. */
+		static const string COMMAND_STATS;
+
+		/** \brief Command to show the state of the processing module deployment jobs. */
+		static const string COMMAND_JOBS;
+
 		/* ----- Special message identifications --------------------------------------------------------------------- */
 
 		/** \brief Code of an any source. */
@@ -203,11 +261,37 @@ class Constants {
 		/** \brief Runtime log file name. */
 		static const string FILE_LOG;
 
+		/** \brief Extension of the checkpoint log of a processing module instance. */
+		static const string FILE_CHECKPOINT_EXTENSION;
+
+		/** \brief Prefix of the shared memory segments holding the metrics of the processing module instances. */
+		static const string FILE_METRICS_PREFIX;
+
 		/* ---- Runtime directories ---------------------------------------------------------------------------------- */
 
 		/** \brief Runtime executable directory. */
 		static const string DIR_BIN;
 
+		/** \brief Directory where the shared memory segments are listed. */
+		static const string DIR_SHARED_MEMORY;
+
+		/* ---- Deployment jobs -------------------------------------------------------------------------------------- */
+
+		/** \brief State of a deployment job still spawning or initializing its instances. */
+		static const int DEPLOYMENT_RUNNING = 0;
+
+		/** \brief State of a deployment job whose processing module is running. */
+		static const int DEPLOYMENT_DONE = 1;
+
+		/** \brief State of a deployment job that failed. */
+		static const int DEPLOYMENT_FAILED = 2;
+
+		/** \brief Maximum number of deployment jobs spawning their instances at the same time. */
+		static const int DEPLOYMENT_MAX_SPAWNS = 8;
+
+		/** \brief Number of finished deployment jobs kept to be listed. Older ones are discarded. */
+		static const int DEPLOYMENT_HISTORY_SIZE = 32;
+
 		/* ---- Processing Module constants -------------------------------------------------------------------------- */
 
 		/** \brief Automatic number of instances' code. */
@@ -216,6 +300,21 @@ class Constants {
 		/** todo */
 		static const int PROCESSING_MODULE_INVALID_INSTANCE = -1;
 
+		/** \brief Default maximum number of messages delivered to a processing module in a single ProcessBatch call. */
+		static const int PROCESSING_MODULE_DEFAULT_BATCH_SIZE = 16;
+
+		/** \brief Default maximum number of messages held by the reorder buffer of an ordered input. */
+		static const int PROCESSING_MODULE_DEFAULT_REORDER_CAPACITY = 256;
+
+		/** \brief Default maximum time in milliseconds a message waits in the reorder buffer of an ordered input. */
+		static const long PROCESSING_MODULE_DEFAULT_REORDER_LATENCY = 100;
+
+		/** \brief Interval in milliseconds between two statistics reports of an autoscaled processing module instance. */
+		static const long PROCESSING_MODULE_STATISTICS_INTERVAL = 1000;
+
+		/** \brief Interval in milliseconds between two samples of the resources used by a processing module instance. */
+		static const long PROCESSING_MODULE_RESOURCES_INTERVAL = 1000;
+
 		/** \brief Consumer processing module identification. */
 		static const string PROCESSING_MODULE_CONSUMER;
 
@@ -240,6 +339,21 @@ class Constants {
 		/** \brief Labeled stream policy identification. */
 		static const string POLICY_LABELED;
 
+		/** \brief Encoding of output records as XML text. */
+		static const string ENCODING_XML;
+
+		/** \brief Encoding of output records in the binary layout given by the output structure. */
+		static const string ENCODING_BINARY;
+
+		/** \brief Pushdown mode in which the producer sends every record and the consumer input query is not applied. */
+		static const string PUSHDOWN_NONE;
+
+		/** \brief Pushdown mode in which the producer sends only the records matching the consumer input query. */
+		static const string PUSHDOWN_FILTER;
+
+		/** \brief Pushdown mode in which the producer sends only the result of the consumer input query. */
+		static const string PUSHDOWN_PROJECT;
+
 		/** \brief Credit shared by all producer instances */
 		static const int SHARED_CREDIT = 100;
 
@@ -258,6 +372,73 @@ class Constants {
 
 		static const int SCHED_OP_MIGRATION = 0;
 
+		/** \brief Operation adding instances to a processing module. */
+		static const int SCHED_OP_SCALE_OUT = 1;
+
+		/** \brief Operation removing an instance from a processing module. */
+		static const int SCHED_OP_SCALE_IN = 2;
+
+		/** \brief CPU utilization percentage above which a processing module is scaled out. */
+		static const int SCHED_SCALE_OUT_UTILIZATION = 80;
+
+		/** \brief CPU utilization percentage below which a processing module is scaled in. */
+		static const int SCHED_SCALE_IN_UTILIZATION = 30;
+
+		/** \brief CPU utilization percentage aimed at when choosing how many instances are added. */
+		static const int SCHED_TARGET_UTILIZATION = 60;
+
+		/** \brief Percentage of the time waiting for consumer credits above which a module is not scaled out, since
+		 * its consumers are the bottleneck. */
+		static const int SCHED_STARVATION_LIMIT = 20;
+
+		/** \brief Percentage of the average throughput below which a busy instance is migrated to another host. */
+		static const int SCHED_STRAGGLER_THROUGHPUT = 50;
+
+		/** \brief Context switches by second caused by preemption above which a straggler is considered to compete for
+		 * the CPU of its host, and so to gain from being migrated. */
+		static const int SCHED_STRAGGLER_PREEMPTIONS = 50;
+
+		/* ---- Metrics ---------------------------------------------------------------------------------------------- */
+
+		/** \brief Identification of a valid metrics segment. */
+		static const int METRICS_MAGIC = 0x57534d31;
+
+		/** \brief Maximum number of inputs and outputs whose metrics are kept by instance. */
+		static const int METRICS_MAX_STREAMS = 16;
+
+		/** \brief Maximum length of the module and stream names in a metrics segment. */
+		static const int METRICS_NAME_SIZE = 64;
+
+		/** \brief Number of power of two buckets of the processing time histogram, in microseconds. */
+		static const int METRICS_HISTOGRAM_BUCKETS = 32;
+
+		/** \brief Number of bits of each latency magnitude, the latency histograms error being below 2^-bits. */
+		static const int METRICS_LATENCY_PRECISION_BITS = 4;
+
+		/** \brief Number of log-linear buckets of the latency histograms, covering up to 2^45 nanoseconds. */
+		static const int METRICS_LATENCY_BUCKETS = 672;
+
+		/** \brief Direction of the metrics of an input. */
+		static const int METRICS_INPUT = 0;
+
+		/** \brief Direction of the metrics of an output. */
+		static const int METRICS_OUTPUT = 1;
+
+		/* ---- Logging ---------------------------------------------------------------------------------------------- */
+
+		/** \brief Number of records held by the ring buffer of an asynchronous logger. */
+		static const int LOG_RING_CAPACITY = 512;
+
+		/** \brief Maximum length of a log record queued by an asynchronous logger, longer ones being truncated. */
+		static const int LOG_RECORD_SIZE = 512;
+
+		/** \brief Interval in milliseconds between two batches sent by an asynchronous logger, and between two flushes
+		 * of the log file. */
+		static const long LOG_FLUSH_INTERVAL = 100;
+
+		/** \brief Maximum number of records by second sent by an asynchronous logger, the others being dropped. */
+		static const int LOG_RATE_LIMIT = 200;
+
 	protected:
 
 	private:
@@ -20,6 +20,9 @@ Logger::Logger ( string log_file_name, bool screen_as_output, string screen_sepa
 	screen_as_output_ = screen_as_output;
 	screen_separator_ = screen_separator;
 	log_file_.open ( log_file_name.c_str (), fstream::app );
+	formatted_second_ = 0;
+	formatted_time_[0] = '\0';
+	gettimeofday ( &last_flush_time_, NULL );
 }
 
 Logger::~Logger ( void ) {
@@ -30,6 +33,22 @@ Logger::~Logger ( void ) {
 	log_file_.close ();
 }
 
+void Logger::Flush ( void ) {
+	log_file_.flush ( );
+	gettimeofday ( &last_flush_time_, NULL );
+}
+
+const char* Logger::FormatTime ( void ) {
+	time_t rawtime = time ( NULL );
+	if ( rawtime != formatted_second_ ) {
+		struct tm timeinfo;
+		localtime_r ( &rawtime, &timeinfo );
+		strftime ( formatted_time_, sizeof ( formatted_time_ ), "[%F %T]", &timeinfo );
+		formatted_second_ = rawtime;
+	}
+	return formatted_time_;
+}
+
 void Logger::Lock ( void ) {
 	pthread_mutex_lock ( &class_mutex_ );
 }
@@ -37,22 +56,20 @@ void Logger::Lock ( void ) {
 void Logger::PrintError ( string message ) {
 	message = ERROR_TEXT + " " + message;
 	PrintFile ( message );
+	Flush ( );
 	if ( screen_as_output_ ) {
 		PrintScreen ( message );
 	}
 }
 
 void Logger::PrintFile ( string message ) {
-	time_t rawtime;
-	struct tm* timeinfo;
-	int time_size = 50;
-	char formatted_time[time_size];
+	log_file_ << FormatTime ( ) << " " << message << '\n';
 
-	time ( &rawtime );
-	timeinfo = localtime ( &rawtime );
-	strftime ( formatted_time, time_size, "[%F %T]", timeinfo );
-
-	log_file_ << formatted_time << " " << message << endl;
+	struct timeval now;
+	gettimeofday ( &now, NULL );
+	if ( ( now.tv_sec - last_flush_time_.tv_sec ) * 1000 + ( now.tv_usec - last_flush_time_.tv_usec ) / 1000 >= Constants::LOG_FLUSH_INTERVAL ) {
+		Flush ( );
+	}
 }
 
 void Logger::PrintInfo ( string message ) {
@@ -64,20 +81,12 @@ void Logger::PrintInfo ( string message ) {
 }
 
 void Logger::PrintScreen ( string message ) {
-	time_t rawtime;
-	struct tm* timeinfo;
-	int time_size = 50;
-	char formatted_time[time_size];
-
-	time ( &rawtime );
-	timeinfo = localtime ( &rawtime );
-	strftime ( formatted_time, time_size, "[%F %T]", timeinfo );
-
-	cout << formatted_time << " " << message << endl;
+	cout << FormatTime ( ) << " " << message << endl;
 }
 
 void Logger::PrintScreenSeparator ( void ) {
-	log_file_ << screen_separator_ << endl;
+	log_file_ << screen_separator_ << '\n';
+	Flush ( );
 	cout << screen_separator_ << endl;
 }
 
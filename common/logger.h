@@ -9,17 +9,23 @@
 
 /* C libraries */
 #include <string.h>
+#include <sys/time.h>
+#include <time.h>
 
 /* C++ libraries */
 #include <fstream>
 #include <iostream>
 #include <string>
 
+/* Project's .h */
+#include "common/constants.h"
+
 using namespace std;
 
 /**
  * \class Logger
- * \brief Implementation of a logger.
+ * \brief Implementation of a logger. The log file is written through its buffer and flushed once every flush
+ * interval, on errors and on Flush, so a burst of records costs a few writes.
  * \author Rodrigo Silva Oliveira
  * \author Thatyene Louise Alves de Souza Ramos
  * \version 1.0
@@ -44,6 +50,12 @@ class Logger {
 		 */
 		virtual ~Logger ( void );
 
+		/**
+		 * \brief Writes the buffered records to the log file.
+		 * \return Not applicable.
+		 */
+		void Flush ( void );
+
 		/**
 		 * \brief Locks the class mutex.
 		 * \return Not applicable.
@@ -87,6 +99,12 @@ class Logger {
 
 	private:
 
+		/**
+		 * \brief Formats the current time, formatting it again only when the second changes.
+		 * \return The formatted time.
+		 */
+		const char* FormatTime ( void );
+
 		/**
 		 * \brief Print a message in the log file.
 		 * \param message Message to be printed.
@@ -113,6 +131,15 @@ class Logger {
 		/**\brief System log file. */
 		ofstream log_file_;
 
+		/** \brief Second of the formatted time. */
+		time_t formatted_second_;
+
+		/** \brief The current time formatted. */
+		char formatted_time_[50];
+
+		/** \brief When the log file was last flushed. */
+		struct timeval last_flush_time_;
+
 		/** \brief Error message notification. */
 		static const string ERROR_TEXT;
 
@@ -0,0 +1,502 @@
+/**
+ * \file common/streaming_xpath.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project's .h */
+#include "common/streaming_xpath.h"
+
+StreamingXPath::StreamingXPath ( string query ) {
+	target_ = TARGET_ELEMENT;
+	compiled_ = Compile ( query );
+}
+
+StreamingXPath::~StreamingXPath ( void ) {
+	steps_.clear ( );
+}
+
+bool StreamingXPath::AppendDecoded ( const char* data, int length, bool attribute, string& result ) {
+	const char* end = data + length;
+	while ( data < end ) {
+		const char* special = data;
+		while ( special < end && *special != '&' && *special != '\r' && ( !attribute || ( *special != '\n' && *special != '\t' ) ) ) {
+			++special;
+		}
+		result.append ( data, special - data );
+		if ( special == end ) {
+			break;
+		}
+
+		/* Line ends are normalized and attribute blanks become spaces */
+		if ( *special != '&' ) {
+			if ( attribute ) {
+				result.push_back ( ' ' );
+			}
+			else if ( *special == '\r' ) {
+				result.push_back ( '\n' );
+			}
+			data = special + 1;
+			if ( *special == '\r' && data < end && *data == '\n' ) {
+				++data;
+			}
+			continue;
+		}
+
+		const char* semicolon = ( const char* ) memchr ( special, ';', end - special );
+		if ( semicolon == NULL ) {
+			return false;
+		}
+		int reference_length = semicolon - special - 1;
+		const char* reference = special + 1;
+		if ( reference_length == 2 && strncmp ( reference, "lt", 2 ) == 0 ) {
+			result.push_back ( '<' );
+		}
+		else if ( reference_length == 2 && strncmp ( reference, "gt", 2 ) == 0 ) {
+			result.push_back ( '>' );
+		}
+		else if ( reference_length == 3 && strncmp ( reference, "amp", 3 ) == 0 ) {
+			result.push_back ( '&' );
+		}
+		else if ( reference_length == 4 && strncmp ( reference, "quot", 4 ) == 0 ) {
+			result.push_back ( '"' );
+		}
+		else if ( reference_length == 4 && strncmp ( reference, "apos", 4 ) == 0 ) {
+			result.push_back ( '\'' );
+		}
+		else if ( reference_length > 1 && reference[0] == '#' ) {
+			char* number_end;
+			unsigned long code;
+			if ( reference[1] == 'x' ) {
+				code = strtoul ( reference + 2, &number_end, 16 );
+			}
+			else {
+				code = strtoul ( reference + 1, &number_end, 10 );
+			}
+			if ( number_end != semicolon || code == 0 || code > 0x10FFFF ) {
+				return false;
+			}
+
+			/* UTF-8 encoding of the character */
+			if ( code < 0x80 ) {
+				result.push_back ( ( char ) code );
+			}
+			else if ( code < 0x800 ) {
+				result.push_back ( ( char ) ( 0xC0 | ( code >> 6 ) ) );
+				result.push_back ( ( char ) ( 0x80 | ( code & 0x3F ) ) );
+			}
+			else if ( code < 0x10000 ) {
+				result.push_back ( ( char ) ( 0xE0 | ( code >> 12 ) ) );
+				result.push_back ( ( char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+				result.push_back ( ( char ) ( 0x80 | ( code & 0x3F ) ) );
+			}
+			else {
+				result.push_back ( ( char ) ( 0xF0 | ( code >> 18 ) ) );
+				result.push_back ( ( char ) ( 0x80 | ( ( code >> 12 ) & 0x3F ) ) );
+				result.push_back ( ( char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+				result.push_back ( ( char ) ( 0x80 | ( code & 0x3F ) ) );
+			}
+		}
+		else {
+			return false;
+		}
+		data = semicolon + 1;
+	}
+	return true;
+}
+
+bool StreamingXPath::Compile ( string query ) {
+	string::size_type begin = query.find_first_not_of ( " \t\r\n" );
+	if ( begin == string::npos ) {
+		return false;
+	}
+	query = query.substr ( begin, query.find_last_not_of ( " \t\r\n" ) - begin + 1 );
+	if ( query.compare ( 0, 2, "//" ) == 0 ) {
+		return false;
+	}
+	if ( query[0] == '/' ) {
+		query.erase ( 0, 1 );
+	}
+
+	/* Splits the steps, keeping the predicates' literals */
+	vector < string > steps;
+	string step;
+	char quote = 0;
+	for ( unsigned int i = 0; i < query.length ( ); ++i ) {
+		if ( quote != 0 ) {
+			if ( query[i] == quote ) {
+				quote = 0;
+			}
+		}
+		else if ( query[i] == '\'' || query[i] == '"' ) {
+			quote = query[i];
+		}
+		else if ( query[i] == '/' ) {
+			steps.push_back ( step );
+			step.clear ( );
+			continue;
+		}
+		step.push_back ( query[i] );
+	}
+	steps.push_back ( step );
+
+	if ( steps.back ( ) == "text()" ) {
+		target_ = TARGET_TEXT;
+		steps.pop_back ( );
+	}
+	else if ( !steps.back ( ).empty ( ) && steps.back ( )[0] == '@' ) {
+		target_ = TARGET_ATTRIBUTE;
+		attribute_ = steps.back ( ).substr ( 1 );
+		steps.pop_back ( );
+		if ( !IsName ( attribute_ ) ) {
+			return false;
+		}
+	}
+
+	if ( steps.empty ( ) ) {
+		return false;
+	}
+	for ( unsigned int i = 0; i < steps.size ( ); ++i ) {
+		if ( !CompileStep ( steps[i] ) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool StreamingXPath::CompileStep ( string step ) {
+	Step compiled;
+	string::size_type predicates = step.find ( '[' );
+	compiled.name_ = step.substr ( 0, predicates );
+	if ( compiled.name_ != "*" && !IsName ( compiled.name_ ) ) {
+		return false;
+	}
+
+	while ( predicates != string::npos && predicates < step.length ( ) ) {
+		if ( step[predicates] != '[' ) {
+			return false;
+		}
+		string::size_type close = predicates + 1;
+		char quote = 0;
+		while ( close < step.length ( ) && ( quote != 0 || step[close] != ']' ) ) {
+			if ( quote != 0 && step[close] == quote ) {
+				quote = 0;
+			}
+			else if ( quote == 0 && ( step[close] == '\'' || step[close] == '"' ) ) {
+				quote = step[close];
+			}
+			++close;
+		}
+		if ( close == step.length ( ) ) {
+			return false;
+		}
+
+		/* [@a], [@a='v'] or [@a!='v'] */
+		string predicate = step.substr ( predicates + 1, close - predicates - 1 );
+		predicates = close + 1;
+		string::size_type begin = predicate.find_first_not_of ( " " );
+		if ( begin == string::npos || predicate[begin] != '@' ) {
+			return false;
+		}
+		string::size_type name_end = predicate.find_first_of ( " !=", begin );
+		Predicate compiled_predicate;
+		compiled_predicate.attribute_ = predicate.substr ( begin + 1, ( name_end == string::npos ) ? string::npos : name_end - begin - 1 );
+		if ( !IsName ( compiled_predicate.attribute_ ) ) {
+			return false;
+		}
+		string::size_type operator_begin = ( name_end == string::npos ) ? string::npos : predicate.find_first_not_of ( " ", name_end );
+		if ( operator_begin == string::npos ) {
+			compiled_predicate.operator_ = OPERATOR_EXISTS;
+		}
+		else {
+			string::size_type literal_begin;
+			if ( predicate.compare ( operator_begin, 2, "!=" ) == 0 ) {
+				compiled_predicate.operator_ = OPERATOR_NOT_EQUAL;
+				literal_begin = operator_begin + 2;
+			}
+			else if ( predicate[operator_begin] == '=' ) {
+				compiled_predicate.operator_ = OPERATOR_EQUAL;
+				literal_begin = operator_begin + 1;
+			}
+			else {
+				return false;
+			}
+			string literal = predicate.substr ( literal_begin );
+			string::size_type first = literal.find_first_not_of ( " " );
+			string::size_type last = literal.find_last_not_of ( " " );
+			if ( first == string::npos || last == first || ( literal[first] != '\'' && literal[first] != '"' ) || literal[last] != literal[first] ) {
+				return false;
+			}
+			compiled_predicate.value_ = literal.substr ( first + 1, last - first - 1 );
+		}
+		compiled.predicates_.push_back ( compiled_predicate );
+	}
+
+	steps_.push_back ( compiled );
+	return true;
+}
+
+bool StreamingXPath::Evaluate ( const char* document, int length, string& result ) {
+	result.clear ( );
+	if ( !compiled_ ) {
+		return false;
+	}
+
+	const char* position = document;
+	const char* end = document + length;
+	int number_steps = steps_.size ( );
+	int depth = 0;
+	int matched = 0;
+	bool root_closed = false;
+	bool capturing = false;
+	bool text_node = false;
+
+	while ( position < end ) {
+		/* Character data */
+		if ( *position != '<' ) {
+			const char* text_end = ( const char* ) memchr ( position, '<', end - position );
+			if ( text_end == NULL ) {
+				text_end = end;
+			}
+			if ( depth == 0 ) {
+				for ( const char* c = position; c < text_end; ++c ) {
+					if ( *c != ' ' && *c != '\t' && *c != '\r' && *c != '\n' && *c != '\0' ) {
+						return false;
+					}
+				}
+			}
+			else if ( capturing || ( target_ == TARGET_TEXT && matched == number_steps && depth == number_steps ) ) {
+				if ( !AppendDecoded ( position, text_end - position, false, result ) ) {
+					return false;
+				}
+				text_node = text_node || ( target_ == TARGET_TEXT && text_end > position );
+			}
+			position = text_end;
+			continue;
+		}
+
+		/* CDATA sections are part of the surrounding text node */
+		if ( end - position >= 9 && memcmp ( position, "<![CDATA[", 9 ) == 0 ) {
+			const char* section_end = position + 9;
+			while ( section_end + 3 <= end && memcmp ( section_end, "]]>", 3 ) != 0 ) {
+				++section_end;
+			}
+			if ( section_end + 3 > end || depth == 0 ) {
+				return false;
+			}
+			if ( capturing || ( target_ == TARGET_TEXT && matched == number_steps && depth == number_steps ) ) {
+				result.append ( position + 9, section_end - position - 9 );
+				text_node = text_node || ( target_ == TARGET_TEXT && section_end > position + 9 );
+			}
+			position = section_end + 3;
+			continue;
+		}
+
+		/* Any other markup ends the current text node */
+		if ( text_node ) {
+			result.push_back ( ' ' );
+			text_node = false;
+		}
+
+		/* Comments and processing instructions */
+		if ( end - position >= 4 && memcmp ( position, "<!--", 4 ) == 0 ) {
+			const char* comment_end = position + 4;
+			while ( comment_end + 3 <= end && memcmp ( comment_end, "-->", 3 ) != 0 ) {
+				++comment_end;
+			}
+			if ( comment_end + 3 > end ) {
+				return false;
+			}
+			position = comment_end + 3;
+			continue;
+		}
+		if ( end - position >= 2 && position[1] == '?' ) {
+			const char* instruction_end = position + 2;
+			while ( instruction_end + 2 <= end && memcmp ( instruction_end, "?>", 2 ) != 0 ) {
+				++instruction_end;
+			}
+			if ( instruction_end + 2 > end ) {
+				return false;
+			}
+			position = instruction_end + 2;
+			continue;
+		}
+
+		/* Document type declarations may define entities and default attributes */
+		if ( end - position >= 2 && position[1] == '!' ) {
+			return false;
+		}
+
+		/* End tag */
+		if ( end - position >= 2 && position[1] == '/' ) {
+			const char* tag_end = ( const char* ) memchr ( position, '>', end - position );
+			if ( tag_end == NULL || depth == 0 ) {
+				return false;
+			}
+			if ( matched == depth ) {
+				if ( capturing && depth == number_steps ) {
+					result.push_back ( ' ' );
+					capturing = false;
+				}
+				--matched;
+			}
+			--depth;
+			root_closed = ( depth == 0 );
+			position = tag_end + 1;
+			continue;
+		}
+
+		/* Start tag */
+		const char* name = position + 1;
+		const char* name_end = name;
+		while ( name_end < end && *name_end != ' ' && *name_end != '\t' && *name_end != '\r' && *name_end != '\n' && *name_end != '/' && *name_end != '>' ) {
+			++name_end;
+		}
+		const char* tag_end = name_end;
+		char quote = 0;
+		while ( tag_end < end && ( quote != 0 || *tag_end != '>' ) ) {
+			if ( quote != 0 && *tag_end == quote ) {
+				quote = 0;
+			}
+			else if ( quote == 0 && ( *tag_end == '"' || *tag_end == '\'' ) ) {
+				quote = *tag_end;
+			}
+			++tag_end;
+		}
+		if ( tag_end == end || name_end == name || root_closed ) {
+			return false;
+		}
+		bool empty = ( tag_end[-1] == '/' );
+		const char* attributes_end = ( empty ) ? tag_end - 1 : tag_end;
+
+		/* Queries do not bind namespaces, so qualified documents are left to the complete engine */
+		for ( const char* c = name_end; c + 5 <= attributes_end; ++c ) {
+			if ( memcmp ( c, "xmlns", 5 ) == 0 ) {
+				return false;
+			}
+		}
+
+		++depth;
+		if ( matched == depth - 1 && depth <= number_steps && Matches ( depth - 1, name, name_end - name, name_end, attributes_end ) ) {
+			matched = depth;
+			if ( depth == number_steps ) {
+				if ( target_ == TARGET_ELEMENT ) {
+					capturing = true;
+				}
+				else if ( target_ == TARGET_ATTRIBUTE ) {
+					const char* value;
+					int value_length;
+					if ( FindAttribute ( name_end, attributes_end, attribute_, &value, &value_length ) ) {
+						if ( !AppendDecoded ( value, value_length, true, result ) ) {
+							return false;
+						}
+						result.push_back ( ' ' );
+					}
+				}
+			}
+		}
+		if ( empty ) {
+			if ( matched == depth ) {
+				if ( capturing ) {
+					result.push_back ( ' ' );
+					capturing = false;
+				}
+				--matched;
+			}
+			--depth;
+			root_closed = ( depth == 0 );
+		}
+		position = tag_end + 1;
+	}
+
+	return depth == 0 && root_closed;
+}
+
+bool StreamingXPath::FindAttribute ( const char* attributes, const char* end, const string& name, const char** value, int* length ) {
+	const char* position = attributes;
+	while ( position < end ) {
+		while ( position < end && ( *position == ' ' || *position == '\t' || *position == '\r' || *position == '\n' ) ) {
+			++position;
+		}
+		const char* attribute_name = position;
+		while ( position < end && *position != '=' && *position != ' ' && *position != '\t' && *position != '\r' && *position != '\n' ) {
+			++position;
+		}
+		int name_length = position - attribute_name;
+		while ( position < end && *position != '"' && *position != '\'' ) {
+			++position;
+		}
+		if ( position == end ) {
+			return false;
+		}
+		char quote = *position;
+		const char* attribute_value = ++position;
+		while ( position < end && *position != quote ) {
+			++position;
+		}
+		if ( name_length == ( int ) name.length ( ) && memcmp ( attribute_name, name.data ( ), name_length ) == 0 ) {
+			*value = attribute_value;
+			*length = position - attribute_value;
+			return true;
+		}
+		++position;
+	}
+	return false;
+}
+
+bool StreamingXPath::IsCompiled ( void ) {
+	return compiled_;
+}
+
+bool StreamingXPath::IsName ( const string& name ) {
+	if ( name.empty ( ) || !( isalpha ( ( unsigned char ) name[0] ) || name[0] == '_' ) ) {
+		return false;
+	}
+	for ( unsigned int i = 1; i < name.length ( ); ++i ) {
+		if ( !( isalnum ( ( unsigned char ) name[i] ) || name[i] == '_' || name[i] == '-' || name[i] == '.' ) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool StreamingXPath::Matches ( int step, const char* name, int name_length, const char* attributes, const char* end ) {
+	Step& compiled = steps_[step];
+	if ( compiled.name_ != "*" && ( name_length != ( int ) compiled.name_.length ( ) || memcmp ( name, compiled.name_.data ( ), name_length ) != 0 ) ) {
+		return false;
+	}
+
+	for ( unsigned int i = 0; i < compiled.predicates_.size ( ); ++i ) {
+		Predicate& predicate = compiled.predicates_[i];
+		const char* value;
+		int value_length;
+		if ( !FindAttribute ( attributes, end, predicate.attribute_, &value, &value_length ) ) {
+			return false;
+		}
+		if ( predicate.operator_ == OPERATOR_EXISTS ) {
+			continue;
+		}
+
+		/* Values with references are compared after decoding */
+		bool equal;
+		if ( memchr ( value, '&', value_length ) == NULL && memchr ( value, '\t', value_length ) == NULL && memchr ( value, '\n', value_length ) == NULL && memchr ( value, '\r', value_length ) == NULL ) {
+			equal = ( value_length == ( int ) predicate.value_.length ( ) && memcmp ( value, predicate.value_.data ( ), value_length ) == 0 );
+		}
+		else {
+			string decoded;
+			if ( !AppendDecoded ( value, value_length, true, decoded ) ) {
+				return false;
+			}
+			equal = ( decoded == predicate.value_ );
+		}
+		if ( equal != ( predicate.operator_ == OPERATOR_EQUAL ) ) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,155 @@
+/**
+ * \file common/streaming_xpath.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_COMMON_STREAMING_XPATH_H_
+#define WATERSHED_COMMON_STREAMING_XPATH_H_
+
+/* C++ libraries */
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * \class StreamingXPath
+ * \brief Evaluates simple XPath queries in a single pass over the bytes of a document, without building a tree. The
+ * supported queries are absolute or relative paths of child steps, where a step is an element name or *, optionally
+ * followed by predicates over its attributes ([@a], [@a='v'] or [@a!='v']), and the path may end in an attribute
+ * (@a) or in text(). For example, /order[@status='open']/item/@sku. Queries outside this subset are not compiled,
+ * and documents the evaluator does not handle (document type declarations, namespaces, unknown entities or
+ * malformed markup) are rejected, so the caller can fall back to a complete XQuery engine.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class StreamingXPath {
+
+	public:
+
+		/**
+		 * \brief Creates a new StreamingXPath instance and compiles the query.
+		 * \param query The query text.
+		 * \return Not applicable.
+		 */
+		StreamingXPath ( string query );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~StreamingXPath ( void );
+
+		/**
+		 * \brief Evaluates the query over a document.
+		 * \param document The document.
+		 * \param length The document length in bytes.
+		 * \param result Where the string values of the selected items are written, each one followed by a space.
+		 * \return False if the document cannot be evaluated by this class.
+		 */
+		bool Evaluate ( const char* document, int length, string& result );
+
+		/**
+		 * \brief Checks whether the query belongs to the supported subset.
+		 * \return True if Evaluate can be used.
+		 */
+		bool IsCompiled ( void );
+
+	protected:
+
+	private:
+
+		/** \brief What the query selects from the elements reached by the steps. */
+		enum Target {
+			TARGET_ELEMENT, TARGET_ATTRIBUTE, TARGET_TEXT
+		};
+
+		/** \brief Comparisons of a predicate. */
+		enum Operator {
+			OPERATOR_EXISTS, OPERATOR_EQUAL, OPERATOR_NOT_EQUAL
+		};
+
+		/** \brief A predicate over an attribute of a step. */
+		struct Predicate {
+				string attribute_;
+				Operator operator_;
+				string value_;
+		};
+
+		/** \brief A child step. */
+		struct Step {
+				string name_;
+				vector < Predicate > predicates_;
+		};
+
+		/**
+		 * \brief Appends character data or an attribute value to the result, replacing the entity and character
+		 * references.
+		 * \param data The raw text.
+		 * \param length The raw text length.
+		 * \param attribute Whether the text is an attribute value, whose blanks are normalized.
+		 * \param result Where the text is appended.
+		 * \return False if the text has a reference that cannot be replaced.
+		 */
+		static bool AppendDecoded ( const char* data, int length, bool attribute, string& result );
+
+		/**
+		 * \brief Compiles the query.
+		 * \param query The query text.
+		 * \return True if the query belongs to the supported subset.
+		 */
+		bool Compile ( string query );
+
+		/**
+		 * \brief Compiles a step and its predicates.
+		 * \param step The step text.
+		 * \return True if the step belongs to the supported subset.
+		 */
+		bool CompileStep ( string step );
+
+		/**
+		 * \brief Looks for an attribute in a start tag.
+		 * \param attributes Beginning of the attributes in the start tag.
+		 * \param end End of the attributes.
+		 * \param name The attribute name.
+		 * \param value Where the pointer to the raw value is stored.
+		 * \param length Where the raw value length is stored.
+		 * \return True if the element has the attribute.
+		 */
+		static bool FindAttribute ( const char* attributes, const char* end, const string& name, const char** value, int* length );
+
+		/**
+		 * \brief Checks whether a name is a valid element or attribute name.
+		 * \param name The name.
+		 * \return True if the name is valid.
+		 */
+		static bool IsName ( const string& name );
+
+		/**
+		 * \brief Checks whether an element satisfies a step.
+		 * \param step The step index.
+		 * \param name The element name.
+		 * \param name_length The element name length.
+		 * \param attributes Beginning of the attributes in the start tag.
+		 * \param end End of the attributes.
+		 * \return True if the element satisfies the step.
+		 */
+		bool Matches ( int step, const char* name, int name_length, const char* attributes, const char* end );
+
+		/** \brief The child steps. */
+		vector < Step > steps_;
+
+		/** \brief What the query selects. */
+		Target target_;
+
+		/** \brief Attribute selected when the target is an attribute. */
+		string attribute_;
+
+		/** \brief Whether the query belongs to the supported subset. */
+		bool compiled_;
+};
+
+#endif /* WATERSHED_COMMON_STREAMING_XPATH_H_ */
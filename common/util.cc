@@ -7,6 +7,8 @@
 /* Project's .h */
 #include "common/util.h"
 
+AsyncLogger* Util::logger_ = NULL;
+
 vector < string > Util::TokenizeString ( const string &delimiters, const string &word ) {
 
 	vector < string > tokens;
@@ -36,6 +38,10 @@ void Util::Error ( MpiCommunicator* communicator, string message ) {
 }
 
 void Util::Information ( MpiCommunicator* communicator, string message ) {
+	if ( logger_ != NULL && logger_->GetCommunicator ( ) == communicator ) {
+		logger_->Log ( Constants::MESSAGE_OP_INFO_LOG, message );
+		return;
+	}
 	Message output_message;
 	output_message.SetOperationCode ( Constants::MESSAGE_OP_INFO_LOG );
 	output_message.SetData ( ( void* ) message.c_str ( ), message.length ( ) + 1 );
@@ -43,6 +49,10 @@ void Util::Information ( MpiCommunicator* communicator, string message ) {
 }
 
 void Util::Warning ( MpiCommunicator* communicator, string message ) {
+	if ( logger_ != NULL && logger_->GetCommunicator ( ) == communicator ) {
+		logger_->Log ( Constants::MESSAGE_OP_WARNING_LOG, message );
+		return;
+	}
 	Message output_message;
 	output_message.SetOperationCode ( Constants::MESSAGE_OP_WARNING_LOG );
 	output_message.SetData ( ( void* ) message.c_str ( ), message.length ( ) + 1 );
@@ -62,3 +72,14 @@ string Util::IntegerToString(int number) {
 	string response = number_representation;
 	return response;
 }
+
+string Util::LongToString(long number) {
+	char number_representation[MAX_NUMBER_REPRESENTATION_SIZE];
+	sprintf(number_representation,"%ld", number);
+	string response = number_representation;
+	return response;
+}
+
+void Util::SetLogger ( AsyncLogger* logger ) {
+	logger_ = logger;
+}
@@ -13,6 +13,7 @@
 
 /** Project's .h */
 #include "comm/mpi/mpi_communicator.h"
+#include "common/async_logger.h"
 
 using namespace std;
 
@@ -54,6 +55,13 @@ class Util {
 		 */
 		static string IntegerToString ( int number );
 
+		/**
+		 * \brief Converts a long integer number to a string.
+		 * \param number The number to be converted.
+		 * \return The string representing the number.
+		 */
+		static string LongToString ( long number );
+
 		/**
 		 * \brief Transforms a string in a vector of tokens according to delimiters.
 		 * \param delimiters Delimiters used to split the string.
@@ -63,7 +71,8 @@ class Util {
 		static vector < string > TokenizeString ( const string &delimiters, const string &word );
 
 		/**
-		 * \brief Sends an error message to the root process in a communicator.
+		 * \brief Sends an error message to the root process in a communicator. Errors are always sent at once, never
+		 * through the asynchronous logger, so they are neither delayed nor dropped.
 		 * \param communicator Communicator to be used.
 		 * \param message The message to be sent.
 		 * \return Not applicable.
@@ -71,7 +80,8 @@ class Util {
 		static void Error ( MpiCommunicator* communicator, string message );
 
 		/**
-		 * \brief Sends an information message to the root process in a communicator.
+		 * \brief Sends an information message to the root process in a communicator, through the asynchronous logger
+		 * when it sends to the same communicator.
 		 * \param communicator Communicator to be used.
 		 * \param message The message to be sent.
 		 * \return Not applicable.
@@ -79,19 +89,30 @@ class Util {
 		static void Information ( MpiCommunicator* communicator, string message );
 
 		/**
-		 * \brief Sends an warning message to the root process in a communicator.
+		 * \brief Sends an warning message to the root process in a communicator, through the asynchronous logger when
+		 * it sends to the same communicator.
 		 * \param communicator Communicator to be used.
 		 * \param message The message to be sent.
 		 * \return Not applicable.
 		 */
 		static void Warning ( MpiCommunicator* communicator, string message );
 
+		/**
+		 * \brief Sets the asynchronous logger of the process.
+		 * \param logger The logger, NULL to send every message at once.
+		 * \return Not applicable.
+		 */
+		static void SetLogger ( AsyncLogger* logger );
+
 	protected:
 
 	private:
 
 		/** \brief The maximun size for a number representation. */
 		static const int MAX_NUMBER_REPRESENTATION_SIZE = 100;
+
+		/** \brief The asynchronous logger of the process, NULL when there is none. */
+		static AsyncLogger* logger_;
 };
 
 #endif /* WATERSHED_COMMON_UTIL_H_ */
@@ -7,19 +7,31 @@
 #include "common/xml_query.h"
 
 XMLQuery::XMLQuery(void) {
+	xqilla_ = NULL;
+	number_lookups_ = 0;
 }
 
 XMLQuery::~XMLQuery(void) {
+	for (map<string, CompiledQuery>::iterator it = compiled_queries_.begin(); it != compiled_queries_.end(); ++it) {
+		ReleaseCompiledQuery(&it->second);
+	}
+	compiled_queries_.clear();
+	delete xqilla_;
 }
 
 string XMLQuery::ExecuteQuery(string xml_file, string query_flow_in) {
-	XQilla xqilla;
 	string value = "";
+	CompiledQuery *compiled = GetCompiledQuery(query_flow_in);
+	if (compiled->path_->IsCompiled() && compiled->path_->Evaluate(xml_file.data(), xml_file.length(), value)) {
+		return value;
+	}
+
+	value.clear();
 	try {
-		AutoDelete < XQQuery > query(xqilla.parse(X(query_flow_in.c_str())));
-		AutoDelete < DynamicContext > context(XQilla::createContext());
+		PrepareXQuery(compiled, query_flow_in);
+		DynamicContext *context = compiled->context_;
 		DocumentCache *cache = (DocumentCache*) context->getDocumentCache();
-		MemBufInputSource xml((const XMLByte*)  xml_file.c_str(), xml_file.length(), "input");
+		MemBufInputSource xml((const XMLByte*) xml_file.c_str(), xml_file.length(), "input");
 		Node::Ptr node = cache->parseDocument(xml, context);
 
 		if (node && node->isNode()) {
@@ -27,11 +39,20 @@ string XMLQuery::ExecuteQuery(string xml_file, string query_flow_in) {
 			context->setContextPosition(1);
 			context->setContextSize(1);
 		}
-		Result result = query->execute(context);
+		Result result = compiled->query_->execute(context);
 		Item::Ptr item;
+		int number_items = 0;
+		bool is_false = false;
 		while (item = result->next(context)) {
+			is_false = item->isAtomicValue() && ((const AnyAtomicType*) item.get())->getPrimitiveTypeIndex() == AnyAtomicType::BOOLEAN && !((const ATBooleanOrDerived*) item.get())->isTrue();
 			value.append(UTF8(item->asString(context)));
 			value.append(" ");
+			++number_items;
+		}
+
+		/* A predicate that does not hold is no match, as a path that selects nothing */
+		if (number_items == 1 && is_false) {
+			value.clear();
 		}
 	} catch (XMLParseException e) {
 
@@ -40,3 +61,63 @@ string XMLQuery::ExecuteQuery(string xml_file, string query_flow_in) {
 	return value;
 }
 
+void XMLQuery::EvictCompiledQuery(void) {
+	map<string, CompiledQuery>::iterator oldest = compiled_queries_.begin();
+	for (map<string, CompiledQuery>::iterator it = compiled_queries_.begin(); it != compiled_queries_.end(); ++it) {
+		if (it->second.last_use_ < oldest->second.last_use_) {
+			oldest = it;
+		}
+	}
+	ReleaseCompiledQuery(&oldest->second);
+	compiled_queries_.erase(oldest);
+}
+
+XMLQuery::CompiledQuery* XMLQuery::GetCompiledQuery(string query_flow_in) {
+	map<string, CompiledQuery>::iterator it = compiled_queries_.find(query_flow_in);
+
+	if (it == compiled_queries_.end()) {
+		if ((int) compiled_queries_.size() >= Constants::XML_QUERY_CACHE_CAPACITY) {
+			EvictCompiledQuery();
+		}
+		CompiledQuery compiled;
+		compiled.path_ = new StreamingXPath(query_flow_in);
+		compiled.query_ = NULL;
+		compiled.context_ = NULL;
+		compiled.number_executions_ = 0;
+		it = compiled_queries_.insert(make_pair(query_flow_in, compiled)).first;
+	}
+	it->second.last_use_ = ++number_lookups_;
+
+	return &it->second;
+}
+
+int XMLQuery::GetNumberCompiledQueries(void) {
+	return compiled_queries_.size();
+}
+
+void XMLQuery::PrepareXQuery(CompiledQuery* compiled, string query_flow_in) {
+	if (compiled->query_ == NULL) {
+		if (xqilla_ == NULL) {
+			xqilla_ = new XQilla();
+		}
+		compiled->query_ = xqilla_->parse(X(query_flow_in.c_str()));
+		compiled->context_ = compiled->query_->createDynamicContext();
+		compiled->number_executions_ = 0;
+	} else if (compiled->number_executions_ >= Constants::XML_QUERY_CONTEXT_REUSE_LIMIT) {
+		/* Documents parsed through a context are kept in its memory until the context is destroyed */
+		delete compiled->context_;
+		compiled->context_ = compiled->query_->createDynamicContext();
+		compiled->number_executions_ = 0;
+	} else {
+		compiled->context_->clearDynamicContext();
+	}
+	++compiled->number_executions_;
+}
+
+void XMLQuery::ReleaseCompiledQuery(CompiledQuery* compiled) {
+	delete compiled->path_;
+	if (compiled->query_ != NULL) {
+		delete compiled->context_;
+		delete compiled->query_;
+	}
+}
@@ -8,17 +8,26 @@
 #define XML_QUERY_H_
 
 #include <iostream>
+#include <map>
 #include <xqilla/xqilla-simple.hpp>
+#include <xqilla/items/AnyAtomicType.hpp>
+#include <xqilla/items/ATBooleanOrDerived.hpp>
 #include <xercesc/framework/MemBufInputSource.hpp>
 #include <xqilla/exceptions/XMLParseException.hpp>
 
+#include "common/constants.h"
+#include "common/streaming_xpath.h"
+
 using namespace std;
 using namespace xercesc;
 
 
 /**
  * \class XMLQuery
- * \brief Query XML file parser using Xqilla
+ * \brief Query XML file parser using Xqilla. Queries are compiled once and kept, together with a reusable dynamic
+ * context, in a cache keyed by the query text and bounded by Constants::XML_QUERY_CACHE_CAPACITY. An instance must not
+ * be shared by threads. Simple path queries are evaluated by StreamingXPath in a single pass over
+ * the document, and Xqilla is only used for the other queries and documents.
  * \author Ana Paula de Carvalho
  * \version 1.0
  * \date 2011
@@ -33,22 +42,79 @@ class XMLQuery {
 	    XMLQuery();
 
 	    /**
-	     * \brief Destructor.
+	     * \brief Destructor. Releases all the cached queries.
 	     * \return Not applicable.
 	     */
 	   ~XMLQuery(void);
 
 	   /**
 	   	* \brief Query a XML file.
-	   	* \param xml_file
-	   	* \param query_flow_in
-	   	* \return
+	   	* \param xml_file The XML document.
+	   	* \param query_flow_in The query text. It is compiled on the first call and reused afterwards.
+	   	* \return The items of the result, each one followed by a space. A result made of a single boolean false, as the
+	   	* one of a comparison that does not hold, is empty, so filters written as predicates match nothing.
 	   	*/
 	   string ExecuteQuery(string xml_file, string query_flow_in);
 
+	   /**
+	   	* \brief Retrieves the number of compiled queries in the cache.
+	   	* \return The number of compiled queries.
+	   	*/
+	   int GetNumberCompiledQueries(void);
+
 	private:
 
+	   /** \brief A compiled query and the dynamic context used to execute it. */
+	   struct CompiledQuery {
+			   StreamingXPath* path_;
+			   XQQuery* query_;
+			   DynamicContext* context_;
+			   int number_executions_;
+			   long last_use_;
+	   };
+
+	   /** \brief XQilla instance. Created on the first query. */
+	   XQilla* xqilla_;
+
+	   /** \brief Compiled queries, by query text. */
+	   map<string, CompiledQuery> compiled_queries_;
+
+	   /** \brief Number of cache lookups, used to order the queries by their last use. */
+	   long number_lookups_;
+
+	   /**
+	   	* \brief Evicts the least recently used query from the cache.
+	   	* \return Not applicable.
+	   	*/
+	   void EvictCompiledQuery(void);
+
+	   /**
+	   	* \brief Retrieves a compiled query from the cache, compiling it for StreamingXPath on a miss.
+	   	* \param query_flow_in The query text.
+	   	* \return The compiled query.
+	   	*/
+	   CompiledQuery* GetCompiledQuery(string query_flow_in);
+
+	   /**
+	   	* \brief Compiles the query with Xqilla if it was not compiled yet and prepares its context to execute it.
+	   	* \param compiled The compiled query.
+	   	* \param query_flow_in The query text.
+	   	* \return Not applicable.
+	   	*/
+	   void PrepareXQuery(CompiledQuery* compiled, string query_flow_in);
+
+	   /**
+	   	* \brief Releases the objects of a compiled query.
+	   	* \param compiled The compiled query.
+	   	* \return Not applicable.
+	   	*/
+	   static void ReleaseCompiledQuery(CompiledQuery* compiled);
+
+	   /** \brief Copy is not allowed. */
+	   XMLQuery(const XMLQuery&);
 
+	   /** \brief Assignment is not allowed. */
+	   XMLQuery& operator=(const XMLQuery&);
 };
 
 #endif  // CAHPETA_COMMON_XML_QUERY_H_
@@ -71,7 +71,7 @@ void Console::ParseCommand ( void ) {
 		message_from_server.SetOperationCode ( Constants::MESSAGE_OP_ANY );
 		ReceiveFromServer ( &message_from_server );
 		if (message_from_server.GetOperationCode ( ) == Constants::MESSAGE_OP_ADD_PROCESSING_MODULE_ACK) {
-			log_message = arguments_[0] + " successfully added to " + Constants::SYSTEM_NAME;
+			log_message = arguments_[0] + " submitted to " + Constants::SYSTEM_NAME + " as deployment job " + (char*) message_from_server.GetData ( ) + ", see " + Constants::COMMAND_JOBS;
 			console_logger_->PrintInfo ( log_message );
 		}
 		else {
@@ -91,6 +91,21 @@ void Console::ParseCommand ( void ) {
 			console_logger_->PrintError ( (char*) message_from_server.GetData ( ) );
 		}
 	}
+	else if (command_ == Constants::COMMAND_ADD_INSTANCE) {
+		string number_instances = (arguments_.size ( ) > 1) ? arguments_[1] : "1";
+		AddInstanceMessage message_data ( atoi ( number_instances.c_str ( ) ), arguments_[0] );
+		message_to_server = new Message ( (void*) &message_data, Constants::MESSAGE_OP_ADD_INSTANCE, sizeof(message_data) );
+		SendToServer ( message_to_server );
+		message_from_server.SetOperationCode ( Constants::MESSAGE_OP_ANY );
+		ReceiveFromServer ( &message_from_server );
+		if (message_from_server.GetOperationCode ( ) == Constants::MESSAGE_OP_ADD_INSTANCE_ACK) {
+			log_message = number_instances + " instances successfully added to " + arguments_[0] + " on " + Constants::SYSTEM_NAME;
+			console_logger_->PrintInfo ( log_message );
+		}
+		else {
+			console_logger_->PrintError ( (char*) message_from_server.GetData ( ) );
+		}
+	}
 	else if (command_ == Constants::COMMAND_REMOVE_INSTANCE) {
 		RemoveInstanceMessage message_data ( atoi ( arguments_[1].c_str ( ) ), arguments_[0] );
 		message_to_server = new Message ( (void*) &message_data, Constants::MESSAGE_OP_REMOVE_INSTANCE, sizeof(message_data) );
@@ -106,6 +121,20 @@ void Console::ParseCommand ( void ) {
 		}
 
 	}
+	else if (command_ == Constants::COMMAND_STATS) {
+		message_to_server = new Message ( NULL, Constants::MESSAGE_OP_QUERY_METRICS, 0 );
+		SendToServer ( message_to_server );
+		message_from_server.SetOperationCode ( Constants::MESSAGE_OP_QUERY_METRICS_ACK );
+		ReceiveFromServer ( &message_from_server );
+		cout << (char*) message_from_server.GetData ( );
+	}
+	else if (command_ == Constants::COMMAND_JOBS) {
+		message_to_server = new Message ( NULL, Constants::MESSAGE_OP_QUERY_DEPLOYMENTS, 0 );
+		SendToServer ( message_to_server );
+		message_from_server.SetOperationCode ( Constants::MESSAGE_OP_QUERY_DEPLOYMENTS_ACK );
+		ReceiveFromServer ( &message_from_server );
+		cout << (char*) message_from_server.GetData ( );
+	}
 	else if (command_ == Constants::COMMAND_SHUTDOWN) {
 		log_message = Constants::SYSTEM_NAME + " is going down";
 		console_logger_->PrintInfo ( log_message );
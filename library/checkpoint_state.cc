@@ -0,0 +1,105 @@
+/**
+ * \file library/checkpoint_state.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "library/checkpoint_state.h"
+
+CheckpointState::CheckpointState ( void ) {
+
+}
+
+CheckpointState::~CheckpointState ( void ) {
+	Clear ( );
+}
+
+void CheckpointState::Clear ( void ) {
+	removed_keys_.clear ( );
+	values_.clear ( );
+}
+
+bool CheckpointState::Get ( const string& key, string& value ) {
+	map < string, string >::iterator it = values_.find ( key );
+	if ( it == values_.end ( ) ) {
+		return false;
+	}
+	value = it->second;
+	return true;
+}
+
+set < string >* CheckpointState::GetRemovedKeys ( void ) {
+	return &removed_keys_;
+}
+
+map < string, string >* CheckpointState::GetValues ( void ) {
+	return &values_;
+}
+
+bool CheckpointState::IsEmpty ( void ) {
+	return values_.empty ( ) && removed_keys_.empty ( );
+}
+
+void CheckpointState::Pack ( string& buffer ) {
+	buffer.clear ( );
+	for ( map < string, string >::iterator v = values_.begin ( ); v != values_.end ( ); ++v ) {
+		int32_t key_size = v->first.size ( );
+		int32_t value_size = v->second.size ( );
+		buffer.append ( ( const char* ) &key_size, sizeof(int32_t) );
+		buffer.append ( v->first );
+		buffer.append ( ( const char* ) &value_size, sizeof(int32_t) );
+		buffer.append ( v->second );
+	}
+}
+
+void CheckpointState::Put ( const string& key, const string& value ) {
+	removed_keys_.erase ( key );
+	values_[key] = value;
+}
+
+void CheckpointState::Put ( const string& key, const void* data, int size ) {
+	removed_keys_.erase ( key );
+	values_[key].assign ( ( const char* ) data, size );
+}
+
+void CheckpointState::Remove ( const string& key ) {
+	values_.erase ( key );
+	removed_keys_.insert ( key );
+}
+
+void CheckpointState::Swap ( CheckpointState& state ) {
+	removed_keys_.swap ( state.removed_keys_ );
+	values_.swap ( state.values_ );
+}
+
+bool CheckpointState::Unpack ( const char* data, int size ) {
+	int32_t key_size, value_size;
+	int offset = 0;
+
+	/* Every length is checked against the rest of the buffer, which may come from another process */
+	Clear ( );
+	while ( offset < size ) {
+		if ( size - offset < ( int ) sizeof(int32_t) ) {
+			Clear ( );
+			return false;
+		}
+		memcpy ( &key_size, data + offset, sizeof(int32_t) );
+		offset += sizeof(int32_t);
+		if ( key_size < 0 || key_size > size - offset || size - offset - key_size < ( int ) sizeof(int32_t) ) {
+			Clear ( );
+			return false;
+		}
+		string key ( data + offset, key_size );
+		offset += key_size;
+		memcpy ( &value_size, data + offset, sizeof(int32_t) );
+		offset += sizeof(int32_t);
+		if ( value_size < 0 || value_size > size - offset ) {
+			Clear ( );
+			return false;
+		}
+		values_[key].assign ( data + offset, value_size );
+		offset += value_size;
+	}
+	return true;
+}
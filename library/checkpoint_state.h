@@ -0,0 +1,136 @@
+/**
+ * \file library/checkpoint_state.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_CHECKPOINT_STATE_H_
+#define WATERSHED_LIBRARY_CHECKPOINT_STATE_H_
+
+/* C libraries */
+#include <stdint.h>
+#include <string.h>
+
+/* C++ libraries */
+#include <map>
+#include <set>
+#include <string>
+
+using namespace std;
+
+/**
+ * \class CheckpointState
+ * \brief Keyed state of a processing module instance. When a checkpoint is taken it holds only the keys written or
+ * removed since the previous one, and when a checkpoint is restored it holds all the keys saved until then. Values are
+ * arbitrary bytes.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class CheckpointState {
+
+	public:
+
+		/**
+		 * \brief Creates a new empty CheckpointState instance.
+		 * \return Not applicable.
+		 */
+		CheckpointState ( void );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~CheckpointState ( void );
+
+		/**
+		 * \brief Retrieves the value of a key.
+		 * \param key The key.
+		 * \param value Where the value is stored.
+		 * \return False if the key has no value.
+		 */
+		bool Get ( const string& key, string& value );
+
+		/**
+		 * \brief Checks whether the state has no values neither removed keys.
+		 * \return True if the state is empty.
+		 */
+		bool IsEmpty ( void );
+
+		/**
+		 * \brief Retrieves the keys removed.
+		 * \return The removed keys.
+		 */
+		set < string >* GetRemovedKeys ( void );
+
+		/**
+		 * \brief Retrieves the values, by key.
+		 * \return The values.
+		 */
+		map < string, string >* GetValues ( void );
+
+		/**
+		 * \brief Discards all the values and removed keys.
+		 * \return Not applicable.
+		 */
+		void Clear ( void );
+
+		/**
+		 * \brief Writes the values to a buffer, so the state can be sent to another process.
+		 * \param buffer Where the values are written.
+		 * \return Not applicable.
+		 */
+		void Pack ( string& buffer );
+
+		/**
+		 * \brief Sets the value of a key.
+		 * \param key The key.
+		 * \param value The value.
+		 * \return Not applicable.
+		 */
+		void Put ( const string& key, const string& value );
+
+		/**
+		 * \brief Sets the value of a key.
+		 * \param key The key.
+		 * \param data Pointer to the value.
+		 * \param size The value size in bytes.
+		 * \return Not applicable.
+		 */
+		void Put ( const string& key, const void* data, int size );
+
+		/**
+		 * \brief Removes a key, so it is also removed from the saved state.
+		 * \param key The key.
+		 * \return Not applicable.
+		 */
+		void Remove ( const string& key );
+
+		/**
+		 * \brief Exchanges the contents of two states without copying them.
+		 * \param state The other state.
+		 * \return Not applicable.
+		 */
+		void Swap ( CheckpointState& state );
+
+		/**
+		 * \brief Replaces the state by the values written to a buffer by Pack.
+		 * \param data The buffer.
+		 * \param size The buffer size in bytes.
+		 * \return False if the buffer is truncated or corrupt, in which case the state is left empty.
+		 */
+		bool Unpack ( const char* data, int size );
+
+	protected:
+
+	private:
+
+		/** \brief Keys removed. */
+		set < string > removed_keys_;
+
+		/** \brief Values, by key. */
+		map < string, string > values_;
+};
+
+#endif /* WATERSHED_LIBRARY_CHECKPOINT_STATE_H_ */
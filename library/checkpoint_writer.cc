@@ -0,0 +1,296 @@
+/**
+ * \file library/checkpoint_writer.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Project's .h */
+#include "library/checkpoint_writer.h"
+
+/* A record is the magic number, the checkpoint, whether it has the whole state, the number of entries, the entries and
+ * the checkpoint again. An entry is the key length, the value length (-1 for a removed key), the key and the value. */
+static const int32_t CHECKPOINT_RECORD_MAGIC = 0x5753434B;
+
+CheckpointWriter::CheckpointWriter ( string file_name ) throw ( FileOperationException ) {
+	file_name_ = file_name;
+	stop_ = false;
+	log_size_ = 0;
+	state_size_ = 0;
+	file_ = fopen ( file_name_.c_str ( ), "a+b" );
+	if ( file_ == NULL ) {
+		throw FileOperationException ( "cannot open the checkpoint log " + file_name_ + ": " + strerror ( errno ) );
+	}
+	last_checkpoint_ = ReadLog ( LONG_MAX );
+
+	pthread_mutex_init ( &mutex_, NULL );
+	pthread_cond_init ( &condition_, NULL );
+	pthread_create ( &writer_thread_, NULL, &CheckpointWriter::StartWriterThread, this );
+}
+
+CheckpointWriter::~CheckpointWriter ( void ) {
+	pthread_mutex_lock ( &mutex_ );
+	stop_ = true;
+	pthread_cond_signal ( &condition_ );
+	pthread_mutex_unlock ( &mutex_ );
+	pthread_join ( writer_thread_, NULL );
+
+	fclose ( file_ );
+	pthread_cond_destroy ( &condition_ );
+	pthread_mutex_destroy ( &mutex_ );
+}
+
+void CheckpointWriter::AppendCheckpoint ( PendingCheckpoint& pending ) {
+	string record;
+	int32_t number_entries = 0;
+	int32_t full = 0;
+	int64_t checkpoint = pending.checkpoint_;
+	record.append ( ( const char* ) &CHECKPOINT_RECORD_MAGIC, sizeof ( int32_t ) );
+	record.append ( ( const char* ) &checkpoint, sizeof ( int64_t ) );
+	record.append ( ( const char* ) &full, sizeof ( int32_t ) );
+	record.append ( ( const char* ) &number_entries, sizeof ( int32_t ) );
+
+	map < string, string >* values = pending.changes_->GetValues ( );
+	for ( map < string, string >::iterator v = values->begin ( ); v != values->end ( ); ++v ) {
+		map < string, string >::iterator saved = saved_state_.find ( v->first );
+		if ( saved != saved_state_.end ( ) && saved->second == v->second ) {
+			continue;
+		}
+		int32_t key_length = v->first.length ( );
+		int32_t value_length = v->second.length ( );
+		record.append ( ( const char* ) &key_length, sizeof ( int32_t ) );
+		record.append ( ( const char* ) &value_length, sizeof ( int32_t ) );
+		record.append ( v->first );
+		record.append ( v->second );
+		++number_entries;
+
+		if ( saved == saved_state_.end ( ) ) {
+			state_size_ += 2 * sizeof ( int32_t ) + key_length + value_length;
+			saved_state_[v->first] = v->second;
+		}
+		else {
+			state_size_ += value_length - ( long ) saved->second.length ( );
+			saved->second = v->second;
+		}
+	}
+
+	set < string >* removed_keys = pending.changes_->GetRemovedKeys ( );
+	for ( set < string >::iterator k = removed_keys->begin ( ); k != removed_keys->end ( ); ++k ) {
+		map < string, string >::iterator saved = saved_state_.find ( *k );
+		if ( saved == saved_state_.end ( ) ) {
+			continue;
+		}
+		int32_t key_length = k->length ( );
+		int32_t value_length = -1;
+		record.append ( ( const char* ) &key_length, sizeof ( int32_t ) );
+		record.append ( ( const char* ) &value_length, sizeof ( int32_t ) );
+		record.append ( *k );
+		++number_entries;
+
+		state_size_ -= 2 * sizeof ( int32_t ) + key_length + saved->second.length ( );
+		saved_state_.erase ( saved );
+	}
+
+	/* Records without changes are still written, so the checkpoint is known to be complete */
+	memcpy ( &record[2 * sizeof ( int32_t ) + sizeof ( int64_t )], &number_entries, sizeof ( int32_t ) );
+	record.append ( ( const char* ) &checkpoint, sizeof ( int64_t ) );
+	fwrite ( record.data ( ), 1, record.length ( ), file_ );
+	fflush ( file_ );
+	fdatasync ( fileno ( file_ ) );
+	log_size_ += record.length ( );
+}
+
+void CheckpointWriter::CompactLog ( long checkpoint ) {
+	string temporary_file_name = file_name_ + ".tmp";
+	FILE* temporary_file = fopen ( temporary_file_name.c_str ( ), "wb" );
+	if ( temporary_file == NULL ) {
+		return;
+	}
+
+	int32_t full = 1;
+	int32_t number_entries = saved_state_.size ( );
+	int64_t record_checkpoint = checkpoint;
+	fwrite ( &CHECKPOINT_RECORD_MAGIC, sizeof ( int32_t ), 1, temporary_file );
+	fwrite ( &record_checkpoint, sizeof ( int64_t ), 1, temporary_file );
+	fwrite ( &full, sizeof ( int32_t ), 1, temporary_file );
+	fwrite ( &number_entries, sizeof ( int32_t ), 1, temporary_file );
+	for ( map < string, string >::iterator v = saved_state_.begin ( ); v != saved_state_.end ( ); ++v ) {
+		int32_t key_length = v->first.length ( );
+		int32_t value_length = v->second.length ( );
+		fwrite ( &key_length, sizeof ( int32_t ), 1, temporary_file );
+		fwrite ( &value_length, sizeof ( int32_t ), 1, temporary_file );
+		fwrite ( v->first.data ( ), 1, key_length, temporary_file );
+		fwrite ( v->second.data ( ), 1, value_length, temporary_file );
+	}
+	fwrite ( &record_checkpoint, sizeof ( int64_t ), 1, temporary_file );
+	fflush ( temporary_file );
+	bool written = ( ferror ( temporary_file ) == 0 && fsync ( fileno ( temporary_file ) ) == 0 );
+	log_size_ = ftell ( temporary_file );
+	fclose ( temporary_file );
+
+	/* The old log stays in place until the new one is complete */
+	if ( !written || rename ( temporary_file_name.c_str ( ), file_name_.c_str ( ) ) != 0 ) {
+		unlink ( temporary_file_name.c_str ( ) );
+		fseek ( file_, 0, SEEK_END );
+		log_size_ = ftell ( file_ );
+		return;
+	}
+	fclose ( file_ );
+	file_ = fopen ( file_name_.c_str ( ), "a+b" );
+}
+
+long CheckpointWriter::GetLastCheckpoint ( void ) {
+	pthread_mutex_lock ( &mutex_ );
+	long last_checkpoint = last_checkpoint_;
+	pthread_mutex_unlock ( &mutex_ );
+	return last_checkpoint;
+}
+
+long CheckpointWriter::Load ( long checkpoint, CheckpointState& state ) throw ( FileOperationException ) {
+	pthread_mutex_lock ( &mutex_ );
+	long last_checkpoint = last_checkpoint_;
+	pthread_mutex_unlock ( &mutex_ );
+
+	/* Pending checkpoints would be written after the loaded one, so loading is only allowed before writing */
+	if ( checkpoint < last_checkpoint ) {
+		last_checkpoint = ReadLog ( checkpoint );
+		pthread_mutex_lock ( &mutex_ );
+		last_checkpoint_ = last_checkpoint;
+		pthread_mutex_unlock ( &mutex_ );
+	}
+
+	state.Clear ( );
+	for ( map < string, string >::iterator v = saved_state_.begin ( ); v != saved_state_.end ( ); ++v ) {
+		state.Put ( v->first, v->second );
+	}
+	return last_checkpoint;
+}
+
+long CheckpointWriter::ReadLog ( long checkpoint ) throw ( FileOperationException ) {
+	long last_checkpoint = -1;
+	long valid_size = 0;
+	saved_state_.clear ( );
+	state_size_ = 0;
+	rewind ( file_ );
+
+	while ( true ) {
+		int32_t magic;
+		int64_t record_checkpoint;
+		int32_t full;
+		int32_t number_entries;
+		if ( fread ( &magic, sizeof ( int32_t ), 1, file_ ) != 1 || magic != CHECKPOINT_RECORD_MAGIC || fread ( &record_checkpoint, sizeof ( int64_t ), 1, file_ ) != 1 || fread ( &full, sizeof ( int32_t ), 1, file_ ) != 1 || fread ( &number_entries, sizeof ( int32_t ), 1, file_ ) != 1 ) {
+			break;
+		}
+		if ( record_checkpoint > checkpoint ) {
+			break;
+		}
+
+		/* Entries are applied only after the trailer is read */
+		map < string, string > values;
+		set < string > removed_keys;
+		bool complete = true;
+		for ( int i = 0; i < number_entries && complete; ++i ) {
+			int32_t key_length;
+			int32_t value_length;
+			if ( fread ( &key_length, sizeof ( int32_t ), 1, file_ ) != 1 || fread ( &value_length, sizeof ( int32_t ), 1, file_ ) != 1 || key_length < 0 || value_length < -1 ) {
+				complete = false;
+				break;
+			}
+			string key ( key_length, '\0' );
+			if ( key_length > 0 && fread ( &key[0], 1, key_length, file_ ) != ( size_t ) key_length ) {
+				complete = false;
+				break;
+			}
+			if ( value_length == -1 ) {
+				removed_keys.insert ( key );
+				values.erase ( key );
+				continue;
+			}
+			string value ( value_length, '\0' );
+			if ( value_length > 0 && fread ( &value[0], 1, value_length, file_ ) != ( size_t ) value_length ) {
+				complete = false;
+				break;
+			}
+			removed_keys.erase ( key );
+			values[key] = value;
+		}
+		int64_t trailer;
+		if ( !complete || fread ( &trailer, sizeof ( int64_t ), 1, file_ ) != 1 || trailer != record_checkpoint ) {
+			break;
+		}
+
+		if ( full != 0 ) {
+			saved_state_.clear ( );
+		}
+		for ( set < string >::iterator k = removed_keys.begin ( ); k != removed_keys.end ( ); ++k ) {
+			saved_state_.erase ( *k );
+		}
+		for ( map < string, string >::iterator v = values.begin ( ); v != values.end ( ); ++v ) {
+			saved_state_[v->first] = v->second;
+		}
+		last_checkpoint = record_checkpoint;
+		valid_size = ftell ( file_ );
+	}
+
+	for ( map < string, string >::iterator v = saved_state_.begin ( ); v != saved_state_.end ( ); ++v ) {
+		state_size_ += 2 * sizeof ( int32_t ) + v->first.length ( ) + v->second.length ( );
+	}
+
+	/* Discards an incomplete record left by a failure and the checkpoints after the one applied */
+	fflush ( file_ );
+	if ( ftruncate ( fileno ( file_ ), valid_size ) != 0 ) {
+		throw FileOperationException ( "cannot truncate the checkpoint log " + file_name_ + ": " + strerror ( errno ) );
+	}
+	fseek ( file_, 0, SEEK_END );
+	log_size_ = valid_size;
+	return last_checkpoint;
+}
+
+void* CheckpointWriter::StartWriterThread ( void* obj ) {
+	reinterpret_cast < CheckpointWriter * > ( obj )->WriteCheckpoints ( );
+	pthread_exit ( NULL);
+}
+
+void CheckpointWriter::Write ( long checkpoint, CheckpointState& changes ) {
+	PendingCheckpoint pending;
+	pending.checkpoint_ = checkpoint;
+	pending.changes_ = new CheckpointState ( );
+	pending.changes_->Swap ( changes );
+
+	pthread_mutex_lock ( &mutex_ );
+	pending_checkpoints_.push_back ( pending );
+	pthread_cond_signal ( &condition_ );
+	pthread_mutex_unlock ( &mutex_ );
+}
+
+void CheckpointWriter::WriteCheckpoints ( void ) {
+	while ( true ) {
+		pthread_mutex_lock ( &mutex_ );
+		while ( pending_checkpoints_.empty ( ) && !stop_ ) {
+			pthread_cond_wait ( &condition_, &mutex_ );
+		}
+		if ( pending_checkpoints_.empty ( ) ) {
+			pthread_mutex_unlock ( &mutex_ );
+			break;
+		}
+		PendingCheckpoint pending = pending_checkpoints_.front ( );
+		pending_checkpoints_.pop_front ( );
+		pthread_mutex_unlock ( &mutex_ );
+
+		AppendCheckpoint ( pending );
+		if ( log_size_ > Constants::CHECKPOINT_COMPACTION_MIN_SIZE && log_size_ > 2 * state_size_ ) {
+			CompactLog ( pending.checkpoint_ );
+		}
+		delete ( pending.changes_ );
+
+		pthread_mutex_lock ( &mutex_ );
+		last_checkpoint_ = pending.checkpoint_;
+		pthread_mutex_unlock ( &mutex_ );
+	}
+}
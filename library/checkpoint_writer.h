@@ -0,0 +1,163 @@
+/**
+ * \file library/checkpoint_writer.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_CHECKPOINT_WRITER_H_
+#define WATERSHED_LIBRARY_CHECKPOINT_WRITER_H_
+
+/* C libraries */
+#include <pthread.h>
+#include <stdio.h>
+
+/* C++ libraries */
+#include <deque>
+#include <map>
+#include <string>
+
+/* Project's .h */
+#include "common/constants.h"
+#include "common/exceptions.h"
+#include "library/checkpoint_state.h"
+
+using namespace std;
+
+/**
+ * \class CheckpointWriter
+ * \brief Saves the checkpoints of a processing module instance in a log on the local disk. Write hands the changed keys
+ * over to a background thread and returns, so the instance keeps processing while the checkpoint is written. The
+ * thread keeps a copy of the saved state and appends to the log only the keys whose values have really changed, each
+ * checkpoint being a record that counts only once its trailer is on disk. When the log grows beyond twice the state,
+ * it is replaced by a single record with the whole state.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class CheckpointWriter {
+
+	public:
+
+		/**
+		 * \brief Creates a new CheckpointWriter instance, reading the checkpoints already saved in the log.
+		 * \param file_name The log file name.
+		 * \return Not applicable.
+		 */
+		CheckpointWriter ( string file_name ) throw ( FileOperationException );
+
+		/**
+		 * \brief Destructor. Waits for the pending checkpoints to be written.
+		 * \return Not applicable.
+		 */
+		virtual ~CheckpointWriter ( void );
+
+		/**
+		 * \brief Loads the state saved until a checkpoint, discarding the later ones.
+		 * \param checkpoint The checkpoint identification.
+		 * \param state Where all the keys saved are written.
+		 * \return The identification of the last checkpoint loaded, or -1 if there is none.
+		 */
+		long Load ( long checkpoint, CheckpointState& state ) throw ( FileOperationException );
+
+		/**
+		 * \brief Retrieves the last checkpoint already on disk.
+		 * \return The checkpoint identification, or -1 if there is none.
+		 */
+		long GetLastCheckpoint ( void );
+
+		/**
+		 * \brief Queues a checkpoint to be written. The changes are taken from the state without being copied, and the
+		 * state is left empty.
+		 * \param checkpoint The checkpoint identification, greater than the previous ones.
+		 * \param changes The keys changed since the previous checkpoint.
+		 * \return Not applicable.
+		 */
+		void Write ( long checkpoint, CheckpointState& changes );
+
+	protected:
+
+	private:
+
+		/** \brief A checkpoint waiting to be written. */
+		struct PendingCheckpoint {
+				long checkpoint_;
+				CheckpointState* changes_;
+		};
+
+		/**
+		 * \brief Executes the writer thread.
+		 * \param obj The writer.
+		 * \return A NULL pointer.
+		 */
+		static void* StartWriterThread ( void* obj );
+
+		/**
+		 * \brief Reads the log, applying to the saved state the checkpoints until a given one, and truncates it after
+		 * the last checkpoint applied.
+		 * \param checkpoint The last checkpoint to be applied.
+		 * \return The identification of the last checkpoint applied, or -1 if there is none.
+		 */
+		long ReadLog ( long checkpoint ) throw ( FileOperationException );
+
+		/**
+		 * \brief Appends a checkpoint to the log, with the keys whose values differ from the saved state.
+		 * \param pending The checkpoint.
+		 * \return Not applicable.
+		 */
+		void AppendCheckpoint ( PendingCheckpoint& pending );
+
+		/**
+		 * \brief Replaces the log by a single record with the saved state.
+		 * \param checkpoint The identification of the last checkpoint.
+		 * \return Not applicable.
+		 */
+		void CompactLog ( long checkpoint );
+
+		/**
+		 * \brief Writes the pending checkpoints until the writer is destroyed.
+		 * \return Not applicable.
+		 */
+		void WriteCheckpoints ( void );
+
+		/** \brief Whether the writer thread must stop after writing the pending checkpoints. */
+		bool stop_;
+
+		/** \brief The log. */
+		FILE* file_;
+
+		/** \brief Last checkpoint on disk. */
+		long last_checkpoint_;
+
+		/** \brief Log size in bytes. */
+		long log_size_;
+
+		/** \brief Size in bytes of a record with the saved state. */
+		long state_size_;
+
+		/** \brief Checkpoints waiting to be written. */
+		deque < PendingCheckpoint > pending_checkpoints_;
+
+		/** \brief State saved in the log, by key. */
+		map < string, string > saved_state_;
+
+		/** \brief Mutex controlling the access to the pending checkpoints and to the last checkpoint. */
+		pthread_mutex_t mutex_;
+
+		/** \brief Condition signaled when a checkpoint is queued or the writer is destroyed. */
+		pthread_cond_t condition_;
+
+		/** \brief Writer thread. */
+		pthread_t writer_thread_;
+
+		/** \brief The log file name. */
+		string file_name_;
+
+		/** \brief Copy is not allowed. */
+		CheckpointWriter ( const CheckpointWriter& );
+
+		/** \brief Assignment is not allowed. */
+		CheckpointWriter& operator= ( const CheckpointWriter& );
+};
+
+#endif /* WATERSHED_LIBRARY_CHECKPOINT_WRITER_H_ */
@@ -0,0 +1,53 @@
+/**
+ * \file library/checkpointable.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_CHECKPOINTABLE_H_
+#define WATERSHED_LIBRARY_CHECKPOINTABLE_H_
+
+/* Project's .h */
+#include "library/checkpoint_state.h"
+
+/**
+ * \class Checkpointable
+ * \brief Interface of the processing modules whose state survives the failure of an instance. A module inheriting from
+ * ProcessingModule and Checkpointable is asked to serialize its state whenever a checkpoint barrier has arrived from
+ * all its producers, and to restore it when an instance starts and a checkpoint was saved in the checkpoint directory
+ * of the module.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class Checkpointable {
+
+	public:
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~Checkpointable ( void ) {
+
+		}
+
+		/**
+		 * \brief Restores the state saved by the last checkpoint completed by all the instances.
+		 * \param state All the keys saved.
+		 * \return Not applicable.
+		 */
+		virtual void Restore ( CheckpointState& state ) = 0;
+
+		/**
+		 * \brief Writes the state changed since the previous checkpoint. Keys written again with the same value are not
+		 * saved again, so a module may also write its whole state. The state is saved to disk in background after the
+		 * call returns.
+		 * \param state Where the changed keys are written or removed.
+		 * \return Not applicable.
+		 */
+		virtual void Serialize ( CheckpointState& state ) = 0;
+};
+
+#endif /* WATERSHED_LIBRARY_CHECKPOINTABLE_H_ */
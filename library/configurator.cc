@@ -7,13 +7,29 @@
 /* Project's .h */
 #include "library/configurator.h"
 
+map<string, pair<time_t, string> > ProcessingModuleConfigurator::descriptors_;
+pthread_mutex_t ProcessingModuleConfigurator::descriptors_mutex_ =
+		PTHREAD_MUTEX_INITIALIZER;
+
 ProcessingModuleConfigurator::ProcessingModuleConfigurator(void) {
 	number_termination_messages_ = 0;
+	has_join_ = false;
+	rate_ = 0;
+	minimum_instances_ = 1;
+	maximum_instances_ = 0;
+	batch_size_ = Constants::PROCESSING_MODULE_DEFAULT_BATCH_SIZE;
+	database_peer_identification_ = 0;
 }
 
 ProcessingModuleConfigurator::ProcessingModuleConfigurator(string parse_file)
 		throw (XMLParserException) {
 	number_termination_messages_ = 0;
+	has_join_ = false;
+	rate_ = 0;
+	minimum_instances_ = 1;
+	maximum_instances_ = 0;
+	batch_size_ = Constants::PROCESSING_MODULE_DEFAULT_BATCH_SIZE;
+	database_peer_identification_ = 0;
 	try {
 		processing_module_parser_.Parse(parse_file);
 		FillItems();
@@ -22,6 +38,66 @@ ProcessingModuleConfigurator::ProcessingModuleConfigurator(string parse_file)
 	}
 }
 
+ProcessingModuleConfigurator::ProcessingModuleConfigurator(
+		const char* descriptor, int descriptor_size)
+		throw (XMLParserException) {
+	int offset = 0;
+	batch_size_ = ReadInteger(descriptor, descriptor_size, &offset);
+	has_join_ = ReadInteger(descriptor, descriptor_size, &offset) != 0;
+	int64_t rate = ReadLong(descriptor, descriptor_size, &offset);
+	memcpy(&rate_, &rate, sizeof(rate_));
+	database_peer_identification_ = ReadInteger(descriptor, descriptor_size,
+			&offset);
+	number_instances_ = ReadInteger(descriptor, descriptor_size, &offset);
+	minimum_instances_ = ReadInteger(descriptor, descriptor_size, &offset);
+	maximum_instances_ = ReadInteger(descriptor, descriptor_size, &offset);
+	number_termination_messages_ = ReadInteger(descriptor, descriptor_size,
+			&offset);
+	arguments_ = ReadString(descriptor, descriptor_size, &offset);
+	checkpoint_directory_ = ReadString(descriptor, descriptor_size, &offset);
+	configurator_file_name_ = ReadString(descriptor, descriptor_size, &offset);
+	database_port_name_ = ReadString(descriptor, descriptor_size, &offset);
+	flow_out_ = ReadString(descriptor, descriptor_size, &offset);
+	flow_out_encoding_ = ReadString(descriptor, descriptor_size, &offset);
+	flow_out_structure_ = ReadString(descriptor, descriptor_size, &offset);
+	library_file_ = ReadString(descriptor, descriptor_size, &offset);
+	name_ = ReadString(descriptor, descriptor_size, &offset);
+	port_name_ = ReadString(descriptor, descriptor_size, &offset);
+	query_flow_in_ = ReadString(descriptor, descriptor_size, &offset);
+	running_directory_ = ReadString(descriptor, descriptor_size, &offset);
+	structure_flow_out_ = ReadString(descriptor, descriptor_size, &offset);
+
+	int number_demands = ReadInteger(descriptor, descriptor_size, &offset);
+	for (int i = 0; i < number_demands; ++i) {
+		AddDemand(ReadString(descriptor, descriptor_size, &offset));
+	}
+
+	int number_inputs = ReadInteger(descriptor, descriptor_size, &offset);
+	for (int i = 0; i < number_inputs; ++i) {
+		InputFlow flow_in;
+		flow_in.SetName(ReadString(descriptor, descriptor_size, &offset));
+		flow_in.SetQuery(ReadString(descriptor, descriptor_size, &offset));
+		flow_in.SetPushdown(ReadString(descriptor, descriptor_size, &offset));
+		flow_in.SetPolicy(ReadString(descriptor, descriptor_size, &offset));
+		flow_in.SetPolicyFunctionFile(ReadString(descriptor, descriptor_size,
+				&offset));
+		flow_in.SetOrdered(ReadInteger(descriptor, descriptor_size, &offset)
+				!= 0);
+		flow_in.SetReorderCapacity(ReadInteger(descriptor, descriptor_size,
+				&offset));
+		flow_in.SetReorderLatency(ReadLong(descriptor, descriptor_size,
+				&offset));
+		AddInput(flow_in);
+	}
+
+	if (has_join_) {
+		join_.SetLeft(ReadString(descriptor, descriptor_size, &offset));
+		join_.SetRight(ReadString(descriptor, descriptor_size, &offset));
+		join_.SetWindow(ReadLong(descriptor, descriptor_size, &offset));
+		join_.SetCapacity(ReadInteger(descriptor, descriptor_size, &offset));
+	}
+}
+
 ProcessingModuleConfigurator::~ProcessingModuleConfigurator(void) {
 	demands_.clear();
 }
@@ -34,6 +110,24 @@ void ProcessingModuleConfigurator::AddInput(InputFlow input) {
 	inputs_.push_back(input);
 }
 
+void ProcessingModuleConfigurator::AppendInteger(string* descriptor,
+		int value) {
+	uint32_t network_value = htonl(value);
+	descriptor->append((char*) &network_value, sizeof(network_value));
+}
+
+void ProcessingModuleConfigurator::AppendLong(string* descriptor,
+		int64_t value) {
+	uint64_t network_value = htobe64(value);
+	descriptor->append((char*) &network_value, sizeof(network_value));
+}
+
+void ProcessingModuleConfigurator::AppendString(string* descriptor,
+		const string& value) {
+	AppendInteger(descriptor, value.length());
+	descriptor->append(value);
+}
+
 void ProcessingModuleConfigurator::FillItems(void) throw (XMLParserException) {
 
 	/* Global attributes */
@@ -58,6 +152,54 @@ void ProcessingModuleConfigurator::FillItems(void) throw (XMLParserException) {
 	}
 	SetArguments(processing_module_parser_.GetAttributeByName("arguments"));
 
+	string minimum_instances = processing_module_parser_.GetAttributeByName(
+			"min_instances");
+	if (minimum_instances.compare("") != 0) {
+		if (atoi(minimum_instances.c_str()) < 1) {
+			string msg = "processing module " + GetName()
+					+ " has an invalid minimum number of instances "
+					+ minimum_instances;
+			throw XMLParserException(msg);
+		}
+		SetMinimumInstances(atoi(minimum_instances.c_str()));
+	}
+
+	string maximum_instances = processing_module_parser_.GetAttributeByName(
+			"max_instances");
+	if (maximum_instances.compare("") != 0) {
+		if (atoi(maximum_instances.c_str()) < GetMinimumInstances()) {
+			string msg = "processing module " + GetName()
+					+ " has an invalid maximum number of instances "
+					+ maximum_instances;
+			throw XMLParserException(msg);
+		}
+		SetMaximumInstances(atoi(maximum_instances.c_str()));
+	}
+
+	string batch_size = processing_module_parser_.GetAttributeByName(
+			"batch_size");
+	if (batch_size.compare("") != 0) {
+		if (atoi(batch_size.c_str()) < 1) {
+			string msg = "processing module " + GetName()
+					+ " has an invalid batch size " + batch_size;
+			throw XMLParserException(msg);
+		}
+		SetBatchSize(atoi(batch_size.c_str()));
+	}
+
+	string rate = processing_module_parser_.GetAttributeByName("rate");
+	if (rate.compare("") != 0) {
+		if (atof(rate.c_str()) < 0) {
+			string msg = "processing module " + GetName()
+					+ " has an invalid rate " + rate;
+			throw XMLParserException(msg);
+		}
+		SetRate(atof(rate.c_str()));
+	}
+
+	SetCheckpointDirectory(processing_module_parser_.GetAttributeByName(
+			"checkpoint_dir"));
+
 	/* Inputs attributes */
 	if (processing_module_parser_.DefineCurrentElementByName(0, "inputs") != 0) {
 		int num_inputs = 0;
@@ -70,6 +212,8 @@ void ProcessingModuleConfigurator::FillItems(void) throw (XMLParserException) {
 					processing_module_parser_.GetAttributeByName("name"));
 			flow_in.SetQuery(processing_module_parser_.GetAttributeByName(
 					"query"));
+			flow_in.SetPushdown(processing_module_parser_.GetAttributeByName(
+					"pushdown"));
 			flow_in.SetPolicy(processing_module_parser_.GetAttributeByName(
 					"policy"));
 			flow_in.SetPolicyFunctionFile(
@@ -87,20 +231,77 @@ void ProcessingModuleConfigurator::FillItems(void) throw (XMLParserException) {
 				throw XMLParserException(msg);
 			}
 
+			flow_in.SetOrdered(processing_module_parser_.GetAttributeByName(
+					"ordered").compare("true") == 0);
+			string reorder_capacity =
+					processing_module_parser_.GetAttributeByName(
+							"reorder_capacity");
+			if (reorder_capacity.compare("") != 0) {
+				if (atoi(reorder_capacity.c_str()) < 1) {
+					string msg = "processing module " + GetName()
+							+ " has an invalid reorder capacity "
+							+ reorder_capacity + " for the input "
+							+ flow_in.GetName();
+					throw XMLParserException(msg);
+				}
+				flow_in.SetReorderCapacity(atoi(reorder_capacity.c_str()));
+			}
+			string reorder_latency =
+					processing_module_parser_.GetAttributeByName(
+							"reorder_latency");
+			if (reorder_latency.compare("") != 0) {
+				if (atol(reorder_latency.c_str()) < 0) {
+					string msg = "processing module " + GetName()
+							+ " has an invalid reorder latency "
+							+ reorder_latency + " for the input "
+							+ flow_in.GetName();
+					throw XMLParserException(msg);
+				}
+				flow_in.SetReorderLatency(atol(reorder_latency.c_str()));
+			}
+
 			AddInput(flow_in);
 			++ni;
 		}
 	}
 	processing_module_parser_.CleanChildren();
 
+	/* Join attributes */
+	if (processing_module_parser_.DefineCurrentElementByName(0, "join") != 0) {
+		has_join_ = true;
+		join_.SetLeft(processing_module_parser_.GetAttributeByName("left"));
+		join_.SetRight(processing_module_parser_.GetAttributeByName("right"));
+		join_.SetWindow(atol(
+				processing_module_parser_.GetAttributeByName("window").c_str()));
+		string capacity = processing_module_parser_.GetAttributeByName(
+				"capacity");
+		if (capacity.compare("") != 0) {
+			join_.SetCapacity(atoi(capacity.c_str()));
+		}
+		ValidateJoin();
+	}
+
 	/* Output attributes */
 	if (processing_module_parser_.DefineCurrentElementByName(0, "output") != 0) {
 		SetFlowOut(processing_module_parser_.GetAttributeByName("name"));
 		SetFlowOutStructure(processing_module_parser_.GetAttributeByName(
 				"structure"));
+		string encoding = processing_module_parser_.GetAttributeByName(
+				"encoding");
+		SetFlowOutEncoding(encoding.empty() ? Constants::ENCODING_XML
+				: encoding);
+		if (GetFlowOutEncoding().compare(Constants::ENCODING_BINARY) == 0
+				&& (GetFlowOutStructure().empty()
+						|| GetFlowOutStructure().compare(
+								Constants::EMPTY_ATTRIBUTE) == 0)) {
+			string msg = "processing module " + GetName()
+					+ " has to specify the structure of a binary output";
+			throw XMLParserException(msg);
+		}
 	} else {
 		SetFlowOut(Constants::EMPTY_ATTRIBUTE);
 		SetFlowOutStructure(Constants::EMPTY_ATTRIBUTE);
+		SetFlowOutEncoding(Constants::ENCODING_XML);
 	}
 
 	/* Demands attributes */
@@ -121,6 +322,14 @@ string ProcessingModuleConfigurator::GetArguments(void) {
 	return arguments_;
 }
 
+int ProcessingModuleConfigurator::GetBatchSize(void) {
+	return batch_size_;
+}
+
+string ProcessingModuleConfigurator::GetCheckpointDirectory(void) {
+	return checkpoint_directory_;
+}
+
 string ProcessingModuleConfigurator::GetConfiguratorFileName(void) {
 	return configurator_file_name_;
 }
@@ -141,10 +350,21 @@ vector<InputFlow>* ProcessingModuleConfigurator::GetInputs(void) {
 	return &inputs_;
 }
 
+JoinFlow* ProcessingModuleConfigurator::GetJoin(void) {
+	if (has_join_) {
+		return &join_;
+	}
+	return NULL;
+}
+
 string ProcessingModuleConfigurator::GetFlowOut(void) {
 	return flow_out_;
 }
 
+string ProcessingModuleConfigurator::GetFlowOutEncoding(void) {
+	return flow_out_encoding_;
+}
+
 string ProcessingModuleConfigurator::GetFlowOutStructure(void) {
 	return flow_out_structure_;
 }
@@ -153,6 +373,14 @@ string ProcessingModuleConfigurator::GetLibraryFile(void) {
 	return library_file_;
 }
 
+int ProcessingModuleConfigurator::GetMaximumInstances(void) {
+	return maximum_instances_;
+}
+
+int ProcessingModuleConfigurator::GetMinimumInstances(void) {
+	return minimum_instances_;
+}
+
 string ProcessingModuleConfigurator::GetName(void) {
 	return name_;
 }
@@ -161,6 +389,47 @@ int ProcessingModuleConfigurator::GetNumberInstances(void) {
 	return number_instances_;
 }
 
+bool ProcessingModuleConfigurator::HasLabeledInput(void) {
+	for (uint i = 0; i < inputs_.size(); ++i) {
+		if (inputs_[i].GetPolicy().compare(Constants::POLICY_LABELED) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+ProcessingModuleConfigurator* ProcessingModuleConfigurator::Load(
+		string parse_file) throw (XMLParserException) {
+	struct stat file_status;
+	if (stat(parse_file.c_str(), &file_status) != 0) {
+		string msg = "cannot read the processing module file " + parse_file;
+		throw XMLParserException(msg);
+	}
+
+	/* The file is parsed again when it is modified, since the cache is keyed by its modification time too. */
+	string descriptor;
+	pthread_mutex_lock(&descriptors_mutex_);
+	map<string, pair<time_t, string> >::iterator it = descriptors_.find(
+			parse_file);
+	if (it != descriptors_.end() && it->second.first == file_status.st_mtime) {
+		descriptor = it->second.second;
+	}
+	pthread_mutex_unlock(&descriptors_mutex_);
+
+	if (descriptor.empty()) {
+		ProcessingModuleConfigurator* configurator =
+				new ProcessingModuleConfigurator(parse_file);
+		configurator->SetConfiguratorFileName(parse_file);
+		pthread_mutex_lock(&descriptors_mutex_);
+		descriptors_[parse_file] = make_pair(file_status.st_mtime,
+				configurator->Serialize());
+		pthread_mutex_unlock(&descriptors_mutex_);
+		return configurator;
+	}
+	return new ProcessingModuleConfigurator(descriptor.data(),
+			descriptor.length());
+}
+
 int ProcessingModuleConfigurator::GetNumberTerminationMessages(void) {
 	return number_termination_messages_;
 }
@@ -176,16 +445,35 @@ void ProcessingModuleConfigurator::Print(void) {
 	cout << "Name      : " << GetName() << endl;
 	cout << "Library   : " << GetLibraryFile() << endl;
 	cout << "Instances : " << GetNumberInstances() << endl;
+	if (GetMaximumInstances() > 0) {
+		cout << "Autoscaled: " << GetMinimumInstances() << " to "
+				<< GetMaximumInstances() << " instances" << endl;
+	}
 	cout << "Arguments : " << GetArguments() << endl;
+	cout << "Batch size: " << GetBatchSize() << endl;
+	cout << "Rate      : " << GetRate() << endl;
+	cout << "Checkpoint: " << GetCheckpointDirectory() << endl;
 	cout << "Inputs    : " << endl;
 	for (uint i = 0; i < inputs_.size(); ++i) {
 		cout << "\tName: " << inputs_[i].GetName() << endl << "\tQuery: "
-				<< inputs_[i].GetQuery() << endl << "\tPolicy: "
+				<< inputs_[i].GetQuery() << endl << "\tPushdown: "
+				<< inputs_[i].GetPushdown() << endl << "\tPolicy: "
 				<< inputs_[i].GetPolicy() << endl << "\tFunction File: "
-				<< inputs_[i].GetPolicyFunctionFile() << endl << endl;
+				<< inputs_[i].GetPolicyFunctionFile() << endl;
+		if (inputs_[i].IsOrdered()) {
+			cout << "\tOrdered: " << inputs_[i].GetReorderCapacity()
+					<< " messages, " << inputs_[i].GetReorderLatency()
+					<< " ms" << endl;
+		}
+		cout << endl;
+	}
+	if (has_join_) {
+		cout << "Join      : " << join_.GetLeft() << " x " << join_.GetRight()
+				<< " (window " << join_.GetWindow() << ")" << endl;
 	}
 	cout << "Output    : " << GetFlowOut() << endl;
 	cout << "Out DTD   : " << GetFlowOutStructure() << endl;
+	cout << "Encoding  : " << GetFlowOutEncoding() << endl;
 	cout << "Demands   : " << endl;
 	for (uint i = 0; i < demands_.size(); ++i) {
 		cout << "\tName: " << demands_[i] << endl;
@@ -195,6 +483,10 @@ void ProcessingModuleConfigurator::Print(void) {
 			<< endl;
 }
 
+double ProcessingModuleConfigurator::GetRate(void) {
+	return rate_;
+}
+
 string ProcessingModuleConfigurator::GetQueryFlowIn(void) {
 	return query_flow_in_;
 }
@@ -207,10 +499,107 @@ string ProcessingModuleConfigurator::GetStructureFlowOut(void) {
 	return structure_flow_out_;
 }
 
+int ProcessingModuleConfigurator::ReadInteger(const char* descriptor,
+		int descriptor_size, int* offset) throw (XMLParserException) {
+	uint32_t network_value;
+	if (*offset + (int) sizeof(network_value) > descriptor_size) {
+		string msg = "truncated processing module descriptor";
+		throw XMLParserException(msg);
+	}
+	memcpy(&network_value, descriptor + *offset, sizeof(network_value));
+	*offset += sizeof(network_value);
+	return (int) ntohl(network_value);
+}
+
+int64_t ProcessingModuleConfigurator::ReadLong(const char* descriptor,
+		int descriptor_size, int* offset) throw (XMLParserException) {
+	uint64_t network_value;
+	if (*offset + (int) sizeof(network_value) > descriptor_size) {
+		string msg = "truncated processing module descriptor";
+		throw XMLParserException(msg);
+	}
+	memcpy(&network_value, descriptor + *offset, sizeof(network_value));
+	*offset += sizeof(network_value);
+	return (int64_t) be64toh(network_value);
+}
+
+string ProcessingModuleConfigurator::ReadString(const char* descriptor,
+		int descriptor_size, int* offset) throw (XMLParserException) {
+	int length = ReadInteger(descriptor, descriptor_size, offset);
+	if (length < 0 || *offset + length > descriptor_size) {
+		string msg = "truncated processing module descriptor";
+		throw XMLParserException(msg);
+	}
+	string value(descriptor + *offset, length);
+	*offset += length;
+	return value;
+}
+
+string ProcessingModuleConfigurator::Serialize(void) {
+	string descriptor;
+	int64_t rate;
+	memcpy(&rate, &rate_, sizeof(rate));
+	AppendInteger(&descriptor, batch_size_);
+	AppendInteger(&descriptor, has_join_);
+	AppendLong(&descriptor, rate);
+	AppendInteger(&descriptor, database_peer_identification_);
+	AppendInteger(&descriptor, number_instances_);
+	AppendInteger(&descriptor, minimum_instances_);
+	AppendInteger(&descriptor, maximum_instances_);
+	AppendInteger(&descriptor, number_termination_messages_);
+	AppendString(&descriptor, arguments_);
+	AppendString(&descriptor, checkpoint_directory_);
+	AppendString(&descriptor, configurator_file_name_);
+	AppendString(&descriptor, database_port_name_);
+	AppendString(&descriptor, flow_out_);
+	AppendString(&descriptor, flow_out_encoding_);
+	AppendString(&descriptor, flow_out_structure_);
+	AppendString(&descriptor, library_file_);
+	AppendString(&descriptor, name_);
+	AppendString(&descriptor, port_name_);
+	AppendString(&descriptor, query_flow_in_);
+	AppendString(&descriptor, running_directory_);
+	AppendString(&descriptor, structure_flow_out_);
+
+	AppendInteger(&descriptor, demands_.size());
+	for (uint i = 0; i < demands_.size(); ++i) {
+		AppendString(&descriptor, demands_[i]);
+	}
+
+	AppendInteger(&descriptor, inputs_.size());
+	for (uint i = 0; i < inputs_.size(); ++i) {
+		AppendString(&descriptor, inputs_[i].GetName());
+		AppendString(&descriptor, inputs_[i].GetQuery());
+		AppendString(&descriptor, inputs_[i].GetPushdown());
+		AppendString(&descriptor, inputs_[i].GetPolicy());
+		AppendString(&descriptor, inputs_[i].GetPolicyFunctionFile());
+		AppendInteger(&descriptor, inputs_[i].IsOrdered());
+		AppendInteger(&descriptor, inputs_[i].GetReorderCapacity());
+		AppendLong(&descriptor, inputs_[i].GetReorderLatency());
+	}
+
+	if (has_join_) {
+		AppendString(&descriptor, join_.GetLeft());
+		AppendString(&descriptor, join_.GetRight());
+		AppendLong(&descriptor, join_.GetWindow());
+		AppendInteger(&descriptor, join_.GetCapacity());
+	}
+	return descriptor;
+}
+
 void ProcessingModuleConfigurator::SetArguments(string arguments) {
 	arguments_ = arguments;
 }
 
+void ProcessingModuleConfigurator::SetBatchSize(int batch_size) {
+	batch_size_ = batch_size;
+}
+
+void ProcessingModuleConfigurator::SetCheckpointDirectory(
+		string checkpoint_directory) {
+	checkpoint_directory_ = checkpoint_directory;
+}
+
 void ProcessingModuleConfigurator::SetConfiguratorFileName(
 		string configurator_file_name) {
 	configurator_file_name_ = configurator_file_name;
@@ -230,6 +619,10 @@ void ProcessingModuleConfigurator::SetFlowOut(string flow_out) {
 	flow_out_ = flow_out;
 }
 
+void ProcessingModuleConfigurator::SetFlowOutEncoding(string flow_out_encoding) {
+	flow_out_encoding_ = flow_out_encoding;
+}
+
 void ProcessingModuleConfigurator::SetFlowOutStructure(
 		string flow_out_structure) {
 	flow_out_structure_ = flow_out_structure;
@@ -239,6 +632,14 @@ void ProcessingModuleConfigurator::SetLibraryFile(string library_file) {
 	library_file_ = library_file;
 }
 
+void ProcessingModuleConfigurator::SetMaximumInstances(int maximum_instances) {
+	maximum_instances_ = maximum_instances;
+}
+
+void ProcessingModuleConfigurator::SetMinimumInstances(int minimum_instances) {
+	minimum_instances_ = minimum_instances;
+}
+
 void ProcessingModuleConfigurator::SetName(string name) {
 	name_ = name;
 }
@@ -252,6 +653,46 @@ void ProcessingModuleConfigurator::SetNumberTerminationMessages(
 	number_termination_messages_ = number_termination_messages;
 }
 
+void ProcessingModuleConfigurator::SetRate(double rate) {
+	rate_ = rate;
+}
+
 void ProcessingModuleConfigurator::SetPortName(string port_name) {
 	port_name_ = port_name;
 }
+
+void ProcessingModuleConfigurator::ValidateJoin(void)
+		throw (XMLParserException) {
+	InputFlow* left = NULL;
+	InputFlow* right = NULL;
+	for (uint i = 0; i < inputs_.size(); ++i) {
+		if (inputs_[i].GetName().compare(join_.GetLeft()) == 0) {
+			left = &inputs_[i];
+		}
+		if (inputs_[i].GetName().compare(join_.GetRight()) == 0) {
+			right = &inputs_[i];
+		}
+	}
+
+	if (left == NULL || right == NULL || left == right) {
+		string msg = "processing module " + GetName()
+				+ " has to join two different inputs";
+		throw XMLParserException(msg);
+	}
+	if (join_.GetWindow() <= 0) {
+		string msg = "processing module " + GetName()
+				+ " has to specify a positive join window";
+		throw XMLParserException(msg);
+	}
+
+	/* Matching tuples only meet at the same instance when both inputs are partitioned by the same label function. */
+	if (left->GetPolicy().compare(Constants::POLICY_LABELED) != 0
+			|| right->GetPolicy().compare(Constants::POLICY_LABELED) != 0
+			|| left->GetPolicyFunctionFile().compare(
+					right->GetPolicyFunctionFile()) != 0) {
+		string msg = "processing module " + GetName() + " has to join "
+				+ left->GetName() + " and " + right->GetName()
+				+ " as labeled inputs with the same policy function file";
+		throw XMLParserException(msg);
+	}
+}
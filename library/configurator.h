@@ -13,9 +13,13 @@
 #include <common/util.h>
 #include <common/xml_parser.h>
 #include <library/input_flow.h>
+#include <library/join_flow.h>
 
 /* Other libraries */
+#include <endian.h>
+#include <pthread.h>
 #include <sys/prctl.h>
+#include <sys/stat.h>
 
 using namespace std;
 
@@ -44,18 +48,51 @@ class ProcessingModuleConfigurator {
 		 */
 		ProcessingModuleConfigurator ( string parse_file ) throw ( XMLParserException );
 
+		/**
+		 * \brief Constructor. Creates a new ProcessingModuleConfigurator instance from a descriptor built by Serialize,
+		 * without parsing the XML file again.
+		 * \param descriptor The descriptor.
+		 * \param descriptor_size Number of bytes of the descriptor.
+		 * \return Not applicable.
+		 */
+		ProcessingModuleConfigurator ( const char* descriptor, int descriptor_size ) throw ( XMLParserException );
+
 		/**
 		 * \brief Destructor.
 		 * \return Not applicable.
 		 */
 		virtual ~ProcessingModuleConfigurator ( void );
 
+		/**
+		 * \brief Retrieves the maximum number of messages delivered in a single ProcessBatch call.
+		 * \return The batch size.
+		 */
+		int GetBatchSize ( void );
+
+		/**
+		 * \brief Retrieves the rate at which a processing module without inputs generates records.
+		 * \return The number of records per second, 0 when limited only by the consumers' credits.
+		 */
+		double GetRate ( void );
+
 		/**
 		 * \brief Retrieves the database daemon identification.
 		 * \return The database daemon identification.
 		 */
 		int GetDatabasePeerIdentification ( void );
 
+		/**
+		 * \brief Retrieves the maximum number of instances the autoscaler may run.
+		 * \return The maximum number of instances, 0 when the processing module is not autoscaled.
+		 */
+		int GetMaximumInstances ( void );
+
+		/**
+		 * \brief Retrieves the minimum number of instances the autoscaler keeps running.
+		 * \return The minimum number of instances.
+		 */
+		int GetMinimumInstances ( void );
+
 		/**
 		 * \brief Retrieves the number of instances of a processing module.
 		 * \return The number of instances of a processing module.
@@ -74,6 +111,12 @@ class ProcessingModuleConfigurator {
 		 */
 		string GetArguments ( void );
 
+		/**
+		 * \brief Retrieves the directory where the instances save their checkpoints.
+		 * \return The directory, empty when the module state is not saved.
+		 */
+		string GetCheckpointDirectory ( void );
+
 		/**
 		 * \brief Returns the name of the configurator file.
 		 * \return The configurator file name.
@@ -92,6 +135,12 @@ class ProcessingModuleConfigurator {
 		 */
 		string GetFlowOut ( void );
 
+		/**
+		 * \brief Retrieves how the records of the output flow are encoded.
+		 * \return The encoding, xml or binary.
+		 */
+		string GetFlowOutEncoding ( void );
+
 		/**
 		 * \brief Retrieves the structure of an output flow.
 		 * \return The structure of an output flow.
@@ -134,6 +183,12 @@ class ProcessingModuleConfigurator {
 		 */
 		string GetStructureFlowOut ( void );
 
+		/**
+		 * \brief Retrieves the join between two input streams.
+		 * \return The join description or NULL if the processing module does not define one.
+		 */
+		JoinFlow* GetJoin ( void );
+
 		/**
 		 * \brief Retrieves the processing module's demands.
 		 * \return A list of demands.
@@ -146,6 +201,12 @@ class ProcessingModuleConfigurator {
 		 */
 		vector < InputFlow >* GetInputs ( void );
 
+		/**
+		 * \brief Checks whether an input of the processing module is partitioned by a label function.
+		 * \return True if an input uses the labeled policy.
+		 */
+		bool HasLabeledInput ( void );
+
 		/**
 		 * \brief Adds a demand to a processing module configurator.
 		 * \param demand Demand's name.
@@ -160,12 +221,27 @@ class ProcessingModuleConfigurator {
 		 */
 		void AddInput ( InputFlow input );
 
+		/**
+		 * \brief Creates a configurator from a XML file, which is parsed only the first time it is loaded by this
+		 * process or after it is modified. The other times the configurator is rebuilt from the cached descriptor.
+		 * \param parse_file ProcessingModule descriptor XML file name.
+		 * \return A new configurator, owned by the caller, with the configurator file name set.
+		 */
+		static ProcessingModuleConfigurator* Load ( string parse_file ) throw ( XMLParserException );
+
 		/**
 		 * \brief Prints all the information about the configurator.
 		 * \return Not applicable.
 		 */
 		void Print ( void );
 
+		/**
+		 * \brief Builds a compact binary descriptor of the configurator, sent in place of the XML file name so the
+		 * receivers do not parse the file.
+		 * \return The descriptor.
+		 */
+		string Serialize ( void );
+
 		/**
 		 * \brief Set the processing module arguments.
 		 * \param arguments List of processing module arguments.
@@ -173,6 +249,20 @@ class ProcessingModuleConfigurator {
 		 */
 		void SetArguments ( string arguments );
 
+		/**
+		 * \brief Sets the maximum number of messages delivered in a single ProcessBatch call.
+		 * \param batch_size The batch size.
+		 * \return Not applicable.
+		 */
+		void SetBatchSize ( int batch_size );
+
+		/**
+		 * \brief Sets the directory where the instances save their checkpoints.
+		 * \param checkpoint_directory A directory on the local disk of each host.
+		 * \return Not applicable.
+		 */
+		void SetCheckpointDirectory ( string checkpoint_directory );
+
 		/**
 		 * \brief Sets the configurator file name.
 		 * \param configurator_file_name The configurator file name.
@@ -200,6 +290,13 @@ class ProcessingModuleConfigurator {
 		 */
 		void SetFlowOut ( string flow_out );
 
+		/**
+		 * \brief Sets how the records of the output flow are encoded.
+		 * \param flow_out_encoding The encoding, xml or binary.
+		 * \return Not applicable.
+		 */
+		void SetFlowOutEncoding ( string flow_out_encoding );
+
 		/**
 		 * \brief Sets the structure of an output flow.
 		 * \param flow_out_structure Structure of an output flow.
@@ -221,6 +318,20 @@ class ProcessingModuleConfigurator {
 		 */
 		void SetName ( string name );
 
+		/**
+		 * \brief Sets the maximum number of instances the autoscaler may run.
+		 * \param maximum_instances The maximum number of instances, 0 when the processing module is not autoscaled.
+		 * \return Not applicable.
+		 */
+		void SetMaximumInstances ( int maximum_instances );
+
+		/**
+		 * \brief Sets the minimum number of instances the autoscaler keeps running.
+		 * \param minimum_instances The minimum number of instances.
+		 * \return Not applicable.
+		 */
+		void SetMinimumInstances ( int minimum_instances );
+
 		/**
 		 * \brief Sets the number of instances of a processing module.
 		 * \param number_instances Number of instances.
@@ -235,6 +346,13 @@ class ProcessingModuleConfigurator {
 		 */
 		void SetNumberTerminationMessages ( int number_termination_messages );
 
+		/**
+		 * \brief Sets the rate at which a processing module without inputs generates records.
+		 * \param rate The number of records per second, 0 when limited only by the consumers' credits.
+		 * \return Not applicable.
+		 */
+		void SetRate ( double rate );
+
 		/**
 		 * \brief Set the processing module port name.
 		 * \param port_name Name of the opened port.
@@ -252,18 +370,93 @@ class ProcessingModuleConfigurator {
 		 */
 		void FillItems ( void ) throw ( XMLParserException );
 
+		/**
+		 * \brief Appends a 32 bits integer to a descriptor, in network byte order.
+		 * \param descriptor The descriptor.
+		 * \param value The integer.
+		 * \return Not applicable.
+		 */
+		static void AppendInteger ( string* descriptor, int value );
+
+		/**
+		 * \brief Appends a 64 bits integer to a descriptor, in network byte order.
+		 * \param descriptor The descriptor.
+		 * \param value The integer.
+		 * \return Not applicable.
+		 */
+		static void AppendLong ( string* descriptor, int64_t value );
+
+		/**
+		 * \brief Appends a string to a descriptor, preceded by its length.
+		 * \param descriptor The descriptor.
+		 * \param value The string.
+		 * \return Not applicable.
+		 */
+		static void AppendString ( string* descriptor, const string& value );
+
+		/**
+		 * \brief Reads a 32 bits integer from a descriptor.
+		 * \param descriptor The descriptor.
+		 * \param descriptor_size Number of bytes of the descriptor.
+		 * \param offset Position of the integer, advanced past it.
+		 * \return The integer.
+		 */
+		static int ReadInteger ( const char* descriptor, int descriptor_size, int* offset ) throw ( XMLParserException );
+
+		/**
+		 * \brief Reads a 64 bits integer from a descriptor.
+		 * \param descriptor The descriptor.
+		 * \param descriptor_size Number of bytes of the descriptor.
+		 * \param offset Position of the integer, advanced past it.
+		 * \return The integer.
+		 */
+		static int64_t ReadLong ( const char* descriptor, int descriptor_size, int* offset ) throw ( XMLParserException );
+
+		/**
+		 * \brief Reads a string from a descriptor.
+		 * \param descriptor The descriptor.
+		 * \param descriptor_size Number of bytes of the descriptor.
+		 * \param offset Position of the string length, advanced past the string.
+		 * \return The string.
+		 */
+		static string ReadString ( const char* descriptor, int descriptor_size, int* offset ) throw ( XMLParserException );
+
+		/**
+		 * \brief Checks if the join inputs are labeled streams partitioned by the same function.
+		 * \return Not applicable.
+		 */
+		void ValidateJoin ( void ) throw ( XMLParserException );
+
+		/** \brief Maximum number of messages delivered in a single ProcessBatch call. */
+		int batch_size_;
+
+		/** \brief Flag indicating whether the processing module joins two input streams. */
+		bool has_join_;
+
+		/** \brief Number of records per second generated by a source. */
+		double rate_;
+
 		/** \brief Database with which the processing module will communicate. */
 		int database_peer_identification_;
 
 		/** \brief Number of instances. */
 		int number_instances_;
 
+		/** \brief Minimum number of instances kept by the autoscaler. */
+		int minimum_instances_;
+
+		/** \brief Maximum number of instances run by the autoscaler, 0 when not autoscaled. */
+		int maximum_instances_;
+
 		/** \brief Number of a batch processing module termination messages. */
 		int number_termination_messages_;
 
 		/** \brief Processing module's arguments. */
 		string arguments_;
 
+		/** \brief Directory of the checkpoint logs. */
+		string checkpoint_directory_;
+
 		/** \brief The configurator file name. */
 		string configurator_file_name_;
 
@@ -273,6 +466,9 @@ class ProcessingModuleConfigurator {
 		/** \brief Description of an output flow. */
 		string flow_out_;
 
+		/** \brief Encoding of the output flow records. */
+		string flow_out_encoding_;
+
 		/** \brief Structure of an output flow. */
 		string flow_out_structure_;
 
@@ -297,11 +493,20 @@ class ProcessingModuleConfigurator {
 		/** \brief Processing module's demands. */
 		vector < string > demands_;
 
+		/** \brief Description of the join between two input flows. */
+		JoinFlow join_;
+
 		/** \brief Description of the input flows. */
 		vector < InputFlow > inputs_;
 
 		/**  \brief XML parser. */
 		XMLParser processing_module_parser_;
+
+		/** \brief Descriptors of the files loaded by this process, with the modification time of each file. */
+		static map < string, pair < time_t, string > > descriptors_;
+
+		/** \brief A mutex to control the access to the descriptors. */
+		static pthread_mutex_t descriptors_mutex_;
 };
 
 #endif /* WATERSHED_LIBRARY_CONFIGURATOR_H_ */
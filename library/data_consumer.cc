@@ -12,24 +12,30 @@ pthread_mutex_t DataConsumer::class_mutex_;
 
 DataConsumer::DataConsumer ( void ) throw (FileOperationException) {
 	try {
-		DataConsumer ( Constants::EMPTY_ATTRIBUTE, Constants::EMPTY_ATTRIBUTE, Constants::POLICY_ROUND_ROBIN, Constants::EMPTY_ATTRIBUTE );
+		DataConsumer ( Constants::EMPTY_ATTRIBUTE, Constants::EMPTY_ATTRIBUTE, Constants::POLICY_ROUND_ROBIN, Constants::EMPTY_ATTRIBUTE, Constants::PUSHDOWN_NONE );
 	}
 	catch (FileOperationException& e) {
 		throw e;
 	}
 }
 
-DataConsumer::DataConsumer ( string policy_function_file_name, string processing_module_name, string receive_policy, string query_flow_in ) throw (FileOperationException) {
+DataConsumer::DataConsumer ( string policy_function_file_name, string processing_module_name, string receive_policy, string query_flow_in, string pushdown ) throw (FileOperationException) {
 	try {
 		++number_of_class_instances_;
 		if (number_of_class_instances_ == 1) {
 			pthread_mutex_init ( &class_mutex_, NULL );
 		}
 		instance_to_receive_ = 0;
+		number_records_evaluated_ = 0;
+		number_records_matched_ = 0;
+		metrics_stream_ = -1;
+		schema_ = NULL;
+		record_query_ = NULL;
 		SetProcessingModuleName ( processing_module_name );
 		SetPolicy ( receive_policy );
 		OpenLibrary ( policy_function_file_name );
 		SetQueryFlowIn ( query_flow_in );
+		SetPushdown ( pushdown );
 	}
 	catch (FileOperationException& e) {
 		throw e;
@@ -47,6 +53,58 @@ DataConsumer::~DataConsumer ( void ) {
 	}
 	credits_.clear ( );
 	delete (communicator_);
+	delete (record_query_);
+}
+
+Message* DataConsumer::ApplyQuery ( Message& message ) throw (BadParameterException) {
+	if (!HasQuery ( )) {
+		return &message;
+	}
+
+	++number_records_evaluated_;
+	string result;
+	if (schema_ != NULL) {
+		if (record_query_ == NULL) {
+			record_query_ = new RecordQuery ( schema_, query_flow_in_ );
+		}
+		RecordView record ( schema_, message );
+		if (record_query_->IsCompiled ( )) {
+			result = record_query_->Execute ( record );
+		}
+		else if (record.IsValid ( )) {
+			result = query_.ExecuteQuery ( record.ToXML ( ), query_flow_in_ );
+		}
+	}
+	else {
+		/* Producers usually send strings with their terminating character */
+		string record ( (char*) message.GetData ( ), message.GetDataSize ( ) );
+		string::size_type end = record.find_last_not_of ( '\0' );
+		record.erase ( (end == string::npos) ? 0 : end + 1 );
+		result = query_.ExecuteQuery ( record, query_flow_in_ );
+	}
+	if (result.empty ( )) {
+		return NULL;
+	}
+	++number_records_matched_;
+
+	if (pushdown_.compare ( Constants::PUSHDOWN_PROJECT ) != 0) {
+		return &message;
+	}
+	/* XQuery results end with the separator appended to each item */
+	if (!result.empty ( ) && result[result.length ( ) - 1] == ' ') {
+		result.erase ( result.length ( ) - 1 );
+	}
+	int size = result.length ( ) + 1;
+	if (size > Constants::MAX_DATA_SIZE) {
+		throw BadParameterException ( "the projection of " + query_flow_in_ + " has " + Util::IntegerToString ( size ) + " bytes, more than a message holds" );
+	}
+	projected_message_.SetData ( (void*) result.c_str ( ), size );
+	projected_message_.SetOperationCode ( message.GetOperationCode ( ) );
+	projected_message_.SetSequenceNumber ( message.GetSequenceNumber ( ) );
+	projected_message_.SetSourceStream ( message.GetSourceStream ( ) );
+	projected_message_.SetTimestamp ( message.GetTimestamp ( ) );
+	projected_message_.SetOriginTime ( message.GetOriginTime ( ) );
+	return &projected_message_;
 }
 
 MpiCommunicator* DataConsumer::GetCommunicator ( void ) {
@@ -78,6 +136,18 @@ int DataConsumer::GetNumberInstances ( void ) {
 	return communicator_->GetNumberProcesses ( );
 }
 
+long DataConsumer::GetNumberRecordsEvaluated ( void ) {
+	return number_records_evaluated_;
+}
+
+int DataConsumer::GetMetricsStream ( void ) {
+	return metrics_stream_;
+}
+
+long DataConsumer::GetNumberRecordsMatched ( void ) {
+	return number_records_matched_;
+}
+
 string DataConsumer::GetPolicy ( void ) {
 	return policy_;
 }
@@ -90,10 +160,18 @@ void* DataConsumer::GetPolicyLib ( void ) {
 	return policy_lib_;
 }
 
+string DataConsumer::GetPushdown ( void ) {
+	return pushdown_;
+}
+
 string DataConsumer::GetQueryFlowIn ( void ) {
 	return query_flow_in_;
 }
 
+bool DataConsumer::HasQuery ( void ) {
+	return !query_flow_in_.empty ( ) && query_flow_in_.compare ( Constants::EMPTY_ATTRIBUTE ) != 0 && pushdown_.compare ( Constants::PUSHDOWN_NONE ) != 0;
+}
+
 void DataConsumer::Lock ( void ) {
 	pthread_mutex_lock ( &class_mutex_ );
 }
@@ -137,6 +215,10 @@ void DataConsumer::SetCredit ( int rank, int new_credit ) {
 	credits_[rank] = new_credit;
 }
 
+void DataConsumer::SetMetricsStream ( int metrics_stream ) {
+	metrics_stream_ = metrics_stream;
+}
+
 void DataConsumer::SetNextToReceive ( int next_to_receive ) {
 	instance_to_receive_ = next_to_receive;
 }
@@ -157,10 +239,20 @@ void DataConsumer::SetProcessingModuleName ( string processing_module_name ) {
 	name_ = processing_module_name;
 }
 
+void DataConsumer::SetPushdown ( string pushdown ) {
+	pushdown_ = pushdown;
+}
+
 void DataConsumer::SetQueryFlowIn ( string query_flow_in ) {
 	query_flow_in_ = query_flow_in;
 }
 
+void DataConsumer::SetSchema ( RecordSchema* schema ) {
+	schema_ = schema;
+	delete (record_query_);
+	record_query_ = NULL;
+}
+
 void DataConsumer::Unlock ( void ) {
 	pthread_mutex_unlock ( &class_mutex_ );
 }
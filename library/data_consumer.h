@@ -12,7 +12,10 @@
 
 /* Project libraries */
 #include "comm/mpi/mpi_communicator.h"
+#include "common/util.h"
+#include "common/xml_query.h"
 #include "library/label_function.h"
+#include "library/record_query.h"
 
 using namespace std;
 
@@ -40,9 +43,10 @@ class DataConsumer {
 		 * \param processing_module_name Name of the processing module.
 		 * \param receive_policy Processing module policy to receive messages.
 		 * \param query_flow_in The query to be aaplied on the input stream.
+		 * \param pushdown How the query is applied before sending, none, filter or project.
 		 * \return Not applicable.
 		 */
-		DataConsumer ( string policy_function_file_name, string processing_module_name, string receive_policy, string query_flow_in ) throw (FileOperationException);
+		DataConsumer ( string policy_function_file_name, string processing_module_name, string receive_policy, string query_flow_in, string pushdown ) throw (FileOperationException);
 
 		/**
 		 * \brief Destructor.
@@ -62,6 +66,13 @@ class DataConsumer {
 		 */
 		static void Unlock ( void );
 
+		/**
+		 * \brief Checks whether the consumer has an input query to be applied before sending, which requires a pushdown
+		 * mode other than none.
+		 * \return True if the consumer has an input query.
+		 */
+		bool HasQuery ( void );
+
 		/**
 		 * \brief Return the current credit for a consumer.
 		 * \return the value of the credit.
@@ -81,12 +92,41 @@ class DataConsumer {
 		 */
 		int GetNumberInstances ( void );
 
+		/**
+		 * \brief Retrieves the number of records the input query was applied to.
+		 * \return The number of evaluated records.
+		 */
+		long GetNumberRecordsEvaluated ( void );
+
+		/**
+		 * \brief Retrieves the metrics slot of the output to this data consumer.
+		 * \return The slot, -1 when it has none.
+		 */
+		int GetMetricsStream ( void );
+
+		/**
+		 * \brief Retrieves the number of records that matched the input query.
+		 * \return The number of matching records.
+		 */
+		long GetNumberRecordsMatched ( void );
+
 		/**
 		 * \brief Retrieves a pointer to the policy function.
 		 * \return A pointer to the policy function.
 		 */
 		LabelFunction* GetPolicyFunction ( void );
 
+		/**
+		 * \brief Applies the input query to a message about to be sent to the consumer. The query is compiled on the
+		 * first call. Binary records are queried in place when the query is supported by RecordQuery. A projection that
+		 * does not fit in a message throws a BadParameterException.
+		 * \param message The message produced.
+		 * \return The message itself when it matches the query or there is no query, a message with the query result when
+		 * the pushdown mode is project, or NULL when the message does not match. The projected message is valid until the
+		 * next call.
+		 */
+		Message* ApplyQuery ( Message& message ) throw (BadParameterException);
+
 		/**
 		 * \brief Retrieves a pointer to the data consumer module communicator.
 		 * \return A pointer to the data consumer module communicator.
@@ -105,6 +145,12 @@ class DataConsumer {
 		 */
 		string GetPolicy ( void );
 
+		/**
+		 * \brief Retrieves how the input query is applied before sending.
+		 * \return The pushdown mode, filter or project.
+		 */
+		string GetPushdown ( void );
+
 		/**
 		 * \brief Retrieves the query of the consumer's input flow.
 		 * \return The query of the consumer's input flow.
@@ -137,6 +183,13 @@ class DataConsumer {
 		 */
 		void SetCredit ( int rank, int new_credit );
 
+		/**
+		 * \brief Sets the metrics slot of the output to this data consumer.
+		 * \param metrics_stream The slot, -1 when it has none.
+		 * \return Not applicable.
+		 */
+		void SetMetricsStream ( int metrics_stream );
+
 		/**
 		 * \brief Forces the next instance to receive message.
 		 * \param next_to_receive The next instance to receive message.
@@ -172,6 +225,13 @@ class DataConsumer {
 		 */
 		void SetProcessingModuleName ( string processsing_module_name );
 
+		/**
+		 * \brief Sets how the input query is applied before sending.
+		 * \param pushdown The pushdown mode, filter or project.
+		 * \return Not applicable.
+		 */
+		void SetPushdown ( string pushdown );
+
 		/**
 		 * \brief Sets the input flow query.
 		 * \param query_flow_in Query of an input flow.
@@ -179,6 +239,13 @@ class DataConsumer {
 		 */
 		void SetQueryFlowIn ( string query_flow_in );
 
+		/**
+		 * \brief Sets the layout of the records sent to the consumer. It is owned by the producer.
+		 * \param schema The record schema, or NULL when the records are not binary.
+		 * \return Not applicable.
+		 */
+		void SetSchema ( RecordSchema* schema );
+
 	protected:
 
 	private:
@@ -222,6 +289,30 @@ class DataConsumer {
 
 		/** \brief Query of an input flow. */
 		string query_flow_in_;
+
+		/** \brief How the query is applied before sending. */
+		string pushdown_;
+
+		/** \brief Compiled input flow query. */
+		XMLQuery query_;
+
+		/** \brief Layout of the records sent to the consumer, or NULL when they are not binary. */
+		RecordSchema* schema_;
+
+		/** \brief Input flow query compiled against the record schema. */
+		RecordQuery* record_query_;
+
+		/** \brief Message carrying the query result in project mode. */
+		Message projected_message_;
+
+		/** \brief Number of records the query was applied to. */
+		long number_records_evaluated_;
+
+		/** \brief Number of records that matched the query. */
+		long number_records_matched_;
+
+		/** \brief Metrics slot of the output to this data consumer, -1 when it has none. */
+		int metrics_stream_;
 };
 
 #endif /* WATERSHED_LIBRARY_DATA_CONSUMER_H_ */
@@ -11,6 +11,9 @@ int DataProducer::number_of_class_instances_ = 0;
 pthread_mutex_t DataProducer::class_mutex_;
 
 DataProducer::DataProducer ( void ) {
+	schema_ = NULL;
+	metrics_stream_ = -1;
+	input_index_ = -1;
 }
 
 DataProducer::DataProducer ( string processing_module_name ) {
@@ -19,6 +22,9 @@ DataProducer::DataProducer ( string processing_module_name ) {
 		pthread_mutex_init ( &class_mutex_, NULL );
 	}
 	SetProcessingModuleName ( processing_module_name );
+	schema_ = NULL;
+	metrics_stream_ = -1;
+	input_index_ = -1;
 }
 
 DataProducer::~DataProducer ( void ) {
@@ -28,12 +34,21 @@ DataProducer::~DataProducer ( void ) {
 	}
 	credits_.clear ();
 	delete ( communicator_ );
+	delete ( schema_ );
 }
 
 MpiCommunicator* DataProducer::GetCommunicator ( void ) {
 	return communicator_;
 }
 
+int DataProducer::GetMetricsStream ( void ) {
+	return metrics_stream_;
+}
+
+int DataProducer::GetInputIndex ( void ) {
+	return input_index_;
+}
+
 int DataProducer::GetCredit ( int rank ) {
 	return credits_[rank];
 }
@@ -42,6 +57,10 @@ string DataProducer::GetFlowOut ( void ) {
 	return flow_out_;
 }
 
+RecordSchema* DataProducer::GetSchema ( void ) {
+	return schema_;
+}
+
 string DataProducer::GetName ( void ) {
 	return name_;
 }
@@ -69,10 +88,23 @@ void DataProducer::SetCredit ( int rank, int new_credit ) {
 	credits_[rank] = new_credit;
 }
 
+void DataProducer::SetMetricsStream ( int metrics_stream ) {
+	metrics_stream_ = metrics_stream;
+}
+
+void DataProducer::SetInputIndex ( int input_index ) {
+	input_index_ = input_index;
+}
+
 void DataProducer::SetFlowOut ( string flow_out ) {
 	flow_out_ = flow_out;
 }
 
+void DataProducer::SetSchema ( RecordSchema* schema ) {
+	delete ( schema_ );
+	schema_ = schema;
+}
+
 void DataProducer::SetProcessingModuleName ( string processing_module_name ) {
 	name_ = processing_module_name;
 }
@@ -13,6 +13,7 @@
 /* Project libraries */
 #include <comm/mpi/mpi_communicator.h>
 #include <library/label_function.h>
+#include <library/record_schema.h>
 
 using namespace std;
 
@@ -71,6 +72,24 @@ class DataProducer {
 		 */
 		MpiCommunicator* GetCommunicator ( void );
 
+		/**
+		 * \brief Retrieves the layout of the binary records of the output stream.
+		 * \return The record schema, or NULL when the records are not binary.
+		 */
+		RecordSchema* GetSchema ( void );
+
+		/**
+		 * \brief Retrieves the metrics slot of the input fed by this data producer.
+		 * \return The slot, -1 when it has none.
+		 */
+		int GetMetricsStream ( void );
+
+		/**
+		 * \brief Retrieves the position, among the module inputs, of the stream fed by this data producer.
+		 * \return The input index, -1 when the stream is not an input of the module.
+		 */
+		int GetInputIndex ( void );
+
 		/**
 		 * \brief Returns the credit for this data producer.
 		 * \param rank The rank of target instance.
@@ -102,6 +121,20 @@ class DataProducer {
 		 */
 		void SetCommunicator ( MpiCommunicator* communicator );
 
+		/**
+		 * \brief Sets the metrics slot of the input fed by this data producer.
+		 * \param metrics_stream The slot, -1 when it has none.
+		 * \return Not applicable.
+		 */
+		void SetMetricsStream ( int metrics_stream );
+
+		/**
+		 * \brief Sets the position, among the module inputs, of the stream fed by this data producer.
+		 * \param input_index The input index, -1 when the stream is not an input of the module.
+		 * \return Not applicable.
+		 */
+		void SetInputIndex ( int input_index );
+
 		/**
 		 * \brief Sets the name of the output stream.
 		 * \param flow_out The name of the output stream.
@@ -117,6 +150,13 @@ class DataProducer {
 		 */
 		void SetCredit ( int rank, int new_credit );
 
+		/**
+		 * \brief Sets the layout of the binary records of the output stream. The data producer takes its ownership.
+		 * \param schema The record schema, or NULL when the records are not binary.
+		 * \return Not applicable.
+		 */
+		void SetSchema ( RecordSchema* schema );
+
 		/**
 		 * \brief Sets the data consumer module name.
 		 * \param processing_module_name The data consumer module name.
@@ -145,6 +185,15 @@ class DataProducer {
 
 		/** \brief Credits for all instances. */
 		vector < int > credits_;
+
+		/** \brief Layout of the binary records of the output stream. */
+		RecordSchema* schema_;
+
+		/** \brief Metrics slot of the input fed by this data producer, -1 when it has none. */
+		int metrics_stream_;
+
+		/** \brief Position of the stream among the module inputs, -1 when it is not an input of the module. */
+		int input_index_;
 };
 
 #endif /* WATERSHED_LIBRARY_DATA_PRODUCER_H_ */
@@ -7,6 +7,9 @@
 #include "input_flow.h"
 
 InputFlow::InputFlow ( void ) {
+	ordered_ = false;
+	reorder_capacity_ = Constants::PROCESSING_MODULE_DEFAULT_REORDER_CAPACITY;
+	reorder_latency_ = Constants::PROCESSING_MODULE_DEFAULT_REORDER_LATENCY;
 }
 
 InputFlow::~InputFlow ( void ) {
@@ -24,14 +27,34 @@ string InputFlow::GetPolicyFunctionFile ( void ) {
 	return policy_function_file_;
 }
 
+string InputFlow::GetPushdown ( void ) {
+	return pushdown_;
+}
+
 string InputFlow::GetQuery ( void ) {
 	return query_;
 }
 
+int InputFlow::GetReorderCapacity ( void ) {
+	return reorder_capacity_;
+}
+
+long InputFlow::GetReorderLatency ( void ) {
+	return reorder_latency_;
+}
+
+bool InputFlow::IsOrdered ( void ) {
+	return ordered_;
+}
+
 void InputFlow::SetName ( string name ) {
 	name_ = name;
 }
 
+void InputFlow::SetOrdered ( bool ordered ) {
+	ordered_ = ordered;
+}
+
 void InputFlow::SetPolicy ( string policy ) {
 	policy_ = policy;
 }
@@ -40,6 +63,18 @@ void InputFlow::SetPolicyFunctionFile ( string policy_function_file ) {
 	policy_function_file_ = policy_function_file;
 }
 
+void InputFlow::SetPushdown ( string pushdown ) {
+	pushdown_ = pushdown;
+}
+
 void InputFlow::SetQuery ( string query ) {
 	query_ = query;
 }
+
+void InputFlow::SetReorderCapacity ( int reorder_capacity ) {
+	reorder_capacity_ = reorder_capacity;
+}
+
+void InputFlow::SetReorderLatency ( long reorder_latency ) {
+	reorder_latency_ = reorder_latency;
+}
@@ -10,6 +10,9 @@
 /* C++ libraries */
 #include <string>
 
+/* Project's .h */
+#include "common/constants.h"
+
 using namespace std;
 
 /**
@@ -35,6 +38,24 @@ class InputFlow {
 		 */
 		virtual ~InputFlow ( void );
 
+		/**
+		 * \brief Checks whether the data messages of the input flow are delivered in sequence number order.
+		 * \return True if the input flow is ordered.
+		 */
+		bool IsOrdered ( void );
+
+		/**
+		 * \brief Retrieves the maximum number of messages held by the reorder buffer of an ordered input flow.
+		 * \return The reorder buffer capacity.
+		 */
+		int GetReorderCapacity ( void );
+
+		/**
+		 * \brief Retrieves the maximum time a message waits in the reorder buffer of an ordered input flow.
+		 * \return The reorder latency in milliseconds.
+		 */
+		long GetReorderLatency ( void );
+
 		/**
 		 * \brief Retrieves the name of the input flow.
 		 * \return The name of the input flow.
@@ -53,12 +74,39 @@ class InputFlow {
 		 */
 		string GetPolicyFunctionFile ( void );
 
+		/**
+		 * \brief Retrieves how the producers apply the input flow query.
+		 * \return The pushdown mode, filter or project.
+		 */
+		string GetPushdown ( void );
+
 		/**
 		 * \brief Retrieves the input flow query.
 		 * \return The input flow query.
 		 */
 		string GetQuery ( void );
 
+		/**
+		 * \brief Sets whether the data messages of the input flow are delivered in sequence number order.
+		 * \param ordered True if the input flow is ordered.
+		 * \return Not applicable.
+		 */
+		void SetOrdered ( bool ordered );
+
+		/**
+		 * \brief Sets the maximum number of messages held by the reorder buffer of an ordered input flow.
+		 * \param reorder_capacity The reorder buffer capacity.
+		 * \return Not applicable.
+		 */
+		void SetReorderCapacity ( int reorder_capacity );
+
+		/**
+		 * \brief Sets the maximum time a message waits in the reorder buffer of an ordered input flow.
+		 * \param reorder_latency The reorder latency in milliseconds.
+		 * \return Not applicable.
+		 */
+		void SetReorderLatency ( long reorder_latency );
+
 		/**
 		 * \brief Sets the name of the input flow.
 		 * \param name Input flow name.
@@ -80,6 +128,13 @@ class InputFlow {
 		 */
 		void SetPolicyFunctionFile ( string policy_function_file );
 
+		/**
+		 * \brief Sets how the producers apply the input flow query.
+		 * \param pushdown The pushdown mode, filter or project.
+		 * \return Not applicable.
+		 */
+		void SetPushdown ( string pushdown );
+
 		/**
 		 * \brief Sets the query used in the input stream.
 		 * \param query The query to be used.
@@ -91,6 +146,15 @@ class InputFlow {
 
 	private:
 
+		/** \brief Whether the data messages are delivered in sequence number order. */
+		bool ordered_;
+
+		/** \brief Maximum number of messages in the reorder buffer. */
+		int reorder_capacity_;
+
+		/** \brief Maximum waiting time in the reorder buffer, in milliseconds. */
+		long reorder_latency_;
+
 		/** \brief The input flow name. */
 		string name_;
 
@@ -100,6 +164,9 @@ class InputFlow {
 		/** \brief The policy function file name. */
 		string policy_function_file_;
 
+		/** \brief How the producers apply the query. */
+		string pushdown_;
+
 		/** \brief The query to be applied on the input data. */
 		string query_;
 };
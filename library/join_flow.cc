@@ -0,0 +1,47 @@
+/**
+ * \file library/join_flow.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#include "join_flow.h"
+
+JoinFlow::JoinFlow ( void ) {
+	capacity_ = 0;
+	window_ = 0;
+}
+
+JoinFlow::~JoinFlow ( void ) {
+}
+
+int JoinFlow::GetCapacity ( void ) {
+	return capacity_;
+}
+
+string JoinFlow::GetLeft ( void ) {
+	return left_;
+}
+
+string JoinFlow::GetRight ( void ) {
+	return right_;
+}
+
+long JoinFlow::GetWindow ( void ) {
+	return window_;
+}
+
+void JoinFlow::SetCapacity ( int capacity ) {
+	capacity_ = capacity;
+}
+
+void JoinFlow::SetLeft ( string left ) {
+	left_ = left;
+}
+
+void JoinFlow::SetRight ( string right ) {
+	right_ = right;
+}
+
+void JoinFlow::SetWindow ( long window ) {
+	window_ = window;
+}
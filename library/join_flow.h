@@ -0,0 +1,107 @@
+/**
+ * \file library/join_flow.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_JOIN_FLOW_H_
+#define WATERSHED_LIBRARY_JOIN_FLOW_H_
+
+/* C++ libraries */
+#include <string>
+
+using namespace std;
+
+/**
+ * \class JoinFlow
+ * \brief Implementation of the join between two input flows.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class JoinFlow {
+	public:
+
+		/**
+		 * \brief Creates a new instance of JoinFlow.
+		 * \return Not applicable.
+		 */
+		JoinFlow ( void );
+
+		/**
+		 * \brief Destructor. Destroys the instance of JoinFlow.
+		 * \return Not applicable.
+		 */
+		virtual ~JoinFlow ( void );
+
+		/**
+		 * \brief Retrieves the initial number of tuples each side of the join can hold without growing.
+		 * \return The join capacity.
+		 */
+		int GetCapacity ( void );
+
+		/**
+		 * \brief Retrieves how far apart, in event time units (milliseconds by default), two tuples can be to be joined. Older tuples are evicted.
+		 * \return The join window.
+		 */
+		long GetWindow ( void );
+
+		/**
+		 * \brief Retrieves the name of the left input flow.
+		 * \return The name of the left input flow.
+		 */
+		string GetLeft ( void );
+
+		/**
+		 * \brief Retrieves the name of the right input flow.
+		 * \return The name of the right input flow.
+		 */
+		string GetRight ( void );
+
+		/**
+		 * \brief Sets the initial number of tuples each side of the join can hold without growing.
+		 * \param capacity The join capacity.
+		 * \return Not applicable.
+		 */
+		void SetCapacity ( int capacity );
+
+		/**
+		 * \brief Sets the name of the left input flow.
+		 * \param left Left input flow name.
+		 * \return Not applicable.
+		 */
+		void SetLeft ( string left );
+
+		/**
+		 * \brief Sets the name of the right input flow.
+		 * \param right Right input flow name.
+		 * \return Not applicable.
+		 */
+		void SetRight ( string right );
+
+		/**
+		 * \brief Sets how far apart, in event time units (milliseconds by default), two tuples can be to be joined.
+		 * \param window The join window.
+		 * \return Not applicable.
+		 */
+		void SetWindow ( long window );
+
+	protected:
+
+	private:
+
+		/** \brief The initial number of tuples of each side. */
+		int capacity_;
+
+		/** \brief The join window. */
+		long window_;
+
+		/** \brief The left input flow name. */
+		string left_;
+
+		/** \brief The right input flow name. */
+		string right_;
+};
+
+#endif /* WATERSHED_LIBRARY_JOIN_FLOW_H_ */
@@ -31,10 +31,22 @@ int main(int argc, char** argv) {
 	string database_port_name = Util::TokenizeString("\t", message_data)[1];
 	int database_peer = atoi((Util::TokenizeString("\t", message_data)[2]).c_str());
 	try {
-		processing_module_configurator = new ProcessingModuleConfigurator(configurator_file_name);
+
+		/* The runtime sends the configurator descriptor after the text, so the file is parsed only when it is missing */
+		int descriptor_offset = message_data.length() + 1;
+		if (message_from_runtime.GetDataSize() > descriptor_offset) {
+			processing_module_configurator = new ProcessingModuleConfigurator((char*) message_from_runtime.GetData() + descriptor_offset, message_from_runtime.GetDataSize() - descriptor_offset);
+		} else {
+			processing_module_configurator = new ProcessingModuleConfigurator(configurator_file_name);
+		}
 		processing_module_configurator->SetDatabasePortName(database_port_name);
 		processing_module_configurator->SetDatabasePeerIdentification(database_peer);
 		processing_module_configurator->SetConfiguratorFileName(configurator_file_name);
+
+		/* Instances added to a running module receive its port to join the other instances */
+		if (Util::TokenizeString("\t", message_data).size() > 3) {
+			processing_module_configurator->SetPortName(Util::TokenizeString("\t", message_data)[3]);
+		}
 	} catch (XMLParserException& e) {
 		throw(e);
 	}
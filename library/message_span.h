@@ -0,0 +1,110 @@
+/**
+ * \file library/message_span.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_MESSAGE_SPAN_H_
+#define WATERSHED_LIBRARY_MESSAGE_SPAN_H_
+
+/* Project's .h */
+#include "comm/message.h"
+
+using namespace std;
+
+/**
+ * \class MessageSpan
+ * \brief A view over a contiguous set of messages received by a processing module. It does not own the messages, which
+ * are valid only during the ProcessBatch call.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class MessageSpan {
+
+	public:
+
+		/**
+		 * \brief Creates a new MessageSpan instance.
+		 * \param messages Pointer to the first message of the span.
+		 * \param size Number of messages in the span.
+		 * \return Not applicable.
+		 */
+		MessageSpan ( Message* messages, int size ) {
+			messages_ = messages;
+			inputs_ = NULL;
+			size_ = size;
+		}
+
+		/**
+		 * \brief Creates a new MessageSpan instance which knows the input each message came from.
+		 * \param messages Pointer to the first message of the span.
+		 * \param inputs Pointer to the input index of the first message, as returned by ProcessingModule::GetInputIndex.
+		 * \param size Number of messages in the span.
+		 * \return Not applicable.
+		 */
+		MessageSpan ( Message* messages, int* inputs, int size ) {
+			messages_ = messages;
+			inputs_ = inputs;
+			size_ = size;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~MessageSpan ( void ) {
+
+		}
+
+		/**
+		 * \brief Retrieves a message of the span.
+		 * \param index The message position, from 0 to GetSize ( ) - 1.
+		 * \return The message.
+		 */
+		Message& At ( int index ) {
+			return messages_[index];
+		}
+
+		/**
+		 * \brief Retrieves the input a message of the span came from, resolved once per producer by the module.
+		 * \param index The message position, from 0 to GetSize ( ) - 1.
+		 * \return The input index, -1 when it is unknown.
+		 */
+		int GetInput ( int index ) {
+			return ( inputs_ != NULL ) ? inputs_[index] : -1;
+		}
+
+		/**
+		 * \brief Retrieves the number of messages in the span.
+		 * \return The number of messages.
+		 */
+		int GetSize ( void ) {
+			return size_;
+		}
+
+		/**
+		 * \brief Retrieves a message of the span.
+		 * \param index The message position, from 0 to GetSize ( ) - 1.
+		 * \return The message.
+		 */
+		Message& operator[] ( int index ) {
+			return messages_[index];
+		}
+
+	protected:
+
+	private:
+
+		/** \brief The first message of the span. */
+		Message* messages_;
+
+		/** \brief The input index of the first message, NULL when the inputs are unknown. */
+		int* inputs_;
+
+		/** \brief Number of messages in the span. */
+		int size_;
+};
+
+#endif /* WATERSHED_LIBRARY_MESSAGE_SPAN_H_ */
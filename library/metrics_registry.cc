@@ -0,0 +1,302 @@
+/**
+ * \file library/metrics_registry.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "library/metrics_registry.h"
+
+MetricsRegistry::MetricsRegistry ( void ) {
+	segment_ = new MetricsSegment;
+	memset ( ( void* ) segment_, 0, sizeof(MetricsSegment) );
+	segment_->pid_ = getpid ( );
+	segment_name_ = "";
+}
+
+MetricsRegistry::~MetricsRegistry ( void ) {
+	if ( segment_name_ != "" ) {
+		munmap ( ( void* ) segment_, sizeof(MetricsSegment) );
+		shm_unlink ( segment_name_.c_str ( ) );
+	}
+	else {
+		delete ( segment_ );
+	}
+}
+
+void MetricsRegistry::AddCreditWaitTime ( int stream, long time ) {
+	segment_->credit_wait_time_ += time;
+	if ( stream != -1 ) {
+		segment_->streams_[stream].credit_wait_time_ += time;
+	}
+}
+
+void MetricsRegistry::AddInput ( int stream, long bytes ) {
+	++segment_->records_in_;
+	segment_->bytes_in_ += bytes;
+	if ( stream != -1 ) {
+		++segment_->streams_[stream].records_;
+		segment_->streams_[stream].bytes_ += bytes;
+	}
+}
+
+void MetricsRegistry::AddLatency ( int stream, int64_t origin_time, int64_t send_time, int64_t receive_time ) {
+	if ( origin_time != 0 ) {
+		RecordLatency ( segment_->latency_, receive_time - origin_time );
+		if ( stream != -1 ) {
+			RecordLatency ( segment_->streams_[stream].latency_, receive_time - origin_time );
+		}
+	}
+	if ( stream != -1 ) {
+		RecordLatency ( segment_->streams_[stream].hop_latency_, receive_time - send_time );
+	}
+}
+
+void MetricsRegistry::AddOutput ( int stream, long bytes ) {
+	if ( stream != -1 ) {
+		++segment_->streams_[stream].records_;
+		segment_->streams_[stream].bytes_ += bytes;
+	}
+}
+
+void MetricsRegistry::AddOutputRecord ( long bytes ) {
+	++segment_->records_out_;
+	segment_->bytes_out_ += bytes;
+}
+
+void MetricsRegistry::AddProcessTime ( long time ) {
+	int bucket = 0;
+	while ( ( time >> ( bucket + 1 ) ) > 0 && bucket < Constants::METRICS_HISTOGRAM_BUCKETS - 1 ) {
+		++bucket;
+	}
+	segment_->process_time_ += time;
+	++segment_->process_calls_;
+	++segment_->process_time_histogram_[bucket];
+}
+
+int MetricsRegistry::AddStream ( string name, int direction ) {
+	for ( int i = 0; i < segment_->number_streams_; ++i ) {
+		if ( segment_->streams_[i].direction_ == direction && name.compare ( 0, Constants::METRICS_NAME_SIZE - 1, segment_->streams_[i].name_ ) == 0 ) {
+			return i;
+		}
+	}
+	if ( segment_->number_streams_ == Constants::METRICS_MAX_STREAMS ) {
+		return -1;
+	}
+
+	/* The slot is filled before it is counted, so readers never see it half written */
+	int stream = segment_->number_streams_;
+	strncpy ( segment_->streams_[stream].name_, name.c_str ( ), Constants::METRICS_NAME_SIZE - 1 );
+	segment_->streams_[stream].direction_ = direction;
+	__sync_synchronize ( );
+	segment_->number_streams_ = stream + 1;
+	return stream;
+}
+
+string MetricsRegistry::FormatLatency ( LatencyHistogram& histogram ) {
+	char line[Constants::MAX_LINE_SIZE];
+	snprintf ( line, sizeof ( line ), "p50 %.1f us, p99 %.1f us, p999 %.1f us", GetLatencyPercentile ( histogram, 500 ) / 1000.0, GetLatencyPercentile ( histogram, 990 ) / 1000.0, GetLatencyPercentile ( histogram, 999 ) / 1000.0 );
+	return line;
+}
+
+string MetricsRegistry::FormatSegment ( MetricsSegment& segment ) {
+	char line[Constants::MAX_LINE_SIZE];
+	string text;
+
+	snprintf ( line, sizeof ( line ), "%s[%d] pid %d: in %lld records/%lld bytes, out %lld records/%lld bytes, credit wait %lld ms, process %lld ms in %lld batches (p50 %ld us, p99 %ld us), queue %lld\n", segment.module_name_, segment.rank_, segment.pid_, ( long long ) segment.records_in_, ( long long ) segment.bytes_in_, ( long long ) segment.records_out_, ( long long ) segment.bytes_out_, ( long long ) segment.credit_wait_time_ / 1000, ( long long ) segment.process_time_ / 1000, ( long long ) segment.process_calls_, GetProcessTimePercentile ( segment, 50 ), GetProcessTimePercentile ( segment, 99 ), ( long long ) segment.queue_depth_ );
+	text = line;
+	snprintf ( line, sizeof ( line ), "\tresources: cpu %lld%% (user %lld ms, system %lld ms), rss %lld KB, switches %lld voluntary/%lld involuntary, faults %lld minor/%lld major\n", ( long long ) segment.cpu_utilization_, ( long long ) segment.user_time_ / 1000, ( long long ) segment.system_time_ / 1000, ( long long ) segment.resident_size_ / 1024, ( long long ) segment.voluntary_switches_, ( long long ) segment.involuntary_switches_, ( long long ) segment.minor_faults_, ( long long ) segment.major_faults_ );
+	text += line;
+	text += "\tlatency " + FormatLatency ( segment.latency_ ) + "\n";
+
+	int number_streams = ( segment.number_streams_ < Constants::METRICS_MAX_STREAMS ) ? segment.number_streams_ : Constants::METRICS_MAX_STREAMS;
+	for ( int i = 0; i < number_streams; ++i ) {
+		StreamMetrics& stream = segment.streams_[i];
+		stream.name_[Constants::METRICS_NAME_SIZE - 1] = '\0';
+		if ( stream.direction_ == Constants::METRICS_INPUT ) {
+			snprintf ( line, sizeof ( line ), "\tinput %s: %lld records/%lld bytes, queue %lld, latency ", stream.name_, ( long long ) stream.records_, ( long long ) stream.bytes_, ( long long ) stream.queue_depth_ );
+			text += line + FormatLatency ( stream.latency_ ) + ", hop " + FormatLatency ( stream.hop_latency_ ) + "\n";
+		}
+		else {
+			snprintf ( line, sizeof ( line ), "\toutput %s: %lld records/%lld bytes, credit wait %lld ms", stream.name_, ( long long ) stream.records_, ( long long ) stream.bytes_, ( long long ) stream.credit_wait_time_ / 1000 );
+			text += line;
+			if ( stream.records_evaluated_ > 0 ) {
+				snprintf ( line, sizeof ( line ), ", query %lld of %lld records matched", ( long long ) stream.records_matched_, ( long long ) stream.records_evaluated_ );
+				text += line;
+			}
+			text += "\n";
+		}
+	}
+	return text;
+}
+
+int64_t MetricsRegistry::GetLatencyPercentile ( LatencyHistogram& histogram, int permille ) {
+	int64_t total = 0, count = 0;
+	for ( int i = 0; i < Constants::METRICS_LATENCY_BUCKETS; ++i ) {
+		total += histogram.counts_[i];
+	}
+	if ( total == 0 ) {
+		return 0;
+	}
+
+	int sub_buckets = 1 << Constants::METRICS_LATENCY_PRECISION_BITS;
+	for ( int i = 0; i < Constants::METRICS_LATENCY_BUCKETS; ++i ) {
+		count += histogram.counts_[i];
+		if ( count * 1000 >= total * permille ) {
+			if ( i < sub_buckets ) {
+				return i;
+			}
+			int magnitude = i / sub_buckets - 1;
+			int64_t upper_bound = ( ( ( int64_t ) ( i % sub_buckets + sub_buckets + 1 ) ) << magnitude ) - 1;
+			return ( upper_bound < histogram.max_ ) ? upper_bound : histogram.max_;
+		}
+	}
+	return histogram.max_;
+}
+
+long MetricsRegistry::GetProcessTimePercentile ( MetricsSegment& segment, int percentile ) {
+	int64_t total = 0, count = 0;
+	for ( int i = 0; i < Constants::METRICS_HISTOGRAM_BUCKETS; ++i ) {
+		total += segment.process_time_histogram_[i];
+	}
+	if ( total == 0 ) {
+		return 0;
+	}
+	for ( int i = 0; i < Constants::METRICS_HISTOGRAM_BUCKETS; ++i ) {
+		count += segment.process_time_histogram_[i];
+		if ( count * 100 >= total * percentile ) {
+			return 1L << ( i + 1 );
+		}
+	}
+	return 1L << Constants::METRICS_HISTOGRAM_BUCKETS;
+}
+
+long MetricsRegistry::GetTime ( void ) {
+	struct timespec now;
+	clock_gettime ( CLOCK_MONOTONIC, &now );
+	return now.tv_sec * 1000000L + now.tv_nsec / 1000;
+}
+
+void MetricsRegistry::Publish ( string module_name, int rank ) {
+	if ( segment_name_ != "" ) {
+		return;
+	}
+	string segment_name = "/" + Constants::FILE_METRICS_PREFIX + Util::IntegerToString ( getpid ( ) );
+	int file_descriptor = shm_open ( segment_name.c_str ( ), O_CREAT | O_RDWR | O_TRUNC, 0644 );
+	if ( file_descriptor == -1 ) {
+		return;
+	}
+	if ( ftruncate ( file_descriptor, sizeof(MetricsSegment) ) == -1 ) {
+		close ( file_descriptor );
+		shm_unlink ( segment_name.c_str ( ) );
+		return;
+	}
+	void* shared_segment = mmap ( NULL, sizeof(MetricsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0 );
+	close ( file_descriptor );
+	if ( shared_segment == MAP_FAILED ) {
+		shm_unlink ( segment_name.c_str ( ) );
+		return;
+	}
+
+	/* Carries over what was counted before publishing, and marks the segment valid last */
+	memcpy ( shared_segment, ( void* ) segment_, sizeof(MetricsSegment) );
+	delete ( segment_ );
+	segment_ = ( MetricsSegment* ) shared_segment;
+	segment_name_ = segment_name;
+	strncpy ( segment_->module_name_, module_name.c_str ( ), Constants::METRICS_NAME_SIZE - 1 );
+	segment_->rank_ = rank;
+	__sync_synchronize ( );
+	segment_->magic_ = Constants::METRICS_MAGIC;
+}
+
+string MetricsRegistry::ReadHostMetrics ( void ) {
+	string text;
+	DIR* directory = opendir ( Constants::DIR_SHARED_MEMORY.c_str ( ) );
+	if ( directory == NULL ) {
+		return text;
+	}
+
+	struct dirent* entry;
+	while ( ( entry = readdir ( directory ) ) != NULL ) {
+		if ( Constants::FILE_METRICS_PREFIX.compare ( 0, Constants::FILE_METRICS_PREFIX.length ( ), entry->d_name, 0, Constants::FILE_METRICS_PREFIX.length ( ) ) != 0 ) {
+			continue;
+		}
+		string segment_name = "/" + string ( entry->d_name );
+		int file_descriptor = shm_open ( segment_name.c_str ( ), O_RDONLY, 0 );
+		if ( file_descriptor == -1 ) {
+			continue;
+		}
+		void* shared_segment = mmap ( NULL, sizeof(MetricsSegment), PROT_READ, MAP_SHARED, file_descriptor, 0 );
+		close ( file_descriptor );
+		if ( shared_segment == MAP_FAILED ) {
+			continue;
+		}
+
+		/* A copy is formatted, so the instance keeps writing while the metrics are read */
+		MetricsSegment segment;
+		memcpy ( ( void* ) &segment, shared_segment, sizeof(MetricsSegment) );
+		munmap ( shared_segment, sizeof(MetricsSegment) );
+		if ( segment.magic_ != Constants::METRICS_MAGIC ) {
+			continue;
+		}
+		if ( kill ( segment.pid_, 0 ) == -1 && errno == ESRCH ) {
+			shm_unlink ( segment_name.c_str ( ) );
+			continue;
+		}
+		segment.module_name_[Constants::METRICS_NAME_SIZE - 1] = '\0';
+		text += FormatSegment ( segment );
+	}
+	closedir ( directory );
+	return text;
+}
+
+void MetricsRegistry::RecordLatency ( LatencyHistogram& histogram, int64_t latency ) {
+	uint64_t value = ( latency > 0 ) ? latency : 0;
+	int sub_buckets = 1 << Constants::METRICS_LATENCY_PRECISION_BITS;
+	int bucket = ( int ) value;
+
+	/* Above the linear range, the magnitude selects a group of buckets and the next bits of the value select one */
+	if ( value >= ( uint64_t ) sub_buckets ) {
+		int magnitude = 63 - __builtin_clzll ( value ) - Constants::METRICS_LATENCY_PRECISION_BITS;
+		bucket = ( magnitude + 1 ) * sub_buckets + ( int ) ( ( value >> magnitude ) - sub_buckets );
+		if ( bucket >= Constants::METRICS_LATENCY_BUCKETS ) {
+			bucket = Constants::METRICS_LATENCY_BUCKETS - 1;
+		}
+	}
+	++histogram.counts_[bucket];
+	if ( ( int64_t ) value > histogram.max_ ) {
+		histogram.max_ = value;
+	}
+}
+
+void MetricsRegistry::SetBatchDepth ( long depth ) {
+	segment_->queue_depth_ = depth;
+}
+
+void MetricsRegistry::SetQueueDepth ( int stream, long depth ) {
+	if ( stream != -1 ) {
+		segment_->streams_[stream].queue_depth_ = depth;
+	}
+}
+
+void MetricsRegistry::SetQuerySelectivity ( int stream, long evaluated, long matched ) {
+	if ( stream != -1 ) {
+		segment_->streams_[stream].records_evaluated_ = evaluated;
+		segment_->streams_[stream].records_matched_ = matched;
+	}
+}
+
+void MetricsRegistry::SetRank ( int rank ) {
+	segment_->rank_ = rank;
+}
+
+void MetricsRegistry::SetResources ( int utilization, double user_time, double system_time, long resident_size, long voluntary_switches, long involuntary_switches, long minor_faults, long major_faults ) {
+	segment_->cpu_utilization_ = utilization;
+	segment_->user_time_ = ( int64_t ) ( user_time * 1000000 );
+	segment_->system_time_ = ( int64_t ) ( system_time * 1000000 );
+	segment_->resident_size_ = resident_size;
+	segment_->voluntary_switches_ = voluntary_switches;
+	segment_->involuntary_switches_ = involuntary_switches;
+	segment_->minor_faults_ = minor_faults;
+	segment_->major_faults_ = major_faults;
+}
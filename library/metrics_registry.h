@@ -0,0 +1,328 @@
+/**
+ * \file library/metrics_registry.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_METRICS_REGISTRY_H_
+#define WATERSHED_LIBRARY_METRICS_REGISTRY_H_
+
+/* C libraries */
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+/* C++ libraries */
+#include <string>
+
+/* Project's .h */
+#include "common/constants.h"
+#include "common/util.h"
+
+using namespace std;
+
+/**
+ * \brief Log-linear latency histogram. Values below 2^Constants::METRICS_LATENCY_PRECISION_BITS nanoseconds have a
+ * bucket each, and every power of two above is split in 2^Constants::METRICS_LATENCY_PRECISION_BITS buckets, so a
+ * percentile is off by less than 1/16 of its value whatever its magnitude.
+ */
+struct LatencyHistogram {
+		/** \brief Greatest latency recorded, in nanoseconds. */
+		volatile int64_t max_;
+		/** \brief Number of latencies by bucket. */
+		volatile int64_t counts_[Constants::METRICS_LATENCY_BUCKETS];
+};
+
+/**
+ * \brief Metrics of an input or output of a processing module instance.
+ */
+struct StreamMetrics {
+		/** \brief The input stream or the consumer name. */
+		char name_[Constants::METRICS_NAME_SIZE];
+		/** \brief Constants::METRICS_INPUT or Constants::METRICS_OUTPUT. */
+		int32_t direction_;
+		/** \brief Number of records received or sent. */
+		volatile int64_t records_;
+		/** \brief Number of bytes received or sent. */
+		volatile int64_t bytes_;
+		/** \brief Time waiting for consumer credits, in microseconds. */
+		volatile int64_t credit_wait_time_;
+		/** \brief Number of messages held by the reorder buffer of an ordered input. */
+		volatile int64_t queue_depth_;
+		/** \brief Number of records the input query of the consumer was applied to. */
+		volatile int64_t records_evaluated_;
+		/** \brief Number of records that matched the input query of the consumer. */
+		volatile int64_t records_matched_;
+		/** \brief Latency from the source module to this input. */
+		LatencyHistogram latency_;
+		/** \brief Latency of the last hop, from the producer to this input. */
+		LatencyHistogram hop_latency_;
+};
+
+/**
+ * \brief Metrics of a processing module instance, as laid out in its shared memory segment.
+ */
+struct MetricsSegment {
+		/** \brief Constants::METRICS_MAGIC once the segment is initialized. */
+		volatile int32_t magic_;
+		/** \brief Process identification of the instance. */
+		int32_t pid_;
+		/** \brief Rank of the instance. */
+		volatile int32_t rank_;
+		/** \brief Number of inputs and outputs with metrics. */
+		volatile int32_t number_streams_;
+		/** \brief The processing module name. */
+		char module_name_[Constants::METRICS_NAME_SIZE];
+		/** \brief Number of records received. */
+		volatile int64_t records_in_;
+		/** \brief Number of bytes received. */
+		volatile int64_t bytes_in_;
+		/** \brief Number of records sent. */
+		volatile int64_t records_out_;
+		/** \brief Number of bytes sent. */
+		volatile int64_t bytes_out_;
+		/** \brief Time waiting for consumer credits, in microseconds. */
+		volatile int64_t credit_wait_time_;
+		/** \brief Time spent in Process, in microseconds. */
+		volatile int64_t process_time_;
+		/** \brief Number of batches processed. */
+		volatile int64_t process_calls_;
+		/** \brief Number of messages in the last batch. */
+		volatile int64_t queue_depth_;
+		/** \brief CPU time over clock time between the last two resource samples, in percent. */
+		volatile int64_t cpu_utilization_;
+		/** \brief CPU user time, in microseconds. */
+		volatile int64_t user_time_;
+		/** \brief CPU system time, in microseconds. */
+		volatile int64_t system_time_;
+		/** \brief Resident set size of the process, in bytes. */
+		volatile int64_t resident_size_;
+		/** \brief Context switches caused by blocking, mostly on communication. */
+		volatile int64_t voluntary_switches_;
+		/** \brief Context switches caused by preemption. */
+		volatile int64_t involuntary_switches_;
+		/** \brief Page faults served without reading from the disk. */
+		volatile int64_t minor_faults_;
+		/** \brief Page faults served by reading from the disk. */
+		volatile int64_t major_faults_;
+		/** \brief Number of batches by processing time, bucket i holding the times below 2^(i+1) microseconds. */
+		volatile int64_t process_time_histogram_[Constants::METRICS_HISTOGRAM_BUCKETS];
+		/** \brief Latency from the source module to the instance, whatever the input. */
+		LatencyHistogram latency_;
+		/** \brief Metrics by input and output. */
+		StreamMetrics streams_[Constants::METRICS_MAX_STREAMS];
+};
+
+/**
+ * \class MetricsRegistry
+ * \brief Counters, gauges and histograms of a processing module instance. The instance thread is the only writer and
+ * updates the values in place, without locks, so the metrics cost a few additions on the hot path. Once published, the
+ * values live in a shared memory segment which the runtime of the host reads whenever the metrics are queried.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class MetricsRegistry {
+
+	public:
+
+		/**
+		 * \brief Creates a new MetricsRegistry instance, kept in private memory until it is published.
+		 * \return Not applicable.
+		 */
+		MetricsRegistry ( void );
+
+		/**
+		 * \brief Destructor. Removes the shared memory segment.
+		 * \return Not applicable.
+		 */
+		virtual ~MetricsRegistry ( void );
+
+		/**
+		 * \brief Retrieves a monotonic clock time.
+		 * \return The time in microseconds.
+		 */
+		static long GetTime ( void );
+
+		/**
+		 * \brief Formats the metrics of all the processing module instances running on this host, removing the
+		 * segments left by terminated instances.
+		 * \return One line by instance, followed by one line by input and output.
+		 */
+		static string ReadHostMetrics ( void );
+
+		/**
+		 * \brief Registers an input or output. Registering the same name and direction again returns the same slot.
+		 * \param name The input stream or the consumer name.
+		 * \param direction Constants::METRICS_INPUT or Constants::METRICS_OUTPUT.
+		 * \return The slot of the stream, -1 if there is no slot left.
+		 */
+		int AddStream ( string name, int direction );
+
+		/**
+		 * \brief Counts the time waiting for consumer credits.
+		 * \param stream The output slot, -1 to count it only for the instance.
+		 * \param time The time in microseconds.
+		 * \return Not applicable.
+		 */
+		void AddCreditWaitTime ( int stream, long time );
+
+		/**
+		 * \brief Counts a record received.
+		 * \param stream The input slot, -1 to count it only for the instance.
+		 * \param bytes The record size.
+		 * \return Not applicable.
+		 */
+		void AddInput ( int stream, long bytes );
+
+		/**
+		 * \brief Counts the latency of a record received. Negative latencies, caused by unsynchronized clocks, are
+		 * counted as 0.
+		 * \param stream The input slot, -1 to count it only for the instance.
+		 * \param origin_time When the record was first sent, in nanoseconds, 0 if unknown.
+		 * \param send_time When the record was sent by the producer, in nanoseconds.
+		 * \param receive_time When the record was received, in nanoseconds.
+		 * \return Not applicable.
+		 */
+		void AddLatency ( int stream, int64_t origin_time, int64_t send_time, int64_t receive_time );
+
+		/**
+		 * \brief Counts a record sent through an output.
+		 * \param stream The output slot.
+		 * \param bytes The record size.
+		 * \return Not applicable.
+		 */
+		void AddOutput ( int stream, long bytes );
+
+		/**
+		 * \brief Counts a record sent by the instance, whatever the number of outputs it is sent through.
+		 * \param bytes The record size.
+		 * \return Not applicable.
+		 */
+		void AddOutputRecord ( long bytes );
+
+		/**
+		 * \brief Counts the processing of a batch.
+		 * \param time The time spent in Process, in microseconds.
+		 * \return Not applicable.
+		 */
+		void AddProcessTime ( long time );
+
+		/**
+		 * \brief Moves the metrics to a shared memory segment named after the process identification. The metrics stay
+		 * in private memory if the segment cannot be created.
+		 * \param module_name The processing module name.
+		 * \param rank The instance rank.
+		 * \return Not applicable.
+		 */
+		void Publish ( string module_name, int rank );
+
+		/**
+		 * \brief Sets the number of messages in the batch being processed.
+		 * \param depth The number of messages.
+		 * \return Not applicable.
+		 */
+		void SetBatchDepth ( long depth );
+
+		/**
+		 * \brief Sets the number of messages held by the reorder buffer of an ordered input.
+		 * \param stream The input slot, -1 to ignore the value.
+		 * \param depth The number of messages.
+		 * \return Not applicable.
+		 */
+		void SetQueueDepth ( int stream, long depth );
+
+		/**
+		 * \brief Sets the number of records evaluated and matched by the input query of a consumer.
+		 * \param stream The output slot, -1 to ignore the values.
+		 * \param evaluated The number of records the query was applied to.
+		 * \param matched The number of records that matched the query.
+		 * \return Not applicable.
+		 */
+		void SetQuerySelectivity ( int stream, long evaluated, long matched );
+
+		/**
+		 * \brief Sets the rank of the instance, which changes when the module group grows or shrinks.
+		 * \param rank The instance rank.
+		 * \return Not applicable.
+		 */
+		void SetRank ( int rank );
+
+		/**
+		 * \brief Sets the resources used by the instance, as last sampled.
+		 * \param utilization CPU time over clock time since the previous sample, in percent.
+		 * \param user_time The CPU user time, in seconds.
+		 * \param system_time The CPU system time, in seconds.
+		 * \param resident_size Resident set size of the process, in bytes.
+		 * \param voluntary_switches Context switches caused by blocking.
+		 * \param involuntary_switches Context switches caused by preemption.
+		 * \param minor_faults Page faults served without reading from the disk.
+		 * \param major_faults Page faults served by reading from the disk.
+		 * \return Not applicable.
+		 */
+		void SetResources ( int utilization, double user_time, double system_time, long resident_size, long voluntary_switches, long involuntary_switches, long minor_faults, long major_faults );
+
+	protected:
+
+	private:
+
+		/**
+		 * \brief Formats the metrics of an instance.
+		 * \param segment A copy of the instance segment.
+		 * \return The formatted lines.
+		 */
+		static string FormatSegment ( MetricsSegment& segment );
+
+		/**
+		 * \brief Formats the median, 99th and 99.9th percentiles of a latency histogram.
+		 * \param histogram A copy of the histogram.
+		 * \return The percentiles in microseconds.
+		 */
+		static string FormatLatency ( LatencyHistogram& histogram );
+
+		/**
+		 * \brief Retrieves a percentile of a latency histogram.
+		 * \param histogram A copy of the histogram.
+		 * \param permille The percentile, from 0 to 1000.
+		 * \return The upper bound of the bucket holding the percentile, at most the greatest latency, in nanoseconds.
+		 */
+		static int64_t GetLatencyPercentile ( LatencyHistogram& histogram, int permille );
+
+		/**
+		 * \brief Retrieves a percentile of the processing time histogram.
+		 * \param segment A copy of the instance segment.
+		 * \param percentile The percentile, from 0 to 100.
+		 * \return The upper bound of the bucket holding the percentile, in microseconds.
+		 */
+		static long GetProcessTimePercentile ( MetricsSegment& segment, int percentile );
+
+		/**
+		 * \brief Counts a latency in a histogram.
+		 * \param histogram The histogram.
+		 * \param latency The latency in nanoseconds.
+		 * \return Not applicable.
+		 */
+		static void RecordLatency ( LatencyHistogram& histogram, int64_t latency );
+
+		/** \brief The metrics, either in private memory or in the shared memory segment. */
+		MetricsSegment* segment_;
+
+		/** \brief Name of the shared memory segment, empty while the metrics are private. */
+		string segment_name_;
+
+		/** \brief Copy is not allowed. */
+		MetricsRegistry ( const MetricsRegistry& );
+
+		/** \brief Assignment is not allowed. */
+		MetricsRegistry& operator= ( const MetricsRegistry& );
+};
+
+#endif /* WATERSHED_LIBRARY_METRICS_REGISTRY_H_ */
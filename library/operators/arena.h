@@ -0,0 +1,132 @@
+/**
+ * \file library/operators/arena.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_OPERATORS_ARENA_H_
+#define WATERSHED_LIBRARY_OPERATORS_ARENA_H_
+
+/* C++ libraries */
+#include <new>
+#include <vector>
+
+using namespace std;
+
+/**
+ * \class ObjectArena
+ * \brief Pool of fixed size objects allocated in blocks. Released objects are kept in a free list and reused, so the
+ * memory used by an operator state is bounded by its peak number of live objects.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename T >
+class ObjectArena {
+
+	public:
+
+		/**
+		 * \brief Creates a new ObjectArena instance.
+		 * \param objects_per_block Number of objects allocated at once when the free list is empty.
+		 * \return Not applicable.
+		 */
+		ObjectArena ( int objects_per_block = 64 ) {
+			objects_per_block_ = ( objects_per_block > 0 ) ? objects_per_block : 64;
+			free_list_ = NULL;
+			number_allocated_ = 0;
+		}
+
+		/**
+		 * \brief Destructor. Releases all the blocks. Live objects are not destroyed.
+		 * \return Not applicable.
+		 */
+		virtual ~ObjectArena ( void ) {
+			for ( unsigned int i = 0; i < blocks_.size ( ); ++i ) {
+				delete[] ( blocks_[i] );
+			}
+			blocks_.clear ( );
+		}
+
+		/**
+		 * \brief Allocates and default-constructs an object.
+		 * \return Pointer to the new object.
+		 */
+		T* Allocate ( void ) {
+			if ( free_list_ == NULL ) {
+				Slot* block = new Slot[objects_per_block_];
+				for ( int i = 0; i < objects_per_block_; ++i ) {
+					block[i].next_ = free_list_;
+					free_list_ = &block[i];
+				}
+				blocks_.push_back ( block );
+			}
+			Slot* slot = free_list_;
+			free_list_ = slot->next_;
+			++number_allocated_;
+			return new ( slot->data_ ) T ( );
+		}
+
+		/**
+		 * \brief Retrieves the number of live objects.
+		 * \return The number of live objects.
+		 */
+		int GetNumberAllocated ( void ) {
+			return number_allocated_;
+		}
+
+		/**
+		 * \brief Retrieves the number of objects the arena can hold without allocating a new block.
+		 * \return The arena capacity.
+		 */
+		int GetCapacity ( void ) {
+			return blocks_.size ( ) * objects_per_block_;
+		}
+
+		/**
+		 * \brief Destroys an object and gives its memory back to the arena.
+		 * \param object Object previously returned by Allocate.
+		 * \return Not applicable.
+		 */
+		void Release ( T* object ) {
+			object->~T ( );
+			Slot* slot = reinterpret_cast < Slot* > ( object );
+			slot->next_ = free_list_;
+			free_list_ = slot;
+			--number_allocated_;
+		}
+
+	protected:
+
+	private:
+
+		/** \brief Storage of one object. The union keeps the object aligned and holds the free list link while unused. */
+		union Slot {
+				char data_[sizeof(T)];
+				Slot* next_;
+				double align_double_;
+				long align_long_;
+				void* align_pointer_;
+		};
+
+		/** \brief Number of objects allocated at once. */
+		int objects_per_block_;
+
+		/** \brief Number of live objects. */
+		int number_allocated_;
+
+		/** \brief First free slot. */
+		Slot* free_list_;
+
+		/** \brief All the allocated blocks. */
+		vector < Slot* > blocks_;
+
+		/** \brief Copy is not allowed. */
+		ObjectArena ( const ObjectArena& );
+
+		/** \brief Assignment is not allowed. */
+		ObjectArena& operator= ( const ObjectArena& );
+};
+
+#endif /* WATERSHED_LIBRARY_OPERATORS_ARENA_H_ */
@@ -0,0 +1,628 @@
+/**
+ * \file library/operators/hash_join.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ *
+ * Symmetric hash join of two input streams declared in the join element of the processing module XML:
+ *
+ *   <join left="orders" right="payments" window="60000"/>
+ *
+ * Both inputs must be labeled streams partitioned by the same policy function file, so tuples with the same key always
+ * meet at the same instance. The module extracts the key, and optionally the event time, with a JoinKeyFunction and
+ * receives the matches through a JoinOutput, usually building a new message and calling Send. The module resolves the
+ * input of each tuple once per producer, so the side is found by comparing input indexes:
+ *
+ *   SymmetricHashJoin join ( GetJoin ( ), &key_function, &output );
+ *   int left_input = GetInputIndex ( GetJoin ( )->GetLeft ( ) );
+ *   int right_input = GetInputIndex ( GetJoin ( )->GetRight ( ) );
+ *
+ *   int input = GetCurrentInput ( );
+ *   join.Insert ( ( input == left_input ) ? SymmetricHashJoin::LEFT : ( input == right_input ) ? SymmetricHashJoin::RIGHT : SymmetricHashJoin::NO_SIDE, message );
+ *
+ * Within ProcessBatch, MessageSpan::GetInput gives the input of each message instead of GetCurrentInput.
+ *
+ * Each tuple is probed against the tuples of the other input inserted within the join window and then stored. Tuples
+ * older than the greatest event time seen minus the window are evicted. Event times default to the origin time of the
+ * messages, in milliseconds.
+ */
+
+#ifndef WATERSHED_LIBRARY_OPERATORS_HASH_JOIN_H_
+#define WATERSHED_LIBRARY_OPERATORS_HASH_JOIN_H_
+
+/* C libraries */
+#include <string.h>
+
+/* C++ libraries */
+#include <deque>
+#include <string>
+
+/* Project's .h */
+#include "comm/message.h"
+#include "common/exceptions.h"
+#include "library/join_flow.h"
+#include "library/operators/arena.h"
+
+using namespace std;
+
+/**
+ * \class JoinTuple
+ * \brief A tuple stored by the join.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class JoinTuple {
+
+	public:
+
+		/**
+		 * \brief Creates a new JoinTuple instance.
+		 * \return Not applicable.
+		 */
+		JoinTuple ( void ) {
+			key_ = 0;
+			timestamp_ = 0;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~JoinTuple ( void ) {
+
+		}
+
+		/**
+		 * \brief Retrieves the tuple data.
+		 * \return Pointer to the data.
+		 */
+		const char* GetData ( void ) {
+			return data_.data ( );
+		}
+
+		/**
+		 * \brief Retrieves the tuple data size.
+		 * \return The data size in bytes.
+		 */
+		int GetDataSize ( void ) {
+			return data_.size ( );
+		}
+
+		/**
+		 * \brief Retrieves the join key.
+		 * \return The join key.
+		 */
+		unsigned long GetKey ( void ) {
+			return key_;
+		}
+
+		/**
+		 * \brief Retrieves the tuple timestamp.
+		 * \return The tuple timestamp.
+		 */
+		long GetTimestamp ( void ) {
+			return timestamp_;
+		}
+
+		/**
+		 * \brief Fills the tuple.
+		 * \param key The join key.
+		 * \param timestamp The tuple timestamp.
+		 * \param data The tuple data.
+		 * \param size The data size in bytes.
+		 * \return Not applicable.
+		 */
+		void Set ( unsigned long key, long timestamp, const char* data, int size ) {
+			key_ = key;
+			timestamp_ = timestamp;
+			data_.assign ( data, size );
+		}
+
+	protected:
+
+	private:
+
+		/** \brief The join key. */
+		unsigned long key_;
+
+		/** \brief The tuple timestamp. */
+		long timestamp_;
+
+		/** \brief The tuple data. */
+		string data_;
+};
+
+/**
+ * \class JoinKeyFunction
+ * \brief Extracts the join key of a message. It should be consistent with the label function of the joined inputs.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class JoinKeyFunction {
+
+	public:
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~JoinKeyFunction ( void ) {
+
+		}
+
+		/**
+		 * \brief Extracts the join key.
+		 * \param message The message.
+		 * \return The join key.
+		 */
+		virtual unsigned long GetKey ( Message& message ) = 0;
+
+		/**
+		 * \brief Extracts the event time compared with the join window. Defaults to the time the record entered the
+		 * system, kept by the message across hops.
+		 * \param message The message.
+		 * \return The event time in milliseconds.
+		 */
+		virtual long GetEventTime ( Message& message ) {
+			return ( long ) ( message.GetOriginTime ( ) / 1000000 );
+		}
+};
+
+/**
+ * \class JoinOutput
+ * \brief Receiver of the join matches.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class JoinOutput {
+
+	public:
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~JoinOutput ( void ) {
+
+		}
+
+		/**
+		 * \brief Receives a pair of matching tuples.
+		 * \param left The tuple of the left input.
+		 * \param right The tuple of the right input.
+		 * \return Not applicable.
+		 */
+		virtual void Emit ( JoinTuple& left, JoinTuple& right ) = 0;
+};
+
+/**
+ * \class JoinTable
+ * \brief Tuples of one side of the join. The index is an open addressing table with linear probing whose slots hold
+ * only the key and the tuple number, so a probe scans contiguous memory and touches the tuple data only on a match.
+ * Tuples are kept in arrival order, which is also the eviction order.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class JoinTable {
+
+	public:
+
+		/**
+		 * \brief Creates a new JoinTable instance.
+		 * \param capacity Number of tuples the table holds without growing.
+		 * \return Not applicable.
+		 */
+		JoinTable ( int capacity ) {
+			number_slots_ = 16;
+			while ( number_slots_ < 2 * ( unsigned long ) capacity ) { /* Keeps the load factor under 0.5 */
+				number_slots_ <<= 1;
+			}
+			slots_ = new Slot[number_slots_];
+			for ( unsigned long i = 0; i < number_slots_; ++i ) {
+				slots_[i].tuple_ = EMPTY_SLOT;
+			}
+			first_tuple_ = 0;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~JoinTable ( void ) {
+			for ( unsigned int i = 0; i < tuples_.size ( ); ++i ) {
+				tuple_arena_.Release ( tuples_[i] );
+			}
+			delete[] ( slots_ );
+		}
+
+		/**
+		 * \brief Removes the oldest tuples.
+		 * \param oldest_timestamp Tuples older than this timestamp are removed.
+		 * \return The number of removed tuples.
+		 */
+		int Evict ( long oldest_timestamp ) {
+			int number_evicted = 0;
+			while ( !tuples_.empty ( ) && tuples_.front ( )->GetTimestamp ( ) < oldest_timestamp ) {
+				RemoveSlot ( tuples_.front ( )->GetKey ( ), first_tuple_ );
+				tuple_arena_.Release ( tuples_.front ( ) );
+				tuples_.pop_front ( );
+				++first_tuple_;
+				++number_evicted;
+			}
+			return number_evicted;
+		}
+
+		/**
+		 * \brief Retrieves the number of stored tuples.
+		 * \return The number of tuples.
+		 */
+		int GetSize ( void ) {
+			return tuples_.size ( );
+		}
+
+		/**
+		 * \brief Stores a tuple.
+		 * \param key The join key.
+		 * \param timestamp The tuple timestamp.
+		 * \param data The tuple data.
+		 * \param size The data size in bytes.
+		 * \return The stored tuple.
+		 */
+		JoinTuple* Insert ( unsigned long key, long timestamp, const char* data, int size ) {
+			if ( 2 * ( tuples_.size ( ) + 1 ) > number_slots_ ) {
+				Grow ( );
+			}
+			JoinTuple* tuple = tuple_arena_.Allocate ( );
+			tuple->Set ( key, timestamp, data, size );
+			tuples_.push_back ( tuple );
+			InsertSlot ( key, first_tuple_ + tuples_.size ( ) - 1 );
+			return tuple;
+		}
+
+		/**
+		 * \brief Retrieves the first tuple with a given key.
+		 * \param key The join key.
+		 * \param position Probe position, updated to continue the search with GetNext.
+		 * \return The tuple or NULL if there is none.
+		 */
+		JoinTuple* GetFirst ( unsigned long key, unsigned long& position ) {
+			position = Hash ( key ) & ( number_slots_ - 1 );
+			return Find ( key, position );
+		}
+
+		/**
+		 * \brief Retrieves the next tuple with a given key.
+		 * \param key The join key.
+		 * \param position Probe position returned by GetFirst or by a previous GetNext.
+		 * \return The tuple or NULL if there is none.
+		 */
+		JoinTuple* GetNext ( unsigned long key, unsigned long& position ) {
+			position = ( position + 1 ) & ( number_slots_ - 1 );
+			return Find ( key, position );
+		}
+
+	protected:
+
+	private:
+
+		/** \brief Tuple number of an empty slot. */
+		static const long EMPTY_SLOT = -1;
+
+		/** \brief Entry of the index. */
+		struct Slot {
+				unsigned long key_;
+				long tuple_;
+		};
+
+		/**
+		 * \brief Mixes the key bits so that sequential keys spread over the table.
+		 * \param key The join key.
+		 * \return The hash value.
+		 */
+		static unsigned long Hash ( unsigned long key ) {
+			key ^= key >> 33;
+			key *= 0xff51afd7ed558ccdUL;
+			key ^= key >> 33;
+			key *= 0xc4ceb9fe1a85ec53UL;
+			key ^= key >> 33;
+			return key;
+		}
+
+		/**
+		 * \brief Scans the cluster from a position until a slot with a given key.
+		 * \param key The join key.
+		 * \param position The first position to be scanned, updated to the position found.
+		 * \return The tuple or NULL if there is none.
+		 */
+		JoinTuple* Find ( unsigned long key, unsigned long& position ) {
+			while ( slots_[position].tuple_ != EMPTY_SLOT ) {
+				if ( slots_[position].key_ == key ) {
+					return tuples_[slots_[position].tuple_ - first_tuple_];
+				}
+				position = ( position + 1 ) & ( number_slots_ - 1 );
+			}
+			return NULL;
+		}
+
+		/**
+		 * \brief Doubles the number of slots and rebuilds the index.
+		 * \return Not applicable.
+		 */
+		void Grow ( void ) {
+			delete[] ( slots_ );
+			number_slots_ <<= 1;
+			slots_ = new Slot[number_slots_];
+			for ( unsigned long i = 0; i < number_slots_; ++i ) {
+				slots_[i].tuple_ = EMPTY_SLOT;
+			}
+			for ( unsigned int i = 0; i < tuples_.size ( ); ++i ) {
+				InsertSlot ( tuples_[i]->GetKey ( ), first_tuple_ + i );
+			}
+		}
+
+		/**
+		 * \brief Inserts a tuple in the index.
+		 * \param key The join key.
+		 * \param tuple The tuple number.
+		 * \return Not applicable.
+		 */
+		void InsertSlot ( unsigned long key, long tuple ) {
+			unsigned long position = Hash ( key ) & ( number_slots_ - 1 );
+			while ( slots_[position].tuple_ != EMPTY_SLOT ) {
+				position = ( position + 1 ) & ( number_slots_ - 1 );
+			}
+			slots_[position].key_ = key;
+			slots_[position].tuple_ = tuple;
+		}
+
+		/**
+		 * \brief Removes a tuple from the index, shifting back the following slots of the cluster so that no tombstone is
+		 * needed.
+		 * \param key The join key.
+		 * \param tuple The tuple number.
+		 * \return Not applicable.
+		 */
+		void RemoveSlot ( unsigned long key, long tuple ) {
+			unsigned long mask = number_slots_ - 1;
+			unsigned long hole = Hash ( key ) & mask;
+			while ( slots_[hole].tuple_ != tuple ) {
+				if ( slots_[hole].tuple_ == EMPTY_SLOT ) {
+					return;
+				}
+				hole = ( hole + 1 ) & mask;
+			}
+			slots_[hole].tuple_ = EMPTY_SLOT;
+
+			unsigned long next = hole;
+			while ( true ) {
+				next = ( next + 1 ) & mask;
+				if ( slots_[next].tuple_ == EMPTY_SLOT ) {
+					return;
+				}
+				/* Moves the slot only if its home position is not between the hole and its current position */
+				unsigned long home = Hash ( slots_[next].key_ ) & mask;
+				if ( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) ) {
+					slots_[hole] = slots_[next];
+					slots_[next].tuple_ = EMPTY_SLOT;
+					hole = next;
+				}
+			}
+		}
+
+		/** \brief Number of the first tuple of tuples_. */
+		long first_tuple_;
+
+		/** \brief Number of slots, always a power of two. */
+		unsigned long number_slots_;
+
+		/** \brief The index. */
+		Slot* slots_;
+
+		/** \brief Stored tuples in arrival order. */
+		deque < JoinTuple* > tuples_;
+
+		/** \brief Storage of the tuples. */
+		ObjectArena < JoinTuple > tuple_arena_;
+
+		/** \brief Copy is not allowed. */
+		JoinTable ( const JoinTable& );
+
+		/** \brief Assignment is not allowed. */
+		JoinTable& operator= ( const JoinTable& );
+};
+
+/**
+ * \class SymmetricHashJoin
+ * \brief Time bounded symmetric hash join of two input streams.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class SymmetricHashJoin {
+
+	public:
+
+		/** \brief Identification of the left input. */
+		static const int LEFT = 0;
+
+		/** \brief Identification of the right input. */
+		static const int RIGHT = 1;
+
+		/** \brief Identification of a stream that is not joined. */
+		static const int NO_SIDE = -1;
+
+		/**
+		 * \brief Creates a new SymmetricHashJoin instance.
+		 * \param join_flow The join description from the processing module configuration.
+		 * \param key_function Extractor of the join key.
+		 * \param output Receiver of the matches.
+		 * \return Not applicable.
+		 */
+		SymmetricHashJoin ( JoinFlow* join_flow, JoinKeyFunction* key_function, JoinOutput* output ) throw ( BadParameterException ) {
+			if ( join_flow == NULL ) {
+				throw BadParameterException ( "the processing module does not define a join" );
+			}
+			left_ = join_flow->GetLeft ( );
+			right_ = join_flow->GetRight ( );
+			window_ = join_flow->GetWindow ( );
+			key_function_ = key_function;
+			output_ = output;
+			tables_[LEFT] = new JoinTable ( join_flow->GetCapacity ( ) );
+			tables_[RIGHT] = new JoinTable ( join_flow->GetCapacity ( ) );
+			started_ = false;
+			max_timestamp_ = 0;
+			number_evicted_ = 0;
+			number_matches_ = 0;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~SymmetricHashJoin ( void ) {
+			delete ( tables_[LEFT] );
+			delete ( tables_[RIGHT] );
+		}
+
+		/**
+		 * \brief Retrieves the number of tuples evicted by the window.
+		 * \return The number of evicted tuples.
+		 */
+		long GetNumberEvicted ( void ) {
+			return number_evicted_;
+		}
+
+		/**
+		 * \brief Retrieves the number of matches emitted.
+		 * \return The number of matches.
+		 */
+		long GetNumberMatches ( void ) {
+			return number_matches_;
+		}
+
+		/**
+		 * \brief Retrieves the number of tuples stored for an input.
+		 * \param side LEFT or RIGHT.
+		 * \return The number of stored tuples.
+		 */
+		int GetNumberTuples ( int side ) {
+			return tables_[side]->GetSize ( );
+		}
+
+		/**
+		 * \brief Retrieves the side of an input stream, for callers which know the stream name rather than the input
+		 * index. It should be resolved once per input instead of once per tuple.
+		 * \param stream_name The input stream name.
+		 * \return LEFT, RIGHT or NO_SIDE if the stream is not joined.
+		 */
+		int GetSide ( const string& stream_name ) {
+			if ( left_ == stream_name ) {
+				return LEFT;
+			}
+			if ( right_ == stream_name ) {
+				return RIGHT;
+			}
+			return NO_SIDE;
+		}
+
+		/**
+		 * \brief Joins a message from one of the inputs, using the key function for its key and event time.
+		 * \param side LEFT or RIGHT, the side of the input carrying the message.
+		 * \param message The received message.
+		 * \return False if the side is not LEFT or RIGHT.
+		 */
+		bool Insert ( int side, Message& message ) {
+			if ( side != LEFT && side != RIGHT ) {
+				return false;
+			}
+			Insert ( side, key_function_->GetKey ( message ), key_function_->GetEventTime ( message ), ( const char* ) message.GetData ( ), message.GetDataSize ( ) );
+			return true;
+		}
+
+		/**
+		 * \brief Joins a tuple from one of the inputs.
+		 * \param side LEFT or RIGHT.
+		 * \param key The join key.
+		 * \param timestamp The tuple timestamp.
+		 * \param data The tuple data.
+		 * \param size The data size in bytes.
+		 * \return Not applicable.
+		 */
+		void Insert ( int side, unsigned long key, long timestamp, const char* data, int size ) {
+			if ( !started_ || timestamp > max_timestamp_ ) {
+				started_ = true;
+				max_timestamp_ = timestamp;
+				number_evicted_ += tables_[LEFT]->Evict ( max_timestamp_ - window_ );
+				number_evicted_ += tables_[RIGHT]->Evict ( max_timestamp_ - window_ );
+			}
+			if ( timestamp < max_timestamp_ - window_ ) { /* Its matches were already evicted */
+				return;
+			}
+
+			JoinTuple* tuple = tables_[side]->Insert ( key, timestamp, data, size );
+			unsigned long position;
+			JoinTable* other = tables_[1 - side];
+			for ( JoinTuple* match = other->GetFirst ( key, position ); match != NULL; match = other->GetNext ( key, position ) ) {
+				long distance = match->GetTimestamp ( ) - timestamp;
+				if ( distance <= window_ && distance >= -window_ && output_ != NULL ) {
+					if ( side == LEFT ) {
+						output_->Emit ( *tuple, *match );
+					}
+					else {
+						output_->Emit ( *match, *tuple );
+					}
+					++number_matches_;
+				}
+			}
+		}
+
+	protected:
+
+	private:
+
+		/** \brief Flag indicating whether a tuple was already inserted. */
+		bool started_;
+
+		/** \brief The greatest event time seen. */
+		long max_timestamp_;
+
+		/** \brief Number of evicted tuples. */
+		long number_evicted_;
+
+		/** \brief Number of emitted matches. */
+		long number_matches_;
+
+		/** \brief The join window. */
+		long window_;
+
+		/** \brief The left input flow name. */
+		string left_;
+
+		/** \brief The right input flow name. */
+		string right_;
+
+		/** \brief Extractor of the join key. */
+		JoinKeyFunction* key_function_;
+
+		/** \brief Receiver of the matches. */
+		JoinOutput* output_;
+
+		/** \brief Tuples of each input. */
+		JoinTable* tables_[2];
+
+		/** \brief Copy is not allowed. */
+		SymmetricHashJoin ( const SymmetricHashJoin& );
+
+		/** \brief Assignment is not allowed. */
+		SymmetricHashJoin& operator= ( const SymmetricHashJoin& );
+};
+
+#endif /* WATERSHED_LIBRARY_OPERATORS_HASH_JOIN_H_ */
@@ -0,0 +1,859 @@
+/**
+ * \file library/operators/window.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ *
+ * Windowed aggregation operators. A module creates one window per aggregated stream, feeds it from Process and lets
+ * the window send the results through a WindowOutput, usually a WindowSender bound to the module:
+ *
+ *   WindowSender < long > sender ( this );
+ *   TumblingWindow < CountAggregate < int > > window ( 60000, 0, &sender );
+ *
+ *   void Process ( Message& message ) {
+ *     window.Insert ( message, 1 );
+ *   }
+ *
+ * Timestamps are the origin times of the messages, in milliseconds, unless the module passes its own event times. A
+ * window fires when the watermark, the greatest timestamp seen minus the allowed lateness, reaches its end. Records
+ * older than the oldest open window are dropped. A record more than a window ahead of the open windows closes them all
+ * at once, regardless of the allowed lateness.
+ */
+
+#ifndef WATERSHED_LIBRARY_OPERATORS_WINDOW_H_
+#define WATERSHED_LIBRARY_OPERATORS_WINDOW_H_
+
+/* C libraries */
+#include <limits.h>
+
+/* C++ libraries */
+#include <deque>
+#include <limits>
+#include <list>
+#include <sstream>
+
+/* Project's .h */
+#include "comm/message.h"
+#include "common/exceptions.h"
+#include "library/operators/arena.h"
+#include "library/processing_module.h"
+
+using namespace std;
+
+/**
+ * \class SumAggregate
+ * \brief Incremental sum of the window values.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename T >
+class SumAggregate {
+
+	public:
+
+		/** \brief Type of the inserted values. */
+		typedef T InputType;
+
+		/** \brief Type of the partial and final aggregates. */
+		typedef T ValueType;
+
+		/**
+		 * \brief Combines two partial aggregates.
+		 * \param first The older partial aggregate.
+		 * \param second The newer partial aggregate.
+		 * \return The combined aggregate.
+		 */
+		static ValueType Combine ( const ValueType& first, const ValueType& second ) {
+			return first + second;
+		}
+
+		/**
+		 * \brief Retrieves the aggregate of an empty window.
+		 * \return The identity element.
+		 */
+		static ValueType Identity ( void ) {
+			return ValueType ( );
+		}
+
+		/**
+		 * \brief Transforms an inserted value into a partial aggregate.
+		 * \param value The inserted value.
+		 * \return The partial aggregate.
+		 */
+		static ValueType Lift ( const InputType& value ) {
+			return value;
+		}
+};
+
+/**
+ * \class CountAggregate
+ * \brief Incremental count of the window values.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename T >
+class CountAggregate {
+
+	public:
+
+		/** \brief Type of the inserted values. */
+		typedef T InputType;
+
+		/** \brief Type of the partial and final aggregates. */
+		typedef long ValueType;
+
+		/**
+		 * \brief Combines two partial aggregates.
+		 * \param first The older partial aggregate.
+		 * \param second The newer partial aggregate.
+		 * \return The combined aggregate.
+		 */
+		static ValueType Combine ( const ValueType& first, const ValueType& second ) {
+			return first + second;
+		}
+
+		/**
+		 * \brief Retrieves the aggregate of an empty window.
+		 * \return The identity element.
+		 */
+		static ValueType Identity ( void ) {
+			return 0;
+		}
+
+		/**
+		 * \brief Transforms an inserted value into a partial aggregate.
+		 * \param value The inserted value.
+		 * \return The partial aggregate.
+		 */
+		static ValueType Lift ( const InputType& value ) {
+			return 1;
+		}
+};
+
+/**
+ * \class MinAggregate
+ * \brief Incremental minimum of the window values.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename T >
+class MinAggregate {
+
+	public:
+
+		/** \brief Type of the inserted values. */
+		typedef T InputType;
+
+		/** \brief Type of the partial and final aggregates. */
+		typedef T ValueType;
+
+		/**
+		 * \brief Combines two partial aggregates.
+		 * \param first The older partial aggregate.
+		 * \param second The newer partial aggregate.
+		 * \return The combined aggregate.
+		 */
+		static ValueType Combine ( const ValueType& first, const ValueType& second ) {
+			return ( second < first ) ? second : first;
+		}
+
+		/**
+		 * \brief Retrieves the aggregate of an empty window.
+		 * \return The identity element.
+		 */
+		static ValueType Identity ( void ) {
+			return numeric_limits < T >::max ( );
+		}
+
+		/**
+		 * \brief Transforms an inserted value into a partial aggregate.
+		 * \param value The inserted value.
+		 * \return The partial aggregate.
+		 */
+		static ValueType Lift ( const InputType& value ) {
+			return value;
+		}
+};
+
+/**
+ * \class MaxAggregate
+ * \brief Incremental maximum of the window values.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename T >
+class MaxAggregate {
+
+	public:
+
+		/** \brief Type of the inserted values. */
+		typedef T InputType;
+
+		/** \brief Type of the partial and final aggregates. */
+		typedef T ValueType;
+
+		/**
+		 * \brief Combines two partial aggregates.
+		 * \param first The older partial aggregate.
+		 * \param second The newer partial aggregate.
+		 * \return The combined aggregate.
+		 */
+		static ValueType Combine ( const ValueType& first, const ValueType& second ) {
+			return ( first < second ) ? second : first;
+		}
+
+		/**
+		 * \brief Retrieves the aggregate of an empty window.
+		 * \return The identity element.
+		 */
+		static ValueType Identity ( void ) {
+			return numeric_limits < T >::is_integer ? numeric_limits < T >::min ( ) : -numeric_limits < T >::max ( );
+		}
+
+		/**
+		 * \brief Transforms an inserted value into a partial aggregate.
+		 * \param value The inserted value.
+		 * \return The partial aggregate.
+		 */
+		static ValueType Lift ( const InputType& value ) {
+			return value;
+		}
+};
+
+/**
+ * \class WindowOutput
+ * \brief Receiver of the results of a window. Custom monoids follow the interface of SumAggregate: the InputType and
+ * ValueType types and the static Identity, Lift and Combine functions, where Combine must be associative.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename V >
+class WindowOutput {
+
+	public:
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~WindowOutput ( void ) {
+
+		}
+
+		/**
+		 * \brief Receives the aggregate of a closed window.
+		 * \param start The window start timestamp, inclusive.
+		 * \param end The window end timestamp, exclusive.
+		 * \param value The window aggregate.
+		 * \return Not applicable.
+		 */
+		virtual void Emit ( long start, long end, const V& value ) = 0;
+};
+
+/**
+ * \class WindowSender
+ * \brief Window output which sends each result to the consumers of a processing module as a text message in the form
+ * "start end value".
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename V >
+class WindowSender: public WindowOutput < V > {
+
+	public:
+
+		/**
+		 * \brief Creates a new WindowSender instance.
+		 * \param processing_module The module whose consumers receive the results.
+		 * \return Not applicable.
+		 */
+		WindowSender ( ProcessingModule* processing_module ) {
+			processing_module_ = processing_module;
+		}
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~WindowSender ( void ) {
+
+		}
+
+		/**
+		 * \brief Sends the aggregate of a closed window.
+		 * \param start The window start timestamp, inclusive.
+		 * \param end The window end timestamp, exclusive.
+		 * \param value The window aggregate.
+		 * \return Not applicable.
+		 */
+		void Emit ( long start, long end, const V& value ) {
+			ostringstream output;
+			output << start << " " << end << " " << value;
+			string message_data = output.str ( );
+			Message message ( ( void* ) message_data.c_str ( ), Constants::MESSAGE_OP_PROCESSING_MODULE_DATA, message_data.length ( ) + 1 );
+			processing_module_->Send ( message );
+		}
+
+	protected:
+
+	private:
+
+		/** \brief The module whose consumers receive the results. */
+		ProcessingModule* processing_module_;
+};
+
+/**
+ * \class PaneWindow
+ * \brief Sliding window of a given size advancing by a given slide. The time is split into panes of gcd(size, slide)
+ * units, each one keeping the partial aggregate of its records, so a window result combines size / pane partial
+ * aggregates instead of re-aggregating the records shared by overlapping windows. Panes are discarded as soon as no open
+ * window includes them.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename Aggregate >
+class PaneWindow {
+
+	public:
+
+		/** \brief Type of the inserted values. */
+		typedef typename Aggregate::InputType InputType;
+
+		/** \brief Type of the window results. */
+		typedef typename Aggregate::ValueType ValueType;
+
+		/**
+		 * \brief Creates a new PaneWindow instance.
+		 * \param size The window size.
+		 * \param slide The distance between the start of two consecutive windows.
+		 * \param allowed_lateness How much the watermark is delayed from the greatest timestamp seen.
+		 * \param output Receiver of the window results.
+		 * \return Not applicable.
+		 */
+		PaneWindow ( long size, long slide, long allowed_lateness, WindowOutput < ValueType >* output ) throw ( BadParameterException ) {
+			if ( size <= 0 || slide <= 0 || allowed_lateness < 0 ) {
+				throw BadParameterException ( "window size and slide must be positive and the allowed lateness cannot be negative" );
+			}
+			size_ = size;
+			slide_ = slide;
+			pane_size_ = GreatestCommonDivisor ( size, slide );
+			panes_per_window_ = size / pane_size_;
+			panes_per_slide_ = slide / pane_size_;
+			allowed_lateness_ = allowed_lateness;
+			output_ = output;
+			started_ = false;
+			first_pane_ = 0;
+			next_window_ = 0;
+			max_timestamp_ = 0;
+			number_dropped_ = 0;
+		}
+
+		/**
+		 * \brief Destructor. Discards the open windows.
+		 * \return Not applicable.
+		 */
+		virtual ~PaneWindow ( void ) {
+			for ( unsigned int i = 0; i < panes_.size ( ); ++i ) {
+				if ( panes_[i] != NULL ) {
+					pane_arena_.Release ( panes_[i] );
+				}
+			}
+			panes_.clear ( );
+		}
+
+		/**
+		 * \brief Retrieves the number of records dropped for arriving after their windows were closed.
+		 * \return The number of dropped records.
+		 */
+		long GetNumberDropped ( void ) {
+			return number_dropped_;
+		}
+
+		/**
+		 * \brief Retrieves the number of panes holding data.
+		 * \return The number of live panes.
+		 */
+		int GetNumberPanes ( void ) {
+			return pane_arena_.GetNumberAllocated ( );
+		}
+
+		/**
+		 * \brief Closes all the windows ending until a given timestamp. Used by modules driven by time instead of records.
+		 * \param watermark No record older than this timestamp is expected anymore.
+		 * \return Not applicable.
+		 */
+		void Advance ( long watermark ) {
+			if ( !started_ ) {
+				return;
+			}
+			while ( true ) {
+				if ( panes_.empty ( ) ) { /* Skips the windows without data */
+					long first_open_window = FloorDivide ( watermark - size_, slide_ ) + 1;
+					if ( first_open_window > next_window_ ) {
+						next_window_ = first_open_window;
+					}
+					first_pane_ = next_window_ * panes_per_slide_;
+					return;
+				}
+				if ( next_window_ * slide_ + size_ > watermark ) {
+					return;
+				}
+				EmitWindow ( );
+				++next_window_;
+				EvictPanes ( );
+			}
+		}
+
+		/**
+		 * \brief Closes all the open windows. Usually called before the module terminates.
+		 * \return Not applicable.
+		 */
+		void Flush ( void ) {
+			while ( !panes_.empty ( ) ) {
+				EmitWindow ( );
+				++next_window_;
+				EvictPanes ( );
+			}
+		}
+
+		/**
+		 * \brief Inserts a record in the window.
+		 * \param timestamp The record timestamp.
+		 * \param value The record value.
+		 * \return Not applicable.
+		 */
+		void Insert ( long timestamp, const InputType& value ) {
+			if ( !started_ ) {
+				started_ = true;
+				next_window_ = FloorDivide ( timestamp - size_, slide_ ) + 1;
+				first_pane_ = next_window_ * panes_per_slide_;
+				max_timestamp_ = timestamp;
+			}
+
+			long pane = FloorDivide ( timestamp, pane_size_ );
+			if ( pane < next_window_ * panes_per_slide_ ) { /* All the windows including this record were closed */
+				++number_dropped_;
+				return;
+			}
+
+			/* A record more than a window past the kept panes closes every window holding them, and the windows in
+			 * between are skipped, so memory and time do not grow with the gap between timestamps */
+			if ( pane >= first_pane_ + ( long ) panes_.size ( ) + panes_per_window_ ) {
+				Flush ( );
+				long first_window = FloorDivide ( timestamp - size_, slide_ ) + 1;
+				if ( first_window > next_window_ ) {
+					next_window_ = first_window;
+				}
+			}
+			if ( panes_.empty ( ) ) {
+				first_pane_ = next_window_ * panes_per_slide_;
+			}
+			while ( first_pane_ + ( long ) panes_.size ( ) <= pane ) {
+				panes_.push_back ( NULL );
+			}
+			Pane*& current_pane = panes_[pane - first_pane_];
+			if ( current_pane == NULL ) {
+				current_pane = pane_arena_.Allocate ( );
+				current_pane->value_ = Aggregate::Identity ( );
+			}
+			current_pane->value_ = Aggregate::Combine ( current_pane->value_, Aggregate::Lift ( value ) );
+
+			if ( timestamp > max_timestamp_ ) {
+				max_timestamp_ = timestamp;
+			}
+			Advance ( max_timestamp_ - allowed_lateness_ );
+		}
+
+		/**
+		 * \brief Inserts a record in the window using the message origin time, the time the record entered the system,
+		 * in milliseconds.
+		 * \param message The message carrying the record.
+		 * \param value The record value.
+		 * \return Not applicable.
+		 */
+		void Insert ( Message& message, const InputType& value ) {
+			Insert ( ( long ) ( message.GetOriginTime ( ) / 1000000 ), value );
+		}
+
+	protected:
+
+	private:
+
+		/** \brief Partial aggregate of the records of a pane. */
+		struct Pane {
+				ValueType value_;
+		};
+
+		/**
+		 * \brief Division rounding towards minus infinity.
+		 * \param dividend The dividend.
+		 * \param divisor The divisor, greater than zero.
+		 * \return The quotient.
+		 */
+		static long FloorDivide ( long dividend, long divisor ) {
+			long quotient = dividend / divisor;
+			if ( dividend % divisor != 0 && dividend < 0 ) {
+				--quotient;
+			}
+			return quotient;
+		}
+
+		/**
+		 * \brief Computes the greatest common divisor of two positive numbers.
+		 * \param a The first number.
+		 * \param b The second number.
+		 * \return The greatest common divisor.
+		 */
+		static long GreatestCommonDivisor ( long a, long b ) {
+			while ( b != 0 ) {
+				long r = a % b;
+				a = b;
+				b = r;
+			}
+			return a;
+		}
+
+		/**
+		 * \brief Combines the panes of the next window and sends the result, if the window has data.
+		 * \return Not applicable.
+		 */
+		void EmitWindow ( void ) {
+			long start_pane = next_window_ * panes_per_slide_;
+			bool has_data = false;
+			ValueType value = Aggregate::Identity ( );
+			for ( long p = start_pane; p < start_pane + panes_per_window_; ++p ) {
+				if ( p >= first_pane_ && p < first_pane_ + ( long ) panes_.size ( ) && panes_[p - first_pane_] != NULL ) {
+					value = Aggregate::Combine ( value, panes_[p - first_pane_]->value_ );
+					has_data = true;
+				}
+			}
+			if ( has_data && output_ != NULL ) {
+				output_->Emit ( next_window_ * slide_, next_window_ * slide_ + size_, value );
+			}
+		}
+
+		/**
+		 * \brief Discards the panes which do not belong to any open window.
+		 * \return Not applicable.
+		 */
+		void EvictPanes ( void ) {
+			while ( !panes_.empty ( ) && first_pane_ < next_window_ * panes_per_slide_ ) {
+				if ( panes_.front ( ) != NULL ) {
+					pane_arena_.Release ( panes_.front ( ) );
+				}
+				panes_.pop_front ( );
+				++first_pane_;
+			}
+		}
+
+		/** \brief Flag indicating whether a record was already inserted. */
+		bool started_;
+
+		/** \brief How much the watermark is delayed from the greatest timestamp seen. */
+		long allowed_lateness_;
+
+		/** \brief Index of the first pane kept in memory. */
+		long first_pane_;
+
+		/** \brief The greatest timestamp seen. */
+		long max_timestamp_;
+
+		/** \brief Index of the next window to be closed. */
+		long next_window_;
+
+		/** \brief Number of late records dropped. */
+		long number_dropped_;
+
+		/** \brief Size of a pane. */
+		long pane_size_;
+
+		/** \brief Number of panes in a slide. */
+		long panes_per_slide_;
+
+		/** \brief Number of panes in a window. */
+		long panes_per_window_;
+
+		/** \brief The window size. */
+		long size_;
+
+		/** \brief The window slide. */
+		long slide_;
+
+		/** \brief Panes kept in memory, starting at first_pane_. Empty panes are NULL. */
+		deque < Pane* > panes_;
+
+		/** \brief Storage of the panes. */
+		ObjectArena < Pane > pane_arena_;
+
+		/** \brief Receiver of the window results. */
+		WindowOutput < ValueType >* output_;
+};
+
+/**
+ * \class SlidingWindow
+ * \brief Window of a given size advancing by a given slide.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename Aggregate >
+class SlidingWindow: public PaneWindow < Aggregate > {
+
+	public:
+
+		/**
+		 * \brief Creates a new SlidingWindow instance.
+		 * \param size The window size.
+		 * \param slide The distance between the start of two consecutive windows.
+		 * \param allowed_lateness How much the watermark is delayed from the greatest timestamp seen.
+		 * \param output Receiver of the window results.
+		 * \return Not applicable.
+		 */
+		SlidingWindow ( long size, long slide, long allowed_lateness, WindowOutput < typename Aggregate::ValueType >* output ) throw ( BadParameterException ) :
+			PaneWindow < Aggregate > ( size, slide, allowed_lateness, output ) {
+		}
+};
+
+/**
+ * \class TumblingWindow
+ * \brief Window of a given size where consecutive windows do not overlap.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename Aggregate >
+class TumblingWindow: public PaneWindow < Aggregate > {
+
+	public:
+
+		/**
+		 * \brief Creates a new TumblingWindow instance.
+		 * \param size The window size.
+		 * \param allowed_lateness How much the watermark is delayed from the greatest timestamp seen.
+		 * \param output Receiver of the window results.
+		 * \return Not applicable.
+		 */
+		TumblingWindow ( long size, long allowed_lateness, WindowOutput < typename Aggregate::ValueType >* output ) throw ( BadParameterException ) :
+			PaneWindow < Aggregate > ( size, size, allowed_lateness, output ) {
+		}
+};
+
+/**
+ * \class SessionWindow
+ * \brief Window grouping records separated by less than a gap. A session closes when the watermark passes its last
+ * record plus the gap. Sessions bridged by a new record are merged.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+template < typename Aggregate >
+class SessionWindow {
+
+	public:
+
+		/** \brief Type of the inserted values. */
+		typedef typename Aggregate::InputType InputType;
+
+		/** \brief Type of the window results. */
+		typedef typename Aggregate::ValueType ValueType;
+
+		/**
+		 * \brief Creates a new SessionWindow instance.
+		 * \param gap The inactivity time which closes a session.
+		 * \param allowed_lateness How much the watermark is delayed from the greatest timestamp seen.
+		 * \param output Receiver of the window results.
+		 * \return Not applicable.
+		 */
+		SessionWindow ( long gap, long allowed_lateness, WindowOutput < ValueType >* output ) throw ( BadParameterException ) {
+			if ( gap <= 0 || allowed_lateness < 0 ) {
+				throw BadParameterException ( "session gap must be positive and the allowed lateness cannot be negative" );
+			}
+			gap_ = gap;
+			allowed_lateness_ = allowed_lateness;
+			output_ = output;
+			started_ = false;
+			max_timestamp_ = 0;
+			number_dropped_ = 0;
+			watermark_ = LONG_MIN;
+		}
+
+		/**
+		 * \brief Destructor. Discards the open sessions.
+		 * \return Not applicable.
+		 */
+		virtual ~SessionWindow ( void ) {
+			for ( typename list < Session* >::iterator s = sessions_.begin ( ); s != sessions_.end ( ); ++s ) {
+				session_arena_.Release ( *s );
+			}
+			sessions_.clear ( );
+		}
+
+		/**
+		 * \brief Retrieves the number of records dropped for arriving after their sessions were closed.
+		 * \return The number of dropped records.
+		 */
+		long GetNumberDropped ( void ) {
+			return number_dropped_;
+		}
+
+		/**
+		 * \brief Retrieves the number of open sessions.
+		 * \return The number of open sessions.
+		 */
+		int GetNumberSessions ( void ) {
+			return sessions_.size ( );
+		}
+
+		/**
+		 * \brief Closes all the sessions ending until a given timestamp.
+		 * \param watermark No record older than this timestamp is expected anymore.
+		 * \return Not applicable.
+		 */
+		void Advance ( long watermark ) {
+			if ( watermark > watermark_ ) {
+				watermark_ = watermark;
+			}
+			/* Sessions are disjoint, so the list is sorted by both start and end */
+			while ( !sessions_.empty ( ) && sessions_.front ( )->end_ <= watermark_ ) {
+				EmitSession ( sessions_.front ( ) );
+				sessions_.pop_front ( );
+			}
+		}
+
+		/**
+		 * \brief Closes all the open sessions.
+		 * \return Not applicable.
+		 */
+		void Flush ( void ) {
+			while ( !sessions_.empty ( ) ) {
+				EmitSession ( sessions_.front ( ) );
+				sessions_.pop_front ( );
+			}
+		}
+
+		/**
+		 * \brief Inserts a record in the window.
+		 * \param timestamp The record timestamp.
+		 * \param value The record value.
+		 * \return Not applicable.
+		 */
+		void Insert ( long timestamp, const InputType& value ) {
+			if ( timestamp + gap_ <= watermark_ ) { /* The session of this record was closed */
+				++number_dropped_;
+				return;
+			}
+
+			Session* session = session_arena_.Allocate ( );
+			session->start_ = timestamp;
+			session->end_ = timestamp + gap_;
+			session->value_ = Aggregate::Lift ( value );
+
+			/* Merges the sessions within the gap of the record */
+			typename list < Session* >::iterator s = sessions_.begin ( );
+			while ( s != sessions_.end ( ) && ( *s )->start_ < session->end_ ) {
+				if ( ( *s )->end_ > session->start_ ) {
+					if ( ( *s )->start_ < session->start_ ) {
+						session->value_ = Aggregate::Combine ( ( *s )->value_, session->value_ );
+						session->start_ = ( *s )->start_;
+					}
+					else {
+						session->value_ = Aggregate::Combine ( session->value_, ( *s )->value_ );
+					}
+					if ( ( *s )->end_ > session->end_ ) {
+						session->end_ = ( *s )->end_;
+					}
+					session_arena_.Release ( *s );
+					s = sessions_.erase ( s );
+				}
+				else {
+					++s;
+				}
+			}
+			sessions_.insert ( s, session );
+
+			if ( !started_ || timestamp > max_timestamp_ ) {
+				started_ = true;
+				max_timestamp_ = timestamp;
+			}
+			Advance ( max_timestamp_ - allowed_lateness_ );
+		}
+
+		/**
+		 * \brief Inserts a record in the window using the message origin time, the time the record entered the system,
+		 * in milliseconds.
+		 * \param message The message carrying the record.
+		 * \param value The record value.
+		 * \return Not applicable.
+		 */
+		void Insert ( Message& message, const InputType& value ) {
+			Insert ( ( long ) ( message.GetOriginTime ( ) / 1000000 ), value );
+		}
+
+	protected:
+
+	private:
+
+		/** \brief An open session. */
+		struct Session {
+				long start_;
+				long end_;
+				ValueType value_;
+		};
+
+		/**
+		 * \brief Sends the result of a session and releases it.
+		 * \param session The session to be closed.
+		 * \return Not applicable.
+		 */
+		void EmitSession ( Session* session ) {
+			if ( output_ != NULL ) {
+				output_->Emit ( session->start_, session->end_, session->value_ );
+			}
+			session_arena_.Release ( session );
+		}
+
+		/** \brief Flag indicating whether a record was already inserted. */
+		bool started_;
+
+		/** \brief How much the watermark is delayed from the greatest timestamp seen. */
+		long allowed_lateness_;
+
+		/** \brief The inactivity time which closes a session. */
+		long gap_;
+
+		/** \brief The greatest timestamp seen. */
+		long max_timestamp_;
+
+		/** \brief Number of late records dropped. */
+		long number_dropped_;
+
+		/** \brief The current watermark. */
+		long watermark_;
+
+		/** \brief Open sessions sorted by start. */
+		list < Session* > sessions_;
+
+		/** \brief Storage of the sessions. */
+		ObjectArena < Session > session_arena_;
+
+		/** \brief Receiver of the window results. */
+		WindowOutput < ValueType >* output_;
+};
+
+#endif /* WATERSHED_LIBRARY_OPERATORS_WINDOW_H_ */
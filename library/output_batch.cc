@@ -0,0 +1,39 @@
+/**
+ * \file library/output_batch.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "library/output_batch.h"
+#include "library/processing_module.h"
+
+OutputBatch::OutputBatch ( ProcessingModule* processing_module, int capacity ) {
+	processing_module_ = processing_module;
+	capacity_ = capacity;
+	size_ = 0;
+}
+
+OutputBatch::~OutputBatch ( void ) {
+}
+
+bool OutputBatch::Add ( Message& message ) {
+	if ( IsFull ( ) ) {
+		return false;
+	}
+	processing_module_->Send ( message );
+	++size_;
+	return true;
+}
+
+int OutputBatch::GetCapacity ( void ) {
+	return capacity_;
+}
+
+int OutputBatch::GetSize ( void ) {
+	return size_;
+}
+
+bool OutputBatch::IsFull ( void ) {
+	return size_ >= capacity_;
+}
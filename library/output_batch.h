@@ -0,0 +1,83 @@
+/**
+ * \file library/output_batch.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_OUTPUT_BATCH_H_
+#define WATERSHED_LIBRARY_OUTPUT_BATCH_H_
+
+/* Project's .h */
+#include "comm/message.h"
+
+using namespace std;
+
+class ProcessingModule;
+
+/**
+ * \class OutputBatch
+ * \brief Records produced by a source processing module in a single Generate call. Each added record is sent at once
+ * to the module consumers, so the batch capacity only bounds how many records the source may produce in the call.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class OutputBatch {
+
+	public:
+
+		/**
+		 * \brief Creates a new OutputBatch instance.
+		 * \param processing_module The module sending the records.
+		 * \param capacity Maximum number of records in the batch.
+		 * \return Not applicable.
+		 */
+		OutputBatch ( ProcessingModule* processing_module, int capacity );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~OutputBatch ( void );
+
+		/**
+		 * \brief Sends a record to the module consumers if the batch is not full.
+		 * \param message The record.
+		 * \return False if the batch is full and the record was not sent.
+		 */
+		bool Add ( Message& message );
+
+		/**
+		 * \brief Checks if the batch is full.
+		 * \return True if no record can be added.
+		 */
+		bool IsFull ( void );
+
+		/**
+		 * \brief Retrieves the maximum number of records in the batch.
+		 * \return The batch capacity.
+		 */
+		int GetCapacity ( void );
+
+		/**
+		 * \brief Retrieves the number of records already added.
+		 * \return The number of records.
+		 */
+		int GetSize ( void );
+
+	protected:
+
+	private:
+
+		/** \brief Maximum number of records. */
+		int capacity_;
+
+		/** \brief Number of records added. */
+		int size_;
+
+		/** \brief The module sending the records. */
+		ProcessingModule* processing_module_;
+};
+
+#endif /* WATERSHED_LIBRARY_OUTPUT_BATCH_H_ */
@@ -15,13 +15,37 @@ extern char** argv_;
 ProcessingModule::ProcessingModule ( void ) {
 	SetInitialTime ( );
 	message_sequence_number_ = 0;
+	records_sent_ = 0;
+	records_received_ = 0;
+	origin_time_ = 0;
+	last_statistics_records_ = 0;
+	last_statistics_time_ = 0;
+	last_statistics_cpu_time_ = 0;
+	last_statistics_voluntary_switches_ = 0;
+	last_statistics_involuntary_switches_ = 0;
+	last_resources_time_ = 0;
+	last_resources_cpu_time_ = 0;
+	starvation_time_ = 0;
+	aligning_checkpoint_ = -1;
+	last_checkpoint_ = -1;
+	requested_checkpoint_ = -1;
+	checkpoint_writer_ = NULL;
+	token_bucket_ = NULL;
+	logger_ = NULL;
+	output_schema_ = NULL;
 	error_on_init_ = false;
 	termination_requested_ = false;
+	requested_instances_ = false;
+	requested_migration_ = -1;
+	migration_successor_ = -1;
 	error_message_on_init_ = "";
 
 	/* Communicator including all the processing module instances. */
 	group_communicator_ = new MpiCommunicator ( argc_, argv_, Constants::COMM_SCOPE_WORLD );
 	database_communicator_ = NULL;
+	batch_messages_ = NULL;
+	batch_inputs_ = NULL;
+	current_input_ = -1;
 
 	shutdown_notification_ = false;
 	CreateArguments ( );
@@ -34,8 +58,12 @@ ProcessingModule::~ProcessingModule ( void ) {
 
 	/* Synchronizes all instances to terminate together */
 	group_communicator_->Synchronize ( );
+	StopLogger ( );
 
 	arguments_.clear ( );
+	for ( map < string, DataConsumer* >::iterator c = consumers_.begin ( ); c != consumers_.end ( ); ++c ) {
+		ReportQuerySelectivity ( c->second );
+	}
 	pthread_t disconnection_threads[2];
 	pthread_create ( &disconnection_threads[0], 0, &ProcessingModule::ThreadDisconnectConsumers, this );
 	pthread_create ( &disconnection_threads[1], 0, &ProcessingModule::ThreadDisconnectProducers, this );
@@ -51,6 +79,14 @@ ProcessingModule::~ProcessingModule ( void ) {
 	delete ( runtime_communicator_ );
 	delete ( group_communicator_ );
 	delete ( processing_module_configurator_ );
+	delete[] ( batch_messages_ );
+	delete[] ( batch_inputs_ );
+	delete ( token_bucket_ );
+	delete ( output_schema_ );
+	delete ( checkpoint_writer_ );
+	for ( map < string, ReorderBuffer* >::iterator b = reorder_buffers_.begin ( ); b != reorder_buffers_.end ( ); ++b ) {
+		delete ( b->second );
+	}
 }
 
 void ProcessingModule::AcceptConnection ( void ) {
@@ -96,12 +132,46 @@ void ProcessingModule::AcceptConnection ( void ) {
 	}
 }
 
+void ProcessingModule::AlignCheckpointBarrier ( string producer_id, int source, long checkpoint, int* batch_size ) {
+	if ( checkpoint <= last_checkpoint_ ) {
+		return;
+	}
+	if ( aligning_checkpoint_ == -1 ) {
+		aligning_checkpoint_ = checkpoint;
+	}
+	aligned_channels_.insert ( make_pair ( producer_id, source ) );
+	if ( ( int ) aligned_channels_.size ( ) < GetNumberProducerInstances ( ) ) {
+		return;
+	}
+
+	/* The messages received before the barriers belong to the checkpoint */
+	ReleaseOrderedMessages ( true, batch_size );
+	FlushBatch ( batch_size );
+	TakeCheckpoint ( aligning_checkpoint_ );
+	aligning_checkpoint_ = -1;
+	aligned_channels_.clear ( );
+	for ( set < pair < string, int > >::iterator d = deferred_credits_.begin ( ); d != deferred_credits_.end ( ); ++d ) {
+		if ( producers_.find ( d->first ) != producers_.end ( ) ) {
+			SendCreditToProducer ( d->second, d->first );
+		}
+	}
+	deferred_credits_.clear ( );
+
+	deque < ChannelMessage > aligned_messages;
+	aligned_messages.swap ( aligned_messages_ );
+	for ( deque < ChannelMessage >::iterator m = aligned_messages.begin ( ); m != aligned_messages.end ( ); ++m ) {
+		batch_messages_[*batch_size] = m->message_;
+		DeliverProducerMessage ( m->producer_id_, m->source_, batch_size );
+		if ( *batch_size == processing_module_configurator_->GetBatchSize ( ) ) {
+			FlushBatch ( batch_size );
+		}
+	}
+}
+
 string ProcessingModule::AddConsumer ( MpiCommunicator* new_communicator, Message& received_message ) throw ( FileOperationException ) {
-	string configurator_file_name = ( char* ) received_message.GetData ( );
 	ProcessingModuleConfigurator* consumer_configurator;
 	try {
-		consumer_configurator = new ProcessingModuleConfigurator ( configurator_file_name );
-		consumer_configurator->SetConfiguratorFileName ( configurator_file_name );
+		consumer_configurator = new ProcessingModuleConfigurator ( ( char* ) received_message.GetData ( ), received_message.GetDataSize ( ) );
 	}
 	catch ( XMLParserException& e ) {
 		throw ( e );
@@ -112,8 +182,9 @@ string ProcessingModule::AddConsumer ( MpiCommunicator* new_communicator, Messag
 	for ( uint i = 0; i < consumer_inputs->size ( ); ++i ) {
 		if ( consumer_inputs->at ( i ).GetName ( ).compare ( processing_module_configurator_->GetFlowOut ( ) ) == 0 ) {
 			try {
-				new_consumer = new DataConsumer ( consumer_inputs->at ( i ).GetPolicyFunctionFile ( ), consumer_configurator->GetName ( ), consumer_inputs->at ( i ).GetPolicy ( ), consumer_configurator->GetQueryFlowIn ( ) );
+				new_consumer = new DataConsumer ( consumer_inputs->at ( i ).GetPolicyFunctionFile ( ), consumer_configurator->GetName ( ), consumer_inputs->at ( i ).GetPolicy ( ), consumer_inputs->at ( i ).GetQuery ( ), consumer_inputs->at ( i ).GetPushdown ( ) );
 				new_consumer->SetCommunicator ( new_communicator );
+				new_consumer->SetSchema ( output_schema_ );
 			}
 			catch ( FileOperationException& e ) {
 				throw e;
@@ -123,22 +194,34 @@ string ProcessingModule::AddConsumer ( MpiCommunicator* new_communicator, Messag
 
 	// Sends the producer name to the new consumer
 	if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
-		Message info_message ( ( void* ) processing_module_configurator_->GetConfiguratorFileName ( ).c_str ( ), Constants::MESSAGE_OP_CONSUMER_PROCESSING_MODULE_PRESENTATION, processing_module_configurator_->GetConfiguratorFileName ( ).length ( ) + 1 );
+		string descriptor = processing_module_configurator_->Serialize ( );
+		Message info_message ( ( void* ) descriptor.data ( ), Constants::MESSAGE_OP_CONSUMER_PROCESSING_MODULE_PRESENTATION, descriptor.length ( ) );
 		new_consumer->GetCommunicator ( )->BroadCast ( &info_message );
 	}
 
+	// A consumer which has added instances connects again
+	if ( consumers_.find ( new_consumer->GetName ( ) ) != consumers_.end ( ) ) {
+		RetireConsumer ( new_consumer->GetName ( ) );
+	}
+	new_consumer->SetMetricsStream ( metrics_.AddStream ( new_consumer->GetName ( ), Constants::METRICS_OUTPUT ) );
 	consumers_[new_consumer->GetName ( )] = new_consumer;
 	string log_message_data = consumer_configurator->GetName ( ) + " has connected to " + processing_module_configurator_->GetName ( ) + " as consumer";
 	delete ( consumer_configurator );
 	return log_message_data;
 }
 
+void ProcessingModule::AddInstances ( void ) {
+	group_communicator_->Synchronize ( );
+	MpiCommunicator* new_communicator = group_communicator_->Accept ( processing_module_configurator_->GetPortName ( ) );
+	group_communicator_->Synchronize ( );
+	MergeGroup ( new_communicator, false );
+}
+
 string ProcessingModule::AddProducer ( MpiCommunicator* new_communicator, Message& received_message ) {
 	Message output_message;
-	string configurator_file_name = ( char* ) received_message.GetData ( );
 	ProcessingModuleConfigurator* producer_configurator;
 	try {
-		producer_configurator = new ProcessingModuleConfigurator ( configurator_file_name );
+		producer_configurator = new ProcessingModuleConfigurator ( ( char* ) received_message.GetData ( ), received_message.GetDataSize ( ) );
 	}
 	catch ( XMLParserException& e ) {
 		throw ( e );
@@ -146,14 +229,22 @@ string ProcessingModule::AddProducer ( MpiCommunicator* new_communicator, Messag
 
 	if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
 		output_message.SetOperationCode ( Constants::MESSAGE_OP_PRODUCER_PROCESSING_MODULE_PRESENTATION );
-		string message_data = processing_module_configurator_->GetConfiguratorFileName ( );
-		output_message.SetData ( ( void* ) message_data.c_str ( ), message_data.length ( ) + 1 );
+		string descriptor = processing_module_configurator_->Serialize ( );
+		output_message.SetData ( ( void* ) descriptor.data ( ), descriptor.length ( ) );
 		new_communicator->BroadCast ( &output_message );
 	}
 
 	DataProducer* new_producer = new DataProducer ( producer_configurator->GetName ( ) );
 	new_producer->SetCommunicator ( new_communicator );
 	new_producer->SetFlowOut ( producer_configurator->GetFlowOut ( ) );
+	new_producer->SetSchema ( LoadSchema ( producer_configurator ) );
+
+	/* A producer which has added instances connects again */
+	if ( producers_.find ( new_producer->GetName ( ) ) != producers_.end ( ) ) {
+		RetireProducer ( new_producer->GetName ( ) );
+	}
+	new_producer->SetMetricsStream ( metrics_.AddStream ( new_producer->GetFlowOut ( ), Constants::METRICS_INPUT ) );
+	new_producer->SetInputIndex ( GetInputIndex ( new_producer->GetFlowOut ( ) ) );
 	producers_[new_producer->GetName ( )] = new_producer;
 
 	for ( int i = 0; i < new_producer->GetNumberInstances ( ); ++i ) {
@@ -166,6 +257,10 @@ string ProcessingModule::AddProducer ( MpiCommunicator* new_communicator, Messag
 	return log_message_data;
 }
 
+bool ProcessingModule::CancelTimer ( int timer_id ) {
+	return timer_wheel_.CancelTimer ( timer_id );
+}
+
 int ProcessingModule::ComputeProducerCredit ( void ) {
 	if ( GetNumberProducerInstances ( ) != 0 ) {
 		return Constants::SHARED_CREDIT / GetNumberProducerInstances ( );
@@ -176,10 +271,17 @@ int ProcessingModule::ComputeProducerCredit ( void ) {
 }
 
 void ProcessingModule::ComputeResourcesUsage ( void ) {
-	struct rusage t;
-	getrusage ( RUSAGE_THREAD, &t );
-	user_time_ = ( t.ru_utime.tv_sec ) + ( t.ru_utime.tv_usec ) * 0.000001;
-	system_time_ = ( t.ru_stime.tv_sec ) + ( t.ru_stime.tv_usec ) * 0.000001;
+	double clock_time = GetClockTime ( );
+	resources_.Sample ( );
+
+	int utilization = 0;
+	if ( clock_time > last_resources_time_ ) {
+		utilization = ( int ) ( ( GetCPUTime ( ) - last_resources_cpu_time_ ) * 100 / ( clock_time - last_resources_time_ ) );
+	}
+	metrics_.SetResources ( utilization, resources_.GetUserTime ( ), resources_.GetSystemTime ( ), resources_.GetResidentSize ( ), resources_.GetVoluntarySwitches ( ), resources_.GetInvoluntarySwitches ( ), resources_.GetMinorFaults ( ), resources_.GetMajorFaults ( ) );
+
+	last_resources_time_ = clock_time;
+	last_resources_cpu_time_ = GetCPUTime ( );
 }
 
 void ProcessingModule::ConfigureProcess ( void ) {
@@ -230,15 +332,16 @@ void ProcessingModule::ConnectToConsumers ( void ) throw ( FileOperationExceptio
 		source = runtime_communicator_->Poll ( Constants::COMM_ROOT_PROCESS, Constants::MESSAGE_OP_PROCESSING_MODULE_PORTS_QUERY );
 		runtime_communicator_->Receive ( source, &input_message );
 
-		/* Connects to all consumers. */
+		/* Connects to all consumers, presenting this module by its descriptor. */
 		vector < string > consumers_ports = Util::TokenizeString ( " ", ( char* ) input_message.GetData ( ) );
+		string descriptor = processing_module_configurator_->Serialize ( );
 		for ( int i = 0; i < ( int ) consumers_ports.size ( ); ++i ) {
 			group_communicator_->Synchronize ( );
 			MpiCommunicator* new_communicator = group_communicator_->Connect ( consumers_ports[i] );
 
 			if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
 				output_message.SetOperationCode ( Constants::MESSAGE_OP_PRODUCER_PROCESSING_MODULE_PRESENTATION );
-				output_message.SetData ( ( void* ) processing_module_configurator_->GetConfiguratorFileName ( ).c_str ( ), processing_module_configurator_->GetConfiguratorFileName ( ).length ( ) + 1 );
+				output_message.SetData ( ( void* ) descriptor.data ( ), descriptor.length ( ) );
 				new_communicator->BroadCast ( &output_message );
 			}
 
@@ -247,11 +350,9 @@ void ProcessingModule::ConnectToConsumers ( void ) throw ( FileOperationExceptio
 			source = new_communicator->Poll ( Constants::COMM_ROOT_PROCESS, Constants::MESSAGE_OP_PRODUCER_PROCESSING_MODULE_PRESENTATION );
 			new_communicator->Receive ( source, &input_message );
 
-			string configurator_file_name = ( char* ) input_message.GetData ( );
 			ProcessingModuleConfigurator* consumer_configurator;
 			try {
-				consumer_configurator = new ProcessingModuleConfigurator ( configurator_file_name );
-				consumer_configurator->SetConfiguratorFileName ( configurator_file_name );
+				consumer_configurator = new ProcessingModuleConfigurator ( ( char* ) input_message.GetData ( ), input_message.GetDataSize ( ) );
 			}
 			catch ( XMLParserException& e ) {
 				throw ( e );
@@ -263,8 +364,13 @@ void ProcessingModule::ConnectToConsumers ( void ) throw ( FileOperationExceptio
 			for ( uint i = 0; i < consumer_inputs->size ( ); ++i ) {
 				if ( consumer_inputs->at ( i ).GetName ( ) == processing_module_configurator_->GetFlowOut ( ) ) {
 					try {
-						new_consumer = new DataConsumer ( consumer_inputs->at ( i ).GetPolicyFunctionFile ( ), consumer_configurator->GetName ( ), consumer_inputs->at ( i ).GetPolicy ( ), consumer_configurator->GetQueryFlowIn ( ) );
+						new_consumer = new DataConsumer ( consumer_inputs->at ( i ).GetPolicyFunctionFile ( ), consumer_configurator->GetName ( ), consumer_inputs->at ( i ).GetPolicy ( ), consumer_inputs->at ( i ).GetQuery ( ), consumer_inputs->at ( i ).GetPushdown ( ) );
 						new_consumer->SetCommunicator ( new_communicator );
+						new_consumer->SetSchema ( output_schema_ );
+						if ( consumers_.find ( new_consumer->GetName ( ) ) != consumers_.end ( ) ) {
+							RetireConsumer ( new_consumer->GetName ( ) );
+						}
+						new_consumer->SetMetricsStream ( metrics_.AddStream ( new_consumer->GetName ( ), Constants::METRICS_OUTPUT ) );
 						consumers_[new_consumer->GetName ( )] = new_consumer;
 						group_communicator_->Synchronize ( );
 					}
@@ -285,34 +391,20 @@ void ProcessingModule::ConnectToConsumers ( void ) throw ( FileOperationExceptio
 }
 
 void ProcessingModule::ConnectToDatabaseDaemon ( void ) {
-	int source;
 	Message output_message;
-	Message input_message;
 
 	/* Connects to the database group */
 	group_communicator_->Synchronize ( );
 	database_communicator_ = group_communicator_->Connect ( processing_module_configurator_->GetDatabasePortName ( ) );
 	group_communicator_->Synchronize ( );
 
-	/* Registers at the database group, opens a communication port and send it to interested processes. */
+	/* Registers at the database group. */
 	if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
-		string message_data = processing_module_configurator_->GetConfiguratorFileName ( );
-		output_message.SetData ( ( void* ) message_data.c_str ( ), message_data.length ( ) + 1 );
+		string descriptor = processing_module_configurator_->Serialize ( );
+		output_message.SetData ( ( void* ) descriptor.data ( ), descriptor.length ( ) );
 		output_message.SetOperationCode ( Constants::MESSAGE_OP_ADD_PROCESSING_MODULE );
 		database_communicator_->BroadCast ( &output_message );
-
-		string port_name = group_communicator_->OpenPort ( );
-		output_message.SetData ( ( void* ) port_name.c_str ( ), port_name.length ( ) + 1 );
-		output_message.SetOperationCode ( Constants::MESSAGE_OP_PORT_NAME );
-		group_communicator_->BroadCast ( &output_message );
-		runtime_communicator_->Send ( &output_message, Constants::COMM_ROOT_PROCESS );
 	}
-
-	/* Receives the name of the opened port. */
-	input_message.SetOperationCode ( Constants::MESSAGE_OP_PORT_NAME );
-	source = group_communicator_->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_PORT_NAME );
-	group_communicator_->Receive ( source, &input_message );
-	processing_module_configurator_->SetPortName ( ( char* ) input_message.GetData ( ) );
 }
 
 void ProcessingModule::ConnectToProducers ( void ) {
@@ -343,8 +435,9 @@ void ProcessingModule::ConnectToProducers ( void ) {
 	source = runtime_communicator_->Poll ( Constants::COMM_ROOT_PROCESS, Constants::MESSAGE_OP_PROCESSING_MODULE_PORTS_QUERY );
 	runtime_communicator_->Receive ( source, &input_message );
 
-	/* Connects to its producers. */
+	/* Connects to its producers, presenting this module by its descriptor. */
 	vector < string > producers_ports = Util::TokenizeString ( " ", ( char* ) input_message.GetData ( ) );
+	string descriptor = processing_module_configurator_->Serialize ( );
 	for ( int i = 0; i < ( int ) producers_ports.size ( ); ++i ) {
 		group_communicator_->Synchronize ( );
 		MpiCommunicator* new_communicator = group_communicator_->Connect ( producers_ports[i] );
@@ -353,9 +446,8 @@ void ProcessingModule::ConnectToProducers ( void ) {
 
 		/* Sends the initial information to all producers. */
 		if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
-			string message_data = processing_module_configurator_->GetConfiguratorFileName ( );
 			output_message.SetOperationCode ( Constants::MESSAGE_OP_CONSUMER_PROCESSING_MODULE_PRESENTATION );
-			output_message.SetData ( ( void* ) message_data.c_str ( ), message_data.length ( ) + 1 );
+			output_message.SetData ( ( void* ) descriptor.data ( ), descriptor.length ( ) );
 			new_producer->GetCommunicator ( )->BroadCast ( &output_message );
 		}
 
@@ -364,10 +456,9 @@ void ProcessingModule::ConnectToProducers ( void ) {
 		source = new_producer->GetCommunicator ( )->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_CONSUMER_PROCESSING_MODULE_PRESENTATION );
 		new_producer->GetCommunicator ( )->Receive ( source, &input_message );
 
-		string configurator_file_name = ( char* ) input_message.GetData ( );
 		ProcessingModuleConfigurator* producer_configurator;
 		try {
-			producer_configurator = new ProcessingModuleConfigurator ( configurator_file_name );
+			producer_configurator = new ProcessingModuleConfigurator ( ( char* ) input_message.GetData ( ), input_message.GetDataSize ( ) );
 		}
 		catch ( XMLParserException& e ) {
 			throw ( e );
@@ -375,6 +466,12 @@ void ProcessingModule::ConnectToProducers ( void ) {
 
 		new_producer->SetProcessingModuleName ( producer_configurator->GetName ( ) );
 		new_producer->SetFlowOut ( producer_configurator->GetFlowOut ( ) );
+		new_producer->SetSchema ( LoadSchema ( producer_configurator ) );
+		if ( producers_.find ( new_producer->GetName ( ) ) != producers_.end ( ) ) {
+			RetireProducer ( new_producer->GetName ( ) );
+		}
+		new_producer->SetMetricsStream ( metrics_.AddStream ( new_producer->GetFlowOut ( ), Constants::METRICS_INPUT ) );
+		new_producer->SetInputIndex ( GetInputIndex ( new_producer->GetFlowOut ( ) ) );
 		producers_[new_producer->GetName ( )] = new_producer;
 		for ( int i = 0; i < new_producer->GetNumberInstances ( ); ++i ) {
 			SendCreditToProducer ( i, new_producer->GetName ( ) );
@@ -383,6 +480,19 @@ void ProcessingModule::ConnectToProducers ( void ) {
 	group_communicator_->Synchronize ( );
 }
 
+void ProcessingModule::ConsumeProducerCredit ( string producer_id, int source ) {
+	producers_[producer_id]->SetCredit ( source, producers_[producer_id]->GetCredit ( source ) - 1 );
+	if ( producers_[producer_id]->GetCredit ( source ) == 0 ) {
+		/* An aligned channel gets no credit until the checkpoint is taken, so it buffers at most one credit of messages */
+		if ( aligning_checkpoint_ != -1 && aligned_channels_.find ( make_pair ( producer_id, source ) ) != aligned_channels_.end ( ) ) {
+			deferred_credits_.insert ( make_pair ( producer_id, source ) );
+		}
+		else {
+			SendCreditToProducer ( source, producer_id );
+		}
+	}
+}
+
 void ProcessingModule::CreateArguments ( void ) {
 	if ( argc_ % 2 == 0 ) {
 		error_on_init_ = true;
@@ -406,6 +516,33 @@ void ProcessingModule::CreateArguments ( void ) {
 	}
 }
 
+void ProcessingModule::DeliverProducerMessage ( string producer_id, int source, int* batch_size ) {
+	Message& message = batch_messages_[*batch_size];
+	batch_inputs_[*batch_size] = producers_[producer_id]->GetInputIndex ( );
+
+	/* Messages that arrive through a channel after its barrier wait for the checkpoint to be taken */
+	if ( aligning_checkpoint_ != -1 && aligned_channels_.find ( make_pair ( producer_id, source ) ) != aligned_channels_.end ( ) ) {
+		ChannelMessage aligned_message;
+		aligned_message.producer_id_ = producer_id;
+		aligned_message.source_ = source;
+		aligned_message.message_ = message;
+		aligned_messages_.push_back ( aligned_message );
+		return;
+	}
+
+	if ( message.GetOperationCode ( ) == Constants::MESSAGE_OP_CHECKPOINT_BARRIER ) {
+		AlignCheckpointBarrier ( producer_id, source, * ( ( long* ) message.GetData ( ) ), batch_size );
+	}
+	else if ( reorder_buffers_.find ( producers_[producer_id]->GetFlowOut ( ) ) != reorder_buffers_.end ( ) ) {
+		reorder_buffers_[producers_[producer_id]->GetFlowOut ( )]->Push ( producer_id, source, message );
+		ReleaseOrderedMessages ( false, batch_size );
+		metrics_.SetQueueDepth ( producers_[producer_id]->GetMetricsStream ( ), reorder_buffers_[producers_[producer_id]->GetFlowOut ( )]->GetSize ( ) );
+	}
+	else {
+		++*batch_size;
+	}
+}
+
 void ProcessingModule::DisconnectConsumers ( void ) {
 	/* Disconnects from consumers */
 	Message M ( NULL, Constants::MESSAGE_OP_TERMINATION, 0 );
@@ -421,6 +558,9 @@ void ProcessingModule::DisconnectConsumers ( void ) {
 void ProcessingModule::DisconnectFromProcessingModule ( Message* received_message ) {
 	runtime_communicator_->Synchronize ( );
 	string module_name = ( char* ) received_message->GetData ( );
+	if ( producers_.find ( module_name ) != producers_.end ( ) ) {
+		DrainOrderedMessages ( );
+	}
 	ReceiveLastMessages ( module_name );
 
 	// Disconnects from the module if it is a consumer
@@ -433,6 +573,7 @@ void ProcessingModule::DisconnectFromProcessingModule ( Message* received_messag
 
 	// Disconnects from the module if it is producer
 	if ( consumers_.find ( module_name ) != consumers_.end ( ) ) {
+		ReportQuerySelectivity ( consumers_[module_name] );
 		consumers_[module_name]->GetCommunicator ( )->Synchronize ( );
 		consumers_[module_name]->GetCommunicator ( )->Disconnect ( );
 		delete ( consumers_[module_name] );
@@ -452,14 +593,78 @@ void ProcessingModule::DisconnectProducers ( void ) {
 	producers_.clear ( );
 }
 
+void ProcessingModule::DrainOrderedMessages ( void ) {
+	/* Called between batches, so the batch buffer is empty */
+	int batch_size = 0;
+	ReleaseOrderedMessages ( true, &batch_size );
+	FlushBatch ( &batch_size );
+}
+
 bool ProcessingModule::ErrorOnInit ( void ) {
 	return error_on_init_;
 }
 
+void ProcessingModule::FlushBatch ( int* batch_size ) {
+	records_received_ += *batch_size;
+	if ( *batch_size > 0 && !termination_requested_ ) {
+		metrics_.SetBatchDepth ( *batch_size );
+
+		/* A module processing the batch as a whole sends records as old as the oldest it received */
+		origin_time_ = 0;
+		for ( int i = 0; i < *batch_size; ++i ) {
+			if ( origin_time_ == 0 || ( batch_messages_[i].GetOriginTime ( ) != 0 && batch_messages_[i].GetOriginTime ( ) < origin_time_ ) ) {
+				origin_time_ = batch_messages_[i].GetOriginTime ( );
+			}
+		}
+		long start_time = MetricsRegistry::GetTime ( );
+		ProcessBatch ( MessageSpan ( batch_messages_, batch_inputs_, *batch_size ) );
+		metrics_.AddProcessTime ( MetricsRegistry::GetTime ( ) - start_time );
+		origin_time_ = 0;
+	}
+	*batch_size = 0;
+}
+
+void ProcessingModule::Generate ( OutputBatch& batch ) {
+	Message empty_message ( NULL, Constants::MESSAGE_OP_PROCESSING_MODULE_DATA, 0 );
+	Process ( empty_message );
+}
+
+int ProcessingModule::GenerateBatch ( void ) {
+	int capacity = processing_module_configurator_->GetBatchSize ( );
+	if ( token_bucket_ != NULL ) {
+		token_bucket_->Refill ( );
+		if ( token_bucket_->GetAvailable ( ) == 0 ) {
+			long wait_time = token_bucket_->GetWaitTime ( );
+			usleep ( ( wait_time < Constants::SOURCE_MAX_SLEEP_TIME ) ? wait_time : Constants::SOURCE_MAX_SLEEP_TIME );
+			return Constants::COMM_ROOT_PROCESS;
+		}
+		if ( token_bucket_->GetAvailable ( ) < capacity ) {
+			capacity = token_bucket_->GetAvailable ( );
+		}
+	}
+
+	/* Records sent directly by Process also consume tokens */
+	long records_sent = records_sent_;
+	OutputBatch batch ( this, capacity );
+	long start_time = MetricsRegistry::GetTime ( );
+	Generate ( batch );
+	metrics_.AddProcessTime ( MetricsRegistry::GetTime ( ) - start_time );
+	records_sent = records_sent_ - records_sent;
+
+	if ( token_bucket_ != NULL ) {
+		token_bucket_->Consume ( records_sent );
+	}
+	return ( records_sent > 0 ) ? Constants::COMM_ROOT_PROCESS : -1;
+}
+
 string ProcessingModule::GetArgument ( string argument_name ) {
 	return arguments_[argument_name];
 }
 
+string ProcessingModule::GetCheckpointFileName ( void ) {
+	return processing_module_configurator_->GetCheckpointDirectory ( ) + "/" + GetModuleName ( ) + "." + Util::IntegerToString ( GetRank ( ) ) + Constants::FILE_CHECKPOINT_EXTENSION;
+}
+
 double ProcessingModule::GetClockTime ( void ) {
 	struct timeval final_time;
 	gettimeofday ( &final_time, NULL );
@@ -475,6 +680,37 @@ string ProcessingModule::GetErrorMessageOnInit ( void ) {
 	return error_message_on_init_;
 }
 
+JoinFlow* ProcessingModule::GetJoin ( void ) {
+	return processing_module_configurator_->GetJoin ( );
+}
+
+int ProcessingModule::GetCurrentInput ( void ) {
+	return current_input_;
+}
+
+int ProcessingModule::GetInputIndex ( string stream_name ) {
+	vector < InputFlow >* inputs = processing_module_configurator_->GetInputs ( );
+	for ( uint i = 0; i < inputs->size ( ); ++i ) {
+		if ( ( *inputs )[i].GetName ( ) == stream_name ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+RecordSchema* ProcessingModule::GetInputSchema ( Message& message ) {
+	for ( map < string, DataProducer* >::iterator p = producers_.begin ( ); p != producers_.end ( ); ++p ) {
+		if ( p->second->GetFlowOut ( ) == message.GetSourceStream ( ) ) {
+			return p->second->GetSchema ( );
+		}
+	}
+	return NULL;
+}
+
+RecordSchema* ProcessingModule::GetOutputSchema ( void ) {
+	return output_schema_;
+}
+
 string ProcessingModule::GetModuleName ( void ) {
 	return processing_module_configurator_->GetName ( );
 }
@@ -514,11 +750,11 @@ int ProcessingModule::GetRank ( void ) {
 }
 
 double ProcessingModule::GetSystemTime ( void ) {
-	return system_time_;
+	return resources_.GetSystemTime ( );
 }
 
 double ProcessingModule::GetUserTime ( void ) {
-	return user_time_;
+	return resources_.GetUserTime ( );
 }
 
 void ProcessingModule::HandleDatabaseMessage ( Message& received_message ) {
@@ -532,13 +768,20 @@ void ProcessingModule::HandleProcessingModuleMessage ( string processing_module_
 			break;
 		}
 
+		case Constants::MESSAGE_OP_CHECKPOINT_BARRIER : {
+			/* Received from a retiring producer, so it is not aligned but still uses a credit */
+			ConsumeProducerCredit ( processing_module_id, source );
+			break;
+		}
+
 		case Constants::MESSAGE_OP_PROCESSING_MODULE_DATA : {
-			producers_[processing_module_id]->SetCredit ( source, producers_[processing_module_id]->GetCredit ( source ) - 1 );
-			if ( producers_[processing_module_id]->GetCredit ( source ) == 0 ) {
-				SendCreditToProducer ( source, processing_module_id );
-			}
+			ConsumeProducerCredit ( processing_module_id, source );
 			if ( !termination_requested_ ) {
+				origin_time_ = received_message.GetOriginTime ( );
+				current_input_ = producers_[processing_module_id]->GetInputIndex ( );
 				Process ( received_message );
+				origin_time_ = 0;
+				current_input_ = -1;
 			}
 			break;
 		}
@@ -557,13 +800,35 @@ void ProcessingModule::HandleRuntimeMessage ( Message& received_message ) {
 			break;
 		}
 
+		case Constants::MESSAGE_OP_ADD_INSTANCE : {
+			/* Accepted in the main loop, since this message may arrive while a record is being sent */
+			requested_instances_ = true;
+			break;
+		}
+
+		case Constants::MESSAGE_OP_CHECKPOINT_BARRIER : {
+			/* Taken in the main loop, since this message may arrive while a record is being sent */
+			if ( processing_module_configurator_->GetInputs ( )->size ( ) == 0 ) {
+				requested_checkpoint_ = * ( ( long* ) received_message.GetData ( ) );
+			}
+			break;
+		}
+
 		case Constants::MESSAGE_OP_DISCONNECT : {
 			DisconnectFromProcessingModule ( &received_message );
 			break;
 		}
 
 		case Constants::MESSAGE_OP_REMOVE_INSTANCE : {
-			RemoveInstance ( received_message );
+			/* A migration transfers the state, so it waits for the main loop, between two batches */
+			RemoveInstanceMessage* remove_instance = ( RemoveInstanceMessage* ) received_message.GetData ( );
+			if ( remove_instance->GetSuccessorIdentification ( ) != -1 ) {
+				requested_migration_ = remove_instance->GetInstanceIdentification ( );
+				migration_successor_ = remove_instance->GetSuccessorIdentification ( );
+			}
+			else {
+				RemoveInstance ( received_message );
+			}
 			break;
 		}
 
@@ -613,16 +878,47 @@ void ProcessingModule::HandleSignal ( int signal ) {
 }
 
 void ProcessingModule::InitProcessingModule ( void ) {
+
+	/* Instances spawned for a running module already know its port */
+	if ( processing_module_configurator_->GetPortName ( ) != "" ) {
+		JoinInstances ( );
+		return;
+	}
+
 	ConnectToDatabaseDaemon ( );
+	OpenPort ( );
 	if ( processing_module_configurator_->GetFlowOut ( ) != Constants::EMPTY_ATTRIBUTE ) {
 		ConnectToConsumers ( );
 	}
 	if ( processing_module_configurator_->GetInputs ( )->size ( ) != 0 ) {
 		ConnectToProducers ( );
 	}
+	RestoreCheckpoint ( );
 	group_communicator_->Synchronize ( );
 }
 
+void ProcessingModule::JoinInstances ( void ) {
+
+	/* Tells the runtime the instances have started, so it asks the running ones to accept them */
+	if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
+		string port_name = processing_module_configurator_->GetPortName ( );
+		Message ready_message ( ( void* ) port_name.c_str ( ), Constants::MESSAGE_OP_PORT_NAME, port_name.length ( ) + 1 );
+		runtime_communicator_->Send ( &ready_message, Constants::COMM_ROOT_PROCESS );
+	}
+
+	group_communicator_->Synchronize ( );
+	MpiCommunicator* new_communicator = group_communicator_->Connect ( processing_module_configurator_->GetPortName ( ) );
+	group_communicator_->Synchronize ( );
+	MergeGroup ( new_communicator, true );
+}
+
+RecordSchema* ProcessingModule::LoadSchema ( ProcessingModuleConfigurator* configurator ) throw ( FileOperationException, XMLParserException ) {
+	if ( configurator->GetFlowOutEncoding ( ) != Constants::ENCODING_BINARY ) {
+		return NULL;
+	}
+	return new RecordSchema ( configurator->GetFlowOutStructure ( ) );
+}
+
 void ProcessingModule::MainLoop ( void ) {
 	int source;
 	Message received_message;
@@ -646,34 +942,49 @@ void ProcessingModule::MainLoop ( void ) {
 				}
 			}
 
-			/* If there is no message from runtime neither from database daemons, checks whether there is a message from processing module */
-			if ( source == -1 ) {
-				for ( map < string, DataProducer* >::iterator p = producers_.begin ( ); p != producers_.end ( ); ++p ) { // Checks for producers messages
-					source = p->second->GetCommunicator ( )->Probe ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
-					if ( source != -1 ) { /* Receives the message from processing module. */
-						p->second->GetCommunicator ( )->Receive ( source, &received_message );
-						HandleProcessingModuleMessage ( p->first, source, received_message );
-						break;
-					}
-				}
-				if ( source == -1 ) {
-					for ( map < string, DataConsumer* >::iterator c = consumers_.begin ( ); c != consumers_.end ( ); ++c ) { // Checks for consumers messages
-						source = c->second->GetCommunicator ( )->Probe ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
-						if ( source != -1 ) { /* Receives the message from processing module. */
-							c->second->GetCommunicator ( )->Receive ( source, &received_message );
-							HandleProcessingModuleMessage ( c->first, source, received_message );
-							break;
-						}
-					}
-				}
+			/* If there is no message from runtime neither from database daemons, receives a batch from processing modules */
+			if ( source == -1 && ReceiveBatch ( ) > 0 ) {
+				source = Constants::COMM_ROOT_PROCESS;
+			}
+
+			/* Expires the due timers */
+			if ( !shutdown_notification_ && !termination_requested_ && timer_wheel_.Advance ( ) > 0 ) {
+				source = Constants::COMM_ROOT_PROCESS;
+			}
+
+			/* Takes the checkpoint requested to a module without inputs between two batches */
+			if ( requested_checkpoint_ != -1 ) {
+				TakeCheckpoint ( requested_checkpoint_ );
+				requested_checkpoint_ = -1;
 			}
 
-			/* Process the message */
+			/* Merges the instances requested by the runtime between two batches */
+			if ( requested_instances_ ) {
+				requested_instances_ = false;
+				AddInstances ( );
+			}
+
+			/* Migrates the instance requested by the runtime between two batches */
+			if ( requested_migration_ != -1 ) {
+				int instance = requested_migration_;
+				requested_migration_ = -1;
+				MigrateInstance ( instance, migration_successor_ );
+			}
+
+			/* Samples the resources used by the instance */
+			if ( ( GetClockTime ( ) - last_resources_time_ ) * 1000 >= Constants::PROCESSING_MODULE_RESOURCES_INTERVAL ) {
+				ComputeResourcesUsage ( );
+			}
+
+			/* Feeds the runtime autoscaler */
+			if ( processing_module_configurator_->GetMaximumInstances ( ) > 0 && !shutdown_notification_ && !termination_requested_ ) {
+				ReportStatistics ( );
+			}
+
+			/* Drives the module as a source when it has no inputs */
 			if ( !shutdown_notification_ ) {
 				if ( source == -1 && processing_module_configurator_->GetInputs ( )->size ( ) == 0 and !termination_requested_ ) {
-					received_message.SetOperationCode ( Constants::MESSAGE_OP_PROCESSING_MODULE_DATA );
-					received_message.SetData ( NULL, 0 );
-					Process ( received_message );
+					source = GenerateBatch ( );
 				}
 			}
 		}
@@ -688,6 +999,216 @@ void ProcessingModule::MainLoop ( void ) {
 	while ( !shutdown_notification_ );
 }
 
+void ProcessingModule::MergeGroup ( MpiCommunicator* communicator, bool high ) {
+	int previous_number_instances = GetNumberInstances ( );
+	MpiCommunicator* merged_communicator = communicator->Merge ( high );
+	communicator->Disconnect ( );
+	delete ( communicator );
+	delete ( group_communicator_ );
+	group_communicator_ = merged_communicator;
+
+	/* The logger sends through the runtime communicator, so it is flushed before the communicator is replaced and
+	 * started again on the new one */
+	bool logging = ( logger_ != NULL );
+	StopLogger ( );
+
+	/* Tells the runtime the group has grown and waits for it to connect to the whole group */
+	if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
+		Message ack_message ( NULL, Constants::MESSAGE_OP_ADD_INSTANCE_ACK, 0 );
+		runtime_communicator_->Send ( &ack_message, Constants::COMM_ROOT_PROCESS );
+	}
+	MpiCommunicator* new_runtime_communicator = group_communicator_->Accept ( processing_module_configurator_->GetPortName ( ) );
+	runtime_communicator_->Disconnect ( );
+	delete ( runtime_communicator_ );
+	runtime_communicator_ = new_runtime_communicator;
+	if ( logging ) {
+		StartLogger ( );
+	}
+	processing_module_configurator_->SetNumberInstances ( GetNumberInstances ( ) );
+	metrics_.SetRank ( GetRank ( ) );
+
+	/* Registers the group again at the database daemons, which replace the previous connection */
+	MpiCommunicator* previous_database_communicator = database_communicator_;
+	ConnectToDatabaseDaemon ( );
+	if ( previous_database_communicator != NULL ) {
+		previous_database_communicator->Disconnect ( );
+		delete ( previous_database_communicator );
+	}
+
+	/* Connects the whole group to the neighbours, which stop using the previous channels once drained */
+	if ( processing_module_configurator_->GetFlowOut ( ) != Constants::EMPTY_ATTRIBUTE ) {
+		ConnectToConsumers ( );
+	}
+	if ( processing_module_configurator_->GetInputs ( )->size ( ) != 0 ) {
+		ConnectToProducers ( );
+	}
+	ConfigureProcess ( );
+	group_communicator_->Synchronize ( );
+
+	if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS && !high ) {
+		string message = GetModuleName ( ) + " has grown from " + Util::IntegerToString ( previous_number_instances ) + " to " + Util::IntegerToString ( GetNumberInstances ( ) ) + " instances";
+		Util::Information ( runtime_communicator_, message );
+	}
+}
+
+void ProcessingModule::MigrateInstance ( int instance, int successor ) {
+	Checkpointable* checkpointable = dynamic_cast < Checkpointable* > ( this );
+	int my_rank = group_communicator_->GetProcessRank ( );
+	CheckpointState state;
+
+	if ( my_rank == instance ) {
+		/* Producers no longer send to this instance, so it processes what is still in flight */
+		int batch_size = 0;
+		ReceiveMigrationMessages ( &batch_size );
+		ReleaseOrderedMessages ( true, &batch_size );
+		FlushBatch ( &batch_size );
+
+		/* The whole state is the one saved by the checkpoints plus the changes since the last one */
+		if ( checkpointable != NULL ) {
+			if ( checkpoint_writer_ != NULL ) {
+				try {
+					delete ( checkpoint_writer_ );
+					checkpoint_writer_ = new CheckpointWriter ( GetCheckpointFileName ( ) );
+					checkpoint_writer_->Load ( checkpoint_writer_->GetLastCheckpoint ( ), state );
+				}
+				catch ( FileOperationException& e ) {
+					checkpoint_writer_ = NULL;
+					Util::Error ( runtime_communicator_, e.ToString ( ) );
+				}
+			}
+			CheckpointState changes;
+			checkpointable->Serialize ( changes );
+			for ( map < string, string >::iterator v = changes.GetValues ( )->begin ( ); v != changes.GetValues ( )->end ( ); ++v ) {
+				state.Put ( v->first, v->second );
+			}
+			for ( set < string >::iterator k = changes.GetRemovedKeys ( )->begin ( ); k != changes.GetRemovedKeys ( )->end ( ); ++k ) {
+				state.GetValues ( )->erase ( *k );
+			}
+		}
+
+		/* The state may exceed a message, so it is sent in chunks followed by an empty one */
+		string buffer;
+		state.Pack ( buffer );
+		for ( uint offset = 0; offset < buffer.size ( ); offset += Constants::MAX_DATA_SIZE ) {
+			int chunk_size = min ( buffer.size ( ) - offset, ( size_t ) Constants::MAX_DATA_SIZE );
+			Message state_message ( ( void* ) ( buffer.data ( ) + offset ), Constants::MESSAGE_OP_MIGRATION_STATE, chunk_size );
+			group_communicator_->Send ( &state_message, successor );
+		}
+		Message end_message ( NULL, Constants::MESSAGE_OP_MIGRATION_STATE, 0 );
+		group_communicator_->Send ( &end_message, successor );
+	}
+	else if ( my_rank == successor ) {
+		Message state_message;
+		string buffer;
+		do {
+			state_message.SetOperationCode ( Constants::MESSAGE_OP_MIGRATION_STATE );
+			int source = group_communicator_->Poll ( instance, Constants::MESSAGE_OP_MIGRATION_STATE );
+			group_communicator_->Receive ( source, &state_message );
+			buffer.append ( ( char* ) state_message.GetData ( ), state_message.GetDataSize ( ) );
+		}
+		while ( state_message.GetDataSize ( ) > 0 );
+		if ( checkpointable != NULL ) {
+			if ( state.Unpack ( buffer.data ( ), buffer.size ( ) ) ) {
+				checkpointable->Restore ( state );
+			}
+			else {
+				Util::Error ( runtime_communicator_, GetModuleName ( ) + "[" + Util::IntegerToString ( my_rank ) + "] received a corrupt state from instance " + Util::IntegerToString ( instance ) );
+			}
+		}
+		Util::Information ( runtime_communicator_, GetModuleName ( ) + "[" + Util::IntegerToString ( my_rank ) + "] took over the state of instance " + Util::IntegerToString ( instance ) );
+	}
+
+	RemoveInstanceMessage remove_instance ( instance, GetModuleName ( ) );
+	Message remove_message ( ( void* ) &remove_instance, Constants::MESSAGE_OP_REMOVE_INSTANCE, sizeof(RemoveInstanceMessage) );
+	RemoveInstance ( remove_message );
+}
+
+void ProcessingModule::OpenPort ( void ) {
+	int source;
+	Message output_message;
+	Message input_message;
+
+	/* Opens a communication port and send it to interested processes. */
+	if ( group_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
+		string port_name = group_communicator_->OpenPort ( );
+		output_message.SetData ( ( void* ) port_name.c_str ( ), port_name.length ( ) + 1 );
+		output_message.SetOperationCode ( Constants::MESSAGE_OP_PORT_NAME );
+		group_communicator_->BroadCast ( &output_message );
+		runtime_communicator_->Send ( &output_message, Constants::COMM_ROOT_PROCESS );
+	}
+
+	/* Receives the name of the opened port. */
+	input_message.SetOperationCode ( Constants::MESSAGE_OP_PORT_NAME );
+	source = group_communicator_->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_PORT_NAME );
+	group_communicator_->Receive ( source, &input_message );
+	processing_module_configurator_->SetPortName ( ( char* ) input_message.GetData ( ) );
+}
+
+void ProcessingModule::ProcessBatch ( MessageSpan batch ) {
+	int64_t batch_origin_time = origin_time_;
+	for ( int i = 0; i < batch.GetSize ( ) && !termination_requested_; ++i ) {
+		origin_time_ = batch[i].GetOriginTime ( );
+		current_input_ = batch.GetInput ( i );
+		Process ( batch[i] );
+	}
+	origin_time_ = batch_origin_time;
+	current_input_ = -1;
+}
+
+int ProcessingModule::ReceiveBatch ( void ) {
+	int source;
+	int number_received = 0;
+	int batch_size = 0;
+	bool received;
+	Message received_message;
+
+	do {
+		received = false;
+
+		/* Checks for producers messages, keeping the data ones in the batch buffer */
+		for ( map < string, DataProducer* >::iterator p = producers_.begin ( ); p != producers_.end ( ) && batch_size < processing_module_configurator_->GetBatchSize ( ); ++p ) {
+			source = p->second->GetCommunicator ( )->Probe ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
+			if ( source != -1 ) {
+				batch_messages_[batch_size].SetOperationCode ( Constants::MESSAGE_OP_ANY );
+				p->second->GetCommunicator ( )->Receive ( source, &batch_messages_[batch_size] );
+				if ( batch_messages_[batch_size].GetOperationCode ( ) == Constants::MESSAGE_OP_PROCESSING_MODULE_DATA ) {
+					ConsumeProducerCredit ( p->first, source );
+					metrics_.AddInput ( p->second->GetMetricsStream ( ), batch_messages_[batch_size].GetDataSize ( ) );
+					metrics_.AddLatency ( p->second->GetMetricsStream ( ), batch_messages_[batch_size].GetOriginTime ( ), batch_messages_[batch_size].GetSendTime ( ), batch_messages_[batch_size].GetReceiveTime ( ) );
+					DeliverProducerMessage ( p->first, source, &batch_size );
+				}
+				else if ( batch_messages_[batch_size].GetOperationCode ( ) == Constants::MESSAGE_OP_CHECKPOINT_BARRIER ) {
+					ConsumeProducerCredit ( p->first, source );
+					DeliverProducerMessage ( p->first, source, &batch_size );
+				}
+				else {
+					HandleProcessingModuleMessage ( p->first, source, batch_messages_[batch_size] );
+				}
+				received = true;
+				++number_received;
+			}
+		}
+
+		/* Checks for consumers messages */
+		for ( map < string, DataConsumer* >::iterator c = consumers_.begin ( ); c != consumers_.end ( ); ++c ) {
+			source = c->second->GetCommunicator ( )->Probe ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
+			if ( source != -1 ) {
+				received_message.SetOperationCode ( Constants::MESSAGE_OP_ANY );
+				c->second->GetCommunicator ( )->Receive ( source, &received_message );
+				HandleProcessingModuleMessage ( c->first, source, received_message );
+				received = true;
+				++number_received;
+			}
+		}
+	}
+	while ( received && batch_size < processing_module_configurator_->GetBatchSize ( ) );
+
+	/* Releases the ordered messages whose latency has expired, even if nothing was received */
+	ReleaseOrderedMessages ( false, &batch_size );
+	FlushBatch ( &batch_size );
+	return number_received;
+}
+
 void ProcessingModule::ReceiveLastMessages ( string module_name ) {
 	Message received_message;
 
@@ -732,10 +1253,69 @@ void ProcessingModule::ReceiveLastMessages ( string module_name ) {
 	}
 }
 
+void ProcessingModule::ReleaseOrderedMessages ( bool flush, int* batch_size ) {
+	for ( map < string, ReorderBuffer* >::iterator b = reorder_buffers_.begin ( ); b != reorder_buffers_.end ( ); ++b ) {
+		int number_channels = flush ? 0 : GetNumberOfProducers ( b->first );
+		int input_index = GetInputIndex ( b->first );
+		while ( b->second->Pop ( number_channels, batch_messages_[*batch_size] ) ) {
+			batch_inputs_[*batch_size] = input_index;
+			++*batch_size;
+			if ( *batch_size == processing_module_configurator_->GetBatchSize ( ) ) {
+				FlushBatch ( batch_size );
+			}
+		}
+	}
+}
+
+void ProcessingModule::ReceiveMigrationMessages ( int* batch_size ) {
+	map < string, int > number_terminations;
+	uint finished_producers = 0;
+
+	while ( finished_producers < producers_.size ( ) ) {
+		for ( map < string, DataProducer* >::iterator p = producers_.begin ( ); p != producers_.end ( ); ++p ) {
+			if ( number_terminations[p->first] == p->second->GetCommunicator ( )->GetNumberProcesses ( ) ) {
+				continue;
+			}
+			int source = p->second->GetCommunicator ( )->Probe ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
+			if ( source == -1 ) {
+				continue;
+			}
+			batch_messages_[*batch_size].SetOperationCode ( Constants::MESSAGE_OP_ANY );
+			p->second->GetCommunicator ( )->Receive ( source, &batch_messages_[*batch_size] );
+
+			/* The producers already dropped this instance, so the data and barriers are delivered without returning credits */
+			if ( batch_messages_[*batch_size].GetOperationCode ( ) == Constants::MESSAGE_OP_TERMINATION ) {
+				if ( ++number_terminations[p->first] == p->second->GetCommunicator ( )->GetNumberProcesses ( ) ) {
+					++finished_producers;
+				}
+			}
+			else if ( batch_messages_[*batch_size].GetOperationCode ( ) == Constants::MESSAGE_OP_PROCESSING_MODULE_DATA ) {
+				metrics_.AddInput ( p->second->GetMetricsStream ( ), batch_messages_[*batch_size].GetDataSize ( ) );
+				DeliverProducerMessage ( p->first, source, batch_size );
+			}
+			else if ( batch_messages_[*batch_size].GetOperationCode ( ) == Constants::MESSAGE_OP_CHECKPOINT_BARRIER ) {
+				DeliverProducerMessage ( p->first, source, batch_size );
+			}
+			else {
+				HandleProcessingModuleMessage ( p->first, source, batch_messages_[*batch_size] );
+			}
+
+			if ( *batch_size == processing_module_configurator_->GetBatchSize ( ) ) {
+				FlushBatch ( batch_size );
+			}
+		}
+	}
+}
+
 void ProcessingModule::RemoveConsumerInstance ( Message& received_message ) {
 	string module_name = ( ( RemoveInstanceMessage* ) received_message.GetData ( ) )->GetModuleName ( );
 	int instance_rank = ( ( RemoveInstanceMessage* ) received_message.GetData ( ) )->GetInstanceIdentification ( );
 	if ( consumers_.find ( module_name ) != consumers_.end ( ) ) {
+		/* A migrating instance receives until this marker, which follows everything sent to it through the channel */
+		if ( ( ( RemoveInstanceMessage* ) received_message.GetData ( ) )->GetSuccessorIdentification ( ) != -1 ) {
+			Message termination_message ( NULL, Constants::MESSAGE_OP_TERMINATION, 0 );
+			consumers_[module_name]->GetCommunicator ( )->Send ( &termination_message, instance_rank );
+		}
 		consumers_[module_name]->RemoveInstance ( instance_rank );
 	}
 }
@@ -771,6 +1351,9 @@ void ProcessingModule::RemoveInstance ( Message& received_message ) {
 	if ( instance_to_remove == my_rank ) {
 		shutdown_notification_ = true;
 	}
+	else {
+		metrics_.SetRank ( GetRank ( ) );
+	}
 
 }
 
@@ -792,18 +1375,113 @@ void ProcessingModule::RemoveProducerInstance ( Message& received_message ) {
 	}
 }
 
+void ProcessingModule::ReportStatistics ( void ) {
+	double clock_time = GetClockTime ( );
+	double interval = clock_time - last_statistics_time_;
+
+	if ( interval * 1000 < Constants::PROCESSING_MODULE_STATISTICS_INTERVAL ) {
+		return;
+	}
+
+	/* Sources are measured by what they generate, the other modules by what they receive */
+	ComputeResourcesUsage ( );
+	long records = ( processing_module_configurator_->GetInputs ( )->size ( ) == 0 ) ? records_sent_ : records_received_;
+	InstanceStatisticsMessage statistics ( group_communicator_->GetHostName ( ), ( int ) ( interval * 1000 ), ( int ) ( records - last_statistics_records_ ), ( int ) ( ( GetCPUTime ( ) - last_statistics_cpu_time_ ) * 1000 ), ( int ) ( starvation_time_ * 1000 ), ( int ) ( resources_.GetResidentSize ( ) / 1024 ), ( int ) ( resources_.GetVoluntarySwitches ( ) - last_statistics_voluntary_switches_ ), ( int ) ( resources_.GetInvoluntarySwitches ( ) - last_statistics_involuntary_switches_ ) );
+	Message statistics_message ( ( void* ) &statistics, Constants::MESSAGE_OP_INSTANCE_STATISTICS, sizeof(InstanceStatisticsMessage) );
+	runtime_communicator_->Send ( &statistics_message, Constants::COMM_ROOT_PROCESS );
+
+	last_statistics_time_ = clock_time;
+	last_statistics_cpu_time_ = GetCPUTime ( );
+	last_statistics_voluntary_switches_ = resources_.GetVoluntarySwitches ( );
+	last_statistics_involuntary_switches_ = resources_.GetInvoluntarySwitches ( );
+	last_statistics_records_ = records;
+	starvation_time_ = 0;
+}
+
+void ProcessingModule::RestoreCheckpoint ( void ) {
+	long checkpoint = -1;
+	if ( processing_module_configurator_->GetCheckpointDirectory ( ) != "" ) {
+		try {
+			checkpoint_writer_ = new CheckpointWriter ( GetCheckpointFileName ( ) );
+			checkpoint = checkpoint_writer_->GetLastCheckpoint ( );
+		}
+		catch ( FileOperationException& e ) {
+			Util::Error ( runtime_communicator_, e.ToString ( ) );
+		}
+	}
+
+	/* Instances restore the last checkpoint completed by all of them */
+	Message output_message ( ( void* ) &checkpoint, sizeof(long) );
+	Message* input_messages = new Message[GetNumberInstances ( )];
+	group_communicator_->AllGather ( &output_message, input_messages );
+	for ( int i = 0; i < GetNumberInstances ( ); ++i ) {
+		long instance_checkpoint = * ( ( long* ) input_messages[i].GetData ( ) );
+		if ( instance_checkpoint < checkpoint ) {
+			checkpoint = instance_checkpoint;
+		}
+	}
+	delete[] ( input_messages );
+
+	Checkpointable* checkpointable = dynamic_cast < Checkpointable* > ( this );
+	if ( checkpoint == -1 || checkpoint_writer_ == NULL || checkpointable == NULL ) {
+		return;
+	}
+	try {
+		last_checkpoint_ = checkpoint_writer_->Load ( checkpoint, checkpoint_state_ );
+		checkpointable->Restore ( checkpoint_state_ );
+		checkpoint_state_.Clear ( );
+		Util::Information ( runtime_communicator_, GetModuleName ( ) + "[" + Util::IntegerToString ( GetRank ( ) ) + "] restored checkpoint " + Util::LongToString ( last_checkpoint_ ) );
+	}
+	catch ( FileOperationException& e ) {
+		Util::Error ( runtime_communicator_, e.ToString ( ) );
+	}
+}
+
+void ProcessingModule::RetireConsumer ( string consumer_id ) {
+	Message termination_message ( NULL, Constants::MESSAGE_OP_TERMINATION, 0 );
+	consumers_[consumer_id]->GetCommunicator ( )->BroadCast ( &termination_message );
+	consumers_[consumer_id]->GetCommunicator ( )->Synchronize ( );
+	consumers_[consumer_id]->GetCommunicator ( )->Disconnect ( );
+	delete ( consumers_[consumer_id] );
+	consumers_.erase ( consumer_id );
+}
+
+void ProcessingModule::RetireProducer ( string producer_id ) {
+	DrainOrderedMessages ( );
+	ReceiveLastMessages ( producer_id );
+	producers_[producer_id]->GetCommunicator ( )->Synchronize ( );
+	producers_[producer_id]->GetCommunicator ( )->Disconnect ( );
+	delete ( producers_[producer_id] );
+	producers_.erase ( producer_id );
+}
+
 void ProcessingModule::Run ( void ) {
 	ConfigureProcess ( );
 	InitProcessingModule ( );
+	metrics_.Publish ( GetModuleName ( ), GetRank ( ) );
+
+	/* Started once the runtime has the port, since it expects no other message before */
+	StartLogger ( );
 	MainLoop ( );
 }
 
+int ProcessingModule::SchedulePeriodicTimer ( long period, TimerCallback* callback ) {
+	return timer_wheel_.SchedulePeriodicTimer ( period, callback );
+}
+
+int ProcessingModule::ScheduleTimer ( long delay, TimerCallback* callback ) {
+	return timer_wheel_.ScheduleTimer ( delay, callback );
+}
+
 void ProcessingModule::Send ( Message& output_message ) {
 	if ( !error_on_init_ && consumers_.size ( ) > 0 ) {
 		/* Prepares the message and sends it to the consumers according to their policies. */
 		output_message.SetOperationCode ( Constants::MESSAGE_OP_PROCESSING_MODULE_DATA );
 		output_message.SetSequenceNumber ( message_sequence_number_++ );
 		output_message.SetSourceStream ( processing_module_configurator_->GetFlowOut ( ) );
+		output_message.SetOriginTime ( ( origin_time_ != 0 ) ? origin_time_ : Message::GetCurrentTime ( ) );
+		++records_sent_;
+		metrics_.AddOutputRecord ( output_message.GetDataSize ( ) );
 
 		vector < string > consumer_names;
 		for ( map < string, DataConsumer* >::iterator c = consumers_.begin ( ); c != consumers_.end ( ); ++c ) {
@@ -811,20 +1489,43 @@ void ProcessingModule::Send ( Message& output_message ) {
 		}
 
 		for ( uint c = 0; c < consumer_names.size ( ); ++c ) {
+			/* Applies the consumer input query here, so records it would discard are not sent. Credits and labels are
+			 * computed on the original record, since the projection may not hold the labeled fields */
+			Message* consumer_message = NULL;
+			try {
+				consumer_message = consumers_[consumer_names[c]]->ApplyQuery ( output_message );
+			}
+			catch ( BadParameterException& e ) {
+				Util::Error ( runtime_communicator_, GetModuleName ( ) + "[" + Util::IntegerToString ( GetRank ( ) ) + "] did not send a record to " + consumer_names[c] + ": " + e.ToString ( ) );
+			}
+			if ( consumers_[consumer_names[c]]->HasQuery ( ) ) {
+				metrics_.SetQuerySelectivity ( consumers_[consumer_names[c]]->GetMetricsStream ( ), consumers_[consumer_names[c]]->GetNumberRecordsEvaluated ( ), consumers_[consumer_names[c]]->GetNumberRecordsMatched ( ) );
+			}
+			if ( consumer_message == NULL ) {
+				continue;
+			}
 			UpdateConsumerCredits ( consumer_names[c], output_message );
 			if ( !shutdown_notification_ && consumers_.find ( consumer_names[c] ) != consumers_.end ( ) ) {
 				if ( consumers_[consumer_names[c]]->GetPolicy ( ) == Constants::POLICY_BROADCAST ) {
-					consumers_[consumer_names[c]]->GetCommunicator ( )->BroadCast ( &output_message );
+					consumers_[consumer_names[c]]->GetCommunicator ( )->BroadCast ( consumer_message );
 				}
 				else {
 					int destination = consumers_[consumer_names[c]]->GetNextToReceive ( output_message );
-					consumers_[consumer_names[c]]->GetCommunicator ( )->Send ( &output_message, destination );
+					consumers_[consumer_names[c]]->GetCommunicator ( )->Send ( consumer_message, destination );
 				}
+				metrics_.AddOutput ( consumers_[consumer_names[c]]->GetMetricsStream ( ), consumer_message->GetDataSize ( ) );
 			}
 		}
 	}
 }
 
+void ProcessingModule::ReportQuerySelectivity ( DataConsumer* consumer ) {
+	if ( consumer->HasQuery ( ) ) {
+		string message = GetModuleName ( ) + "[" + Util::IntegerToString ( GetRank ( ) ) + "] sent " + Util::LongToString ( consumer->GetNumberRecordsMatched ( ) ) + " of " + Util::LongToString ( consumer->GetNumberRecordsEvaluated ( ) ) + " records of " + processing_module_configurator_->GetFlowOut ( ) + " to " + consumer->GetName ( ) + " (" + consumer->GetPushdown ( ) + ")";
+		Util::Information ( runtime_communicator_, message );
+	}
+}
+
 void ProcessingModule::SendCreditToProducer ( int instance, string producer_id ) {
 	int credit = ComputeProducerCredit ( );
 	producers_[producer_id]->SetCredit ( instance, credit );
@@ -834,11 +1535,30 @@ void ProcessingModule::SendCreditToProducer ( int instance, string producer_id )
 
 void ProcessingModule::SetConfigurator ( ProcessingModuleConfigurator* configurator ) {
 	processing_module_configurator_ = configurator;
+	batch_messages_ = new Message[processing_module_configurator_->GetBatchSize ( )];
+	batch_inputs_ = new int[processing_module_configurator_->GetBatchSize ( )];
+	if ( processing_module_configurator_->GetRate ( ) > 0 ) {
+		token_bucket_ = new TokenBucket ( processing_module_configurator_->GetRate ( ), processing_module_configurator_->GetBatchSize ( ) );
+	}
+	try {
+		output_schema_ = LoadSchema ( processing_module_configurator_ );
+	}
+	catch ( FileOperationException& e ) {
+		error_on_init_ = true;
+		error_message_on_init_ = e.ToString ( );
+	}
+	catch ( XMLParserException& e ) {
+		error_on_init_ = true;
+		error_message_on_init_ = e.ToString ( );
+	}
 	vector < InputFlow >* inputs = processing_module_configurator_->GetInputs ( );
 	for ( uint i = 0; i < inputs->size ( ); ++i ) {
 		if ( inputs->at ( i ).GetPolicy ( ).compare ( Constants::POLICY_LABELED ) == 0 ) {
 			ValidateLabelFunction ( inputs->at ( i ).GetPolicyFunctionFile ( ) );
 		}
+		if ( inputs->at ( i ).IsOrdered ( ) ) {
+			reorder_buffers_[inputs->at ( i ).GetName ( )] = new ReorderBuffer ( inputs->at ( i ).GetReorderCapacity ( ), inputs->at ( i ).GetReorderLatency ( ) );
+		}
 	}
 }
 
@@ -856,11 +1576,25 @@ void ProcessingModule::SetRuntimeCommunicator ( MpiCommunicator* runtime_communi
 }
 
 void ProcessingModule::Shutdown ( void ) {
+	StopLogger ( );
 	runtime_communicator_->Synchronize ( );
 	ComputeResourcesUsage ( );
 	shutdown_notification_ = true;
 }
 
+void ProcessingModule::StartLogger ( void ) {
+	logger_ = new AsyncLogger ( runtime_communicator_, GetModuleName ( ) + " at " + runtime_communicator_->GetHostName ( ) );
+	Util::SetLogger ( logger_ );
+}
+
+void ProcessingModule::StopLogger ( void ) {
+	if ( logger_ != NULL ) {
+		Util::SetLogger ( NULL );
+		delete ( logger_ );
+		logger_ = NULL;
+	}
+}
+
 void ProcessingModule::SynchronizeConsumers ( Message& message ) {
 	message.SetOperationCode ( Constants::MESSAGE_OP_PROCESSING_MODULE_DATA );
 	message.SetSequenceNumber ( message_sequence_number_++ );
@@ -870,6 +1604,29 @@ void ProcessingModule::SynchronizeConsumers ( Message& message ) {
 	}
 }
 
+void ProcessingModule::TakeCheckpoint ( long checkpoint ) {
+	Checkpointable* checkpointable = dynamic_cast < Checkpointable* > ( this );
+	if ( checkpointable != NULL && checkpoint_writer_ != NULL ) {
+		checkpointable->Serialize ( checkpoint_state_ );
+		checkpoint_writer_->Write ( checkpoint, checkpoint_state_ );
+	}
+	last_checkpoint_ = checkpoint;
+
+	/* The barrier follows the records sent before the checkpoint through the same channels, using a credit of each
+	 * consumer instance like a broadcast record */
+	Message barrier ( ( void* ) &checkpoint, Constants::MESSAGE_OP_CHECKPOINT_BARRIER, sizeof(long) );
+	vector < string > consumer_names;
+	for ( map < string, DataConsumer* >::iterator c = consumers_.begin ( ); c != consumers_.end ( ); ++c ) {
+		consumer_names.push_back ( c->first );
+	}
+	for ( uint c = 0; c < consumer_names.size ( ); ++c ) {
+		UpdateCreditsForBroadcastConsumer ( consumer_names[c] );
+		if ( !shutdown_notification_ && consumers_.find ( consumer_names[c] ) != consumers_.end ( ) ) {
+			consumers_[consumer_names[c]]->GetCommunicator ( )->BroadCast ( &barrier );
+		}
+	}
+}
+
 void ProcessingModule::TerminateModule ( void ) {
 	/* Asks the runtime to terminate this module instances. */
 	Message termination_message ( ( void* ) GetModuleName ( ).c_str ( ), Constants::MESSAGE_OP_TERMINATION, GetModuleName ( ).length ( ) + 1 );
@@ -910,6 +1667,7 @@ void ProcessingModule::UpdateCreditsForBroadcastConsumer ( string consumer_id )
 	for ( int i = 0; i < consumers_[consumer_id]->GetNumberInstances ( ); ++i ) {
 		if ( consumers_[consumer_id]->GetCredit ( i ) == 0 ) {
 			bool ready = false;
+			double wait_start = GetClockTime ( );
 			while ( !shutdown_notification_ && !ready ) {
 				usleep ( Constants::SLEEP_TIME );
 				/* Deal with control message in case it exists. */
@@ -931,6 +1689,9 @@ void ProcessingModule::UpdateCreditsForBroadcastConsumer ( string consumer_id )
 					ready = true;
 				}
 			}
+			double wait_time = GetClockTime ( ) - wait_start;
+			starvation_time_ += wait_time;
+			metrics_.AddCreditWaitTime ( consumers_[consumer_id]->GetMetricsStream ( ), ( long ) ( wait_time * 1000000 ) );
 		}
 		consumers_[consumer_id]->SetCredit ( i, consumers_[consumer_id]->GetCredit ( i ) - 1 );
 	}
@@ -940,6 +1701,7 @@ void ProcessingModule::UpdateCreditsForLabeledStreamConsumer ( string consumer_i
 	int instance_to_receive = consumers_[consumer_id]->GetNextToReceive ( received_message );
 	if ( consumers_[consumer_id]->GetCredit ( instance_to_receive ) == 0 ) {
 		bool ready = false;
+		double wait_start = GetClockTime ( );
 		while ( !shutdown_notification_ && !ready ) {
 			usleep ( Constants::SLEEP_TIME );
 			/* Deal with control message in case it exists. */
@@ -960,6 +1722,9 @@ void ProcessingModule::UpdateCreditsForLabeledStreamConsumer ( string consumer_i
 				ready = true;
 			}
 		}
+		double wait_time = GetClockTime ( ) - wait_start;
+		starvation_time_ += wait_time;
+		metrics_.AddCreditWaitTime ( consumers_[consumer_id]->GetMetricsStream ( ), ( long ) ( wait_time * 1000000 ) );
 	}
 	consumers_[consumer_id]->SetCredit ( instance_to_receive, consumers_[consumer_id]->GetCredit ( instance_to_receive ) - 1 );
 }
@@ -978,6 +1743,7 @@ void ProcessingModule::UpdateCreditsForRoundRobinConsumer ( string consumer_id,
 
 	/* waits for a credit announcement message from some consumer */
 	if ( !message_can_be_sent ) {
+		double wait_start = GetClockTime ( );
 		while ( !shutdown_notification_ && !message_can_be_sent ) {
 			usleep ( Constants::SLEEP_TIME );
 			int source = runtime_communicator_->Probe ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
@@ -998,6 +1764,9 @@ void ProcessingModule::UpdateCreditsForRoundRobinConsumer ( string consumer_id,
 				message_can_be_sent = true;
 			}
 		}
+		double wait_time = GetClockTime ( ) - wait_start;
+		starvation_time_ += wait_time;
+		metrics_.AddCreditWaitTime ( consumers_[consumer_id]->GetMetricsStream ( ), ( long ) ( wait_time * 1000000 ) );
 	}
 	else {
 		int source;
@@ -13,16 +13,34 @@
 #include <sys/resource.h>
 #include <sys/time.h>
 
+/* C++ libraries */
+#include <deque>
+#include <set>
+
 /* Project's .h */
 #include <comm/message.h>
 #include <comm/communicator.h>
 #include <comm/mpi/mpi_communicator.h>
 #include <common/util.h>
 #include <common/xml_query.h>
+#include <library/checkpoint_state.h>
+#include <library/checkpoint_writer.h>
+#include <library/checkpointable.h>
 #include <library/configurator.h>
 #include <library/data_consumer.h>
 #include <library/data_producer.h>
 #include <library/label_function.h>
+#include <library/message_span.h>
+#include <library/metrics_registry.h>
+#include <library/output_batch.h>
+#include <library/record_builder.h>
+#include <library/record_query.h>
+#include <library/record_schema.h>
+#include <library/record_view.h>
+#include <library/reorder_buffer.h>
+#include <library/resource_sampler.h>
+#include <library/timer_wheel.h>
+#include <library/token_bucket.h>
 #include <library/xml.h>
 
 /* Other libraries */
@@ -62,23 +80,30 @@ class ProcessingModule {
 		double GetClockTime ( void );
 
 		/**
-		 * \brief Retrieves the CPU consumption until the call moment.
+		 * \brief Retrieves the CPU consumption as of the last resources sample, taken once every resources interval.
 		 * \return A value representing the time in seconds.
 		 */
 		double GetCPUTime ( void );
 
 		/**
-		 * \brief Retrieves the CPU System consumption until the call moment.
+		 * \brief Retrieves the CPU System consumption as of the last resources sample.
 		 * \return A value representing the time in seconds.
 		 */
 		double GetSystemTime ( void );
 
 		/**
-		 * \brief Retrieves the CPU User consumption until the call moment.
+		 * \brief Retrieves the CPU User consumption as of the last resources sample.
 		 * \return A value representing the time in seconds.
 		 */
 		double GetUserTime ( void );
 
+		/**
+		 * \brief Cancels a pending timer.
+		 * \param timer_id The timer identification.
+		 * \return False if there is no pending timer with this identification.
+		 */
+		bool CancelTimer ( int timer_id );
+
 		/**
 		 * \brief Checks if an error occurred on the startup moment.
 		 * \return The error condition.
@@ -105,6 +130,23 @@ class ProcessingModule {
 
 		int GetNumberOfConsumers ( void );
 
+		/**
+		 * \brief Schedules a timer to expire once. Timers expire in the main loop, even when no message arrives, so the
+		 * callback may call Send.
+		 * \param delay Delay in milliseconds.
+		 * \param callback The receiver of the expiration.
+		 * \return The timer identification.
+		 */
+		int ScheduleTimer ( long delay, TimerCallback* callback );
+
+		/**
+		 * \brief Schedules a timer to expire periodically until it is canceled.
+		 * \param period Period in milliseconds.
+		 * \param callback The receiver of the expirations.
+		 * \return The timer identification.
+		 */
+		int SchedulePeriodicTimer ( long period, TimerCallback* callback );
+
 		/**
 		 * \brief Retrieves the instance rank.
 		 * \return The instance rank.
@@ -130,6 +172,51 @@ class ProcessingModule {
 		 */
 		string GetModuleName ( void );
 
+		/**
+		 * \brief Retrieves the join between two input streams declared in the processing module configuration.
+		 * \return The join description or NULL if there is none.
+		 */
+		JoinFlow* GetJoin ( void );
+
+		/**
+		 * \brief Retrieves the input the message being processed came from. It is resolved once per producer, when the
+		 * producer connects, so modules with several inputs, such as joins, need not compare stream names per record.
+		 * Within ProcessBatch, MessageSpan::GetInput gives the input of each message.
+		 * \return The input index, -1 outside Process or when the message was not received from a producer.
+		 */
+		int GetCurrentInput ( void );
+
+		/**
+		 * \brief Retrieves the index of an input stream, as returned by GetCurrentInput. It is the position of the input
+		 * in the processing module configuration.
+		 * \param stream_name The input stream name.
+		 * \return The input index, -1 when the stream is not an input of the module.
+		 */
+		int GetInputIndex ( string stream_name );
+
+		/**
+		 * \brief Retrieves the layout of the binary records of the stream a message came from.
+		 * \param message A data message received from a producer.
+		 * \return The record schema, or NULL if the producer does not send binary records.
+		 */
+		RecordSchema* GetInputSchema ( Message& message );
+
+		/**
+		 * \brief Retrieves the layout of the binary records of the output flow. Records are written into a message with
+		 * RecordBuilder before being sent.
+		 * \return The record schema, or NULL if the output encoding is not binary.
+		 */
+		RecordSchema* GetOutputSchema ( void );
+
+		/**
+		 * \brief Produces records in a processing module without inputs. The driver calls it as fast as the consumers'
+		 * credits allow or at the rate set in the module configuration. The default implementation calls Process with an
+		 * empty data message, which may send records directly.
+		 * \param batch Batch receiving the produced records. Records beyond its capacity are not sent.
+		 * \return Not applicable.
+		 */
+		virtual void Generate ( OutputBatch& batch );
+
 		/**
 		 * \brief Receive a message and do some computation.
 		 * \param message Message received.
@@ -137,6 +224,14 @@ class ProcessingModule {
 		 */
 		virtual void Process ( Message& message ) = 0;
 
+		/**
+		 * \brief Receives all the data messages already available, up to the module batch size, and do some computation.
+		 * The default implementation calls Process for each message of the batch.
+		 * \param batch Messages received. They are valid only during this call.
+		 * \return Not applicable.
+		 */
+		virtual void ProcessBatch ( MessageSpan batch );
+
 		/**
 		 * todo
 		 */
@@ -154,7 +249,8 @@ class ProcessingModule {
 		void Run ( void );
 
 		/**
-		 * \brief Send a message to the processing module's consumers.
+		 * \brief Send a message to the processing module's consumers. The message keeps the origin time of the records
+		 * being processed, so the end-to-end latency is measured from the source module.
 		 * \param output_message Message to be sent.
 		 * \return Not applicable.
 		 */
@@ -197,6 +293,13 @@ class ProcessingModule {
 
 	private:
 
+		/** \brief A message received through a channel already aligned to a checkpoint barrier. */
+		struct ChannelMessage {
+				string producer_id_;
+				int source_;
+				Message message_;
+		};
+
 		/**
 		 * \brief Handles the signals received from the operating system.
 		 * \param signal Signal code.
@@ -220,12 +323,24 @@ class ProcessingModule {
 		 */
 		int ComputeProducerCredit ( void );
 
+		/**
+		 * \brief Calls Generate limited by the source rate, sleeping while there is no token available.
+		 * \return -1 if no record was produced, so the main loop can sleep.
+		 */
+		int GenerateBatch ( void );
+
 		/**
 		 * \brief Retrieves the number of instances which send data to this module.
 		 * \return The number of producer instances.
 		 */
 		int GetNumberProducerInstances ( void );
 
+		/**
+		 * \brief Retrieves the name of the checkpoint log of the instance.
+		 * \return The log file name.
+		 */
+		string GetCheckpointFileName ( void );
+
 		/**
 		 * todo
 		 */
@@ -239,6 +354,13 @@ class ProcessingModule {
 		 */
 		string AddConsumer ( MpiCommunicator* new_communicator, Message& received_message ) throw ( FileOperationException );
 
+		/**
+		 * \brief Accepts the new instances requested by the runtime on the module port and merges them into the
+		 * group.
+		 * \return Not applicable.
+		 */
+		void AddInstances ( void );
+
 		/**
 		 * \brief Adds a producer module to this one.
 		 * \param new_communicator Communicator between this module and the new producer.
@@ -248,7 +370,20 @@ class ProcessingModule {
 		string AddProducer ( MpiCommunicator* new_communicator, Message& received_message );
 
 		/**
-		 * \brief Computes the resource usage for the PM instance.
+		 * \brief Registers the arrival of a checkpoint barrier through a producer channel. The messages received
+		 * afterwards through the channel are held until the barrier has arrived through all channels, when the checkpoint
+		 * is taken and the held messages are delivered.
+		 * \param producer_id The identification of the producer in the internal data structure.
+		 * \param source The producer instance which sent the barrier.
+		 * \param checkpoint The checkpoint identification.
+		 * \param batch_size Number of data messages in the batch buffer, processed before the checkpoint.
+		 * \return Not applicable.
+		 */
+		void AlignCheckpointBarrier ( string producer_id, int source, long checkpoint, int* batch_size );
+
+		/**
+		 * \brief Samples the resource usage for the PM instance and publishes it with its metrics, along with the CPU
+		 * utilization since the previous sample.
 		 * \return Not applicable.
 		 */
 		void ComputeResourcesUsage ( void );
@@ -258,6 +393,15 @@ class ProcessingModule {
 		 */
 		void ConfigureProcess ( void );
 
+		/**
+		 * \brief Consumes one credit of a producer instance and sends a new credit announcement when it is exhausted,
+		 * unless the instance channel is waiting for a checkpoint alignment. Data messages and barriers use a credit.
+		 * \param producer_id The identification of the producer in the internal data structure.
+		 * \param source The producer instance which sent the data message.
+		 * \return Not applicable.
+		 */
+		void ConsumeProducerCredit ( string producer_id, int source );
+
 		/**
 		 * \brief Connects to all consumers.
 		 * \return Not applicable.
@@ -265,7 +409,7 @@ class ProcessingModule {
 		void ConnectToConsumers ( void ) throw ( FileOperationException );
 
 		/**
-		 * \brief Connects to a database daemon.
+		 * \brief Connects to the database group and registers the module on it.
 		 * \return Not applicable.
 		 */
 		void ConnectToDatabaseDaemon ( void );
@@ -282,6 +426,23 @@ class ProcessingModule {
 		 */
 		void CreateArguments ( void );
 
+		/**
+		 * \brief Delivers a data message or a checkpoint barrier received from a producer and stored in the batch buffer
+		 * after the messages of the current batch.
+		 * \param producer_id The identification of the producer in the internal data structure.
+		 * \param source The producer instance which sent the message.
+		 * \param batch_size Number of data messages in the batch buffer, incremented when the message joins the batch.
+		 * \return Not applicable.
+		 */
+		void DeliverProducerMessage ( string producer_id, int source, int* batch_size );
+
+		/**
+		 * \brief Delivers all the messages held by the reorder buffers to ProcessBatch, in sequence number order. Used
+		 * before a producer disconnects, when its last messages are processed directly.
+		 * \return Not applicable.
+		 */
+		void DrainOrderedMessages ( void );
+
 		/**
 		 * \brief Disconnects from a processing module.
 		 * \param received_message Received message with the information to proceed with the disconnection.
@@ -289,6 +450,13 @@ class ProcessingModule {
 		 */
 		void DisconnectFromProcessingModule ( Message* received_message );
 
+		/**
+		 * \brief Delivers the data messages in the batch buffer to ProcessBatch.
+		 * \param batch_size Number of data messages in the batch buffer, set to 0.
+		 * \return Not applicable.
+		 */
+		void FlushBatch ( int* batch_size );
+
 		/**
 		 * todo
 		 */
@@ -310,17 +478,69 @@ class ProcessingModule {
 		 */
 		void InitProcessingModule ( void );
 
+		/**
+		 * \brief Connects the instances spawned to scale out a running module to its port, announced by the runtime, and
+		 * merges them into the group.
+		 * \return Not applicable.
+		 */
+		void JoinInstances ( void );
+
+		/**
+		 * \brief Compiles the record schema of the output flow of a processing module.
+		 * \param configurator The processing module configuration.
+		 * \return The record schema, or NULL if the output encoding is not binary.
+		 */
+		RecordSchema* LoadSchema ( ProcessingModuleConfigurator* configurator ) throw ( FileOperationException, XMLParserException );
+
 		/**
 		 * \brief Waits for messages from other processes.
 		 * \return Not applicable.
 		 */
 		void MainLoop ( void );
 
+		/**
+		 * \brief Merges the instances connected through the module port into the group. The runtime, database daemons,
+		 * consumers and producers are then connected again from the larger group, replacing the previous channels once
+		 * the messages in flight through them have been received.
+		 * \param communicator Communicator between the instances already running and the new ones.
+		 * \param high Whether the instances are ranked after the other side in the merged group.
+		 * \return Not applicable.
+		 */
+		void MergeGroup ( MpiCommunicator* communicator, bool high );
+
+		/**
+		 * \brief Removes an instance migrated to another host. The migrated instance processes the records already sent
+		 * to it and sends its whole state to the instance replacing it, which restores it, before being removed.
+		 * \param instance The migrated instance.
+		 * \param successor The instance replacing it, already in the group.
+		 * \return Not applicable.
+		 */
+		void MigrateInstance ( int instance, int successor );
+
+		/**
+		 * \brief Opens the module port, through which other modules connect to it, and sends its name to the runtime.
+		 * \return Not applicable.
+		 */
+		void OpenPort ( void );
+
+		/**
+		 * \brief Drains the messages available from producers and consumers and delivers the data messages to ProcessBatch.
+		 * \return The number of messages received.
+		 */
+		int ReceiveBatch ( void );
+
 		/**
 		 * todo
 		 */
 		void ReceiveLastMessages ( string module_name );
 
+		/**
+		 * \brief Receives what the producers sent to a migrating instance, until every producer instance sent the termination marker that ends its channel.
+		 * \param batch_size Number of data messages in the batch buffer, processed whenever the buffer is full.
+		 * \return Not applicable.
+		 */
+		void ReceiveMigrationMessages ( int* batch_size );
+
 		/**
 		 * todo
 		 */
@@ -341,6 +561,53 @@ class ProcessingModule {
 		 */
 		void RemoveProducerInstance ( Message& received_message );
 
+		/**
+		 * \brief Moves the messages released by the reorder buffers of the ordered inputs to the batch buffer,
+		 * delivering the batch whenever it is full.
+		 * \param flush Whether all the messages held are released, regardless of the other producer instances.
+		 * \param batch_size Number of data messages in the batch buffer.
+		 * \return Not applicable.
+		 */
+		void ReleaseOrderedMessages ( bool flush, int* batch_size );
+
+		/**
+		 * \brief Informs the runtime how many records matched the input query of a consumer.
+		 * \param consumer The consumer.
+		 * \return Not applicable.
+		 */
+		void ReportQuerySelectivity ( DataConsumer* consumer );
+
+		/**
+		 * \brief Reports to the runtime the CPU time, the records processed, the time waiting for consumer credits, the
+		 * context switches since the last report and the resident size, once every statistics interval, so the runtime
+		 * can scale an autoscaled module.
+		 * \return Not applicable.
+		 */
+		void ReportStatistics ( void );
+
+		/**
+		 * \brief Opens the checkpoint log of the instance and restores the last checkpoint completed by all instances,
+		 * if the module is checkpointable.
+		 * \return Not applicable.
+		 */
+		void RestoreCheckpoint ( void );
+
+		/**
+		 * \brief Terminates the channel to a consumer which has been connected again, so it receives the messages
+		 * already sent before disconnecting.
+		 * \param consumer_id The identification of the consumer in the internal data structure.
+		 * \return Not applicable.
+		 */
+		void RetireConsumer ( string consumer_id );
+
+		/**
+		 * \brief Receives the last messages from a producer which has been connected again and disconnects the previous
+		 * channel.
+		 * \param producer_id The identification of the producer in the internal data structure.
+		 * \return Not applicable.
+		 */
+		void RetireProducer ( string producer_id );
+
 		/**
 		 * \brief Sends a credit message to a producer.
 		 * \param instance The instance to receive the credit announcement.
@@ -363,6 +630,27 @@ class ProcessingModule {
 		 */
 		void Shutdown ( void );
 
+		/**
+		 * \brief Starts the asynchronous logger on the current runtime communicator.
+		 * \return Not applicable.
+		 */
+		void StartLogger ( void );
+
+		/**
+		 * \brief Stops the asynchronous logger, sending the records still queued, and sends the next messages to the
+		 * runtime at once.
+		 * \return Not applicable.
+		 */
+		void StopLogger ( void );
+
+		/**
+		 * \brief Takes a checkpoint, handing the state changed since the previous one to the checkpoint writer, and
+		 * forwards the barrier to the consumers, waiting for a credit of each consumer instance as a broadcast does.
+		 * \param checkpoint The checkpoint identification.
+		 * \return Not applicable.
+		 */
+		void TakeCheckpoint ( long checkpoint );
+
 		/**
 		 * \brief Adjusts the credits for all consumers' instances in a send operation.
 		 * \param consumer_id The internal identification for the consumer.
@@ -416,15 +704,93 @@ class ProcessingModule {
 		/** \brief Flag used to indicates that the PM module has asked to terminate. */
 		bool termination_requested_;
 
-		/** \brief The CPU user time. */
-		double user_time_;
+		/** \brief Flag used to indicates that the runtime has spawned new instances waiting to join the group. */
+		bool requested_instances_;
 
-		/** \brief The CPU system time. */
-		double system_time_;
+		/** \brief Resources used by the instance, as last sampled. */
+		ResourceSampler resources_;
+
+		/** \brief Clock time, in seconds, when the resources were last sampled. */
+		double last_resources_time_;
+
+		/** \brief CPU time, in seconds, when the resources were last sampled. */
+		double last_resources_cpu_time_;
 
 		/** \brief Sequence number of a message. */
 		int message_sequence_number_;
 
+		/** \brief Instance whose migration was requested by the runtime, -1 when there is none. */
+		int requested_migration_;
+
+		/** \brief Instance replacing the one whose migration was requested. */
+		int migration_successor_;
+
+		/** \brief Number of records sent to the consumers. */
+		long records_sent_;
+
+		/** \brief Number of records received from the producers. */
+		long records_received_;
+
+		/** \brief Origin time of the records being processed, in nanoseconds, 0 outside of Process. */
+		int64_t origin_time_;
+
+		/** \brief Records counted when the statistics were last reported. */
+		long last_statistics_records_;
+
+		/** \brief Clock time, in seconds, when the statistics were last reported. */
+		double last_statistics_time_;
+
+		/** \brief CPU time, in seconds, when the statistics were last reported. */
+		double last_statistics_cpu_time_;
+
+		/** \brief Context switches caused by blocking when the statistics were last reported. */
+		long last_statistics_voluntary_switches_;
+
+		/** \brief Context switches caused by preemption when the statistics were last reported. */
+		long last_statistics_involuntary_switches_;
+
+		/** \brief Time, in seconds, spent waiting for consumer credits since the statistics were last reported. */
+		double starvation_time_;
+
+		/** \brief Checkpoint whose barrier has arrived through some producer channels, -1 when there is none. */
+		long aligning_checkpoint_;
+
+		/** \brief Last checkpoint taken or restored, -1 when there is none. */
+		long last_checkpoint_;
+
+		/** \brief Checkpoint requested by the runtime to a module without inputs, -1 when there is none. */
+		long requested_checkpoint_;
+
+		/** \brief State changed since the last checkpoint. */
+		CheckpointState checkpoint_state_;
+
+		/** \brief Writer of the checkpoint log, NULL when the module has no checkpoint directory. */
+		CheckpointWriter* checkpoint_writer_;
+
+		/** \brief Timers scheduled by the module. */
+		TimerWheel timer_wheel_;
+
+		/** \brief Metrics of the instance, published to the runtime of the host. */
+		MetricsRegistry metrics_;
+
+		/** \brief Sends the log messages to the runtime in batches once the instance is running, NULL otherwise. */
+		AsyncLogger* logger_;
+
+		/** \brief Rate limiter of a source module, NULL when it is limited only by the consumers' credits. */
+		TokenBucket* token_bucket_;
+
+		/** \brief Buffer holding the data messages of a batch. */
+		Message* batch_messages_;
+
+		/** \brief Input index of each data message of the batch. */
+		int* batch_inputs_;
+
+		/** \brief Input index of the message being processed, -1 outside Process. */
+		int current_input_;
+
+		/** \brief Layout of the binary output records, NULL when the output is not binary. */
+		RecordSchema* output_schema_;
+
 		/** \brief Communicator with the database group. */
 		MpiCommunicator* database_communicator_;
 
@@ -455,6 +821,18 @@ class ProcessingModule {
 		/** \brief Module producers. */
 		map < string, DataProducer* > producers_;
 
+		/** \brief Reorder buffers of the ordered inputs, by input name. */
+		map < string, ReorderBuffer* > reorder_buffers_;
+
+		/** \brief Producer channels, as producer and instance, through which the checkpoint barrier has arrived. */
+		set < pair < string, int > > aligned_channels_;
+
+		/** \brief Messages received through the aligned channels, delivered after the checkpoint. */
+		deque < ChannelMessage > aligned_messages_;
+
+		/** \brief Aligned channels which ran out of credit, granted a new one once the checkpoint is taken. */
+		set < pair < string, int > > deferred_credits_;
+
 		/** \brief The queris for all consumers. */
 		vector < string > queries_flows_consumers_;
 };
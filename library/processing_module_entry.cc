@@ -16,6 +16,7 @@ ProcessingModuleEntry::ProcessingModuleEntry ( MpiCommunicator* communicator, Pr
 	}
 	SetCommunicator ( communicator );
 	SetConfigurator ( configurator );
+	timerclear ( &last_scaling_time_ );
 }
 
 ProcessingModuleEntry::~ProcessingModuleEntry ( void ) {
@@ -27,6 +28,10 @@ ProcessingModuleEntry::~ProcessingModuleEntry ( void ) {
 	delete ( communicator_ );
 }
 
+void ProcessingModuleEntry::ClearStatistics ( void ) {
+	statistics_.clear ( );
+}
+
 MpiCommunicator* ProcessingModuleEntry::GetCommunicator ( void ) {
 	return communicator_;
 }
@@ -35,6 +40,14 @@ ProcessingModuleConfigurator* ProcessingModuleEntry::GetConfigurator ( void ) {
 	return configurator_;
 }
 
+struct timeval ProcessingModuleEntry::GetLastScalingTime ( void ) {
+	return last_scaling_time_;
+}
+
+map < int, InstanceStatisticsMessage >* ProcessingModuleEntry::GetStatistics ( void ) {
+	return &statistics_;
+}
+
 void ProcessingModuleEntry::Lock ( void ) {
 	pthread_mutex_lock ( &class_mutex_ );
 }
@@ -47,6 +60,15 @@ void ProcessingModuleEntry::SetConfigurator ( ProcessingModuleConfigurator* conf
 	configurator_ = configurator;
 }
 
+void ProcessingModuleEntry::SetLastScalingTime ( struct timeval last_scaling_time ) {
+	last_scaling_time_ = last_scaling_time;
+}
+
+void ProcessingModuleEntry::SetStatistics ( int instance, InstanceStatisticsMessage& statistics ) {
+	statistics_.erase ( instance );
+	statistics_.insert ( make_pair ( instance, statistics ) );
+}
+
 void ProcessingModuleEntry::Unlock ( void ) {
 	pthread_mutex_unlock ( &class_mutex_ );
 }
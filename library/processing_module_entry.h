@@ -7,6 +7,14 @@
 #ifndef WATERSHED_LIBRARY_PROCESSING_MODULE_ENTRY_H_
 #define WATERSHED_LIBRARY_PROCESSING_MODULE_ENTRY_H_
 
+/* C libraries */
+#include <sys/time.h>
+
+/* C++ libraries */
+#include <map>
+
+/* Project's .h */
+#include "comm/message_data.h"
 #include "comm/mpi/mpi_communicator.h"
 #include "library/configurator.h"
 
@@ -61,6 +69,24 @@ class ProcessingModuleEntry {
 		 */
 		ProcessingModuleConfigurator* GetConfigurator ( void );
 
+		/**
+		 * \brief Retrieves the last statistics reported by each instance since the statistics were cleared.
+		 * \return The statistics by instance rank.
+		 */
+		map < int, InstanceStatisticsMessage >* GetStatistics ( void );
+
+		/**
+		 * \brief Retrieves when the module was last scaled.
+		 * \return The time of the last scaling operation, zero when it has never been scaled.
+		 */
+		struct timeval GetLastScalingTime ( void );
+
+		/**
+		 * \brief Discards the statistics reported by the instances.
+		 * \return Not applicable.
+		 */
+		void ClearStatistics ( void );
+
 		/**
 		 * \brief Sets the communicator.
 		 * \param communicator The communicator to be used.
@@ -75,6 +101,21 @@ class ProcessingModuleEntry {
 		 */
 		void SetConfigurator ( ProcessingModuleConfigurator* configurator );
 
+		/**
+		 * \brief Sets when the module was last scaled.
+		 * \param last_scaling_time The time of the scaling operation.
+		 * \return Not applicable.
+		 */
+		void SetLastScalingTime ( struct timeval last_scaling_time );
+
+		/**
+		 * \brief Keeps the statistics reported by an instance, replacing its previous report.
+		 * \param instance The instance rank.
+		 * \param statistics The statistics.
+		 * \return Not applicable.
+		 */
+		void SetStatistics ( int instance, InstanceStatisticsMessage& statistics );
+
 	protected:
 
 	private:
@@ -90,6 +131,12 @@ class ProcessingModuleEntry {
 
 		/** \brief The PM entry configurator. */
 		ProcessingModuleConfigurator* configurator_;
+
+		/** \brief The last statistics reported by each instance. */
+		map < int, InstanceStatisticsMessage > statistics_;
+
+		/** \brief Time of the last scaling operation. */
+		struct timeval last_scaling_time_;
 };
 
 #endif /* WATERSHED_LIBRARY_PROCESSING_MODULE_ENTRY_H_ */
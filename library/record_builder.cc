@@ -0,0 +1,58 @@
+/**
+ * \file library/record_builder.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <string.h>
+
+/* Project's .h */
+#include "library/record_builder.h"
+
+RecordBuilder::RecordBuilder ( RecordSchema* schema, Message& message ) {
+	schema_ = schema;
+	message_ = &message;
+	record_ = ( char* ) message.GetData ( );
+	Reset ( );
+}
+
+RecordBuilder::~RecordBuilder ( void ) {
+}
+
+void RecordBuilder::Reset ( void ) {
+	size_ = schema_->GetFixedSize ( );
+	memset ( record_, 0, size_ );
+	RecordSchema::Write32 ( record_, schema_->GetIdentifier ( ) );
+	message_->SetDataSize ( size_ );
+}
+
+void RecordBuilder::SetDouble ( int field, double value ) {
+	uint64_t bits;
+	memcpy ( &bits, &value, sizeof(double) );
+	RecordSchema::Write64 ( record_ + schema_->GetFieldOffset ( field ), bits );
+}
+
+void RecordBuilder::SetInt ( int field, int32_t value ) {
+	RecordSchema::Write32 ( record_ + schema_->GetFieldOffset ( field ), ( uint32_t ) value );
+}
+
+void RecordBuilder::SetLong ( int field, int64_t value ) {
+	RecordSchema::Write64 ( record_ + schema_->GetFieldOffset ( field ), ( uint64_t ) value );
+}
+
+bool RecordBuilder::SetString ( int field, const char* value, int length ) {
+	if ( length < 0 || size_ + length > Constants::MAX_DATA_SIZE ) {
+		return false;
+	}
+	memcpy ( record_ + size_, value, length );
+	RecordSchema::Write32 ( record_ + schema_->GetFieldOffset ( field ), size_ );
+	RecordSchema::Write32 ( record_ + schema_->GetFieldOffset ( field ) + sizeof(uint32_t), length );
+	size_ += length;
+	message_->SetDataSize ( size_ );
+	return true;
+}
+
+bool RecordBuilder::SetString ( int field, string value ) {
+	return SetString ( field, value.data ( ), value.length ( ) );
+}
@@ -0,0 +1,110 @@
+/**
+ * \file library/record_builder.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_RECORD_BUILDER_H_
+#define WATERSHED_LIBRARY_RECORD_BUILDER_H_
+
+/* C++ libraries */
+#include <string>
+
+/* Project's .h */
+#include "comm/message.h"
+#include "library/record_schema.h"
+
+using namespace std;
+
+/**
+ * \class RecordBuilder
+ * \brief Writes a binary record directly into the data of a message, following the layout of a RecordSchema. Fields
+ * may be set in any order; the ones not set are zero or empty.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class RecordBuilder {
+
+	public:
+
+		/**
+		 * \brief Creates a new RecordBuilder instance and starts a record in the message.
+		 * \param schema The record layout.
+		 * \param message The message to hold the record.
+		 * \return Not applicable.
+		 */
+		RecordBuilder ( RecordSchema* schema, Message& message );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~RecordBuilder ( void );
+
+		/**
+		 * \brief Sets a string field. The value is appended to the record, so it should be set only once.
+		 * \param field The field index.
+		 * \param value Pointer to the value.
+		 * \param length The value length in bytes.
+		 * \return False if the value does not fit in the message.
+		 */
+		bool SetString ( int field, const char* value, int length );
+
+		/**
+		 * \brief Sets a string field. The value is appended to the record, so it should be set only once.
+		 * \param field The field index.
+		 * \param value The value.
+		 * \return False if the value does not fit in the message.
+		 */
+		bool SetString ( int field, string value );
+
+		/**
+		 * \brief Discards the fields written and starts a new record in the same message.
+		 * \return Not applicable.
+		 */
+		void Reset ( void );
+
+		/**
+		 * \brief Sets a double field.
+		 * \param field The field index.
+		 * \param value The value.
+		 * \return Not applicable.
+		 */
+		void SetDouble ( int field, double value );
+
+		/**
+		 * \brief Sets an int field.
+		 * \param field The field index.
+		 * \param value The value.
+		 * \return Not applicable.
+		 */
+		void SetInt ( int field, int32_t value );
+
+		/**
+		 * \brief Sets a long field.
+		 * \param field The field index.
+		 * \param value The value.
+		 * \return Not applicable.
+		 */
+		void SetLong ( int field, int64_t value );
+
+	protected:
+
+	private:
+
+		/** \brief The record layout. */
+		RecordSchema* schema_;
+
+		/** \brief The message holding the record. */
+		Message* message_;
+
+		/** \brief Beginning of the record in the message data. */
+		char* record_;
+
+		/** \brief Current record size. */
+		int size_;
+};
+
+#endif /* WATERSHED_LIBRARY_RECORD_BUILDER_H_ */
@@ -0,0 +1,266 @@
+/**
+ * \file library/record_query.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <stdlib.h>
+
+/* Project's .h */
+#include "library/record_query.h"
+
+RecordQuery::RecordQuery ( RecordSchema* schema, string query ) {
+	schema_ = schema;
+	projected_field_ = -1;
+	text_node_ = false;
+	compiled_ = Compile ( Trim ( query ) );
+}
+
+RecordQuery::~RecordQuery ( void ) {
+	conditions_.clear ( );
+}
+
+bool RecordQuery::Compile ( string query ) {
+	bool descendant = false;
+	if ( query.compare ( 0, 2, "//" ) == 0 ) {
+		descendant = true;
+		query.erase ( 0, 2 );
+	}
+	else if ( query.compare ( 0, 1, "/" ) == 0 ) {
+		query.erase ( 0, 1 );
+	}
+
+	/* Splits the steps */
+	vector < string > steps;
+	string::size_type begin = 0;
+	string::size_type end;
+	while ( ( end = FindUnquoted ( query, "/", begin ) ) != string::npos ) {
+		steps.push_back ( Trim ( query.substr ( begin, end - begin ) ) );
+		begin = end + 1;
+	}
+	steps.push_back ( Trim ( query.substr ( begin ) ) );
+
+	if ( steps.back ( ) == "text()" ) {
+		text_node_ = true;
+		steps.pop_back ( );
+	}
+	if ( steps.empty ( ) || steps.size ( ) > 2 ) {
+		return false;
+	}
+
+	/* A descendant field, as //price */
+	if ( descendant && steps.size ( ) == 1 && steps[0] != schema_->GetName ( ) ) {
+		projected_field_ = schema_->GetFieldIndex ( steps[0] );
+		return projected_field_ >= 0;
+	}
+
+	/* The record, with its predicates, and then a field */
+	string record_step = steps[0];
+	string::size_type predicates = record_step.find ( '[' );
+	string record_name = Trim ( record_step.substr ( 0, predicates ) );
+	if ( record_name != schema_->GetName ( ) && record_name != "*" ) {
+		return false;
+	}
+	if ( predicates != string::npos && !CompilePredicates ( record_step.substr ( predicates ) ) ) {
+		return false;
+	}
+	if ( steps.size ( ) == 2 ) {
+		projected_field_ = schema_->GetFieldIndex ( steps[1] );
+		if ( projected_field_ < 0 || schema_->GetFieldIndex ( schema_->GetName ( ) ) >= 0 ) {
+			return false;
+		}
+	}
+	else if ( text_node_ ) {
+		return false;
+	}
+	return true;
+}
+
+bool RecordQuery::CompileCondition ( string condition ) {
+	const char* operators[] = { "!=", "<=", ">=", "=", "<", ">" };
+	const Operator codes[] = { OPERATOR_NOT_EQUAL, OPERATOR_LESS_EQUAL, OPERATOR_GREATER_EQUAL, OPERATOR_EQUAL, OPERATOR_LESS, OPERATOR_GREATER };
+
+	Condition compiled;
+	string::size_type position = string::npos;
+	string::size_type length = 0;
+	for ( int i = 0; i < 6; ++i ) {
+		string::size_type found = FindUnquoted ( condition, operators[i], 0 );
+		if ( found < position ) {
+			position = found;
+			length = string ( operators[i] ).length ( );
+			compiled.operator_ = codes[i];
+		}
+	}
+	if ( position == string::npos ) {
+		return false;
+	}
+
+	compiled.field_ = schema_->GetFieldIndex ( Trim ( condition.substr ( 0, position ) ) );
+	if ( compiled.field_ < 0 ) {
+		return false;
+	}
+
+	string literal = Trim ( condition.substr ( position + length ) );
+	if ( literal.length ( ) >= 2 && ( literal[0] == '"' || literal[0] == '\'' ) && literal[literal.length ( ) - 1] == literal[0] ) {
+		compiled.numeric_ = false;
+		compiled.number_ = 0;
+		compiled.text_ = literal.substr ( 1, literal.length ( ) - 2 );
+	}
+	else {
+		char* end;
+		compiled.numeric_ = true;
+		compiled.number_ = strtod ( literal.c_str ( ), &end );
+		if ( literal.empty ( ) || *end != '\0' ) {
+			return false;
+		}
+	}
+	conditions_.push_back ( compiled );
+	return true;
+}
+
+bool RecordQuery::CompilePredicates ( string predicates ) {
+	string::size_type begin = 0;
+	while ( begin < predicates.length ( ) ) {
+		if ( predicates[begin] != '[' ) {
+			return false;
+		}
+		string::size_type end = FindUnquoted ( predicates, "]", begin );
+		if ( end == string::npos ) {
+			return false;
+		}
+		string predicate = predicates.substr ( begin + 1, end - begin - 1 );
+		if ( FindUnquoted ( predicate, " or ", 0 ) != string::npos || FindUnquoted ( predicate, "(", 0 ) != string::npos ) {
+			return false;
+		}
+
+		string::size_type condition_begin = 0;
+		string::size_type condition_end;
+		while ( ( condition_end = FindUnquoted ( predicate, " and ", condition_begin ) ) != string::npos ) {
+			if ( !CompileCondition ( predicate.substr ( condition_begin, condition_end - condition_begin ) ) ) {
+				return false;
+			}
+			condition_begin = condition_end + 5;
+		}
+		if ( !CompileCondition ( predicate.substr ( condition_begin ) ) ) {
+			return false;
+		}
+		begin = predicates.find_first_not_of ( " \t\r\n", end + 1 );
+	}
+	return true;
+}
+
+bool RecordQuery::Evaluate ( Condition& condition, RecordView& record ) {
+	int comparison;
+	if ( condition.numeric_ ) {
+		double value;
+		switch ( record.GetSchema ( )->GetFieldType ( condition.field_ ) ) {
+			case RecordSchema::FIELD_INT : {
+				value = record.GetInt ( condition.field_ );
+				break;
+			}
+
+			case RecordSchema::FIELD_LONG : {
+				value = record.GetLong ( condition.field_ );
+				break;
+			}
+
+			case RecordSchema::FIELD_DOUBLE : {
+				value = record.GetDouble ( condition.field_ );
+				break;
+			}
+
+			default : {
+				/* Text that is not a number never satisfies a numeric comparison */
+				string text = Trim ( record.GetText ( condition.field_ ) );
+				char* end;
+				value = strtod ( text.c_str ( ), &end );
+				if ( text.empty ( ) || *end != '\0' ) {
+					return false;
+				}
+				break;
+			}
+		}
+		if ( value != value ) {
+			return condition.operator_ == OPERATOR_NOT_EQUAL;
+		}
+		comparison = ( value < condition.number_ ) ? -1 : ( ( value > condition.number_ ) ? 1 : 0 );
+	}
+	else {
+		comparison = record.GetText ( condition.field_ ).compare ( condition.text_ );
+	}
+
+	switch ( condition.operator_ ) {
+		case OPERATOR_EQUAL :
+			return comparison == 0;
+		case OPERATOR_NOT_EQUAL :
+			return comparison != 0;
+		case OPERATOR_LESS :
+			return comparison < 0;
+		case OPERATOR_LESS_EQUAL :
+			return comparison <= 0;
+		case OPERATOR_GREATER :
+			return comparison > 0;
+		default :
+			return comparison >= 0;
+	}
+}
+
+string RecordQuery::Execute ( RecordView& record ) {
+	if ( !record.IsValid ( ) ) {
+		return "";
+	}
+	for ( unsigned int i = 0; i < conditions_.size ( ); ++i ) {
+		if ( !Evaluate ( conditions_[i], record ) ) {
+			return "";
+		}
+	}
+
+	string value;
+	if ( projected_field_ < 0 ) {
+		/* The string value of the record is the concatenation of its fields */
+		for ( int i = 0; i < schema_->GetNumberFields ( ); ++i ) {
+			value.append ( record.GetText ( i ) );
+		}
+	}
+	else {
+		value = record.GetText ( projected_field_ );
+
+		/* An empty element has no text node */
+		if ( text_node_ && value.empty ( ) ) {
+			return "";
+		}
+	}
+	value.append ( " " );
+	return value;
+}
+
+string::size_type RecordQuery::FindUnquoted ( string query, string text, string::size_type position ) {
+	char quote = 0;
+	for ( string::size_type i = position; i < query.length ( ); ++i ) {
+		if ( quote != 0 ) {
+			if ( query[i] == quote ) {
+				quote = 0;
+			}
+		}
+		else if ( query[i] == '"' || query[i] == '\'' ) {
+			quote = query[i];
+		}
+		else if ( query.compare ( i, text.length ( ), text ) == 0 ) {
+			return i;
+		}
+	}
+	return string::npos;
+}
+
+bool RecordQuery::IsCompiled ( void ) {
+	return compiled_;
+}
+
+string RecordQuery::Trim ( string text ) {
+	string::size_type begin = text.find_first_not_of ( " \t\r\n" );
+	if ( begin == string::npos ) {
+		return "";
+	}
+	return text.substr ( begin, text.find_last_not_of ( " \t\r\n" ) - begin + 1 );
+}
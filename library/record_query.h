@@ -0,0 +1,141 @@
+/**
+ * \file library/record_query.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_RECORD_QUERY_H_
+#define WATERSHED_LIBRARY_RECORD_QUERY_H_
+
+/* C++ libraries */
+#include <string>
+#include <vector>
+
+/* Project's .h */
+#include "library/record_schema.h"
+#include "library/record_view.h"
+
+using namespace std;
+
+/**
+ * \class RecordQuery
+ * \brief Evaluates an input flow query directly over binary records, without building their XML form. It accepts the
+ * paths that select the record or one of its fields, with the record filtered by comparisons between fields and
+ * literals, as in /trade[price > 10 and symbol = 'ABC']/volume or //volume. Other queries are not compiled and have to
+ * be evaluated by XMLQuery over RecordView::ToXML.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class RecordQuery {
+
+	public:
+
+		/**
+		 * \brief Creates a new RecordQuery instance and compiles the query against the schema.
+		 * \param schema The layout of the records.
+		 * \param query The query text.
+		 * \return Not applicable.
+		 */
+		RecordQuery ( RecordSchema* schema, string query );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~RecordQuery ( void );
+
+		/**
+		 * \brief Checks whether the query could be compiled to run over binary records.
+		 * \return True if Execute can be used.
+		 */
+		bool IsCompiled ( void );
+
+		/**
+		 * \brief Executes the query over a record.
+		 * \param record The record.
+		 * \return The items of the result, each one followed by a space, as returned by XMLQuery::ExecuteQuery.
+		 */
+		string Execute ( RecordView& record );
+
+	protected:
+
+	private:
+
+		/** \brief Comparison operators. */
+		enum Operator {
+			OPERATOR_EQUAL, OPERATOR_NOT_EQUAL, OPERATOR_LESS, OPERATOR_LESS_EQUAL, OPERATOR_GREATER, OPERATOR_GREATER_EQUAL
+		};
+
+		/** \brief A comparison between a field and a literal. */
+		struct Condition {
+				int field_;
+				Operator operator_;
+				bool numeric_;
+				double number_;
+				string text_;
+		};
+
+		/**
+		 * \brief Compiles the query.
+		 * \param query The query text.
+		 * \return True if the query is supported.
+		 */
+		bool Compile ( string query );
+
+		/**
+		 * \brief Compiles a comparison of a predicate.
+		 * \param condition The comparison text.
+		 * \return True if the comparison is supported.
+		 */
+		bool CompileCondition ( string condition );
+
+		/**
+		 * \brief Compiles the predicates of the record step.
+		 * \param predicates The text of the predicates, each one between brackets.
+		 * \return True if the predicates are supported.
+		 */
+		bool CompilePredicates ( string predicates );
+
+		/**
+		 * \brief Evaluates a comparison over a record.
+		 * \param condition The comparison.
+		 * \param record The record.
+		 * \return True if the record satisfies the comparison.
+		 */
+		bool Evaluate ( Condition& condition, RecordView& record );
+
+		/**
+		 * \brief Finds a text outside the quoted literals of a query.
+		 * \param query The query.
+		 * \param text The text to be found.
+		 * \param position Where the search starts.
+		 * \return The text position, or string::npos.
+		 */
+		static string::size_type FindUnquoted ( string query, string text, string::size_type position );
+
+		/**
+		 * \brief Removes the blanks around a text.
+		 * \param text The text.
+		 * \return The text without leading and trailing blanks.
+		 */
+		static string Trim ( string text );
+
+		/** \brief The layout of the records. */
+		RecordSchema* schema_;
+
+		/** \brief Comparisons the record must satisfy. */
+		vector < Condition > conditions_;
+
+		/** \brief Field selected by the query, or -1 when it selects the record. */
+		int projected_field_;
+
+		/** \brief Whether the query selects the text node of the field. */
+		bool text_node_;
+
+		/** \brief Whether the query is supported. */
+		bool compiled_;
+};
+
+#endif /* WATERSHED_LIBRARY_RECORD_QUERY_H_ */
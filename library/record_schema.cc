@@ -0,0 +1,209 @@
+/**
+ * \file library/record_schema.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <arpa/inet.h>
+#include <string.h>
+
+/* C++ libraries */
+#include <fstream>
+#include <map>
+#include <sstream>
+
+/* Project's .h */
+#include "common/util.h"
+#include "library/record_schema.h"
+
+RecordSchema::RecordSchema ( void ) {
+	fixed_size_ = sizeof(uint32_t);
+	identifier_ = 2166136261u;
+}
+
+RecordSchema::RecordSchema ( string structure_file_name ) throw ( FileOperationException, XMLParserException ) {
+	fixed_size_ = sizeof(uint32_t);
+	identifier_ = 2166136261u;
+
+	ifstream structure_file ( structure_file_name.c_str ( ) );
+	if ( !structure_file.is_open ( ) ) {
+		throw FileOperationException ( "cannot open the structure file " + structure_file_name );
+	}
+	stringstream structure;
+	structure << structure_file.rdbuf ( );
+	structure_file.close ( );
+
+	try {
+		ParseStructure ( structure.str ( ) );
+	}
+	catch ( XMLParserException& e ) {
+		throw e;
+	}
+}
+
+RecordSchema::~RecordSchema ( void ) {
+	fields_.clear ( );
+}
+
+void RecordSchema::AddField ( string name, FieldType type ) {
+	Field field;
+	field.name_ = name;
+	field.type_ = type;
+	field.offset_ = fixed_size_;
+	fields_.push_back ( field );
+	fixed_size_ += ( type == FIELD_INT ) ? sizeof(uint32_t) : 2 * sizeof(uint32_t);
+
+	/* FNV-1a over the names and types, so producers and consumers can detect different layouts */
+	string signature = name + ( char ) ( '0' + type );
+	for ( unsigned int i = 0; i < signature.length ( ); ++i ) {
+		identifier_ ^= ( unsigned char ) signature[i];
+		identifier_ *= 16777619u;
+	}
+}
+
+int RecordSchema::GetFieldIndex ( string name ) {
+	for ( unsigned int i = 0; i < fields_.size ( ); ++i ) {
+		if ( fields_[i].name_ == name ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+string RecordSchema::GetFieldName ( int field ) {
+	return fields_[field].name_;
+}
+
+int RecordSchema::GetFieldOffset ( int field ) {
+	return fields_[field].offset_;
+}
+
+RecordSchema::FieldType RecordSchema::GetFieldType ( int field ) {
+	return fields_[field].type_;
+}
+
+int RecordSchema::GetFixedSize ( void ) {
+	return fixed_size_;
+}
+
+uint32_t RecordSchema::GetIdentifier ( void ) {
+	return identifier_;
+}
+
+string RecordSchema::GetName ( void ) {
+	return name_;
+}
+
+int RecordSchema::GetNumberFields ( void ) {
+	return fields_.size ( );
+}
+
+void RecordSchema::ParseStructure ( string structure ) throw ( XMLParserException ) {
+	/* Removes the comments */
+	string::size_type begin;
+	while ( ( begin = structure.find ( "<!--" ) ) != string::npos ) {
+		string::size_type end = structure.find ( "-->", begin );
+		structure.erase ( begin, ( end == string::npos ) ? string::npos : end + 3 - begin );
+	}
+
+	/* Collects the content of the elements and the default value of their type attributes */
+	string record_name;
+	string record_content;
+	map < string, string > field_types;
+	string::size_type position = 0;
+	while ( ( position = structure.find ( "<!", position ) ) != string::npos ) {
+		string::size_type end = structure.find ( '>', position );
+		if ( end == string::npos ) {
+			throw XMLParserException ( "unterminated declaration in the structure file" );
+		}
+		string declaration = structure.substr ( position + 2, end - position - 2 );
+		position = end + 1;
+
+		vector < string > tokens = Util::TokenizeString ( " \t\r\n", declaration );
+		if ( tokens.size ( ) < 2 ) {
+			continue;
+		}
+		if ( tokens[0] == "ELEMENT" && record_name.empty ( ) ) {
+			record_name = tokens[1];
+			record_content = declaration.substr ( declaration.find ( tokens[1], tokens[0].length ( ) ) + tokens[1].length ( ) );
+		}
+		else if ( tokens[0] == "ATTLIST" ) {
+			for ( unsigned int i = 2; i + 2 < tokens.size ( ); ++i ) {
+				if ( tokens[i] != "type" ) {
+					continue;
+				}
+				unsigned int default_value = ( tokens[i + 2] == "#FIXED" ) ? i + 3 : i + 2;
+				if ( default_value < tokens.size ( ) && tokens[default_value].length ( ) > 2 && ( tokens[default_value][0] == '"' || tokens[default_value][0] == '\'' ) ) {
+					field_types[tokens[1]] = tokens[default_value].substr ( 1, tokens[default_value].length ( ) - 2 );
+				}
+				break;
+			}
+		}
+	}
+
+	if ( record_name.empty ( ) ) {
+		throw XMLParserException ( "the structure file does not declare a record element" );
+	}
+	SetName ( record_name );
+
+	vector < string > children = Util::TokenizeString ( " \t\r\n(),", record_content );
+	for ( unsigned int i = 0; i < children.size ( ); ++i ) {
+		string name = children[i];
+		char modifier = name[name.length ( ) - 1];
+		if ( modifier == '*' || modifier == '+' || name.find ( '|' ) != string::npos ) {
+			throw XMLParserException ( "the field " + name + " of " + record_name + " does not have a fixed position" );
+		}
+		if ( modifier == '?' ) {
+			name.erase ( name.length ( ) - 1 );
+		}
+		if ( name == "#PCDATA" || name == "EMPTY" || name == "ANY" ) {
+			continue;
+		}
+
+		string type = ( field_types.find ( name ) != field_types.end ( ) ) ? field_types[name] : "string";
+		if ( type == "int" ) {
+			AddField ( name, FIELD_INT );
+		}
+		else if ( type == "long" ) {
+			AddField ( name, FIELD_LONG );
+		}
+		else if ( type == "double" ) {
+			AddField ( name, FIELD_DOUBLE );
+		}
+		else if ( type == "string" ) {
+			AddField ( name, FIELD_STRING );
+		}
+		else {
+			throw XMLParserException ( "unknown type " + type + " of the field " + name );
+		}
+	}
+
+	if ( fields_.empty ( ) ) {
+		throw XMLParserException ( "the record " + record_name + " has no fields" );
+	}
+}
+
+uint32_t RecordSchema::Read32 ( const char* buffer ) {
+	uint32_t value;
+	memcpy ( &value, buffer, sizeof(uint32_t) );
+	return ntohl ( value );
+}
+
+uint64_t RecordSchema::Read64 ( const char* buffer ) {
+	return ( ( uint64_t ) Read32 ( buffer ) << 32 ) | Read32 ( buffer + sizeof(uint32_t) );
+}
+
+void RecordSchema::SetName ( string name ) {
+	name_ = name;
+}
+
+void RecordSchema::Write32 ( char* buffer, uint32_t value ) {
+	value = htonl ( value );
+	memcpy ( buffer, &value, sizeof(uint32_t) );
+}
+
+void RecordSchema::Write64 ( char* buffer, uint64_t value ) {
+	Write32 ( buffer, ( uint32_t ) ( value >> 32 ) );
+	Write32 ( buffer + sizeof(uint32_t), ( uint32_t ) value );
+}
@@ -0,0 +1,192 @@
+/**
+ * \file library/record_schema.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_RECORD_SCHEMA_H_
+#define WATERSHED_LIBRARY_RECORD_SCHEMA_H_
+
+/* C libraries */
+#include <stdint.h>
+
+/* C++ libraries */
+#include <string>
+#include <vector>
+
+/* Project's .h */
+#include "common/exceptions.h"
+
+using namespace std;
+
+/**
+ * \class RecordSchema
+ * \brief Binary layout of the records of an output flow, compiled from the flow structure file. The structure is a DTD
+ * whose first element is the record and whose children are the fields. The type of a field is given by the default
+ * value of its type attribute, as in <!ATTLIST price type CDATA #FIXED "double">, and is string when not declared.
+ *
+ * A record starts with the schema identifier, followed by one slot per field at an offset fixed by the schema: 4 bytes
+ * for int, 8 bytes for long and double, and the offset and length of the value for string. String values are stored
+ * after the slots. All the numbers are in network byte order.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class RecordSchema {
+
+	public:
+
+		/** \brief Types of a field. */
+		enum FieldType {
+			FIELD_INT, FIELD_LONG, FIELD_DOUBLE, FIELD_STRING
+		};
+
+		/**
+		 * \brief Creates a new RecordSchema instance without fields.
+		 * \return Not applicable.
+		 */
+		RecordSchema ( void );
+
+		/**
+		 * \brief Creates a new RecordSchema instance from a structure file.
+		 * \param structure_file_name The structure file name.
+		 * \return Not applicable.
+		 */
+		RecordSchema ( string structure_file_name ) throw ( FileOperationException, XMLParserException );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~RecordSchema ( void );
+
+		/**
+		 * \brief Retrieves the type of a field.
+		 * \param field The field index.
+		 * \return The field type.
+		 */
+		FieldType GetFieldType ( int field );
+
+		/**
+		 * \brief Retrieves the position of a field. It should be resolved once and used for every record.
+		 * \param name The field name.
+		 * \return The field index, or -1 if the schema has no such field.
+		 */
+		int GetFieldIndex ( string name );
+
+		/**
+		 * \brief Retrieves where the slot of a field starts in a record.
+		 * \param field The field index.
+		 * \return The slot offset in bytes.
+		 */
+		int GetFieldOffset ( int field );
+
+		/**
+		 * \brief Retrieves the size of a record without its string values.
+		 * \return The size of the identifier and the slots in bytes.
+		 */
+		int GetFixedSize ( void );
+
+		/**
+		 * \brief Retrieves the number of fields.
+		 * \return The number of fields.
+		 */
+		int GetNumberFields ( void );
+
+		/**
+		 * \brief Retrieves the name of a field.
+		 * \param field The field index.
+		 * \return The field name.
+		 */
+		string GetFieldName ( int field );
+
+		/**
+		 * \brief Retrieves the record name.
+		 * \return The record name.
+		 */
+		string GetName ( void );
+
+		/**
+		 * \brief Retrieves the schema identifier, written at the beginning of every record.
+		 * \return The schema identifier.
+		 */
+		uint32_t GetIdentifier ( void );
+
+		/**
+		 * \brief Reads a 32 bits number in network byte order.
+		 * \param buffer Where the number is.
+		 * \return The number.
+		 */
+		static uint32_t Read32 ( const char* buffer );
+
+		/**
+		 * \brief Reads a 64 bits number in network byte order.
+		 * \param buffer Where the number is.
+		 * \return The number.
+		 */
+		static uint64_t Read64 ( const char* buffer );
+
+		/**
+		 * \brief Appends a field to the schema.
+		 * \param name The field name.
+		 * \param type The field type.
+		 * \return Not applicable.
+		 */
+		void AddField ( string name, FieldType type );
+
+		/**
+		 * \brief Sets the record name.
+		 * \param name The record name.
+		 * \return Not applicable.
+		 */
+		void SetName ( string name );
+
+		/**
+		 * \brief Writes a 32 bits number in network byte order.
+		 * \param buffer Where the number is written.
+		 * \param value The number.
+		 * \return Not applicable.
+		 */
+		static void Write32 ( char* buffer, uint32_t value );
+
+		/**
+		 * \brief Writes a 64 bits number in network byte order.
+		 * \param buffer Where the number is written.
+		 * \param value The number.
+		 * \return Not applicable.
+		 */
+		static void Write64 ( char* buffer, uint64_t value );
+
+	protected:
+
+	private:
+
+		/** \brief Description of a field. */
+		struct Field {
+				string name_;
+				FieldType type_;
+				int offset_;
+		};
+
+		/**
+		 * \brief Parses the record declarations of a structure file.
+		 * \param structure The structure file content.
+		 * \return Not applicable.
+		 */
+		void ParseStructure ( string structure ) throw ( XMLParserException );
+
+		/** \brief The record name. */
+		string name_;
+
+		/** \brief The fields, in record order. */
+		vector < Field > fields_;
+
+		/** \brief Size of the identifier and the slots. */
+		int fixed_size_;
+
+		/** \brief Hash of the field names and types. */
+		uint32_t identifier_;
+};
+
+#endif /* WATERSHED_LIBRARY_RECORD_SCHEMA_H_ */
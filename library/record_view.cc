@@ -0,0 +1,110 @@
+/**
+ * \file library/record_view.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <stdio.h>
+#include <string.h>
+
+/* Project's .h */
+#include "library/record_view.h"
+#include "library/xml_writer.h"
+
+RecordView::RecordView ( RecordSchema* schema, Message& message ) {
+	schema_ = schema;
+	record_ = ( const char* ) message.GetData ( );
+	size_ = message.GetDataSize ( );
+}
+
+RecordView::RecordView ( RecordSchema* schema, const char* record, int size ) {
+	schema_ = schema;
+	record_ = record;
+	size_ = size;
+}
+
+RecordView::~RecordView ( void ) {
+}
+
+double RecordView::GetDouble ( int field ) {
+	uint64_t bits = RecordSchema::Read64 ( record_ + schema_->GetFieldOffset ( field ) );
+	double value;
+	memcpy ( &value, &bits, sizeof(double) );
+	return value;
+}
+
+int32_t RecordView::GetInt ( int field ) {
+	return ( int32_t ) RecordSchema::Read32 ( record_ + schema_->GetFieldOffset ( field ) );
+}
+
+int64_t RecordView::GetLong ( int field ) {
+	return ( int64_t ) RecordSchema::Read64 ( record_ + schema_->GetFieldOffset ( field ) );
+}
+
+RecordSchema* RecordView::GetSchema ( void ) {
+	return schema_;
+}
+
+const char* RecordView::GetString ( int field, int* length ) {
+	uint32_t offset = RecordSchema::Read32 ( record_ + schema_->GetFieldOffset ( field ) );
+	uint32_t value_length = RecordSchema::Read32 ( record_ + schema_->GetFieldOffset ( field ) + sizeof(uint32_t) );
+
+	/* A corrupted slot is read as an empty value */
+	if ( offset < ( uint32_t ) schema_->GetFixedSize ( ) || offset > ( uint32_t ) size_ || value_length > ( uint32_t ) size_ - offset ) {
+		*length = 0;
+		return record_ + size_;
+	}
+	*length = value_length;
+	return record_ + offset;
+}
+
+string RecordView::GetText ( int field ) {
+	char number[32];
+	switch ( schema_->GetFieldType ( field ) ) {
+		case RecordSchema::FIELD_INT : {
+			snprintf ( number, sizeof ( number ), "%d", GetInt ( field ) );
+			break;
+		}
+
+		case RecordSchema::FIELD_LONG : {
+			snprintf ( number, sizeof ( number ), "%lld", ( long long ) GetLong ( field ) );
+			break;
+		}
+
+		case RecordSchema::FIELD_DOUBLE : {
+			snprintf ( number, sizeof ( number ), "%.15g", GetDouble ( field ) );
+			break;
+		}
+
+		default : {
+			int length;
+			const char* value = GetString ( field, &length );
+			return string ( value, length );
+		}
+	}
+	return number;
+}
+
+bool RecordView::IsValid ( void ) {
+	return size_ >= schema_->GetFixedSize ( ) && RecordSchema::Read32 ( record_ ) == schema_->GetIdentifier ( );
+}
+
+string RecordView::ToXML ( void ) {
+	XMLWriter writer ( size_ * 2 + 64 );
+	writer.CreateTag ( schema_->GetName ( ) );
+	for ( int i = 0; i < schema_->GetNumberFields ( ); ++i ) {
+		writer.CreateTag ( schema_->GetFieldName ( i ) );
+		if ( schema_->GetFieldType ( i ) == RecordSchema::FIELD_STRING ) {
+			int length;
+			const char* value = GetString ( i, &length );
+			writer.CreateCharData ( value, length );
+		}
+		else {
+			writer.CreateCharData ( GetText ( i ) );
+		}
+		writer.CloseTag ( schema_->GetFieldName ( i ) );
+	}
+	writer.CloseTag ( schema_->GetName ( ) );
+	return string ( writer.GetData ( ), writer.GetSize ( ) );
+}
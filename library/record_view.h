@@ -0,0 +1,123 @@
+/**
+ * \file library/record_view.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_RECORD_VIEW_H_
+#define WATERSHED_LIBRARY_RECORD_VIEW_H_
+
+/* C++ libraries */
+#include <string>
+
+/* Project's .h */
+#include "comm/message.h"
+#include "library/record_schema.h"
+
+using namespace std;
+
+/**
+ * \class RecordView
+ * \brief Reads the fields of a binary record in place, following the layout of a RecordSchema. It does not copy nor own
+ * the record, which must outlive the view.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class RecordView {
+
+	public:
+
+		/**
+		 * \brief Creates a new RecordView instance over the data of a message.
+		 * \param schema The record layout.
+		 * \param message The message holding the record.
+		 * \return Not applicable.
+		 */
+		RecordView ( RecordSchema* schema, Message& message );
+
+		/**
+		 * \brief Creates a new RecordView instance over a buffer.
+		 * \param schema The record layout.
+		 * \param record The record.
+		 * \param size The record size in bytes.
+		 * \return Not applicable.
+		 */
+		RecordView ( RecordSchema* schema, const char* record, int size );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~RecordView ( void );
+
+		/**
+		 * \brief Checks whether the record was written with the schema of this view.
+		 * \return True if the record identifier and size match the schema.
+		 */
+		bool IsValid ( void );
+
+		/**
+		 * \brief Retrieves the value of a string field without copying it.
+		 * \param field The field index.
+		 * \param length Where the value length is stored.
+		 * \return Pointer to the value inside the record, not terminated by '\\0'.
+		 */
+		const char* GetString ( int field, int* length );
+
+		/**
+		 * \brief Retrieves the value of a double field.
+		 * \param field The field index.
+		 * \return The field value.
+		 */
+		double GetDouble ( int field );
+
+		/**
+		 * \brief Retrieves the value of an int field.
+		 * \param field The field index.
+		 * \return The field value.
+		 */
+		int32_t GetInt ( int field );
+
+		/**
+		 * \brief Retrieves the value of a long field.
+		 * \param field The field index.
+		 * \return The field value.
+		 */
+		int64_t GetLong ( int field );
+
+		/**
+		 * \brief Retrieves the record schema.
+		 * \return The record schema.
+		 */
+		RecordSchema* GetSchema ( void );
+
+		/**
+		 * \brief Retrieves the text of a field, as it appears in the XML form of the record.
+		 * \param field The field index.
+		 * \return The field text.
+		 */
+		string GetText ( int field );
+
+		/**
+		 * \brief Builds the XML form of the record. Used only by queries that cannot be evaluated over the binary form.
+		 * \return The record as an XML document.
+		 */
+		string ToXML ( void );
+
+	protected:
+
+	private:
+
+		/** \brief The record layout. */
+		RecordSchema* schema_;
+
+		/** \brief The record. */
+		const char* record_;
+
+		/** \brief The record size in bytes. */
+		int size_;
+};
+
+#endif /* WATERSHED_LIBRARY_RECORD_VIEW_H_ */
@@ -0,0 +1,83 @@
+/**
+ * \file library/reorder_buffer.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "library/reorder_buffer.h"
+
+ReorderBuffer::ReorderBuffer ( int capacity, long latency ) {
+	capacity_ = ( capacity > 0 ) ? capacity : 1;
+	latency_ = latency;
+	size_ = 0;
+}
+
+ReorderBuffer::~ReorderBuffer ( void ) {
+	for ( uint i = 0; i < slots_.size ( ); ++i ) {
+		delete ( slots_[i] );
+	}
+}
+
+int ReorderBuffer::GetSize ( void ) {
+	return size_;
+}
+
+bool ReorderBuffer::Pop ( int number_channels, Message& message ) {
+	if ( size_ == 0 ) {
+		return false;
+	}
+
+	/* Finds the smallest head and the oldest one, which are the same when the messages arrive in order */
+	deque < int >* smallest = NULL;
+	int smallest_sequence_number = 0;
+	int number_waiting = 0;
+	struct timeval oldest_arrival;
+	for ( map < pair < string, int >, deque < int > >::iterator c = channels_.begin ( ); c != channels_.end ( ); ++c ) {
+		if ( c->second.empty ( ) ) {
+			continue;
+		}
+		int slot = c->second.front ( );
+		if ( smallest == NULL || slots_[slot]->GetSequenceNumber ( ) < smallest_sequence_number ) {
+			smallest = &c->second;
+			smallest_sequence_number = slots_[slot]->GetSequenceNumber ( );
+		}
+		if ( number_waiting == 0 || timercmp ( &arrival_times_[slot], &oldest_arrival, < ) ) {
+			oldest_arrival = arrival_times_[slot];
+		}
+		++number_waiting;
+	}
+
+	if ( number_waiting < number_channels && size_ < capacity_ ) {
+		struct timeval now;
+		gettimeofday ( &now, NULL );
+		long waiting_time = ( now.tv_sec - oldest_arrival.tv_sec ) * 1000 + ( now.tv_usec - oldest_arrival.tv_usec ) / 1000;
+		if ( waiting_time < latency_ ) {
+			return false;
+		}
+	}
+
+	int slot = smallest->front ( );
+	smallest->pop_front ( );
+	message = *slots_[slot];
+	free_slots_.push_back ( slot );
+	--size_;
+	return true;
+}
+
+void ReorderBuffer::Push ( string producer_id, int source, Message& message ) {
+	int slot;
+	if ( !free_slots_.empty ( ) ) {
+		slot = free_slots_.back ( );
+		free_slots_.pop_back ( );
+	}
+	else {
+		slot = slots_.size ( );
+		slots_.push_back ( new Message ( ) );
+		arrival_times_.push_back ( timeval ( ) );
+	}
+	*slots_[slot] = message;
+	gettimeofday ( &arrival_times_[slot], NULL );
+	channels_[make_pair ( producer_id, source )].push_back ( slot );
+	++size_;
+}
@@ -0,0 +1,110 @@
+/**
+ * \file library/reorder_buffer.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_REORDER_BUFFER_H_
+#define WATERSHED_LIBRARY_REORDER_BUFFER_H_
+
+/* C libraries */
+#include <sys/time.h>
+
+/* C++ libraries */
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+/* Project's .h */
+#include "comm/message.h"
+
+using namespace std;
+
+/**
+ * \class ReorderBuffer
+ * \brief Merges the data messages of an ordered input in sequence number order. Each producer instance sends its
+ * messages in increasing sequence numbers, so the buffer keeps one queue per producer instance and releases the
+ * smallest head once every instance has a message queued. Instances that send nothing would hold the others forever,
+ * so the smallest head is also released when the buffer is full or when a head has waited longer than the latency.
+ * Messages are copied into slots allocated on demand and reused, up to the buffer capacity.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class ReorderBuffer {
+
+	public:
+
+		/**
+		 * \brief Creates a new ReorderBuffer instance.
+		 * \param capacity Maximum number of messages held.
+		 * \param latency Maximum time in milliseconds a message waits for the messages of other producer instances.
+		 * \return Not applicable.
+		 */
+		ReorderBuffer ( int capacity, long latency );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~ReorderBuffer ( void );
+
+		/**
+		 * \brief Releases the message with the smallest sequence number, if the merge allows it.
+		 * \param number_channels Number of producer instances of the input. With 0, any message held is released.
+		 * \param message Where the released message is copied.
+		 * \return False if no message can be released yet.
+		 */
+		bool Pop ( int number_channels, Message& message );
+
+		/**
+		 * \brief Retrieves the number of messages held.
+		 * \return The number of messages.
+		 */
+		int GetSize ( void );
+
+		/**
+		 * \brief Holds a message received from a producer instance. The buffer must not be full, which holds as long
+		 * as the messages are popped after each push.
+		 * \param producer_id The identification of the producer.
+		 * \param source The producer instance which sent the message.
+		 * \param message The message.
+		 * \return Not applicable.
+		 */
+		void Push ( string producer_id, int source, Message& message );
+
+	protected:
+
+	private:
+
+		/** \brief Maximum number of messages held. */
+		int capacity_;
+
+		/** \brief Number of messages held. */
+		int size_;
+
+		/** \brief Maximum waiting time in milliseconds. */
+		long latency_;
+
+		/** \brief Message slots allocated so far. */
+		vector < Message* > slots_;
+
+		/** \brief Arrival time of the message in each slot. */
+		vector < struct timeval > arrival_times_;
+
+		/** \brief Slots not holding a message. */
+		vector < int > free_slots_;
+
+		/** \brief Slots of the messages held, in arrival order, by producer and instance. */
+		map < pair < string, int >, deque < int > > channels_;
+
+		/** \brief Copy is not allowed. */
+		ReorderBuffer ( const ReorderBuffer& );
+
+		/** \brief Assignment is not allowed. */
+		ReorderBuffer& operator= ( const ReorderBuffer& );
+};
+
+#endif /* WATERSHED_LIBRARY_REORDER_BUFFER_H_ */
@@ -0,0 +1,70 @@
+/**
+ * \file library/resource_sampler.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "library/resource_sampler.h"
+
+ResourceSampler::ResourceSampler ( void ) {
+	user_time_ = 0;
+	system_time_ = 0;
+	resident_size_ = 0;
+	voluntary_switches_ = 0;
+	involuntary_switches_ = 0;
+	minor_faults_ = 0;
+	major_faults_ = 0;
+}
+
+ResourceSampler::~ResourceSampler ( void ) {
+}
+
+long ResourceSampler::GetInvoluntarySwitches ( void ) {
+	return involuntary_switches_;
+}
+
+long ResourceSampler::GetMajorFaults ( void ) {
+	return major_faults_;
+}
+
+long ResourceSampler::GetMinorFaults ( void ) {
+	return minor_faults_;
+}
+
+long ResourceSampler::GetResidentSize ( void ) {
+	return resident_size_;
+}
+
+double ResourceSampler::GetSystemTime ( void ) {
+	return system_time_;
+}
+
+double ResourceSampler::GetUserTime ( void ) {
+	return user_time_;
+}
+
+long ResourceSampler::GetVoluntarySwitches ( void ) {
+	return voluntary_switches_;
+}
+
+void ResourceSampler::Sample ( void ) {
+	struct rusage t;
+	getrusage ( RUSAGE_THREAD, &t );
+	user_time_ = ( t.ru_utime.tv_sec ) + ( t.ru_utime.tv_usec ) * 0.000001;
+	system_time_ = ( t.ru_stime.tv_sec ) + ( t.ru_stime.tv_usec ) * 0.000001;
+	voluntary_switches_ = t.ru_nvcsw;
+	involuntary_switches_ = t.ru_nivcsw;
+	minor_faults_ = t.ru_minflt;
+	major_faults_ = t.ru_majflt;
+
+	/* The current resident size, ru_maxrss being only its peak */
+	FILE* statm = fopen ( "/proc/self/statm", "r" );
+	if ( statm != NULL ) {
+		long size, resident;
+		if ( fscanf ( statm, "%ld %ld", &size, &resident ) == 2 ) {
+			resident_size_ = resident * sysconf ( _SC_PAGESIZE );
+		}
+		fclose ( statm );
+	}
+}
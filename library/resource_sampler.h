@@ -0,0 +1,116 @@
+/**
+ * \file library/resource_sampler.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_RESOURCE_SAMPLER_H_
+#define WATERSHED_LIBRARY_RESOURCE_SAMPLER_H_
+
+/* C libraries */
+#include <stdio.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * \class ResourceSampler
+ * \brief Resources used by a processing module instance. CPU time, context switches and page faults are those of the
+ * thread taking the sample, which drives the instance, and the resident size is the one of the whole process.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class ResourceSampler {
+
+	public:
+
+		/**
+		 * \brief Creates a new ResourceSampler instance, with every value at 0 until the first sample.
+		 * \return Not applicable.
+		 */
+		ResourceSampler ( void );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~ResourceSampler ( void );
+
+		/**
+		 * \brief Retrieves the CPU system time.
+		 * \return The time in seconds.
+		 */
+		double GetSystemTime ( void );
+
+		/**
+		 * \brief Retrieves the CPU user time.
+		 * \return The time in seconds.
+		 */
+		double GetUserTime ( void );
+
+		/**
+		 * \brief Retrieves the number of context switches caused by the scheduler preempting the thread.
+		 * \return The number of context switches.
+		 */
+		long GetInvoluntarySwitches ( void );
+
+		/**
+		 * \brief Retrieves the number of page faults served by reading from the disk.
+		 * \return The number of page faults.
+		 */
+		long GetMajorFaults ( void );
+
+		/**
+		 * \brief Retrieves the number of page faults served without reading from the disk.
+		 * \return The number of page faults.
+		 */
+		long GetMinorFaults ( void );
+
+		/**
+		 * \brief Retrieves the resident set size of the process.
+		 * \return The size in bytes.
+		 */
+		long GetResidentSize ( void );
+
+		/**
+		 * \brief Retrieves the number of context switches caused by the thread blocking, mostly on communication.
+		 * \return The number of context switches.
+		 */
+		long GetVoluntarySwitches ( void );
+
+		/**
+		 * \brief Samples the resources used so far. Must be called by the thread being measured.
+		 * \return Not applicable.
+		 */
+		void Sample ( void );
+
+	protected:
+
+	private:
+
+		/** \brief The CPU user time, in seconds. */
+		double user_time_;
+
+		/** \brief The CPU system time, in seconds. */
+		double system_time_;
+
+		/** \brief Resident set size of the process, in bytes. */
+		long resident_size_;
+
+		/** \brief Context switches caused by blocking. */
+		long voluntary_switches_;
+
+		/** \brief Context switches caused by preemption. */
+		long involuntary_switches_;
+
+		/** \brief Page faults served without reading from the disk. */
+		long minor_faults_;
+
+		/** \brief Page faults served by reading from the disk. */
+		long major_faults_;
+};
+
+#endif /* WATERSHED_LIBRARY_RESOURCE_SAMPLER_H_ */
@@ -0,0 +1,209 @@
+/**
+ * \file library/timer_wheel.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "library/timer_wheel.h"
+
+TimerWheel::TimerWheel ( void ) {
+	number_timers_ = 0;
+	clock_gettime ( CLOCK_MONOTONIC, &start_time_ );
+	current_tick_ = 0;
+	for ( int level = 0; level < WHEEL_LEVELS; ++level ) {
+		for ( int index = 0; index < WHEEL_SIZE; ++index ) {
+			slots_[level][index].next_ = &slots_[level][index];
+			slots_[level][index].previous_ = &slots_[level][index];
+		}
+	}
+}
+
+TimerWheel::~TimerWheel ( void ) {
+	timers_.clear ( );
+	free_ids_.clear ( );
+}
+
+int TimerWheel::AddTimer ( long delay, long period, TimerCallback* callback ) {
+	long now = GetCurrentTick ( );
+
+	/* The wheel only moves while there are timers, so it may be behind the clock */
+	if ( number_timers_ == 0 && current_tick_ < now ) {
+		current_tick_ = now;
+	}
+
+	Timer* timer = timer_arena_.Allocate ( );
+	if ( free_ids_.empty ( ) ) {
+		timer->id_ = timers_.size ( );
+		timers_.push_back ( timer );
+	}
+	else {
+		timer->id_ = free_ids_.back ( );
+		free_ids_.pop_back ( );
+		timers_[timer->id_] = timer;
+	}
+	timer->cancelled_ = false;
+	timer->expiring_ = false;
+	timer->expires_ = now + ( ( delay > 0 ) ? delay : 0 );
+	timer->period_ = period;
+	timer->callback_ = callback;
+	++number_timers_;
+	Insert ( timer );
+	return timer->id_;
+}
+
+int TimerWheel::Advance ( void ) {
+	int number_expired = 0;
+	long now = GetCurrentTick ( );
+
+	if ( number_timers_ == 0 ) {
+		if ( current_tick_ < now ) {
+			current_tick_ = now;
+		}
+		return 0;
+	}
+
+	while ( current_tick_ <= now ) {
+		int index = current_tick_ & ( WHEEL_SIZE - 1 );
+
+		/* Brings the timers of the next slot of each upper level down when the lower level turns */
+		if ( index == 0 ) {
+			for ( int level = 1; level < WHEEL_LEVELS; ++level ) {
+				int level_index = ( current_tick_ >> ( WHEEL_BITS * level ) ) & ( WHEEL_SIZE - 1 );
+				Cascade ( level, level_index );
+				if ( level_index != 0 ) {
+					break;
+				}
+			}
+		}
+
+		/* Detaches the slot, so callbacks can schedule timers for the next ticks */
+		Timer expired;
+		expired.next_ = &expired;
+		expired.previous_ = &expired;
+		Timer* slot = &slots_[0][index];
+		if ( slot->next_ != slot ) {
+			expired.next_ = slot->next_;
+			expired.previous_ = slot->previous_;
+			expired.next_->previous_ = &expired;
+			expired.previous_->next_ = &expired;
+			slot->next_ = slot;
+			slot->previous_ = slot;
+		}
+		++current_tick_;
+
+		while ( expired.next_ != &expired ) {
+			Timer* timer = expired.next_;
+			Unlink ( timer );
+			if ( timer->expires_ >= current_tick_ ) {
+				Insert ( timer );
+				continue;
+			}
+
+			timer->expiring_ = true;
+			timer->callback_->OnTimer ( timer->id_ );
+			timer->expiring_ = false;
+			++number_expired;
+
+			if ( timer->cancelled_ || timer->period_ <= 0 ) {
+				Release ( timer );
+			}
+			else {
+				timer->expires_ += timer->period_;
+				if ( timer->expires_ < current_tick_ ) { /* Does not try to catch up lost periods */
+					timer->expires_ = current_tick_;
+				}
+				Insert ( timer );
+			}
+		}
+	}
+	return number_expired;
+}
+
+bool TimerWheel::CancelTimer ( int timer_id ) {
+	if ( timer_id < 0 || timer_id >= ( int ) timers_.size ( ) || timers_[timer_id] == NULL ) {
+		return false;
+	}
+	Timer* timer = timers_[timer_id];
+	if ( timer->expiring_ ) { /* Released by Advance after the callback returns */
+		timer->cancelled_ = true;
+		return true;
+	}
+	Unlink ( timer );
+	Release ( timer );
+	return true;
+}
+
+void TimerWheel::Cascade ( int level, int index ) {
+	Timer* slot = &slots_[level][index];
+	while ( slot->next_ != slot ) {
+		Timer* timer = slot->next_;
+		Unlink ( timer );
+		Insert ( timer );
+	}
+}
+
+long TimerWheel::GetCurrentTick ( void ) {
+	struct timespec now;
+	clock_gettime ( CLOCK_MONOTONIC, &now );
+	return ( now.tv_sec - start_time_.tv_sec ) * 1000 + ( now.tv_nsec - start_time_.tv_nsec ) / 1000000;
+}
+
+int TimerWheel::GetNumberTimers ( void ) {
+	return number_timers_;
+}
+
+void TimerWheel::Insert ( Timer* timer ) {
+	long expires = timer->expires_;
+	long delta = expires - current_tick_;
+	Timer* slot;
+
+	if ( delta < 0 ) {
+		slot = &slots_[0][current_tick_ & ( WHEEL_SIZE - 1 )];
+	}
+	else if ( delta < ( 1L << WHEEL_BITS ) ) {
+		slot = &slots_[0][expires & ( WHEEL_SIZE - 1 )];
+	}
+	else if ( delta < ( 1L << ( 2 * WHEEL_BITS ) ) ) {
+		slot = &slots_[1][( expires >> WHEEL_BITS ) & ( WHEEL_SIZE - 1 )];
+	}
+	else if ( delta < ( 1L << ( 3 * WHEEL_BITS ) ) ) {
+		slot = &slots_[2][( expires >> ( 2 * WHEEL_BITS ) ) & ( WHEEL_SIZE - 1 )];
+	}
+	else {
+		if ( delta >= ( 1L << ( 4 * WHEEL_BITS ) ) ) { /* Beyond the wheel range, it is inserted again when the slot turns */
+			expires = current_tick_ + ( 1L << ( 4 * WHEEL_BITS ) ) - 1;
+		}
+		slot = &slots_[3][( expires >> ( 3 * WHEEL_BITS ) ) & ( WHEEL_SIZE - 1 )];
+	}
+	Link ( slot, timer );
+}
+
+void TimerWheel::Link ( Timer* head, Timer* timer ) {
+	timer->next_ = head->next_;
+	timer->previous_ = head;
+	head->next_->previous_ = timer;
+	head->next_ = timer;
+}
+
+void TimerWheel::Release ( Timer* timer ) {
+	timers_[timer->id_] = NULL;
+	free_ids_.push_back ( timer->id_ );
+	timer_arena_.Release ( timer );
+	--number_timers_;
+}
+
+int TimerWheel::ScheduleTimer ( long delay, TimerCallback* callback ) {
+	return AddTimer ( delay, 0, callback );
+}
+
+int TimerWheel::SchedulePeriodicTimer ( long period, TimerCallback* callback ) {
+	return AddTimer ( period, period, callback );
+}
+
+void TimerWheel::Unlink ( Timer* timer ) {
+	timer->previous_->next_ = timer->next_;
+	timer->next_->previous_ = timer->previous_;
+	timer->next_ = timer;
+	timer->previous_ = timer;
+}
@@ -0,0 +1,215 @@
+/**
+ * \file library/timer_wheel.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_TIMER_WHEEL_H_
+#define WATERSHED_LIBRARY_TIMER_WHEEL_H_
+
+/* C libraries */
+#include <time.h>
+
+/* C++ libraries */
+#include <vector>
+
+/* Project's .h */
+#include "library/operators/arena.h"
+
+using namespace std;
+
+/**
+ * \class TimerCallback
+ * \brief Receiver of timer expirations.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class TimerCallback {
+
+	public:
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~TimerCallback ( void ) {
+
+		}
+
+		/**
+		 * \brief Called when a timer expires.
+		 * \param timer_id The timer identification returned when it was scheduled.
+		 * \return Not applicable.
+		 */
+		virtual void OnTimer ( int timer_id ) = 0;
+};
+
+/**
+ * \class TimerWheel
+ * \brief Hierarchical timing wheel with millisecond ticks. Each level has WHEEL_SIZE slots covering WHEEL_SIZE times
+ * the range of the previous one. Scheduling and canceling are O(1), and a timer moves to a lower level at most
+ * WHEEL_LEVELS - 1 times before expiring. Delays beyond the wheel range are rescheduled when the last level turns.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class TimerWheel {
+
+	public:
+
+		/**
+		 * \brief Creates a new TimerWheel instance.
+		 * \return Not applicable.
+		 */
+		TimerWheel ( void );
+
+		/**
+		 * \brief Destructor. Pending timers are discarded.
+		 * \return Not applicable.
+		 */
+		virtual ~TimerWheel ( void );
+
+		/**
+		 * \brief Cancels a pending timer. It may be called from a timer callback, even for the expiring timer.
+		 * \param timer_id The timer identification.
+		 * \return False if there is no pending timer with this identification.
+		 */
+		bool CancelTimer ( int timer_id );
+
+		/**
+		 * \brief Retrieves the number of pending timers.
+		 * \return The number of pending timers.
+		 */
+		int GetNumberTimers ( void );
+
+		/**
+		 * \brief Schedules a timer to expire once.
+		 * \param delay Delay in milliseconds.
+		 * \param callback The receiver of the expiration.
+		 * \return The timer identification.
+		 */
+		int ScheduleTimer ( long delay, TimerCallback* callback );
+
+		/**
+		 * \brief Schedules a timer to expire periodically until it is canceled.
+		 * \param period Period in milliseconds.
+		 * \param callback The receiver of the expirations.
+		 * \return The timer identification.
+		 */
+		int SchedulePeriodicTimer ( long period, TimerCallback* callback );
+
+		/**
+		 * \brief Advances the wheel to the current time, calling the callbacks of all the expired timers.
+		 * \return The number of expired timers.
+		 */
+		int Advance ( void );
+
+	protected:
+
+	private:
+
+		/** \brief Number of bits of a slot index. */
+		static const int WHEEL_BITS = 6;
+
+		/** \brief Number of slots in a level. */
+		static const int WHEEL_SIZE = 1 << WHEEL_BITS;
+
+		/** \brief Number of levels. */
+		static const int WHEEL_LEVELS = 4;
+
+		/** \brief A pending timer, linked in a circular list. */
+		struct Timer {
+				bool cancelled_;
+				bool expiring_;
+				int id_;
+				long expires_;
+				long period_;
+				TimerCallback* callback_;
+				Timer* next_;
+				Timer* previous_;
+		};
+
+		/**
+		 * \brief Retrieves the current time in ticks.
+		 * \return The number of milliseconds since the wheel creation.
+		 */
+		long GetCurrentTick ( void );
+
+		/**
+		 * \brief Links a timer after the head of a list.
+		 * \param head The list sentinel.
+		 * \param timer The timer.
+		 * \return Not applicable.
+		 */
+		static void Link ( Timer* head, Timer* timer );
+
+		/**
+		 * \brief Unlinks a timer from its list.
+		 * \param timer The timer.
+		 * \return Not applicable.
+		 */
+		static void Unlink ( Timer* timer );
+
+		/**
+		 * \brief Creates and inserts a timer.
+		 * \param delay Delay in milliseconds.
+		 * \param period Period in milliseconds, 0 for a single expiration.
+		 * \param callback The receiver of the expirations.
+		 * \return The timer identification.
+		 */
+		int AddTimer ( long delay, long period, TimerCallback* callback );
+
+		/**
+		 * \brief Moves the timers of a slot to the slots matching their remaining time.
+		 * \param level The level of the slot.
+		 * \param index The slot index.
+		 * \return Not applicable.
+		 */
+		void Cascade ( int level, int index );
+
+		/**
+		 * \brief Inserts a timer in the slot matching its remaining time.
+		 * \param timer The timer.
+		 * \return Not applicable.
+		 */
+		void Insert ( Timer* timer );
+
+		/**
+		 * \brief Gives a timer and its identification back.
+		 * \param timer The timer.
+		 * \return Not applicable.
+		 */
+		void Release ( Timer* timer );
+
+		/** \brief Number of pending timers. */
+		int number_timers_;
+
+		/** \brief The next tick to be processed. */
+		long current_tick_;
+
+		/** \brief Creation time of the wheel. */
+		struct timespec start_time_;
+
+		/** \brief Sentinels of the slot lists. */
+		Timer slots_[WHEEL_LEVELS][WHEEL_SIZE];
+
+		/** \brief Pending timers indexed by their identification. */
+		vector < Timer* > timers_;
+
+		/** \brief Identifications available for reuse. */
+		vector < int > free_ids_;
+
+		/** \brief Storage of the timers. */
+		ObjectArena < Timer > timer_arena_;
+
+		/** \brief Copy is not allowed. */
+		TimerWheel ( const TimerWheel& );
+
+		/** \brief Assignment is not allowed. */
+		TimerWheel& operator= ( const TimerWheel& );
+};
+
+#endif /* WATERSHED_LIBRARY_TIMER_WHEEL_H_ */
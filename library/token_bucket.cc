@@ -0,0 +1,44 @@
+/**
+ * \file library/token_bucket.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "library/token_bucket.h"
+
+TokenBucket::TokenBucket ( double rate, int size ) {
+	rate_ = rate;
+	size_ = ( size > 0 ) ? size : 1;
+	tokens_ = size_;
+	gettimeofday ( &last_refill_, NULL );
+}
+
+TokenBucket::~TokenBucket ( void ) {
+}
+
+void TokenBucket::Consume ( int number_tokens ) {
+	tokens_ -= number_tokens;
+}
+
+int TokenBucket::GetAvailable ( void ) {
+	return ( tokens_ >= 1 ) ? ( int ) tokens_ : 0;
+}
+
+long TokenBucket::GetWaitTime ( void ) {
+	if ( tokens_ >= 1 ) {
+		return 0;
+	}
+	return ( long ) ( ( 1 - tokens_ ) * 1000000 / rate_ ) + 1;
+}
+
+void TokenBucket::Refill ( void ) {
+	struct timeval now;
+	gettimeofday ( &now, NULL );
+	double elapsed_time = ( now.tv_sec - last_refill_.tv_sec ) + ( now.tv_usec - last_refill_.tv_usec ) * 0.000001;
+	last_refill_ = now;
+	tokens_ += elapsed_time * rate_;
+	if ( tokens_ > size_ ) {
+		tokens_ = size_;
+	}
+}
@@ -0,0 +1,84 @@
+/**
+ * \file library/token_bucket.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_TOKEN_BUCKET_H_
+#define WATERSHED_LIBRARY_TOKEN_BUCKET_H_
+
+/* C libraries */
+#include <stddef.h>
+#include <sys/time.h>
+
+using namespace std;
+
+/**
+ * \class TokenBucket
+ * \brief Rate limiter. Tokens are added at a constant rate up to the bucket size and each produced record consumes one.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class TokenBucket {
+
+	public:
+
+		/**
+		 * \brief Creates a new TokenBucket instance. The bucket starts full.
+		 * \param rate Number of tokens added per second.
+		 * \param size Maximum number of tokens, which bounds the bursts.
+		 * \return Not applicable.
+		 */
+		TokenBucket ( double rate, int size );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~TokenBucket ( void );
+
+		/**
+		 * \brief Retrieves the number of whole tokens available.
+		 * \return The number of tokens.
+		 */
+		int GetAvailable ( void );
+
+		/**
+		 * \brief Retrieves the time until the next token is available.
+		 * \return The time in microseconds, 0 if there is a token available.
+		 */
+		long GetWaitTime ( void );
+
+		/**
+		 * \brief Consumes tokens. The bucket may become negative, delaying the next refills.
+		 * \param number_tokens Number of tokens to be consumed.
+		 * \return Not applicable.
+		 */
+		void Consume ( int number_tokens );
+
+		/**
+		 * \brief Adds the tokens accumulated since the last refill.
+		 * \return Not applicable.
+		 */
+		void Refill ( void );
+
+	protected:
+
+	private:
+
+		/** \brief Number of tokens added per second. */
+		double rate_;
+
+		/** \brief Current number of tokens. */
+		double tokens_;
+
+		/** \brief Maximum number of tokens. */
+		int size_;
+
+		/** \brief Time of the last refill. */
+		struct timeval last_refill_;
+};
+
+#endif /* WATERSHED_LIBRARY_TOKEN_BUCKET_H_ */
@@ -7,51 +7,69 @@
 
 #include "library/xml.h"
 
+pthread_key_t XML::query_key_;
+pthread_once_t XML::query_key_once_ = PTHREAD_ONCE_INIT;
+
 XML::XML ( void ) {
-	doc_XML_ = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-	last_element_ = Constants::START;
+	writer_.CreateDeclaration ( );
+}
+
+XML::XML ( const XML& other ) {
+	writer_ = other.writer_;
 }
 
 XML::~XML ( void ) {
 }
 
+XML& XML::operator= ( const XML& other ) {
+	writer_ = other.writer_;
+	return *this;
+}
+
 string XML::GetDocXML () {
-	return doc_XML_;
+	return string ( writer_.GetData ( ), writer_.GetSize ( ) );
 }
 
 void XML::CreateTag ( string name ) {
-	if ( last_element_ == Constants::CREATE_ATTR || last_element_ == Constants::CREATE_TAG ) {
-		doc_XML_.append ( ">" );
-	}
-	doc_XML_.append ( " <" + name );
-	last_element_ = Constants::CREATE_TAG;
+	writer_.CreateTag ( name );
 }
 
 void XML::CloseTag ( string name ) {
-	if ( last_element_ == Constants::CREATE_ATTR ) {
-		doc_XML_.append ( "/>" );
-	}
-	else {
-		doc_XML_.append ( " </" + name + ">" );
-	}
-	last_element_ = Constants::CLOSE_TAG;
+	writer_.CloseTag ( name );
 }
 
 void XML::CreateAttr ( string name, string value ) {
-	doc_XML_.append ( " " + name + "=\"" + value + "\"" );
-	last_element_ = Constants::CREATE_ATTR;
+	writer_.CreateAttr ( name, value );
 }
 
 void XML::CreateCharData ( string value ) {
-	if ( last_element_ == Constants::CREATE_ATTR || last_element_ == Constants::CREATE_TAG ) {
-		doc_XML_.append ( ">" );
-	}
-	doc_XML_.append ( " " + value );
-	last_element_ = Constants::CREATE_CHAR_DATA;
+	writer_.CreateCharData ( value );
 }
 
 string XML::GetValue ( string doc_xml, string XPath ) {
-	XMLQuery xml_query;
-	string result = xml_query.ExecuteQuery ( doc_xml, XPath );
+	/* Kept by the calling thread, so each query is compiled once per thread */
+	pthread_once ( &query_key_once_, &XML::CreateQueryKey );
+	XMLQuery* xml_query = ( XMLQuery* ) pthread_getspecific ( query_key_ );
+	if ( xml_query == NULL ) {
+		xml_query = new XMLQuery ( );
+		pthread_setspecific ( query_key_, xml_query );
+	}
+	string result = xml_query->ExecuteQuery ( doc_xml, XPath );
 	return result;
 }
+
+void XML::CreateQueryKey ( void ) {
+	pthread_key_create ( &query_key_, &XML::DeleteQuery );
+}
+
+void XML::DeleteQuery ( void* xml_query ) {
+	delete ( ( XMLQuery* ) xml_query );
+}
+
+void XML::WriteTo ( Message& message ) throw (BadParameterException) {
+	int size = writer_.GetSize ( ) + 1;
+	if ( size > Constants::MAX_DATA_SIZE ) {
+		throw BadParameterException ( "document of " + Util::IntegerToString ( size ) + " bytes exceeds the message size" );
+	}
+	message.SetData ( ( void* ) writer_.GetData ( ), size );
+}
@@ -8,8 +8,13 @@
 #ifndef WATERSHED_LIBRARY_XML_H_
 #define WATERSHED_LIBRARY_XML_H_
 
+#include <pthread.h>
+
 #include "common/constants.h"
+#include "common/exceptions.h"
+#include "common/util.h"
 #include "common/xml_query.h"
+#include "library/xml_writer.h"
 
 using namespace std;
 
@@ -22,10 +27,25 @@ public:
 	 */
 	XML(void);
 
+	/**
+	 * \brief Creates a copy of a document, with its own writer.
+	 * \param other The document copied.
+	 * \return Not applicable.
+	 */
+	XML(const XML& other);
+
 	/**
 	 * todo
 	 */
 	~XML(void);
+
+	/**
+	 * \brief Replaces the document by a copy of another one.
+	 * \param other The document copied.
+	 * \return This document.
+	 */
+	XML& operator=(const XML& other);
+
 	/**
 	 * todo
 	 */
@@ -47,7 +67,11 @@ public:
 	void CreateCharData(string value);
 
 	/**
-	 * todo
+	 * \brief Evaluates a query over a document. Each thread has its own XMLQuery, so queries are compiled once per
+	 * thread and never shared by threads.
+	 * \param docXml The XML document.
+	 * \param XPath The query text.
+	 * \return The query result.
 	 */
 	string GetValue(string docXml, string XPath);
 
@@ -56,14 +80,39 @@ public:
 	 */
 	string GetDocXML(void);
 
+	/**
+	 * \brief Copies the document into the data of a message. To avoid the copy, write with an XMLWriter over the
+	 * message instead. A document that does not fit in a message throws a BadParameterException, leaving the message
+	 * unchanged.
+	 * \param message The message receiving the document.
+	 * \return Not applicable.
+	 */
+	void WriteTo(Message& message) throw (BadParameterException);
+
 protected:
 
 private:
-	/** todo */
-	string doc_XML_;
+	/**
+	 * \brief Creates the key of the per-thread XMLQuery.
+	 * \return Not applicable.
+	 */
+	static void CreateQueryKey(void);
+
+	/**
+	 * \brief Deletes the XMLQuery of a thread when it exits.
+	 * \param xml_query The XMLQuery.
+	 * \return Not applicable.
+	 */
+	static void DeleteQuery(void* xml_query);
+
+	/** \brief Key of the per-thread XMLQuery. */
+	static pthread_key_t query_key_;
+
+	/** \brief Guard creating the key once. */
+	static pthread_once_t query_key_once_;
 
-	/** todo */
-	int last_element_;
+	/** \brief Writer holding the document. */
+	XMLWriter writer_;
 
 };
 
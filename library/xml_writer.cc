@@ -0,0 +1,242 @@
+/**
+ * \file library/xml_writer.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* C libraries */
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Project's .h */
+#include "library/xml_writer.h"
+
+XMLWriter::XMLWriter ( int capacity ) {
+	capacity_ = ( capacity > 0 ) ? capacity : Constants::XML_WRITER_DEFAULT_CAPACITY;
+	buffer_ = new char[capacity_];
+	message_ = NULL;
+	Reset ( );
+}
+
+XMLWriter::XMLWriter ( Message& message ) {
+	capacity_ = Constants::MAX_DATA_SIZE;
+	buffer_ = ( char* ) message.GetData ( );
+	message_ = &message;
+	Reset ( );
+}
+
+XMLWriter::XMLWriter ( const XMLWriter& other ) {
+	capacity_ = other.size_ + 1;
+	buffer_ = new char[capacity_];
+	message_ = NULL;
+	memcpy ( buffer_, other.buffer_, other.size_ + 1 );
+	size_ = other.size_;
+	last_element_ = other.last_element_;
+	overflow_ = other.overflow_;
+}
+
+XMLWriter::~XMLWriter ( void ) {
+	if ( message_ == NULL ) {
+		delete[] ( buffer_ );
+	}
+}
+
+void XMLWriter::Append ( const char* data, int length ) {
+	if ( Reserve ( length ) ) {
+		memcpy ( buffer_ + size_, data, length );
+		size_ += length;
+	}
+}
+
+void XMLWriter::AppendEscaped ( const char* data, int length ) {
+	int position = 0;
+	int clean = 0;
+
+#ifdef __SSE2__
+	const __m128i less = _mm_set1_epi8 ( '<' );
+	const __m128i greater = _mm_set1_epi8 ( '>' );
+	const __m128i ampersand = _mm_set1_epi8 ( '&' );
+	const __m128i quote = _mm_set1_epi8 ( '"' );
+	while ( position + 16 <= length ) {
+		__m128i chunk = _mm_loadu_si128 ( ( const __m128i* ) ( data + position ) );
+		__m128i special = _mm_or_si128 ( _mm_or_si128 ( _mm_cmpeq_epi8 ( chunk, less ), _mm_cmpeq_epi8 ( chunk, greater ) ), _mm_or_si128 ( _mm_cmpeq_epi8 ( chunk, ampersand ), _mm_cmpeq_epi8 ( chunk, quote ) ) );
+		int mask = _mm_movemask_epi8 ( special );
+		if ( mask == 0 ) {
+			position += 16;
+			continue;
+		}
+		position += __builtin_ctz ( mask );
+		break;
+	}
+#endif
+
+	for ( ; position < length; ++position ) {
+		const char* entity;
+		int entity_length;
+		switch ( data[position] ) {
+			case '<' : {
+				entity = "&lt;";
+				entity_length = 4;
+				break;
+			}
+
+			case '>' : {
+				entity = "&gt;";
+				entity_length = 4;
+				break;
+			}
+
+			case '&' : {
+				entity = "&amp;";
+				entity_length = 5;
+				break;
+			}
+
+			case '"' : {
+				entity = "&quot;";
+				entity_length = 6;
+				break;
+			}
+
+			default : {
+				continue;
+			}
+		}
+		Append ( data + clean, position - clean );
+		Append ( entity, entity_length );
+		clean = position + 1;
+
+#ifdef __SSE2__
+		/* Skips the next run without special characters */
+		while ( position + 17 <= length ) {
+			__m128i chunk = _mm_loadu_si128 ( ( const __m128i* ) ( data + position + 1 ) );
+			__m128i special = _mm_or_si128 ( _mm_or_si128 ( _mm_cmpeq_epi8 ( chunk, less ), _mm_cmpeq_epi8 ( chunk, greater ) ), _mm_or_si128 ( _mm_cmpeq_epi8 ( chunk, ampersand ), _mm_cmpeq_epi8 ( chunk, quote ) ) );
+			int mask = _mm_movemask_epi8 ( special );
+			if ( mask != 0 ) {
+				position += __builtin_ctz ( mask );
+				break;
+			}
+			position += 16;
+		}
+#endif
+	}
+	Append ( data + clean, length - clean );
+}
+
+void XMLWriter::CloseStartTag ( void ) {
+	if ( last_element_ == Constants::CREATE_ATTR || last_element_ == Constants::CREATE_TAG ) {
+		Append ( ">", 1 );
+	}
+}
+
+void XMLWriter::CloseTag ( const string& name ) {
+	if ( last_element_ == Constants::CREATE_ATTR || last_element_ == Constants::CREATE_TAG ) {
+		Append ( "/>", 2 );
+	}
+	else {
+		Append ( "</", 2 );
+		Append ( name.data ( ), name.length ( ) );
+		Append ( ">", 1 );
+	}
+	last_element_ = Constants::CLOSE_TAG;
+	Commit ( );
+}
+
+void XMLWriter::Commit ( void ) {
+	buffer_[size_] = '\0';
+	if ( message_ != NULL ) {
+		message_->SetDataSize ( size_ + 1 );
+	}
+}
+
+void XMLWriter::CreateAttr ( const string& name, const string& value ) {
+	Append ( " ", 1 );
+	Append ( name.data ( ), name.length ( ) );
+	Append ( "=\"", 2 );
+	AppendEscaped ( value.data ( ), value.length ( ) );
+	Append ( "\"", 1 );
+	last_element_ = Constants::CREATE_ATTR;
+	Commit ( );
+}
+
+void XMLWriter::CreateCharData ( const char* value, int length ) {
+	CloseStartTag ( );
+	AppendEscaped ( value, length );
+	last_element_ = Constants::CREATE_CHAR_DATA;
+	Commit ( );
+}
+
+void XMLWriter::CreateCharData ( const string& value ) {
+	CreateCharData ( value.data ( ), value.length ( ) );
+}
+
+void XMLWriter::CreateDeclaration ( void ) {
+	static const char declaration[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	Append ( declaration, sizeof ( declaration ) - 1 );
+	Commit ( );
+}
+
+void XMLWriter::CreateTag ( const string& name ) {
+	CloseStartTag ( );
+	Append ( "<", 1 );
+	Append ( name.data ( ), name.length ( ) );
+	last_element_ = Constants::CREATE_TAG;
+	Commit ( );
+}
+
+const char* XMLWriter::GetData ( void ) {
+	return buffer_;
+}
+
+int XMLWriter::GetSize ( void ) {
+	return size_;
+}
+
+bool XMLWriter::HasOverflowed ( void ) {
+	return overflow_;
+}
+
+bool XMLWriter::Reserve ( int length ) {
+	if ( overflow_ ) {
+		return false;
+	}
+	if ( size_ + length < capacity_ ) {
+		return true;
+	}
+	if ( message_ != NULL ) {
+		overflow_ = true;
+		return false;
+	}
+
+	int new_capacity = capacity_ * 2;
+	while ( size_ + length >= new_capacity ) {
+		new_capacity *= 2;
+	}
+	char* new_buffer = new char[new_capacity];
+	memcpy ( new_buffer, buffer_, size_ );
+	delete[] ( buffer_ );
+	buffer_ = new_buffer;
+	capacity_ = new_capacity;
+	return true;
+}
+
+XMLWriter& XMLWriter::operator= ( const XMLWriter& other ) {
+	if ( this != &other ) {
+		size_ = 0;
+		overflow_ = false;
+		Append ( other.buffer_, other.size_ );
+		last_element_ = other.last_element_;
+		overflow_ = overflow_ || other.overflow_;
+		Commit ( );
+	}
+	return *this;
+}
+
+void XMLWriter::Reset ( void ) {
+	size_ = 0;
+	last_element_ = Constants::START;
+	overflow_ = false;
+	Commit ( );
+}
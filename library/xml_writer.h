@@ -0,0 +1,196 @@
+/**
+ * \file library/xml_writer.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_LIBRARY_XML_WRITER_H_
+#define WATERSHED_LIBRARY_XML_WRITER_H_
+
+/* C++ libraries */
+#include <string>
+
+/* Project's .h */
+#include "comm/message.h"
+#include "common/constants.h"
+
+using namespace std;
+
+/**
+ * \class XMLWriter
+ * \brief Writes an XML document sequentially, escaping attribute values and character data. It either writes into its
+ * own buffer, which grows as needed and is kept by Reset, or directly into the data of a message to be sent. The
+ * document is always terminated by '\\0', which is part of the message data size.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class XMLWriter {
+
+	public:
+
+		/**
+		 * \brief Creates a new XMLWriter instance writing into its own buffer.
+		 * \param capacity Initial buffer size in bytes.
+		 * \return Not applicable.
+		 */
+		XMLWriter ( int capacity = Constants::XML_WRITER_DEFAULT_CAPACITY );
+
+		/**
+		 * \brief Creates a new XMLWriter instance writing into the data of a message. Documents larger than the message
+		 * are truncated and marked as overflowed.
+		 * \param message The message receiving the document.
+		 * \return Not applicable.
+		 */
+		XMLWriter ( Message& message );
+
+		/**
+		 * \brief Creates a new XMLWriter instance writing into its own buffer, holding a copy of the document of another
+		 * writer.
+		 * \param other The writer copied.
+		 * \return Not applicable.
+		 */
+		XMLWriter ( const XMLWriter& other );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~XMLWriter ( void );
+
+		/**
+		 * \brief Checks whether the document did not fit in the message.
+		 * \return True if part of the document was discarded.
+		 */
+		bool HasOverflowed ( void );
+
+		/**
+		 * \brief Retrieves the document written.
+		 * \return Pointer to the document, terminated by '\\0'.
+		 */
+		const char* GetData ( void );
+
+		/**
+		 * \brief Retrieves the document size, without the terminating '\\0'.
+		 * \return The document size in bytes.
+		 */
+		int GetSize ( void );
+
+		/**
+		 * \brief Closes an element, as an empty element when it has no content.
+		 * \param name The element name.
+		 * \return Not applicable.
+		 */
+		void CloseTag ( const string& name );
+
+		/**
+		 * \brief Writes an attribute of the element just opened.
+		 * \param name The attribute name.
+		 * \param value The attribute value, escaped by the writer.
+		 * \return Not applicable.
+		 */
+		void CreateAttr ( const string& name, const string& value );
+
+		/**
+		 * \brief Writes character data in the current element.
+		 * \param value Pointer to the data, escaped by the writer.
+		 * \param length The data length in bytes.
+		 * \return Not applicable.
+		 */
+		void CreateCharData ( const char* value, int length );
+
+		/**
+		 * \brief Writes character data in the current element.
+		 * \param value The data, escaped by the writer.
+		 * \return Not applicable.
+		 */
+		void CreateCharData ( const string& value );
+
+		/**
+		 * \brief Opens an element.
+		 * \param name The element name.
+		 * \return Not applicable.
+		 */
+		void CreateTag ( const string& name );
+
+		/**
+		 * \brief Writes the XML declaration.
+		 * \return Not applicable.
+		 */
+		void CreateDeclaration ( void );
+
+		/**
+		 * \brief Replaces the document by a copy of the document of another writer. A writer over a message keeps
+		 * writing into the message, and marks the copy as overflowed if it does not fit.
+		 * \param other The writer copied.
+		 * \return This writer.
+		 */
+		XMLWriter& operator= ( const XMLWriter& other );
+
+		/**
+		 * \brief Discards the document and starts a new one, keeping the buffer.
+		 * \return Not applicable.
+		 */
+		void Reset ( void );
+
+	protected:
+
+	private:
+
+		/**
+		 * \brief Appends bytes to the document.
+		 * \param data The bytes.
+		 * \param length Number of bytes.
+		 * \return Not applicable.
+		 */
+		void Append ( const char* data, int length );
+
+		/**
+		 * \brief Appends text to the document replacing the characters that cannot appear in attributes and character
+		 * data by entity references. Runs without such characters are found 16 bytes at a time when SSE2 is available.
+		 * \param data The text.
+		 * \param length The text length in bytes.
+		 * \return Not applicable.
+		 */
+		void AppendEscaped ( const char* data, int length );
+
+		/**
+		 * \brief Closes the start tag of the current element if it is still open.
+		 * \return Not applicable.
+		 */
+		void CloseStartTag ( void );
+
+		/**
+		 * \brief Terminates the document and updates the message data size.
+		 * \return Not applicable.
+		 */
+		void Commit ( void );
+
+		/**
+		 * \brief Makes room for more bytes, growing the own buffer if necessary.
+		 * \param length Number of bytes to be appended.
+		 * \return False if the bytes do not fit in the message.
+		 */
+		bool Reserve ( int length );
+
+		/** \brief Where the document is written. */
+		char* buffer_;
+
+		/** \brief Buffer size, including the terminating '\\0'. */
+		int capacity_;
+
+		/** \brief Document size. */
+		int size_;
+
+		/** \brief Last item written. */
+		int last_element_;
+
+		/** \brief Message receiving the document, NULL when the writer has its own buffer. */
+		Message* message_;
+
+		/** \brief Whether the document did not fit in the message. */
+		bool overflow_;
+};
+
+#endif /* WATERSHED_LIBRARY_XML_WRITER_H_ */
@@ -8,6 +8,9 @@
 #include "runtime/configurator.h"
 
 RuntimeConfigurator::RuntimeConfigurator ( string parse_file ) throw ( XMLParserException ) {
+	checkpoint_interval_ = 0;
+	autoscaling_interval_ = 0;
+	autoscaling_cooldown_ = 0;
 	try {
 		configuration_parser_.Parse ( parse_file );
 	}
@@ -37,6 +40,27 @@ void RuntimeConfigurator::FillConfiguratorItems ( void ) throw ( XMLParserExcept
 		lock_file_ = running_dir_ + "/" + Constants::FILE_LOCK;
 		info_file_ = running_dir_ + "/" + Constants::FILE_INFO;
 		exe_dir_ = server_home_ + "/" + Constants::DIR_BIN;
+		string checkpoint_interval = configuration_parser_.GetAttributeByName ( "checkpoint_interval" );
+		if ( checkpoint_interval.compare ( "" ) != 0 ) {
+			if ( atol ( checkpoint_interval.c_str ( ) ) < 0 ) {
+				throw XMLParserException ( "invalid checkpoint interval " + checkpoint_interval );
+			}
+			checkpoint_interval_ = atol ( checkpoint_interval.c_str ( ) );
+		}
+		string autoscaling_interval = configuration_parser_.GetAttributeByName ( "autoscaling_interval" );
+		if ( autoscaling_interval.compare ( "" ) != 0 ) {
+			if ( atol ( autoscaling_interval.c_str ( ) ) < 0 ) {
+				throw XMLParserException ( "invalid autoscaling interval " + autoscaling_interval );
+			}
+			autoscaling_interval_ = atol ( autoscaling_interval.c_str ( ) );
+		}
+		string autoscaling_cooldown = configuration_parser_.GetAttributeByName ( "autoscaling_cooldown" );
+		if ( autoscaling_cooldown.compare ( "" ) != 0 ) {
+			if ( atol ( autoscaling_cooldown.c_str ( ) ) < 0 ) {
+				throw XMLParserException ( "invalid autoscaling cool-down " + autoscaling_cooldown );
+			}
+			autoscaling_cooldown_ = atol ( autoscaling_cooldown.c_str ( ) );
+		}
 
 		/* Database attributes */
 		configuration_parser_.DefineCurrentElementByName ( 0, "database" );
@@ -80,6 +104,18 @@ void RuntimeConfigurator::FillConfiguratorItems ( void ) throw ( XMLParserExcept
 	}
 }
 
+long RuntimeConfigurator::GetAutoscalingCooldown ( void ) {
+	return autoscaling_cooldown_;
+}
+
+long RuntimeConfigurator::GetAutoscalingInterval ( void ) {
+	return autoscaling_interval_;
+}
+
+long RuntimeConfigurator::GetCheckpointInterval ( void ) {
+	return checkpoint_interval_;
+}
+
 string RuntimeConfigurator::GetDBArguments ( void ) {
 	return database_arguments_;
 }
@@ -134,6 +170,8 @@ void RuntimeConfigurator::Print ( void ) {
 	cout << "Server name      : " << GetServerName () << endl;
 	cout << "Server home      : " << GetServerHome () << endl;
 	cout << "Running dir      : " << GetRunningDir () << endl;
+	cout << "Checkpoint       : " << GetCheckpointInterval () << " ms" << endl;
+	cout << "Autoscaling      : " << GetAutoscalingInterval () << " ms, cool-down " << GetAutoscalingCooldown () << " ms" << endl;
 	cout << "DB exe name      : " << GetDBExeName () << endl;
 	cout << "DB args          : " << GetDBArguments () << endl;
 	cout << "PM exe name      : " << GetProcessingModuleExeName () << endl;
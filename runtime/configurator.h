@@ -7,6 +7,9 @@
 #ifndef WATERSHED_RUNTIME_CONFIGURATOR_H_
 #define WATERSHED_RUNTIME_RUNTIME_CONFIGURATOR_H_
 
+/* C libraries */
+#include <stdlib.h>
+
 /* C++ libraries */
 #include <map>
 
@@ -46,6 +49,24 @@ class RuntimeConfigurator {
 		 */
 		map < string, Host >* GetHosts ( void );
 
+		/**
+		 * \brief Retrieves the minimum time between two scaling operations on the same processing module.
+		 * \return The cool-down period in milliseconds.
+		 */
+		long GetAutoscalingCooldown ( void );
+
+		/**
+		 * \brief Retrieves the interval between two autoscaling decisions.
+		 * \return The interval in milliseconds, 0 when the processing modules are not autoscaled.
+		 */
+		long GetAutoscalingInterval ( void );
+
+		/**
+		 * \brief Retrieves the interval between two checkpoints of the processing modules.
+		 * \return The interval in milliseconds, 0 when no checkpoint is taken.
+		 */
+		long GetCheckpointInterval ( void );
+
 		/**
 		 * \brief Retrieves the database daemon arguments.
 		 * \return The database daemon arguments.
@@ -155,6 +176,15 @@ class RuntimeConfigurator {
 		/** \brief Cluster's hosts. */
 		map < string, Host > hosts_;
 
+		/** \brief Interval between two checkpoints, in milliseconds. */
+		long checkpoint_interval_;
+
+		/** \brief Interval between two autoscaling decisions, in milliseconds. */
+		long autoscaling_interval_;
+
+		/** \brief Minimum time between two scaling operations on a processing module, in milliseconds. */
+		long autoscaling_cooldown_;
+
 		/** \brief Database arguments. */
 		string database_arguments_;
 
@@ -0,0 +1,119 @@
+/**
+ * \file runtime/module_directory.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "runtime/module_directory.h"
+
+ModuleDirectory::ModuleDirectory ( void ) {
+	pthread_mutex_init ( &entries_mutex_, NULL );
+}
+
+ModuleDirectory::~ModuleDirectory ( void ) {
+	pthread_mutex_destroy ( &entries_mutex_ );
+}
+
+bool ModuleDirectory::Apply ( string update ) {
+
+	/* name, version, owner, removed flag, port name and the instances hosts, separated by tabs */
+	vector < string > fields = Util::TokenizeString ( "\t", update );
+	if ( fields.size ( ) < 4 ) {
+		return false;
+	}
+	Entry entry;
+	entry.version_ = atol ( fields[1].c_str ( ) );
+	entry.owner_ = atoi ( fields[2].c_str ( ) );
+	entry.removed_ = fields[3].compare ( "1" ) == 0;
+	if ( fields.size ( ) > 4 ) {
+		entry.port_name_ = fields[4];
+	}
+	if ( fields.size ( ) > 5 ) {
+		entry.hosts_ = Util::TokenizeString ( " ", fields[5] );
+	}
+
+	/* Two owners publishing the same version are ordered by their ranks, so every replica keeps the same entry */
+	bool newer;
+	pthread_mutex_lock ( &entries_mutex_ );
+	map < string, Entry >::iterator it = entries_.find ( fields[0] );
+	newer = it == entries_.end ( ) || entry.version_ > it->second.version_ || ( entry.version_ == it->second.version_ && entry.owner_ > it->second.owner_ );
+	if ( newer ) {
+		entries_[fields[0]] = entry;
+	}
+	pthread_mutex_unlock ( &entries_mutex_ );
+	return newer;
+}
+
+bool ModuleDirectory::Contains ( string processing_module_name ) {
+	pthread_mutex_lock ( &entries_mutex_ );
+	map < string, Entry >::iterator it = entries_.find ( processing_module_name );
+	bool running = it != entries_.end ( ) && !it->second.removed_;
+	pthread_mutex_unlock ( &entries_mutex_ );
+	return running;
+}
+
+vector < string > ModuleDirectory::GetHosts ( string processing_module_name ) {
+	vector < string > hosts;
+	pthread_mutex_lock ( &entries_mutex_ );
+	map < string, Entry >::iterator it = entries_.find ( processing_module_name );
+	if ( it != entries_.end ( ) && !it->second.removed_ ) {
+		hosts = it->second.hosts_;
+	}
+	pthread_mutex_unlock ( &entries_mutex_ );
+	return hosts;
+}
+
+int ModuleDirectory::GetOwner ( string processing_module_name ) {
+	int owner = -1;
+	pthread_mutex_lock ( &entries_mutex_ );
+	map < string, Entry >::iterator it = entries_.find ( processing_module_name );
+	if ( it != entries_.end ( ) && !it->second.removed_ ) {
+		owner = it->second.owner_;
+	}
+	pthread_mutex_unlock ( &entries_mutex_ );
+	return owner;
+}
+
+string ModuleDirectory::GetPortName ( string processing_module_name ) {
+	string port_name = "";
+	pthread_mutex_lock ( &entries_mutex_ );
+	map < string, Entry >::iterator it = entries_.find ( processing_module_name );
+	if ( it != entries_.end ( ) && !it->second.removed_ ) {
+		port_name = it->second.port_name_;
+	}
+	pthread_mutex_unlock ( &entries_mutex_ );
+	return port_name;
+}
+
+string ModuleDirectory::Publish ( string processing_module_name, int owner, string port_name, vector < string > hosts ) {
+	Entry entry;
+	entry.owner_ = owner;
+	entry.removed_ = false;
+	entry.port_name_ = port_name;
+	entry.hosts_ = hosts;
+	return Store ( processing_module_name, entry );
+}
+
+string ModuleDirectory::Store ( string processing_module_name, Entry entry ) {
+	pthread_mutex_lock ( &entries_mutex_ );
+	map < string, Entry >::iterator it = entries_.find ( processing_module_name );
+	entry.version_ = ( it == entries_.end ( ) ) ? 1 : it->second.version_ + 1;
+	entries_[processing_module_name] = entry;
+	pthread_mutex_unlock ( &entries_mutex_ );
+
+	string hosts = "";
+	for ( uint i = 0; i < entry.hosts_.size ( ); ++i ) {
+		hosts += ( i == 0 ? "" : " " ) + entry.hosts_[i];
+	}
+	char version[Constants::MAX_INT_TO_STRING_LENGTH * 2];
+	sprintf ( version, "%ld", entry.version_ );
+	return processing_module_name + "\t" + version + "\t" + Util::IntegerToString ( entry.owner_ ) + "\t" + ( entry.removed_ ? "1" : "0" ) + "\t" + entry.port_name_ + "\t" + hosts;
+}
+
+string ModuleDirectory::Withdraw ( string processing_module_name, int owner ) {
+	Entry entry;
+	entry.owner_ = owner;
+	entry.removed_ = true;
+	return Store ( processing_module_name, entry );
+}
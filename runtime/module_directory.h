@@ -0,0 +1,145 @@
+/**
+ * \file runtime/module_directory.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_RUNTIME_MODULE_DIRECTORY_H_
+#define WATERSHED_RUNTIME_MODULE_DIRECTORY_H_
+
+/* C libraries */
+#include <pthread.h>
+#include <stdlib.h>
+
+/* C++ libraries */
+#include <map>
+#include <string>
+#include <vector>
+
+/* Project's .h */
+#include "common/util.h"
+
+using namespace std;
+
+/**
+ * \class ModuleDirectory
+ * \brief Directory of the processing modules running on the system, replicated by every runtime daemon. Each module is
+ * described by the daemon owning it, which publishes a new version of its entry whenever the module is added, scaled
+ * or removed. A replica applies an update only when it is newer than its own entry, so late updates are ignored, and a
+ * removed module is kept as a removed entry for the same reason.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class ModuleDirectory {
+
+	public:
+
+		/**
+		 * \brief Constructor. Creates a new empty ModuleDirectory instance.
+		 * \return Not applicable.
+		 */
+		ModuleDirectory ( void );
+
+		/**
+		 * \brief Destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~ModuleDirectory ( void );
+
+		/**
+		 * \brief Applies an update published by another runtime daemon.
+		 * \param update The update, as returned by Publish or Withdraw.
+		 * \return True if the update was newer than the entry of the module.
+		 */
+		bool Apply ( string update );
+
+		/**
+		 * \brief Checks whether a processing module is running.
+		 * \param processing_module_name The processing module name.
+		 * \return True if the directory has a not removed entry for the module.
+		 */
+		bool Contains ( string processing_module_name );
+
+		/**
+		 * \brief Retrieves the hosts of the instances of a processing module.
+		 * \param processing_module_name The processing module name.
+		 * \return The host of each instance, by instance rank, empty if the module is not running.
+		 */
+		vector < string > GetHosts ( string processing_module_name );
+
+		/**
+		 * \brief Retrieves the runtime daemon owning a processing module.
+		 * \param processing_module_name The processing module name.
+		 * \return The daemon rank in the cluster communicator, -1 if the module is not running.
+		 */
+		int GetOwner ( string processing_module_name );
+
+		/**
+		 * \brief Retrieves the port opened by a processing module.
+		 * \param processing_module_name The processing module name.
+		 * \return The port name, empty if the module is not running.
+		 */
+		string GetPortName ( string processing_module_name );
+
+		/**
+		 * \brief Describes a processing module owned by this runtime daemon with a new version of its entry.
+		 * \param processing_module_name The processing module name.
+		 * \param owner The rank of this daemon in the cluster communicator.
+		 * \param port_name The port opened by the module.
+		 * \param hosts The host of each instance, by instance rank.
+		 * \return The update to be sent to the other runtime daemons.
+		 */
+		string Publish ( string processing_module_name, int owner, string port_name, vector < string > hosts );
+
+		/**
+		 * \brief Marks a processing module owned by this runtime daemon as removed, with a new version of its entry.
+		 * \param processing_module_name The processing module name.
+		 * \param owner The rank of this daemon in the cluster communicator.
+		 * \return The update to be sent to the other runtime daemons.
+		 */
+		string Withdraw ( string processing_module_name, int owner );
+
+	protected:
+
+	private:
+
+		/**
+		 * \brief Entry of a processing module.
+		 */
+		struct Entry {
+				/** \brief Version of the entry, increased by each update of the module. */
+				long version_;
+				/** \brief Rank of the runtime daemon owning the module. */
+				int owner_;
+				/** \brief Whether the module was removed. */
+				bool removed_;
+				/** \brief Port opened by the module. */
+				string port_name_;
+				/** \brief Host of each instance, by instance rank. */
+				vector < string > hosts_;
+		};
+
+		/**
+		 * \brief Stores a new version of the entry of a module owned by this runtime daemon.
+		 * \param processing_module_name The processing module name.
+		 * \param entry The entry, whose version is set.
+		 * \return The update describing the entry.
+		 */
+		string Store ( string processing_module_name, Entry entry );
+
+		/** \brief Entries of the processing modules, by name. */
+		map < string, Entry > entries_;
+
+		/** \brief A mutex to control the access to the entries. */
+		pthread_mutex_t entries_mutex_;
+
+		/** \brief Copy is not allowed. */
+		ModuleDirectory ( const ModuleDirectory& );
+
+		/** \brief Assignment is not allowed. */
+		ModuleDirectory& operator= ( const ModuleDirectory& );
+};
+
+#endif /* WATERSHED_RUNTIME_MODULE_DIRECTORY_H_ */
@@ -14,9 +14,22 @@ Runtime::Runtime ( int argc, char** argv ) {
 		shutdown_notification_ = false;
 
 		pthread_mutex_init ( &shutdown_notification_mutex_, NULL );
+		pthread_mutex_init ( &scaling_operations_mutex_, NULL );
+		pthread_cond_init ( &scaling_operations_condition_, NULL );
+		scaling_stopped_ = false;
+		pthread_mutex_init ( &deployment_jobs_mutex_, NULL );
+		pthread_cond_init ( &deployment_jobs_condition_, NULL );
+		next_deployment_ = 1;
+		deployment_turn_ = 1;
+		running_deployments_ = 0;
+		gettimeofday ( &last_checkpoint_time_, NULL );
+		gettimeofday ( &last_autoscaling_time_, NULL );
 
 		cluster_communicator_ = new MpiCommunicator ( argc, argv, Constants::COMM_SCOPE_WORLD );
 		self_communicator_ = new MpiCommunicator ( argc, argv, Constants::COMM_SCOPE_SELF );
+		for ( int i = 0; i < Constants::DEPLOYMENT_MAX_SPAWNS; ++i ) {
+			spawn_communicators_.push_back ( self_communicator_->Duplicate ( ) );
+		}
 		ReadConfigurationFile ( );
 		LockLocalResources ( );
 
@@ -45,61 +58,73 @@ Runtime::~Runtime ( void ) {
 	}
 	delete ( runtime_configurator_ );
 	delete ( database_communicator_ );
+	for ( vector < MpiCommunicator* >::iterator it = spawn_communicators_.begin ( ); it != spawn_communicators_.end ( ); ++it ) {
+		( *it )->Free ( );
+		delete ( *it );
+	}
+	for ( map < int, DeploymentJob* >::iterator it = deployment_jobs_.begin ( ); it != deployment_jobs_.end ( ); ++it ) {
+		delete ( it->second );
+	}
 	delete ( self_communicator_ );
 	delete ( cluster_communicator_ );
 	pthread_mutex_destroy ( &shutdown_notification_mutex_ );
+	pthread_mutex_destroy ( &scaling_operations_mutex_ );
+	pthread_cond_destroy ( &scaling_operations_condition_ );
+	pthread_mutex_destroy ( &deployment_jobs_mutex_ );
+	pthread_cond_destroy ( &deployment_jobs_condition_ );
 }
 
-void Runtime::AddProcessingModule ( Message& received_message ) throw ( ProcessSpawnningException, XMLParserException ) {
-
-	string processing_module_configurator_file = ( char* ) received_message.GetData ( );
-	ProcessingModuleConfigurator* processing_module_configurator;
-
-	/* Creates an initial processing module configurator based on a XML configuration file. */
-	try {
-		processing_module_configurator = new ProcessingModuleConfigurator ( processing_module_configurator_file );
-		processing_module_configurator->SetDatabasePortName ( database_port_name_ );
-		processing_module_configurator->SetConfiguratorFileName ( processing_module_configurator_file );
-	}
-	catch ( XMLParserException& e ) {
-		throw ( e );
-	}
-
-	/* Checks whether the processing module is already running on the system. */
-	if ( ProcessingModuleRunning ( processing_module_configurator->GetName ( ) ) ) {
-		string msg = "processing module " + processing_module_configurator->GetName ( ) + " already running on " + Constants::SYSTEM_NAME;
-		delete ( processing_module_configurator );
-		throw ProcessSpawnningException ( msg );
+MpiCommunicator* Runtime::AcquireSpawnCommunicator ( void ) {
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	while ( spawn_communicators_.empty ( ) ) {
+		pthread_cond_wait ( &deployment_jobs_condition_, &deployment_jobs_mutex_ );
 	}
+	MpiCommunicator* spawn_communicator = spawn_communicators_.back ( );
+	spawn_communicators_.pop_back ( );
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+	return spawn_communicator;
+}
 
-	/* Checks the required number of instances */
-	if ( processing_module_configurator->GetNumberInstances ( ) <= 0 && processing_module_configurator->GetNumberInstances ( ) != Constants::PROCESSING_MODULE_AUTOMATIC_NUMBER_INSTANCES ) {
-		string msg = "number of required instances must be greater than 0";
-		delete ( processing_module_configurator );
-		throw ProcessSpawnningException ( msg );
-	}
+void Runtime::AddProcessingModule ( DeploymentJob* job ) throw ( ProcessSpawnningException ) {
+	ProcessingModuleConfigurator* processing_module_configurator = job->configurator_;
 
-	/* Chooses hosts to receive the processing module instances. */
+	/* Chooses hosts to receive the processing module instances, keeping the database chosen for this module. */
 	database_communicator_->Lock ( );
 	map < string, int > scheduler_result = runtime_scheduler_.ChooseHostsToAddProcessingModule ( runtime_configurator_->GetHosts ( ), database_communicator_, processing_module_configurator );
+	int database_identification = runtime_scheduler_.GetLastAssignedDatabase ( );
 	database_communicator_->Unlock ( );
 
 	if ( scheduler_result.size ( ) == 0 ) {
 		string msg = "it was not possible to create the processing module instances because there are no hosts with the demanded resources";
-		delete ( processing_module_configurator );
 		throw ProcessSpawnningException ( msg );
 	}
 
-	/* Tries to spawn the processing module instances. */
-	MpiCommunicator* new_module_communicator = SpawnProcessingModuleInstances ( processing_module_configurator, &scheduler_result );
+	/* Tries to spawn the processing module instances, while other jobs spawn theirs. */
+	MpiCommunicator* spawn_communicator = AcquireSpawnCommunicator ( );
+	MpiCommunicator* new_module_communicator;
+	try {
+		new_module_communicator = SpawnProcessingModuleInstances ( spawn_communicator, processing_module_configurator, &scheduler_result );
+	}
+	catch ( ProcessSpawnningException& e ) {
+		ReleaseSpawnCommunicator ( spawn_communicator );
+		throw ( e );
+	}
+	ReleaseSpawnCommunicator ( spawn_communicator );
+
+	/* The instances are initialized in the submission order, so they find the ports of the modules submitted before. */
+	WaitDeploymentTurn ( job );
 
 	/* Notifies the database manager to accept the connection from the new PM. */
 	Message m ( NULL, Constants::MESSAGE_OP_ACCEPT_CONNECT, 0 );
+	database_communicator_->Lock ( );
 	database_communicator_->BroadCast ( &m );
+	database_communicator_->Unlock ( );
 
-	/* Sends the name of the XML configurator file, the database port name and the database instance identification */
-	string init_message_data = processing_module_configurator->GetConfiguratorFileName ( ) + "\t" + processing_module_configurator->GetDatabasePortName ( ) + "\t" + Util::IntegerToString ( runtime_scheduler_.GetLastAssignedDatabase ( ) );
-	Message processing_module_init_msg ( ( void* ) init_message_data.c_str ( ), Constants::MESSAGE_OP_INIT_PROCESSING_MODULE, init_message_data.length ( ) + 1 );
+	/* Sends the name of the XML configurator file, the database port name and the database instance identification,
+	 * followed by the configurator descriptor, so the instances do not parse the file */
+	string init_message_data = processing_module_configurator->GetConfiguratorFileName ( ) + "\t" + processing_module_configurator->GetDatabasePortName ( ) + "\t" + Util::IntegerToString ( database_identification );
+	init_message_data += '\0' + processing_module_configurator->Serialize ( );
+	Message processing_module_init_msg ( ( void* ) init_message_data.data ( ), Constants::MESSAGE_OP_INIT_PROCESSING_MODULE, init_message_data.length ( ) );
 	new_module_communicator->BroadCast ( &processing_module_init_msg );
 
 	/* Receives the name of the port opened by the processing module instances or an error message. */
@@ -111,19 +136,155 @@ void Runtime::AddProcessingModule ( Message& received_message ) throw ( ProcessS
 	if ( message_from_module.GetOperationCode ( ) == Constants::MESSAGE_OP_PORT_NAME ) {
 		processing_module_configurator->SetPortName ( ( char* ) message_from_module.GetData ( ) );
 		ProcessingModuleEntry* new_entry = new ProcessingModuleEntry ( new_module_communicator, processing_module_configurator );
+		job->configurator_ = NULL;
 
 		/* Update the local table with the new processing module information */
 		ProcessingModuleEntry::Lock ( );
 		active_processing_modules_[processing_module_configurator->GetName ( )] = new_entry;
 		ProcessingModuleEntry::Unlock ( );
+
+		/* The instances were spawned in the order of the scheduling result, so their ranks follow it */
+		vector < string > hosts;
+		for ( map < string, int >::iterator it = scheduler_result.begin ( ); it != scheduler_result.end ( ); ++it ) {
+			hosts.insert ( hosts.end ( ), it->second, it->first );
+		}
+		string update = module_directory_.Publish ( processing_module_configurator->GetName ( ), cluster_communicator_->GetProcessRank ( ), processing_module_configurator->GetPortName ( ), hosts );
+		cluster_communicator_->Lock ( );
+		PublishModuleDirectory ( update );
+		cluster_communicator_->Unlock ( );
 	}
 	else if ( message_from_module.GetOperationCode ( ) == Constants::MESSAGE_OP_ERROR_LOG ) {
 		delete ( new_module_communicator );
-		delete ( processing_module_configurator );
 		throw ProcessSpawnningException ( ( char* ) message_from_module.GetData ( ) );
 	}
 }
 
+void Runtime::AddProcessingModuleInstance ( bool addition_manager, Message& received_message ) throw ( ProcessSpawnningException, XMLParserException ) {
+	string module_name = ( ( AddInstanceMessage* ) received_message.GetData ( ) )->GetModuleName ( );
+	bool status;
+
+	/* If I am the operation manager, I add the instances or pass the command to the other managers */
+	if ( addition_manager ) {
+		if ( ( ( AddInstanceMessage* ) received_message.GetData ( ) )->GetNumberInstances ( ) <= 0 ) {
+			string msg = "number of required instances must be greater than 0";
+			throw ProcessSpawnningException ( msg );
+		}
+
+		ProcessingModuleEntry::Lock ( );
+		status = active_processing_modules_.find ( module_name ) != active_processing_modules_.end ( );
+		ProcessingModuleEntry::Unlock ( );
+
+		if ( status ) {
+			cluster_communicator_->Lock ( );
+			database_communicator_->Lock ( );
+			ProcessingModuleEntry::Lock ( );
+			try {
+				DoProcessingModuleInstanceAddition ( received_message );
+			}
+			catch ( ProcessSpawnningException& e ) {
+				ProcessingModuleEntry::Unlock ( );
+				database_communicator_->Unlock ( );
+				cluster_communicator_->Unlock ( );
+				throw ( e );
+			}
+			catch ( XMLParserException& e ) {
+				ProcessingModuleEntry::Unlock ( );
+				database_communicator_->Unlock ( );
+				cluster_communicator_->Unlock ( );
+				throw ( e );
+			}
+			ProcessingModuleEntry::Unlock ( );
+			database_communicator_->Unlock ( );
+			cluster_communicator_->Unlock ( );
+		}
+		else {
+			received_message.SetOperationCode ( Constants::MESSAGE_OP_ADD_INSTANCE );
+			cluster_communicator_->Lock ( );
+			for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ); ++i ) {
+				if ( i != cluster_communicator_->GetProcessRank ( ) ) {
+					cluster_communicator_->Send ( &received_message, i );
+				}
+			}
+
+			Message input_message;
+			int received_acks = 0;
+			while ( received_acks < cluster_communicator_->GetNumberProcesses ( ) - 1 ) {
+				int source = cluster_communicator_->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ADD_INSTANCE_ACK );
+				input_message.SetOperationCode ( Constants::MESSAGE_OP_ADD_INSTANCE_ACK );
+				cluster_communicator_->Receive ( source, &input_message );
+				++received_acks;
+				status = status || * ( ( bool* ) input_message.GetData ( ) );
+			}
+			cluster_communicator_->Unlock ( );
+
+			if ( !status ) {
+				string error_message = module_name + " was not running on " + Constants::SYSTEM_NAME;
+				throw ProcessSpawnningException ( error_message );
+			}
+		}
+	}
+
+	/* Otherwise, the server responsible for the processing module adds the instances and reports it to the manager */
+	else {
+		status = active_processing_modules_.find ( module_name ) != active_processing_modules_.end ( );
+		if ( status ) {
+			try {
+				DoProcessingModuleInstanceAddition ( received_message );
+			}
+			catch ( ProcessSpawnningException& e ) {
+				Util::Error ( cluster_communicator_, e.ToString ( ) );
+			}
+			catch ( XMLParserException& e ) {
+				Util::Error ( cluster_communicator_, e.ToString ( ) );
+			}
+		}
+		Message response_message ( &status, Constants::MESSAGE_OP_ADD_INSTANCE_ACK, sizeof(bool) );
+		cluster_communicator_->Send ( &response_message, received_message.GetSource ( ) );
+	}
+}
+
+void Runtime::ApplyScalingOperations ( void ) {
+	SchedulerOperation operation;
+
+	pthread_mutex_lock ( &scaling_operations_mutex_ );
+	while ( !scaling_stopped_ ) {
+		if ( scaling_operations_.empty ( ) ) {
+			pthread_cond_wait ( &scaling_operations_condition_, &scaling_operations_mutex_ );
+			continue;
+		}
+		operation = scaling_operations_.front ( );
+		scaling_operations_.pop_front ( );
+		pthread_mutex_unlock ( &scaling_operations_mutex_ );
+
+		switch ( operation.GetOperationDescription ( ) ) {
+			case Constants::SCHED_OP_SCALE_OUT : {
+				AddInstanceMessage add_instance ( operation.GetNumberInstances ( ), operation.GetModuleName ( ) );
+				Message add_message ( ( void* ) &add_instance, Constants::MESSAGE_OP_ADD_INSTANCE, sizeof(AddInstanceMessage) );
+				SubmitScalingOperation ( add_message );
+				break;
+			}
+
+			case Constants::SCHED_OP_SCALE_IN : {
+				RemoveInstanceMessage remove_instance ( operation.GetInstanceRank ( ), operation.GetModuleName ( ) );
+				Message remove_message ( ( void* ) &remove_instance, Constants::MESSAGE_OP_REMOVE_INSTANCE, sizeof(RemoveInstanceMessage) );
+				SubmitScalingOperation ( remove_message );
+				break;
+			}
+
+			case Constants::SCHED_OP_MIGRATION : {
+				MigrateProcessingModuleInstance ( operation.GetInstanceRank ( ), operation.GetModuleName ( ), operation.GetTargetHost ( ) );
+				break;
+			}
+
+			default : {
+				break;
+			}
+		}
+		pthread_mutex_lock ( &scaling_operations_mutex_ );
+	}
+	pthread_mutex_unlock ( &scaling_operations_mutex_ );
+}
+
 void Runtime::Daemonize ( void ) {
 
 	int i, lock_file_pid;
@@ -181,6 +342,95 @@ void Runtime::DoProcessingModuleRemoval ( Message& received_message ) {
 	active_processing_modules_[processing_module_name]->GetCommunicator ( )->Synchronize ( );
 	delete ( active_processing_modules_[processing_module_name] );
 	active_processing_modules_.erase ( processing_module_name );
+	PublishModuleDirectory ( module_directory_.Withdraw ( processing_module_name, cluster_communicator_->GetProcessRank ( ) ) );
+}
+
+void Runtime::DoProcessingModuleInstanceAddition ( Message& received_message ) throw ( ProcessSpawnningException, XMLParserException ) {
+	string processing_module_name = ( ( AddInstanceMessage* ) received_message.GetData ( ) )->GetModuleName ( );
+	int number_instances = ( ( AddInstanceMessage* ) received_message.GetData ( ) )->GetNumberInstances ( );
+	ProcessingModuleEntry* entry = active_processing_modules_[processing_module_name];
+	string message = "adding " + Util::IntegerToString ( number_instances ) + " instances to " + processing_module_name;
+	Util::Information ( cluster_communicator_, message );
+
+	/* The new instances are configured as the running ones, except for their number. */
+	ProcessingModuleConfigurator* processing_module_configurator;
+	try {
+		string descriptor = entry->GetConfigurator ( )->Serialize ( );
+		processing_module_configurator = new ProcessingModuleConfigurator ( descriptor.data ( ), descriptor.length ( ) );
+		processing_module_configurator->SetNumberInstances ( number_instances );
+		processing_module_configurator->SetDatabasePortName ( database_port_name_ );
+	}
+	catch ( XMLParserException& e ) {
+		throw ( e );
+	}
+
+	/* Chooses hosts to receive the new instances, unless the request names one, and spawns them. */
+	map < string, int > scheduler_result;
+	string host_name = ( ( AddInstanceMessage* ) received_message.GetData ( ) )->GetHostName ( );
+	if ( host_name != "" ) {
+		processing_module_configurator->SetDatabasePeerIdentification ( runtime_scheduler_.GetLastAssignedDatabase ( ) );
+		scheduler_result[host_name] = number_instances;
+	}
+	else {
+		scheduler_result = runtime_scheduler_.ChooseHostsToAddProcessingModule ( runtime_configurator_->GetHosts ( ), database_communicator_, processing_module_configurator );
+	}
+	if ( scheduler_result.size ( ) == 0 ) {
+		string msg = "it was not possible to create the new instances of " + processing_module_name + " because there are no hosts with the demanded resources";
+		delete ( processing_module_configurator );
+		throw ProcessSpawnningException ( msg );
+	}
+
+	MpiCommunicator* new_instances_communicator;
+	try {
+		new_instances_communicator = SpawnProcessingModuleInstances ( self_communicator_, processing_module_configurator, &scheduler_result );
+	}
+	catch ( ProcessSpawnningException& e ) {
+		delete ( processing_module_configurator );
+		throw ( e );
+	}
+
+	/* Sends the initial information followed by the port of the running instances, which the new ones connect to. */
+	string init_message_data = processing_module_configurator->GetConfiguratorFileName ( ) + "\t" + processing_module_configurator->GetDatabasePortName ( ) + "\t" + Util::IntegerToString ( runtime_scheduler_.GetLastAssignedDatabase ( ) ) + "\t" + entry->GetConfigurator ( )->GetPortName ( );
+	init_message_data += '\0' + processing_module_configurator->Serialize ( );
+	Message processing_module_init_msg ( ( void* ) init_message_data.data ( ), Constants::MESSAGE_OP_INIT_PROCESSING_MODULE, init_message_data.length ( ) );
+	new_instances_communicator->BroadCast ( &processing_module_init_msg );
+	delete ( processing_module_configurator );
+
+	/* Waits for the new instances to start or for an error message. */
+	Message message_from_module;
+	int source = new_instances_communicator->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
+	message_from_module.SetOperationCode ( Constants::MESSAGE_OP_ANY );
+	new_instances_communicator->Receive ( source, &message_from_module );
+	if ( message_from_module.GetOperationCode ( ) == Constants::MESSAGE_OP_ERROR_LOG ) {
+		delete ( new_instances_communicator );
+		throw ProcessSpawnningException ( ( char* ) message_from_module.GetData ( ) );
+	}
+
+	/* Asks the running instances to accept the new ones and waits for the group to be merged. */
+	Message add_message ( NULL, Constants::MESSAGE_OP_ADD_INSTANCE, 0 );
+	entry->GetCommunicator ( )->BroadCast ( &add_message );
+	Message ack_message;
+	ack_message.SetOperationCode ( Constants::MESSAGE_OP_ADD_INSTANCE_ACK );
+	source = entry->GetCommunicator ( )->Poll ( Constants::COMM_ROOT_PROCESS, Constants::MESSAGE_OP_ADD_INSTANCE_ACK );
+	entry->GetCommunicator ( )->Receive ( source, &ack_message );
+
+	/* Notifies the database manager to accept the group registering again and connects to the whole group. */
+	Message accept_message ( NULL, Constants::MESSAGE_OP_ACCEPT_CONNECT, 0 );
+	database_communicator_->BroadCast ( &accept_message );
+	MpiCommunicator* module_communicator = self_communicator_->Connect ( entry->GetConfigurator ( )->GetPortName ( ) );
+	entry->GetCommunicator ( )->Disconnect ( );
+	delete ( entry->GetCommunicator ( ) );
+	new_instances_communicator->Disconnect ( );
+	delete ( new_instances_communicator );
+	entry->SetCommunicator ( module_communicator );
+	entry->GetConfigurator ( )->SetNumberInstances ( module_communicator->GetNumberProcesses ( ) );
+
+	/* The new instances joined the group as its last ones */
+	vector < string > hosts = module_directory_.GetHosts ( processing_module_name );
+	for ( map < string, int >::iterator it = scheduler_result.begin ( ); it != scheduler_result.end ( ); ++it ) {
+		hosts.insert ( hosts.end ( ), it->second, it->first );
+	}
+	PublishModuleDirectory ( module_directory_.Publish ( processing_module_name, cluster_communicator_->GetProcessRank ( ), entry->GetConfigurator ( )->GetPortName ( ), hosts ) );
 }
 
 void Runtime::DoProcessingModuleInstanceRemoval ( Message& received_message ) {
@@ -189,10 +439,20 @@ void Runtime::DoProcessingModuleInstanceRemoval ( Message& received_message ) {
 	string message = "removing instance " + Util::IntegerToString ( instance ) + " of " + processing_module_name + " from " + Constants::SYSTEM_NAME;
 	Util::Information ( cluster_communicator_, message );
 
+	/* The instances need to know which one leaves */
+	ProcessingModuleEntry* entry = active_processing_modules_[processing_module_name];
 	Message remove_message;
 	remove_message.SetOperationCode ( Constants::MESSAGE_OP_REMOVE_INSTANCE );
-	active_processing_modules_[processing_module_name]->GetCommunicator ( )->BroadCast ( &remove_message );
-	active_processing_modules_[processing_module_name]->GetCommunicator ( )->RemoveProcess ( Constants::PROCESSING_MODULE_INVALID_INSTANCE );
+	remove_message.SetData ( received_message.GetData ( ), received_message.GetDataSize ( ) );
+	entry->GetCommunicator ( )->BroadCast ( &remove_message );
+	entry->GetCommunicator ( )->RemoveProcess ( Constants::PROCESSING_MODULE_INVALID_INSTANCE );
+	entry->GetConfigurator ( )->SetNumberInstances ( entry->GetConfigurator ( )->GetNumberInstances ( ) - 1 );
+
+	vector < string > hosts = module_directory_.GetHosts ( processing_module_name );
+	if ( instance >= 0 && instance < ( int ) hosts.size ( ) ) {
+		hosts.erase ( hosts.begin ( ) + instance );
+	}
+	PublishModuleDirectory ( module_directory_.Publish ( processing_module_name, cluster_communicator_->GetProcessRank ( ), entry->GetConfigurator ( )->GetPortName ( ), hosts ) );
 }
 
 void Runtime::ExchangeInitialInformation ( void ) {
@@ -286,6 +546,21 @@ void Runtime::HandleProcessingModuleMessage ( string processing_module_name, Mes
 			break;
 		}
 
+		case Constants::MESSAGE_OP_INSTANCE_STATISTICS : {
+			active_processing_modules_[processing_module_name]->SetStatistics ( received_message.GetSource ( ), * ( ( InstanceStatisticsMessage* ) received_message.GetData ( ) ) );
+			break;
+		}
+
+		case Constants::MESSAGE_OP_LOG_BATCH : {
+			if ( cluster_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
+				PrintLogBatch ( received_message );
+			}
+			else { /* Forwarded as a whole, so the batch still costs a single message */
+				cluster_communicator_->Send ( &received_message, Constants::COMM_ROOT_PROCESS );
+			}
+			break;
+		}
+
 		case Constants::MESSAGE_OP_PROCESSING_MODULE_PORTS_QUERY : {
 			QueryProcessingModulePorts ( true, processing_module_name, received_message );
 			break;
@@ -318,9 +593,18 @@ void Runtime::HandleProcessingModuleMessage ( string processing_module_name, Mes
 }
 
 void Runtime::HandleRuntimeMessage ( Message& received_message ) {
-	int source = received_message.GetSource ( );
 	switch ( received_message.GetOperationCode ( ) ) {
 
+		case Constants::MESSAGE_OP_ADD_INSTANCE : {
+			AddProcessingModuleInstance ( false, received_message );
+			break;
+		}
+
+		case Constants::MESSAGE_OP_CHECKPOINT_BARRIER : {
+			InjectCheckpointBarrier ( received_message );
+			break;
+		}
+
 		case Constants::MESSAGE_OP_ERROR_LOG : {
 			if ( cluster_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
 				Logger::Lock ( );
@@ -345,13 +629,23 @@ void Runtime::HandleRuntimeMessage ( Message& received_message ) {
 			break;
 		}
 
+		case Constants::MESSAGE_OP_LOG_BATCH : {
+			PrintLogBatch ( received_message );
+			break;
+		}
+
+		case Constants::MESSAGE_OP_MODULE_DIRECTORY_UPDATE : {
+			module_directory_.Apply ( ( char* ) received_message.GetData ( ) );
+			break;
+		}
+
 		case Constants::MESSAGE_OP_PROCESSING_MODULE_PORTS_QUERY : {
 			QueryProcessingModulePorts ( false, "", received_message );
 			break;
 		}
 
-		case Constants::MESSAGE_OP_PROCESSING_MODULE_RUNNING_QUERY : {
-			IsOwnerOfProcessingModule ( received_message, source );
+		case Constants::MESSAGE_OP_QUERY_METRICS : {
+			QueryMetrics ( false, received_message );
 			break;
 		}
 
@@ -398,10 +692,12 @@ void Runtime::HandleSignal ( int signal ) {
 	}
 }
 
-void Runtime::IsOwnerOfProcessingModule ( Message received_message, int requester ) {
-	bool response = active_processing_modules_.find ( ( char* ) received_message.GetData ( ) ) != active_processing_modules_.end ( );
-	Message response_message ( ( void* ) &response, Constants::MESSAGE_OP_PROCESSING_MODULE_RUNNING_ACK, sizeof ( response ) );
-	cluster_communicator_->Send ( &response_message, requester );
+void Runtime::InjectCheckpointBarrier ( Message& barrier ) {
+	for ( map < string, ProcessingModuleEntry* >::iterator it = active_processing_modules_.begin ( ); it != active_processing_modules_.end ( ); ++it ) {
+		if ( it->second->GetConfigurator ( )->GetInputs ( )->size ( ) == 0 ) {
+			it->second->GetCommunicator ( )->BroadCast ( &barrier );
+		}
+	}
 }
 
 void Runtime::LockLocalResources ( void ) throw ( FileOperationException ) {
@@ -437,43 +733,162 @@ void Runtime::LockLocalResources ( void ) throw ( FileOperationException ) {
 	write ( lock_file_pid, str, strlen ( str ) ); /* record pid to lockfile */
 }
 
-void MigrateProcessingModuleInstance ( int instance, string module_name, string target_host ) {
-	cout << "Migrando " << module_name << instance << " para " << target_host << endl;
-}
+void Runtime::MigrateProcessingModuleInstance ( int instance, string module_name, string target_host ) {
 
-bool Runtime::ProcessingModuleRunning ( string processing_module_name ) {
-	bool processing_module_already_running = false;
-	int received_acks = 0;
-	Message output_message;
-	Message input_message;
+	/* Labels are routed by rank, which the removal of the migrated instance would shift away from the moved state */
+	bool labeled = false;
+	ProcessingModuleEntry::Lock ( );
+	if ( active_processing_modules_.find ( module_name ) != active_processing_modules_.end ( ) ) {
+		labeled = active_processing_modules_[module_name]->GetConfigurator ( )->HasLabeledInput ( );
+	}
+	ProcessingModuleEntry::Unlock ( );
+	if ( labeled ) {
+		Util::Warning ( cluster_communicator_, "instance " + Util::IntegerToString ( instance ) + " of " + module_name + " not migrated, since the module has a labeled input" );
+		return;
+	}
+
+	string message = "migrating instance " + Util::IntegerToString ( instance ) + " of " + module_name + " to " + target_host;
+	Util::Information ( cluster_communicator_, message );
 
+	/* The replacement joins the group as its last instance */
+	AddInstanceMessage add_instance ( 1, module_name );
+	add_instance.SetHostName ( target_host );
+	Message add_message ( ( void* ) &add_instance, Constants::MESSAGE_OP_ADD_INSTANCE, sizeof(AddInstanceMessage) );
+	if ( !SubmitScalingOperation ( add_message ) ) {
+		return;
+	}
+
+	int successor = -1;
 	ProcessingModuleEntry::Lock ( );
-	processing_module_already_running = active_processing_modules_.find ( processing_module_name ) != active_processing_modules_.end ( );
+	if ( active_processing_modules_.find ( module_name ) != active_processing_modules_.end ( ) ) {
+		successor = active_processing_modules_[module_name]->GetConfigurator ( )->GetNumberInstances ( ) - 1;
+	}
 	ProcessingModuleEntry::Unlock ( );
 
-	if ( !processing_module_already_running ) {
-		output_message.SetOperationCode ( Constants::MESSAGE_OP_PROCESSING_MODULE_RUNNING_QUERY );
-		output_message.SetData ( ( void* ) processing_module_name.c_str ( ), processing_module_name.length ( ) + 1 );
+	/* The migrated instance hands its state over to the replacement while being removed */
+	RemoveInstanceMessage remove_instance ( instance, module_name );
+	remove_instance.SetSuccessorIdentification ( successor );
+	Message remove_message ( ( void* ) &remove_instance, Constants::MESSAGE_OP_REMOVE_INSTANCE, sizeof(RemoveInstanceMessage) );
+	SubmitScalingOperation ( remove_message );
+}
+
+void Runtime::PrintLogBatch ( Message& batch ) {
+	vector < pair < int, string > > records = AsyncLogger::ReadBatch ( batch );
+	Logger::Lock ( );
+	for ( uint i = 0; i < records.size ( ); ++i ) {
+		switch ( records[i].first ) {
+			case Constants::MESSAGE_OP_ERROR_LOG : {
+				runtime_logger_->PrintError ( records[i].second );
+				break;
+			}
+
+			case Constants::MESSAGE_OP_WARNING_LOG : {
+				runtime_logger_->PrintWarning ( records[i].second );
+				break;
+			}
+
+			default : {
+				runtime_logger_->PrintInfo ( records[i].second );
+				break;
+			}
+		}
+	}
+	Logger::Unlock ( );
+}
+
+bool Runtime::ProcessingModuleRunning ( string processing_module_name ) {
+	return module_directory_.Contains ( processing_module_name );
+}
+
+void Runtime::PublishModuleDirectory ( string update ) {
+	Message update_message ( ( void* ) update.c_str ( ), Constants::MESSAGE_OP_MODULE_DIRECTORY_UPDATE, update.length ( ) + 1 );
+	for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ); ++i ) {
+		if ( i != cluster_communicator_->GetProcessRank ( ) ) {
+			cluster_communicator_->Send ( &update_message, i );
+		}
+	}
+}
+
+void Runtime::PruneDeploymentJobs ( void ) {
+	int number_finished = 0;
+	for ( map < int, DeploymentJob* >::iterator it = deployment_jobs_.begin ( ); it != deployment_jobs_.end ( ); ++it ) {
+		if ( it->second->state_ != Constants::DEPLOYMENT_RUNNING ) {
+			++number_finished;
+		}
+	}
 
-		/* Sends a query to other managers asking if the processing module is running. */
+	/* Jobs finish in identification order, so the oldest finished ones come first */
+	map < int, DeploymentJob* >::iterator it = deployment_jobs_.begin ( );
+	while ( number_finished > Constants::DEPLOYMENT_HISTORY_SIZE && it != deployment_jobs_.end ( ) ) {
+		if ( it->second->state_ != Constants::DEPLOYMENT_RUNNING ) {
+			delete ( it->second );
+			deployment_jobs_.erase ( it++ );
+			--number_finished;
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+string Runtime::QueryDeployments ( void ) {
+	string deployments = "";
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	for ( map < int, DeploymentJob* >::iterator it = deployment_jobs_.begin ( ); it != deployment_jobs_.end ( ); ++it ) {
+		deployments += "job " + Util::IntegerToString ( it->first ) + "\t" + it->second->module_name_ + "\t";
+		switch ( it->second->state_ ) {
+			case Constants::DEPLOYMENT_RUNNING : {
+				deployments += "running";
+				break;
+			}
+
+			case Constants::DEPLOYMENT_DONE : {
+				deployments += "done";
+				break;
+			}
+
+			default : {
+				deployments += "failed: " + it->second->error_;
+				break;
+			}
+		}
+		deployments += "\n";
+	}
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+
+	if ( deployments.empty ( ) ) {
+		deployments = "no deployment jobs submitted to " + Constants::SYSTEM_NAME + "\n";
+	}
+	return deployments;
+}
+
+string Runtime::QueryMetrics ( bool is_query_manager, Message& received_message ) {
+	/* The instances publish their metrics on the host, so reading them does not disturb their processing */
+	string message_data = cluster_communicator_->GetHostName ( ) + ":\n" + MetricsRegistry::ReadHostMetrics ( );
+
+	if ( is_query_manager ) {
+		received_message.SetOperationCode ( Constants::MESSAGE_OP_QUERY_METRICS );
 		cluster_communicator_->Lock ( );
 		for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ); ++i ) {
-			if ( i != cluster_communicator_->GetProcessRank ( ) ) {
-				cluster_communicator_->Send ( &output_message, i );
+			if ( cluster_communicator_->GetProcessRank ( ) != i ) {
+				cluster_communicator_->Send ( &received_message, i );
 			}
 		}
 
-		/* Receives the responses. */
-		while ( received_acks < cluster_communicator_->GetNumberProcesses ( ) - 1 ) {
-			int source = cluster_communicator_->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_PROCESSING_MODULE_RUNNING_ACK );
-			input_message.SetOperationCode ( Constants::MESSAGE_OP_PROCESSING_MODULE_RUNNING_ACK );
+		Message input_message;
+		for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ) - 1; ++i ) {
+			input_message.SetOperationCode ( Constants::MESSAGE_OP_QUERY_METRICS_ACK );
+			int source = cluster_communicator_->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_QUERY_METRICS_ACK );
 			cluster_communicator_->Receive ( source, &input_message );
-			++received_acks;
-			processing_module_already_running = processing_module_already_running || * ( ( bool* ) input_message.GetData ( ) );
+			message_data.append ( ( char* ) input_message.GetData ( ) );
 		}
 		cluster_communicator_->Unlock ( );
+		return message_data;
 	}
-	return processing_module_already_running;
+
+	Message output_message ( ( void* ) message_data.c_str ( ), Constants::MESSAGE_OP_QUERY_METRICS_ACK, message_data.length ( ) + 1 );
+	cluster_communicator_->Send ( &output_message, received_message.GetSource ( ) );
+	return "";
 }
 
 void Runtime::QueryProcessingModulePorts ( bool is_query_manager, string processing_module_name, Message& received_message ) {
@@ -491,17 +906,31 @@ void Runtime::QueryProcessingModulePorts ( bool is_query_manager, string process
 
 	if ( is_query_manager ) {
 
-		/* Send the query to other runtime daemons. */
-		for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ); ++i ) {
-			if ( cluster_communicator_->GetProcessRank ( ) != i ) {
-				cluster_communicator_->Send ( &received_message, i );
+		/* Only the owners of the modules, found in the module directory, make them accept the connections. The query is
+		 * sent to every runtime daemon when a module is not in the directory yet. */
+		set < int > owners;
+		for ( int i = 0; i < ( int ) processing_module_list.size ( ); ++i ) {
+			int owner = module_directory_.GetOwner ( processing_module_list[i] );
+			if ( owner == -1 ) {
+				owners.clear ( );
+				for ( int j = 0; j < cluster_communicator_->GetNumberProcesses ( ); ++j ) {
+					owners.insert ( j );
+				}
+				break;
 			}
+			owners.insert ( owner );
+		}
+		owners.erase ( cluster_communicator_->GetProcessRank ( ) );
+
+		/* Send the query to other runtime daemons. */
+		for ( set < int >::iterator it = owners.begin ( ); it != owners.end ( ); ++it ) {
+			cluster_communicator_->Send ( &received_message, *it );
 		}
 
 		/* Receives the ack messages from other runtime daemons. */
 		Message input_message;
 		input_message.SetOperationCode ( Constants::MESSAGE_OP_RUNTIME_QUERY_PROCESSING_MODULE_PORTS_ACK );
-		for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ) - 1; ++i ) {
+		for ( int i = 0; i < ( int ) owners.size ( ); ++i ) {
 			int source = cluster_communicator_->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_RUNTIME_QUERY_PROCESSING_MODULE_PORTS_ACK );
 			cluster_communicator_->Receive ( source, &input_message );
 			message_data.append ( ( char* ) input_message.GetData ( ) );
@@ -534,6 +963,13 @@ void Runtime::ReadConfigurationFile ( void ) throw ( FileOperationException, XML
 	}
 }
 
+void Runtime::ReleaseSpawnCommunicator ( MpiCommunicator* spawn_communicator ) {
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	spawn_communicators_.push_back ( spawn_communicator );
+	pthread_cond_broadcast ( &deployment_jobs_condition_ );
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+}
+
 void Runtime::RemoveProcessingModule ( bool is_removal_manager, Message& received_message ) {
 	string processing_module_name = ( char* ) received_message.GetData ( );
 	bool status = active_processing_modules_.find ( processing_module_name ) != active_processing_modules_.end ( );
@@ -652,11 +1088,49 @@ void Runtime::Run ( void ) {
 
 	pthread_create ( &console_thread_, 0, &Runtime::StartConsoleThread, this );
 	pthread_create ( &server_thread_, 0, &Runtime::StartServerThread, this );
+	pthread_create ( &scaling_thread_, 0, &Runtime::StartScalingThread, this );
 	pthread_join ( console_thread_, NULL );
 	pthread_join ( server_thread_, NULL );
+	pthread_join ( scaling_thread_, NULL );
+}
+
+void Runtime::RunDeployment ( DeploymentJob* job ) {
+	int state = Constants::DEPLOYMENT_DONE;
+	string error = "";
+	try {
+		AddProcessingModule ( job );
+	}
+	catch ( ProcessSpawnningException& e ) {
+		state = Constants::DEPLOYMENT_FAILED;
+		error = e.ToString ( );
+	}
+	catch ( exception& e ) {
+		state = Constants::DEPLOYMENT_FAILED;
+		error = e.what ( );
+	}
+	if ( state == Constants::DEPLOYMENT_FAILED ) {
+		Util::Error ( cluster_communicator_, error );
+		delete ( job->configurator_ );
+		job->configurator_ = NULL;
+	}
+
+	/* A job gives the turn to the next one even when it failed before taking it */
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	while ( deployment_turn_ != job->identification_ ) {
+		pthread_cond_wait ( &deployment_jobs_condition_, &deployment_jobs_mutex_ );
+	}
+	job->state_ = state;
+	job->error_ = error;
+	++deployment_turn_;
+	deploying_modules_.erase ( job->module_name_ );
+	--running_deployments_;
+	PruneDeploymentJobs ( );
+	pthread_cond_broadcast ( &deployment_jobs_condition_ );
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
 }
 
 void Runtime::Shutdown ( bool is_shutdown_manager, Message& received_message ) {
+	StopScaling ( );
 	cluster_communicator_->Lock ( );
 	if ( is_shutdown_manager ) {
 		for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ); ++i ) {
@@ -755,7 +1229,93 @@ void Runtime::SpawnDatabaseDaemon ( void ) {
 	}
 }
 
-MpiCommunicator* Runtime::SpawnProcessingModuleInstances ( ProcessingModuleConfigurator* processing_module_configurator, map < string, int >* scheduler_result ) throw ( ProcessSpawnningException ) {
+int Runtime::SubmitDeployment ( Message& received_message ) throw ( ProcessSpawnningException, XMLParserException ) {
+
+	string processing_module_configurator_file = ( char* ) received_message.GetData ( );
+	ProcessingModuleConfigurator* processing_module_configurator;
+
+	/* Creates an initial processing module configurator based on a XML configuration file, parsed unless it was
+	 * already loaded unmodified. */
+	try {
+		processing_module_configurator = ProcessingModuleConfigurator::Load ( processing_module_configurator_file );
+		processing_module_configurator->SetDatabasePortName ( database_port_name_ );
+	}
+	catch ( XMLParserException& e ) {
+		throw ( e );
+	}
+
+	/* Checks the required number of instances */
+	if ( processing_module_configurator->GetNumberInstances ( ) <= 0 && processing_module_configurator->GetNumberInstances ( ) != Constants::PROCESSING_MODULE_AUTOMATIC_NUMBER_INSTANCES ) {
+		string msg = "number of required instances must be greater than 0";
+		delete ( processing_module_configurator );
+		throw ProcessSpawnningException ( msg );
+	}
+
+	/* Checks whether the processing module is already running on the system or being deployed by another job. */
+	string processing_module_name = processing_module_configurator->GetName ( );
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	bool deploying = !deploying_modules_.insert ( processing_module_name ).second;
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+	if ( deploying || ProcessingModuleRunning ( processing_module_name ) ) {
+		if ( !deploying ) {
+			pthread_mutex_lock ( &deployment_jobs_mutex_ );
+			deploying_modules_.erase ( processing_module_name );
+			pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+		}
+		string msg = "processing module " + processing_module_name + " already running on " + Constants::SYSTEM_NAME;
+		delete ( processing_module_configurator );
+		throw ProcessSpawnningException ( msg );
+	}
+
+	DeploymentJob* job = new DeploymentJob ( );
+	job->module_name_ = processing_module_name;
+	job->configurator_ = processing_module_configurator;
+	job->state_ = Constants::DEPLOYMENT_RUNNING;
+	job->runtime_ = this;
+
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	job->identification_ = next_deployment_++;
+	deployment_jobs_[job->identification_] = job;
+	++running_deployments_;
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+
+	pthread_t deployment_thread;
+	pthread_create ( &deployment_thread, NULL, Runtime::StartDeploymentThread, job );
+	pthread_detach ( deployment_thread );
+	return job->identification_;
+}
+
+void Runtime::StopScaling ( void ) {
+	pthread_mutex_lock ( &scaling_operations_mutex_ );
+	scaling_stopped_ = true;
+	scaling_operations_.clear ( );
+	pthread_cond_signal ( &scaling_operations_condition_ );
+	pthread_mutex_unlock ( &scaling_operations_mutex_ );
+}
+
+bool Runtime::SubmitScalingOperation ( Message& operation_message ) {
+	Message reply_message;
+
+	/* The console thread serving the operation stops accepting connections at the shutdown */
+	pthread_mutex_lock ( &scaling_operations_mutex_ );
+	bool stopped = scaling_stopped_;
+	pthread_mutex_unlock ( &scaling_operations_mutex_ );
+	if ( stopped ) {
+		return false;
+	}
+
+	MpiCommunicator* communicator = self_communicator_->Connect ( server_port_ );
+	communicator->Send ( &operation_message, Constants::COMM_ROOT_PROCESS );
+	int source = communicator->Poll ( Constants::COMM_ANY_SOURCE, Constants::MESSAGE_OP_ANY );
+	reply_message.SetOperationCode ( Constants::MESSAGE_OP_ANY );
+	communicator->Receive ( source, &reply_message );
+	communicator->Disconnect ( );
+	delete ( communicator );
+
+	return reply_message.GetOperationCode ( ) == Constants::MESSAGE_OP_ADD_INSTANCE_ACK || reply_message.GetOperationCode ( ) == Constants::MESSAGE_OP_REMOVE_INSTANCE_ACK;
+}
+
+MpiCommunicator* Runtime::SpawnProcessingModuleInstances ( MpiCommunicator* spawn_communicator, ProcessingModuleConfigurator* processing_module_configurator, map < string, int >* scheduler_result ) throw ( ProcessSpawnningException ) {
 
 	/* Build the information to spawn processing module instances */
 	vector < string > commands;
@@ -773,7 +1333,7 @@ MpiCommunicator* Runtime::SpawnProcessingModuleInstances ( ProcessingModuleConfi
 	}
 
 	/* Spawns the processing module instances. */
-	MpiCommunicator* new_processing_module_communicator;
+	MpiCommunicator* new_processing_module_communicator = NULL;
 	if ( hosts_to_receive_processing_module.size ( ) > 0 ) {
 		try {
 			char number_instances[Constants::MAX_INT_TO_STRING_LENGTH];
@@ -782,12 +1342,12 @@ MpiCommunicator* Runtime::SpawnProcessingModuleInstances ( ProcessingModuleConfi
 			string message = "spawning " + text_number_instances + " instances of " + processing_module_configurator->GetName ( ) + " from host " + cluster_communicator_->GetHostName ( );
 			Util::Information ( cluster_communicator_, message );
 			string server_work_directory = runtime_configurator_->GetExeDir ( );
-			new_processing_module_communicator = self_communicator_->Spawn ( arguments, commands, hosts_to_receive_processing_module, number_process, server_work_directory );
+			new_processing_module_communicator = spawn_communicator->Spawn ( arguments, commands, hosts_to_receive_processing_module, number_process, server_work_directory );
 		}
 		catch ( MPI::Exception e ) {
 		}
 
-		if ( new_processing_module_communicator->GetNumberProcesses ( ) != total_instances ) {
+		if ( new_processing_module_communicator == NULL || new_processing_module_communicator->GetNumberProcesses ( ) != total_instances ) {
 			string msg = "it was not possible to create the processing module processes from " + cluster_communicator_->GetHostName ( );
 			throw ProcessSpawnningException ( msg );
 		}
@@ -795,11 +1355,64 @@ MpiCommunicator* Runtime::SpawnProcessingModuleInstances ( ProcessingModuleConfi
 	return new_processing_module_communicator;
 }
 
+void Runtime::TriggerCheckpoint ( void ) {
+	struct timeval now;
+	gettimeofday ( &now, NULL );
+	long elapsed_time = ( now.tv_sec - last_checkpoint_time_.tv_sec ) * 1000 + ( now.tv_usec - last_checkpoint_time_.tv_usec ) / 1000;
+	if ( elapsed_time < runtime_configurator_->GetCheckpointInterval ( ) ) {
+		return;
+	}
+	last_checkpoint_time_ = now;
+
+	/* The identification grows across restarts, so instances never mistake an old checkpoint for a new one */
+	long checkpoint = now.tv_sec * 1000L + now.tv_usec / 1000;
+	Message barrier ( ( void* ) &checkpoint, Constants::MESSAGE_OP_CHECKPOINT_BARRIER, sizeof(long) );
+	for ( int i = 0; i < cluster_communicator_->GetNumberProcesses ( ); ++i ) {
+		if ( i != cluster_communicator_->GetProcessRank ( ) ) {
+			cluster_communicator_->Send ( &barrier, i );
+		}
+	}
+	InjectCheckpointBarrier ( barrier );
+}
+
+void Runtime::TriggerAutoscaling ( void ) {
+	struct timeval now;
+	gettimeofday ( &now, NULL );
+	long elapsed_time = ( now.tv_sec - last_autoscaling_time_.tv_sec ) * 1000 + ( now.tv_usec - last_autoscaling_time_.tv_usec ) / 1000;
+	if ( elapsed_time < runtime_configurator_->GetAutoscalingInterval ( ) ) {
+		return;
+	}
+	last_autoscaling_time_ = now;
+
+	/* Each runtime scales the modules it is responsible for, from the statistics their instances report to it */
+	vector < SchedulerOperation > operations = runtime_scheduler_.Balance ( runtime_configurator_->GetHosts ( ), &active_processing_modules_, runtime_configurator_->GetAutoscalingCooldown ( ) );
+	pthread_mutex_lock ( &scaling_operations_mutex_ );
+	for ( vector < SchedulerOperation >::iterator it = operations.begin ( ); it != operations.end ( ); ++it ) {
+		ProcessingModuleEntry* entry = active_processing_modules_[it->GetModuleName ( )];
+		entry->ClearStatistics ( );
+		entry->SetLastScalingTime ( now );
+		scaling_operations_.push_back ( *it );
+	}
+	pthread_cond_signal ( &scaling_operations_condition_ );
+	pthread_mutex_unlock ( &scaling_operations_mutex_ );
+}
+
 void* Runtime::StartConsoleThread ( void* obj ) {
 	reinterpret_cast < Runtime * > ( obj )->WaitConnections ( );
 	pthread_exit ( NULL);
 }
 
+void* Runtime::StartDeploymentThread ( void* obj ) {
+	DeploymentJob* job = reinterpret_cast < DeploymentJob * > ( obj );
+	job->runtime_->RunDeployment ( job );
+	pthread_exit ( NULL);
+}
+
+void* Runtime::StartScalingThread ( void* obj ) {
+	reinterpret_cast < Runtime * > ( obj )->ApplyScalingOperations ( );
+	pthread_exit ( NULL);
+}
+
 void* Runtime::StartServerThread ( void* obj ) {
 	reinterpret_cast < Runtime * > ( obj )->WaitMessages ( );
 	pthread_exit ( NULL);
@@ -822,8 +1435,29 @@ void Runtime::WaitConnections ( void ) {
 			switch ( message_from_console.GetOperationCode ( ) ) {
 
 				case Constants::MESSAGE_OP_ADD_PROCESSING_MODULE : {
-					AddProcessingModule ( message_from_console );
+					string job = Util::IntegerToString ( SubmitDeployment ( message_from_console ) );
 					message_to_console.SetOperationCode ( Constants::MESSAGE_OP_ADD_PROCESSING_MODULE_ACK );
+					message_to_console.SetData ( ( void* ) job.c_str ( ), job.length ( ) + 1 );
+					break;
+				}
+
+				case Constants::MESSAGE_OP_ADD_INSTANCE : {
+					AddProcessingModuleInstance ( true, message_from_console );
+					message_to_console.SetOperationCode ( Constants::MESSAGE_OP_ADD_INSTANCE_ACK );
+					break;
+				}
+
+				case Constants::MESSAGE_OP_QUERY_DEPLOYMENTS : {
+					string deployments = QueryDeployments ( );
+					message_to_console.SetOperationCode ( Constants::MESSAGE_OP_QUERY_DEPLOYMENTS_ACK );
+					message_to_console.SetData ( ( void* ) deployments.c_str ( ), deployments.length ( ) + 1 );
+					break;
+				}
+
+				case Constants::MESSAGE_OP_QUERY_METRICS : {
+					string metrics = QueryMetrics ( true, message_from_console );
+					message_to_console.SetOperationCode ( Constants::MESSAGE_OP_QUERY_METRICS_ACK );
+					message_to_console.SetData ( ( void* ) metrics.c_str ( ), metrics.length ( ) + 1 );
 					break;
 				}
 
@@ -840,6 +1474,7 @@ void Runtime::WaitConnections ( void ) {
 				}
 
 				case Constants::MESSAGE_OP_SHUTDOWN : {
+					WaitDeployments ( );
 					Shutdown ( true, message_from_console );
 					break;
 				}
@@ -878,6 +1513,22 @@ void Runtime::WaitConnections ( void ) {
 	while ( !shutdown_notification_ );
 }
 
+void Runtime::WaitDeployments ( void ) {
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	while ( running_deployments_ > 0 ) {
+		pthread_cond_wait ( &deployment_jobs_condition_, &deployment_jobs_mutex_ );
+	}
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+}
+
+void Runtime::WaitDeploymentTurn ( DeploymentJob* job ) {
+	pthread_mutex_lock ( &deployment_jobs_mutex_ );
+	while ( deployment_turn_ != job->identification_ ) {
+		pthread_cond_wait ( &deployment_jobs_condition_, &deployment_jobs_mutex_ );
+	}
+	pthread_mutex_unlock ( &deployment_jobs_mutex_ );
+}
+
 void Runtime::WaitMessages ( void ) {
 
 	Message received_message;
@@ -917,6 +1568,16 @@ void Runtime::WaitMessages ( void ) {
 					}
 				}
 			}
+
+			/* Starts the periodic checkpoints */
+			if ( !shutdown_notification_ && runtime_configurator_->GetCheckpointInterval ( ) > 0 && cluster_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
+				TriggerCheckpoint ( );
+			}
+
+			/* Scales the autoscaled processing modules */
+			if ( !shutdown_notification_ && runtime_configurator_->GetAutoscalingInterval ( ) > 0 ) {
+				TriggerAutoscaling ( );
+			}
 			ProcessingModuleEntry::Unlock ( );
 			database_communicator_->Unlock ( );
 			cluster_communicator_->Unlock ( );
@@ -932,6 +1593,11 @@ void Runtime::WaitMessages ( void ) {
 			}
 		}
 		if ( source == -1 ) {
+			if ( cluster_communicator_->GetProcessRank ( ) == Constants::COMM_ROOT_PROCESS ) {
+				Logger::Lock ( );
+				runtime_logger_->Flush ( );
+				Logger::Unlock ( );
+			}
 			usleep ( Constants::SLEEP_TIME );
 		}
 	}
@@ -957,6 +1623,9 @@ void Runtime::WaitMessages ( void ) {
 					runtime_logger_->PrintInfo ( ( char* ) received_message.GetData ( ) );
 					Logger::Unlock ( );
 				}
+				else if ( received_message.GetOperationCode ( ) == Constants::MESSAGE_OP_LOG_BATCH ) {
+					PrintLogBatch ( received_message );
+				}
 			}
 			string log_message_text = Constants::SYSTEM_NAME + " stopped";
 			Logger::Lock ( );
@@ -12,6 +12,7 @@
 #include <pthread.h>
 #include <signal.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/types.h>
 
 /* Other libraries */
@@ -19,13 +20,19 @@
 #include <getopt.h>
 #include <netdb.h>
 
+/* C++ libraries */
+#include <deque>
+#include <set>
+
 /* Project's .h */
 #include <comm/mpi/mpi_communicator.h>
 #include <common/logger.h>
 #include <common/util.h>
+#include <library/metrics_registry.h>
 #include <library/processing_module_entry.h>
 #include <library/xml.h>
 #include <runtime/configurator.h>
+#include <runtime/module_directory.h>
 #include <scheduler/scheduler.h>
 
 using namespace std;
@@ -72,12 +79,45 @@ class Runtime {
 
 	private:
 
+		/**
+		 * \brief A processing module deployment submitted by a console. Jobs spawn their instances concurrently, up to
+		 * Constants::DEPLOYMENT_MAX_SPAWNS at a time, and then initialize them one at a time in submission order, so
+		 * each module finds the ports of the modules submitted before it, as in a sequential deployment.
+		 */
+		struct DeploymentJob {
+				/** \brief The job identification, increasing with the submission order. */
+				int identification_;
+				/** \brief The processing module name. */
+				string module_name_;
+				/** \brief The processing module configurator, owned by the job until the module is running. */
+				ProcessingModuleConfigurator* configurator_;
+				/** \brief Constants::DEPLOYMENT_RUNNING, DEPLOYMENT_DONE or DEPLOYMENT_FAILED. */
+				int state_;
+				/** \brief Why the job failed. */
+				string error_;
+				/** \brief The runtime running the job. */
+				Runtime* runtime_;
+		};
+
+		/**
+		 * \brief Runs a deployment job.
+		 * \param obj The job.
+		 * \return A NULL pointer.
+		 */
+		static void* StartDeploymentThread ( void* obj );
+
 		/**
 		 * \brief Waits for a console connection using an opened port.
 		 * \return A NULL pointer.
 		 */
 		static void* StartConsoleThread ( void* obj );
 
+		/**
+		 * \brief Applies the operations decided by the autoscaler.
+		 * \return A NULL pointer.
+		 */
+		static void* StartScalingThread ( void* obj );
+
 		/**
 		 * \brief Waits for a communication from other cluster's machines.
 		 * \return A NULL pointer.
@@ -85,26 +125,123 @@ class Runtime {
 		static void* StartServerThread ( void * obj );
 
 		/**
-		 * \brief Verifies whether a processing module is already running.
+		 * \brief Verifies whether a processing module is already running, from the module directory replica of this
+		 * runtime daemon.
 		 * \param processing_module_name The name of a processing module.
 		 * \return True if the processing module is already running. False otherwise.
 		 */
 		bool ProcessingModuleRunning ( string processing_module_name );
 
+		/**
+		 * \brief Stops the scaling thread, discarding the queued operations. The thread finishes the operation it is
+		 * applying, if any, and is joined when the runtime stops running.
+		 * \return Not applicable.
+		 */
+		void StopScaling ( void );
+
+		/**
+		 * \brief Submits a scaling operation to the console port of this runtime, so it is carried out as a console
+		 * command, one at a time with the commands of the actual consoles.
+		 * \param operation_message The add-instance or remove-instance message.
+		 * \return Whether the operation succeeded.
+		 */
+		bool SubmitScalingOperation ( Message& operation_message );
+
 		/**
 		 * \brief Spawns the instances of a processing module.
+		 * \param spawn_communicator Communicator of this runtime alone, on which the spawn is performed.
 		 * \param processing_module_configurator The processing module configurator.
 		 * \param scheduler_result The scheduling result.
 		 * \return A communicator to the new process group.
 		 */
-		MpiCommunicator* SpawnProcessingModuleInstances ( ProcessingModuleConfigurator* processing_module_configurator, map < string, int >* scheduler_result ) throw ( ProcessSpawnningException );
+		MpiCommunicator* SpawnProcessingModuleInstances ( MpiCommunicator* spawn_communicator, ProcessingModuleConfigurator* processing_module_configurator, map < string, int >* scheduler_result ) throw ( ProcessSpawnningException );
+
+		/**
+		 * \brief Waits for a free spawn communicator. Concurrent spawns cannot share a communicator, so each job spawns
+		 * on one of the Constants::DEPLOYMENT_MAX_SPAWNS duplicates of the self communicator.
+		 * \return The communicator, given back by ReleaseSpawnCommunicator.
+		 */
+		MpiCommunicator* AcquireSpawnCommunicator ( void );
+
+		/**
+		 * \brief Gives back the communicator of a job spawn, so another job can spawn.
+		 * \param spawn_communicator The communicator returned by AcquireSpawnCommunicator.
+		 * \return Not applicable.
+		 */
+		void ReleaseSpawnCommunicator ( MpiCommunicator* spawn_communicator );
 
 		/**
-		 * \brief Adds a processing module to the local server.
+		 * \brief Discards the oldest finished deployment jobs beyond Constants::DEPLOYMENT_HISTORY_SIZE. Must be called
+		 * with the deployment jobs mutex locked.
+		 * \return Not applicable.
+		 */
+		void PruneDeploymentJobs ( void );
+
+		/**
+		 * \brief Lists the deployment jobs submitted to this runtime, the running ones and the most recent finished
+		 * ones, with the error of those that failed.
+		 * \return One line by job, with its identification, its module and its state.
+		 */
+		string QueryDeployments ( void );
+
+		/**
+		 * \brief Runs a deployment job and records its outcome, listed by the jobs command. Failures are also logged, as
+		 * console commands errors are.
+		 * \param job The job.
+		 * \return Not applicable.
+		 */
+		void RunDeployment ( DeploymentJob* job );
+
+		/**
+		 * \brief Validates a processing module submitted by a console and starts a deployment job for it. The checks
+		 * that need no spawn are done at once, so their errors are returned to the console.
 		 * \param received_message Message received from the console.
+		 * \return The job identification.
+		 */
+		int SubmitDeployment ( Message& received_message ) throw ( ProcessSpawnningException, XMLParserException );
+
+		/**
+		 * \brief Waits for the running deployment jobs to finish.
+		 * \return Not applicable.
+		 */
+		void WaitDeployments ( void );
+
+		/**
+		 * \brief Waits for the jobs submitted before a job to initialize their instances.
+		 * \param job The job.
+		 * \return Not applicable.
+		 */
+		void WaitDeploymentTurn ( DeploymentJob* job );
+
+		/**
+		 * \brief Gathers the metrics of the processing module instances running on every host.
+		 * \param is_query_manager Flag to identify the operation manager.
+		 * \param received_message The message containing the query.
+		 * \return The metrics, by host, for the manager. An empty string otherwise.
+		 */
+		string QueryMetrics ( bool is_query_manager, Message& received_message );
+
+		/**
+		 * \brief Adds a processing module to the local server, as a deployment job. Locks are held only while the
+		 * shared state is updated, never while the instances are spawned.
+		 * \param job The deployment job.
+		 * \return Not applicable.
+		 */
+		void AddProcessingModule ( DeploymentJob* job ) throw ( ProcessSpawnningException );
+
+		/**
+		 * \brief Adds instances to a running processing module.
+		 * \param addition_manager Flag to identify the operation manager.
+		 * \param received_message Message received from the console or from the operation manager.
 		 * \return Not applicable.
 		 */
-		void AddProcessingModule ( Message& received_message ) throw ( ProcessSpawnningException, XMLParserException );
+		void AddProcessingModuleInstance ( bool addition_manager, Message& received_message ) throw ( ProcessSpawnningException, XMLParserException );
+
+		/**
+		 * \brief Applies the queued scaling operations one at a time until the shutdown.
+		 * \return Not applicable.
+		 */
+		void ApplyScalingOperations ( void );
 
 		/**
 		 * \brief Creates a child process and exits the parent process. Makes a daemon process.
@@ -112,6 +249,14 @@ class Runtime {
 		 */
 		void Daemonize ( void );
 
+		/**
+		 * \brief Spawns the new instances of a processing module managed by this server and waits for them to join the
+		 * running instances.
+		 * \param received_message Message asking for the new instances.
+		 * \return Not applicable.
+		 */
+		void DoProcessingModuleInstanceAddition ( Message& received_message ) throw ( ProcessSpawnningException, XMLParserException );
+
 		/**
 		 * todo
 		 */
@@ -161,12 +306,13 @@ class Runtime {
 		void HandleSignal ( int signal );
 
 		/**
-		 * \brief Checks whether this manager is the owner of a specified module.
-		 * \param received_message The message asking for the existence of a module.
-		 * \param requester The requester manager.
+		 * \brief Sends a checkpoint barrier to the local processing modules without inputs, which forward it through their
+		 * output flows.
+		 * \param barrier The barrier message, with the checkpoint identification.
 		 * \return Not applicable.
 		 */
-		void IsOwnerOfProcessingModule ( Message received_message, int requester );
+		void InjectCheckpointBarrier ( Message& barrier );
+
 
 		/**
 		 * \brief Locks a file to allow just a single instance of the server.
@@ -175,10 +321,31 @@ class Runtime {
 		void LockLocalResources ( void ) throw ( FileOperationException );
 
 		/**
-		 * todo
+		 * \brief Moves an instance of a processing module to another host, by adding an instance on the target host and
+		 * then removing the migrated one. Modules with a labeled input are not migrated, since the removal would shift the ranks
+		 * their labels are routed to.
+		 * \param instance The rank of the migrated instance.
+		 * \param module_name The processing module name.
+		 * \param target_host The host to receive the instance.
+		 * \return Not applicable.
 		 */
 		void MigrateProcessingModuleInstance ( int instance, string module_name, string target_host );
 
+		/**
+		 * \brief Sends an update of the module directory to the other runtime daemons. The caller holds the cluster
+		 * communicator lock whenever the server thread may be using it.
+		 * \param update The update, as returned by ModuleDirectory::Publish or Withdraw.
+		 * \return Not applicable.
+		 */
+		void PublishModuleDirectory ( string update );
+
+		/**
+		 * \brief Prints the records of a batch sent by an asynchronous logger. Must be called by the root daemon.
+		 * \param batch The message containing the batch.
+		 * \return Not applicable.
+		 */
+		void PrintLogBatch ( Message& batch );
+
 		/**
 		 * \brief Builds a list of the requested ports.
 		 * \param is_query_manager Flag to identify the operation manager.
@@ -215,6 +382,21 @@ class Runtime {
 		 */
 		void SpawnDatabaseDaemon ( void );
 
+		/**
+		 * \brief Asks the scheduler for the scaling operations of the local processing modules when the autoscaling
+		 * interval has elapsed, and queues them to the scaling thread.
+		 * \return Not applicable.
+		 */
+		void TriggerAutoscaling ( void );
+
+		/**
+		 * \brief Starts a checkpoint of all the processing modules when the checkpoint interval has elapsed. Only the
+		 * root manager starts checkpoints, identified by their starting time in milliseconds, and the other managers
+		 * inject the barriers in their local modules.
+		 * \return Not applicable.
+		 */
+		void TriggerCheckpoint ( void );
+
 		/**
 		 * \brief Waits connection from the opened port.
 		 * \return Not applicable.
@@ -254,15 +436,63 @@ class Runtime {
 		/** \brief Communicator including only the local runtime. */
 		MpiCommunicator* self_communicator_;
 
+		/** \brief Time the last checkpoint was started. */
+		struct timeval last_checkpoint_time_;
+
+		/** \brief Time the autoscaler last looked at the processing modules. */
+		struct timeval last_autoscaling_time_;
+
+		/** \brief Scaling operations waiting to be applied. */
+		deque < SchedulerOperation > scaling_operations_;
+
+		/** Mutex used to control access to the scaling operations. */
+		pthread_mutex_t scaling_operations_mutex_;
+
+		/** \brief Condition signaled when scaling operations are queued or the scaling thread must stop. */
+		pthread_cond_t scaling_operations_condition_;
+
+		/** \brief Whether the scaling thread must stop, set at the shutdown. */
+		bool scaling_stopped_;
+
 		/** Mutex used to control access to the shutdown notification. */
 		pthread_mutex_t shutdown_notification_mutex_;
 
+		/** \brief Replica of the directory of the processing modules running on the system. */
+		ModuleDirectory module_directory_;
+
+		/** \brief Deployment jobs submitted to this runtime, by identification. */
+		map < int, DeploymentJob* > deployment_jobs_;
+
+		/** \brief Names of the processing modules being deployed. */
+		set < string > deploying_modules_;
+
+		/** \brief Identification of the next deployment job. */
+		int next_deployment_;
+
+		/** \brief Identification of the deployment job allowed to initialize its instances. */
+		int deployment_turn_;
+
+		/** \brief Duplicates of the self communicator not used by a spawn. */
+		vector < MpiCommunicator* > spawn_communicators_;
+
+		/** \brief Number of deployment jobs not finished. */
+		int running_deployments_;
+
+		/** Mutex used to control access to the deployment jobs. */
+		pthread_mutex_t deployment_jobs_mutex_;
+
+		/** \brief Condition signaled when a deployment job finishes a spawn, its initialization or itself. */
+		pthread_cond_t deployment_jobs_condition_;
+
 		/** \brief Thread to wait connection from console. */
 		pthread_t console_thread_;
 
 		/** \brief Thread used to exchange messages with other servers. */
 		pthread_t server_thread_;
 
+		/** \brief Thread used to apply the scaling operations. */
+		pthread_t scaling_thread_;
+
 		/** \brief Runtime configurator. */
 		RuntimeConfigurator* runtime_configurator_;
 
@@ -4,6 +4,12 @@
  * \author Thatyene Louise Alves de Souza Ramos
  */
 
+/* C libraries */
+#include <math.h>
+
+/* C++ libraries */
+#include <algorithm>
+
 /* Project's .h */
 #include <scheduler/scheduler.h>
 
@@ -15,9 +21,106 @@ Scheduler::~Scheduler ( void ) {
 
 }
 
-vector<SchedulerOperation> Scheduler::Balance ( map<string, ProcessingModuleEntry*>* active_processing_modules ) {
+vector<SchedulerOperation> Scheduler::Balance ( map<string, Host>* cluster, map<string, ProcessingModuleEntry*>* active_processing_modules, long cooldown ) {
 	vector<SchedulerOperation> operations;
-//	op.SetOperationDescription(Constants::SCHED_OP_MIGRATION);
+	map<string, double> host_load;
+	struct timeval now, last_scaling_time;
+
+	gettimeofday ( &now, NULL );
+
+	/* Sums up the utilization of every reported instance by host */
+	for (map<string, ProcessingModuleEntry*>::iterator it = active_processing_modules->begin ( ); it != active_processing_modules->end ( ); ++it) {
+		map<int, InstanceStatisticsMessage>* statistics = it->second->GetStatistics ( );
+		for (map<int, InstanceStatisticsMessage>::iterator it_s = statistics->begin ( ); it_s != statistics->end ( ); ++it_s) {
+			if (it_s->second.GetInterval ( ) > 0) {
+				host_load[it_s->second.GetHostName ( )] += it_s->second.GetCPUTime ( ) * 100.0 / it_s->second.GetInterval ( );
+			}
+		}
+	}
+
+	for (map<string, ProcessingModuleEntry*>::iterator it = active_processing_modules->begin ( ); it != active_processing_modules->end ( ); ++it) {
+		ProcessingModuleConfigurator* configurator = it->second->GetConfigurator ( );
+		map<int, InstanceStatisticsMessage>* statistics = it->second->GetStatistics ( );
+		int number_instances = configurator->GetNumberInstances ( );
+		int minimum_instances = configurator->GetMinimumInstances ( );
+		int maximum_instances = configurator->GetMaximumInstances ( );
+		double total_utilization = 0, total_starvation = 0, total_throughput = 0;
+		map<int, double> utilization, throughput, preemptions;
+
+		/* Only autoscaled modules with a full round of statistics, out of their cool-down period, are considered */
+		if (maximum_instances == 0 || (int) statistics->size ( ) < number_instances) {
+			continue;
+		}
+		last_scaling_time = it->second->GetLastScalingTime ( );
+		if (timerisset ( &last_scaling_time ) && ((now.tv_sec - last_scaling_time.tv_sec) * 1000 + (now.tv_usec - last_scaling_time.tv_usec) / 1000) < cooldown) {
+			continue;
+		}
+
+		for (map<int, InstanceStatisticsMessage>::iterator it_s = statistics->begin ( ); it_s != statistics->end ( ); ++it_s) {
+			double interval = (it_s->second.GetInterval ( ) > 0 ? it_s->second.GetInterval ( ) : 1);
+			utilization[it_s->first] = it_s->second.GetCPUTime ( ) * 100.0 / interval;
+			throughput[it_s->first] = it_s->second.GetNumberRecords ( ) * 1000.0 / interval;
+			preemptions[it_s->first] = it_s->second.GetInvoluntarySwitches ( ) * 1000.0 / interval;
+			total_utilization += utilization[it_s->first];
+			total_starvation += it_s->second.GetStarvationTime ( ) * 100.0 / interval;
+			total_throughput += throughput[it_s->first];
+		}
+
+		double average_utilization = total_utilization / statistics->size ( );
+		double average_starvation = total_starvation / statistics->size ( );
+		double average_throughput = total_throughput / statistics->size ( );
+		SchedulerOperation operation;
+		operation.SetModuleName ( it->first );
+
+		if (average_utilization >= Constants::SCHED_SCALE_OUT_UTILIZATION && average_starvation < Constants::SCHED_STARVATION_LIMIT && number_instances < maximum_instances) {
+			/* Adds enough instances to bring the utilization down to the target, bounded by the maximum */
+			int desired_instances = (int) ceil ( total_utilization / Constants::SCHED_TARGET_UTILIZATION );
+			operation.SetOperationDescription ( Constants::SCHED_OP_SCALE_OUT );
+			operation.SetNumberInstances ( min ( max ( desired_instances - number_instances, 1 ), maximum_instances - number_instances ) );
+			operations.push_back ( operation );
+		}
+		else if (average_utilization < Constants::SCHED_SCALE_IN_UTILIZATION && number_instances > minimum_instances) {
+			operation.SetOperationDescription ( Constants::SCHED_OP_SCALE_IN );
+			operation.SetInstanceRank ( number_instances - 1 );
+			operations.push_back ( operation );
+		}
+		else if (!configurator->HasLabeledInput ( )) {
+			/* Looks for a busy instance delivering much less than its peers while being preempted, since one slowed by
+			 * its own records would be as slow on another host. Instances of labeled inputs are never migrated: the
+			 * replacement joins as the last rank and the ranks after the migrated one shift, so the labels would no
+			 * longer reach the instances holding their state */
+			for (map<int, double>::iterator it_u = utilization.begin ( ); it_u != utilization.end ( ); ++it_u) {
+				if (it_u->second < Constants::SCHED_SCALE_OUT_UTILIZATION || throughput[it_u->first] * 100 >= Constants::SCHED_STRAGGLER_THROUGHPUT * average_throughput || preemptions[it_u->first] < Constants::SCHED_STRAGGLER_PREEMPTIONS) {
+					continue;
+				}
+
+				string straggler_host = statistics->find ( it_u->first )->second.GetHostName ( );
+				vector<string>* demands = configurator->GetDemands ( );
+				string target_host;
+				double target_load = host_load[straggler_host];
+
+				for (map<string, Host>::iterator it_h = cluster->begin ( ); it_h != cluster->end ( ); ++it_h) {
+					bool able = (it_h->first != straggler_host);
+					for (vector<string>::iterator it_d = demands->begin ( ); able && it_d != demands->end ( ); ++it_d) {
+						able = it_h->second.HasResource ( *it_d );
+					}
+					if (able && host_load[it_h->first] < target_load) {
+						target_host = it_h->first;
+						target_load = host_load[it_h->first];
+					}
+				}
+
+				if (target_host != "") {
+					operation.SetOperationDescription ( Constants::SCHED_OP_MIGRATION );
+					operation.SetInstanceRank ( it_u->first );
+					operation.SetTargetHost ( target_host );
+					operations.push_back ( operation );
+				}
+				break;
+			}
+		}
+	}
+
 	return operations;
 }
 
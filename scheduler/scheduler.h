@@ -7,8 +7,12 @@
 #ifndef WATERSHED_SCHEDULER_SCHEDULER_H_
 #define WATERSHED_SCHEDULER_SCHEDULER_H_
 
+/* C libraries */
+#include <sys/time.h>
+
 /* C++ libraries */
 #include <map>
+#include <vector>
 
 /* Project's .h */
 #include <library/configurator.h>
@@ -53,9 +57,16 @@ class Scheduler {
 		map < string, int > ChooseHostsToAddProcessingModule(map<string, Host>* cluster, MpiCommunicator* database_communicator, ProcessingModuleConfigurator* processing_module_configurator);
 
 		/**
-		 * todo
+		 * \brief Decides the scaling operations for the autoscaled processing modules from the statistics reported by
+		 * their instances. A module scales out when its instances are busy and not starved by their producers, scales in
+		 * when they are idle, and otherwise has a straggler instance migrated to the least loaded eligible host, unless
+		 * the module has a labeled input.
+		 * \param cluster Cluster information.
+		 * \param active_processing_modules The running processing modules.
+		 * \param cooldown Minimum time, in milliseconds, between two operations on the same module.
+		 * \return The operations to be applied, at most one by module.
 		 */
-		vector<SchedulerOperation> Balance (map<string, ProcessingModuleEntry*>* active_processing_modules);
+		vector<SchedulerOperation> Balance (map<string, Host>* cluster, map<string, ProcessingModuleEntry*>* active_processing_modules, long cooldown);
 
 	protected:
 
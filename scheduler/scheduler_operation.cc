@@ -7,6 +7,9 @@
 #include <scheduler/scheduler_operation.h>
 
 SchedulerOperation::SchedulerOperation ( void ) {
+	instance_rank_ = 0;
+	number_instances_ = 0;
+	operation_description_ = 0;
 
 }
 
@@ -21,6 +24,10 @@ string SchedulerOperation::GetModuleName ( void ) {
 	return module_name_;
 }
 
+int SchedulerOperation::GetNumberInstances ( void ) {
+	return number_instances_;
+}
+
 int SchedulerOperation::GetOperationDescription ( void ) {
 	return operation_description_;
 }
@@ -37,6 +44,10 @@ void SchedulerOperation::SetModuleName ( string module_name_ ) {
 	this->module_name_ = module_name_;
 }
 
+void SchedulerOperation::SetNumberInstances ( int number_instances_ ) {
+	this->number_instances_ = number_instances_;
+}
+
 void SchedulerOperation::SetOperationDescription ( int operation_description_ ) {
 	this->operation_description_ = operation_description_;
 }
@@ -33,6 +33,12 @@ class SchedulerOperation {
 		 */
 		int GetInstanceRank ( void );
 
+		/**
+		 * \brief Retrieves the number of instances added by a scale-out operation.
+		 * \return The number of instances.
+		 */
+		int GetNumberInstances ( void );
+
 		/**
 		 * todo
 		 */
@@ -58,6 +64,13 @@ class SchedulerOperation {
 		 */
 		void SetModuleName ( string module_name_ );
 
+		/**
+		 * \brief Sets the number of instances added by a scale-out operation.
+		 * \param number_instances_ The number of instances.
+		 * \return Not applicable.
+		 */
+		void SetNumberInstances ( int number_instances_ );
+
 		/**
 		 * todo
 		 */
@@ -74,6 +87,8 @@ class SchedulerOperation {
 
 		/** todo */
 		int instance_rank_;
+		/** \brief Number of instances added by a scale-out operation. */
+		int number_instances_;
 		/** todo */
 		int operation_description_;
 		/** todo */
@@ -0,0 +1,93 @@
+/**
+ * \file stream/stream_catalog.cc
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+/* Project's .h */
+#include "stream_catalog.h"
+
+StreamCatalog::StreamCatalog ( void ) {
+}
+
+StreamCatalog::~StreamCatalog ( void ) {
+}
+
+void StreamCatalog::AddProcessingModule ( string processing_module_name, ProcessingModuleConfigurator* configurator ) {
+	RemoveProcessingModule ( processing_module_name );
+
+	ModuleFlows flows;
+	flows.flow_out_ = configurator->GetFlowOut ( );
+	if (flows.flow_out_.compare ( Constants::EMPTY_ATTRIBUTE ) != 0) {
+		producers_[flows.flow_out_].insert ( processing_module_name );
+	}
+
+	vector<InputFlow>* inputs = configurator->GetInputs ( );
+	for (uint i = 0; i < inputs->size ( ); ++i) {
+		flows.inputs_.push_back ( inputs->at ( i ).GetName ( ) );
+		consumers_[inputs->at ( i ).GetName ( )].insert ( processing_module_name );
+	}
+	modules_[processing_module_name] = flows;
+}
+
+string StreamCatalog::GetConsumers ( string processing_module_name ) {
+	string consumers = "";
+	tr1::unordered_map<string, ModuleFlows>::iterator module = modules_.find ( processing_module_name );
+	if (module == modules_.end ( ) || module->second.flow_out_.compare ( Constants::EMPTY_ATTRIBUTE ) == 0) {
+		return consumers;
+	}
+
+	tr1::unordered_map<string, set<string> >::iterator flow = consumers_.find ( module->second.flow_out_ );
+	if (flow != consumers_.end ( )) {
+		for (set<string>::iterator it = flow->second.begin ( ); it != flow->second.end ( ); ++it) {
+			consumers.append ( *it );
+			consumers.append ( " " );
+		}
+	}
+	return consumers;
+}
+
+string StreamCatalog::GetProducers ( string processing_module_name ) {
+	string producers = "";
+	tr1::unordered_map<string, ModuleFlows>::iterator module = modules_.find ( processing_module_name );
+	if (module == modules_.end ( )) {
+		return producers;
+	}
+
+	for (uint i = 0; i < module->second.inputs_.size ( ); ++i) {
+		tr1::unordered_map<string, set<string> >::iterator flow = producers_.find ( module->second.inputs_[i] );
+		if (flow != producers_.end ( )) {
+			for (set<string>::iterator it = flow->second.begin ( ); it != flow->second.end ( ); ++it) {
+				producers.append ( *it );
+				producers.append ( " " );
+			}
+		}
+	}
+	return producers;
+}
+
+void StreamCatalog::RemoveProcessingModule ( string processing_module_name ) {
+	tr1::unordered_map<string, ModuleFlows>::iterator module = modules_.find ( processing_module_name );
+	if (module == modules_.end ( )) {
+		return;
+	}
+
+	/* Flows left without producers and consumers are dropped, so the indexes only hold the running streams */
+	tr1::unordered_map<string, set<string> >::iterator flow = producers_.find ( module->second.flow_out_ );
+	if (flow != producers_.end ( )) {
+		flow->second.erase ( processing_module_name );
+		if (flow->second.empty ( )) {
+			producers_.erase ( flow );
+		}
+	}
+	for (uint i = 0; i < module->second.inputs_.size ( ); ++i) {
+		flow = consumers_.find ( module->second.inputs_[i] );
+		if (flow != consumers_.end ( )) {
+			flow->second.erase ( processing_module_name );
+			if (flow->second.empty ( )) {
+				consumers_.erase ( flow );
+			}
+		}
+	}
+	modules_.erase ( module );
+}
@@ -0,0 +1,106 @@
+/**
+ * \file stream/stream_catalog.h
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ */
+
+#ifndef WATERSHED_STREAM_STREAM_CATALOG_H_
+#define WATERSHED_STREAM_STREAM_CATALOG_H_
+
+/* C++ libraries */
+#include <set>
+#include <string>
+#include <tr1/unordered_map>
+#include <vector>
+
+/* Project's .h */
+#include "library/configurator.h"
+
+using namespace std;
+
+/**
+ * \class StreamCatalog
+ * \brief Index of the streams of the active processing modules, from each flow name to the modules producing and
+ * consuming it. The catalog is updated when a module is added or removed, so resolving the producers or the consumers
+ * of a module does not scan the other modules.
+ * \author Rodrigo Silva Oliveira
+ * \author Thatyene Louise Alves de Souza Ramos
+ * \version 1.0
+ * \date 2012
+ */
+class StreamCatalog {
+
+	public:
+
+		/**
+		 * \brief Constructor. Creates a new instance of StreamCatalog.
+		 * \return Not applicable.
+		 */
+		StreamCatalog ( void );
+
+		/**
+		 * \brief Default destructor.
+		 * \return Not applicable.
+		 */
+		virtual ~StreamCatalog ( void );
+
+		/**
+		 * \brief Indexes the output and input flows of a processing module, replacing the ones it was indexed with.
+		 * \param processing_module_name The processing module name.
+		 * \param configurator The processing module configurator.
+		 * \return Not applicable.
+		 */
+		void AddProcessingModule ( string processing_module_name, ProcessingModuleConfigurator* configurator );
+
+		/**
+		 * \brief Lists the processing modules consuming the output flow of a processing module.
+		 * \param processing_module_name The processing module name.
+		 * \return The consumers names, each one followed by a space.
+		 */
+		string GetConsumers ( string processing_module_name );
+
+		/**
+		 * \brief Lists the processing modules producing the input flows of a processing module.
+		 * \param processing_module_name The processing module name.
+		 * \return The producers names, each one followed by a space.
+		 */
+		string GetProducers ( string processing_module_name );
+
+		/**
+		 * \brief Removes the flows of a processing module from the indexes.
+		 * \param processing_module_name The processing module name.
+		 * \return Not applicable.
+		 */
+		void RemoveProcessingModule ( string processing_module_name );
+
+	protected:
+
+	private:
+
+		/**
+		 * \brief Flows of an indexed processing module.
+		 */
+		struct ModuleFlows {
+				/** \brief The output flow, Constants::EMPTY_ATTRIBUTE when the module has none. */
+				string flow_out_;
+				/** \brief The input flows. */
+				vector < string > inputs_;
+		};
+
+		/** \brief Flows of each indexed processing module, by module name. */
+		tr1::unordered_map < string, ModuleFlows > modules_;
+
+		/** \brief Processing modules producing each flow, by flow name. */
+		tr1::unordered_map < string, set < string > > producers_;
+
+		/** \brief Processing modules consuming each flow, by flow name. */
+		tr1::unordered_map < string, set < string > > consumers_;
+
+		/** \brief Copy is not allowed. */
+		StreamCatalog ( const StreamCatalog& );
+
+		/** \brief Assignment is not allowed. */
+		StreamCatalog& operator= ( const StreamCatalog& );
+};
+
+#endif /* WATERSHED_STREAM_STREAM_CATALOG_H_ */
@@ -63,14 +63,19 @@ void StreamManager::AcceptConnection ( void ) {
 
 void StreamManager::AddProcessingModule ( MpiCommunicator* communicator, Message& received_message ) {
 
-	/* Receives the processing module's configurator file name */
-	string processing_module_configurator_file_name = (char*) received_message.GetData ( );
-	ProcessingModuleConfigurator* new_processing_module_configurator = new ProcessingModuleConfigurator ( processing_module_configurator_file_name );
-	new_processing_module_configurator->SetConfiguratorFileName ( processing_module_configurator_file_name );
+	/* Receives the processing module's configurator descriptor */
+	ProcessingModuleConfigurator* new_processing_module_configurator = new ProcessingModuleConfigurator ( (char*) received_message.GetData ( ), received_message.GetDataSize ( ) );
 
 	/* Creates the new entry for the new processing module. */
 	ProcessingModuleEntry* new_entry = new ProcessingModuleEntry ( communicator, new_processing_module_configurator );
+
+	/* A module which has added instances registers again, replacing the connection to its previous instances. */
+	if (active_processing_modules_.find ( new_processing_module_configurator->GetName ( ) ) != active_processing_modules_.end ( )) {
+		active_processing_modules_[new_processing_module_configurator->GetName ( )]->GetCommunicator ( )->Disconnect ( );
+		delete (active_processing_modules_[new_processing_module_configurator->GetName ( )]);
+	}
 	active_processing_modules_[new_processing_module_configurator->GetName ( )] = new_entry;
+	stream_catalog_.AddProcessingModule ( new_processing_module_configurator->GetName ( ), new_processing_module_configurator );
 }
 
 void StreamManager::ExchangeInitialInformation ( void ) {
@@ -197,20 +202,7 @@ void StreamManager::MainLoop ( void ) {
 }
 
 void StreamManager::QueryConsumers ( string processing_module_name, Message& received_message ) {
-	string flow_out = active_processing_modules_[processing_module_name]->GetConfigurator ( )->GetFlowOut ( );
-	string message_data = "";
-
-	if (flow_out.compare ( Constants::EMPTY_ATTRIBUTE ) != 0) {
-		for (map<string, ProcessingModuleEntry*>::iterator it = active_processing_modules_.begin ( ); it != active_processing_modules_.end ( ); ++it) {
-			vector<InputFlow>* inputs = it->second->GetConfigurator ( )->GetInputs ( );
-			for (uint i = 0; i < inputs->size ( ); ++i) {
-				if (inputs->at ( i ).GetName ( ).compare ( flow_out ) == 0) {
-					message_data.append ( it->first );
-					message_data.append ( " " );
-				}
-			}
-		}
-	}
+	string message_data = stream_catalog_.GetConsumers ( processing_module_name );
 
 	Message output_message;
 	output_message.SetOperationCode ( Constants::MESSAGE_OP_QUERY_PROCESSING_MODULE_CONSUMERS );
@@ -219,17 +211,7 @@ void StreamManager::QueryConsumers ( string processing_module_name, Message& rec
 }
 
 void StreamManager::QueryProducers ( string processing_module_name, Message& received_message ) {
-	vector<InputFlow>* inputs = active_processing_modules_[processing_module_name]->GetConfigurator ( )->GetInputs ( );
-	string message_data = "";
-
-	for (uint i = 0; i < inputs->size ( ); ++i) {
-		for (map<string, ProcessingModuleEntry*>::iterator it = active_processing_modules_.begin ( ); it != active_processing_modules_.end ( ); ++it) {
-			if (it->second->GetConfigurator ( )->GetFlowOut ( ).compare ( inputs->at ( i ).GetName ( ) ) == 0) {
-				message_data.append ( it->first );
-				message_data.append ( " " );
-			}
-		}
-	}
+	string message_data = stream_catalog_.GetProducers ( processing_module_name );
 
 	Message output_message;
 	output_message.SetOperationCode ( Constants::MESSAGE_OP_QUERY_PROCESSING_MODULE_PRODUCERS );
@@ -243,6 +225,7 @@ void StreamManager::RemoveProcessingModule ( Message& received_message ) {
 		active_processing_modules_[processing_module_name]->GetCommunicator ( )->Disconnect ( );
 		delete (active_processing_modules_[processing_module_name]);
 		active_processing_modules_.erase ( processing_module_name );
+		stream_catalog_.RemoveProcessingModule ( processing_module_name );
 	}
 }
 
@@ -13,6 +13,7 @@
 #include "common/logger.h"
 #include "library/configurator.h"
 #include "library/processing_module_entry.h"
+#include "stream/stream_catalog.h"
 
 /* Other libraries */
 #include <dbxml/DbXml.hpp>
@@ -127,6 +128,9 @@ class StreamManager {
 		/** \brief Active processing modules supported by the database daemons. */
 		map<string, ProcessingModuleEntry*> active_processing_modules_;
 
+		/** \brief Producers and consumers of the streams of the active processing modules. */
+		StreamCatalog stream_catalog_;
+
 		/** \brief Communicator used to exchange data with the other database daemons. */
 		MpiCommunicator* group_communicator_;
 